@@ -22,6 +22,9 @@ struct array_table_page_header
 
 	// first bucket that gets pointed to by this page's subtree
 	uint64_t first_bucket_id;
+
+	// epoch of the array_table, it is present only if the attd_p has_root_epoch, and it is maintained only on the root page
+	uint64_t epoch;
 };
 
 // number of bytes to store level of the page
@@ -29,6 +32,9 @@ struct array_table_page_header
 // values in range 1 to 4 both inclusive
 #define BYTES_FOR_PAGE_LEVEL 2
 
+// number of bytes for the epoch in the page header
+#define BYTES_FOR_ROOT_EPOCH 8
+
 #define sizeof_ARRAY_TABLE_PAGE_HEADER get_offset_to_end_of_array_table_page_header
 
 static inline uint32_t get_offset_to_end_of_array_table_page_header(const array_table_tuple_defs* attd_p);
@@ -51,7 +57,7 @@ static inline void print_array_table_page_header(const persistent_page* ppage, c
 
 static inline uint32_t get_offset_to_end_of_array_table_page_header(const array_table_tuple_defs* attd_p)
 {
-	return get_offset_to_end_of_common_page_header(attd_p->pas_p) + BYTES_FOR_PAGE_LEVEL + sizeof(uint64_t);
+	return get_offset_to_end_of_common_page_header(attd_p->pas_p) + BYTES_FOR_PAGE_LEVEL + sizeof(uint64_t) + (attd_p->has_root_epoch ? BYTES_FOR_ROOT_EPOCH : 0);
 }
 
 static inline uint32_t get_level_of_array_table_page(const persistent_page* ppage, const array_table_tuple_defs* attd_p)
@@ -81,6 +87,7 @@ static inline array_table_page_header get_array_table_page_header(const persiste
 		.parent = get_common_page_header(ppage, attd_p->pas_p),
 		.level = deserialize_uint32(array_table_page_header_serial, BYTES_FOR_PAGE_LEVEL),
 		.first_bucket_id = deserialize_uint64(array_table_page_header_serial + BYTES_FOR_PAGE_LEVEL, sizeof(uint64_t)),
+		.epoch = attd_p->has_root_epoch ? deserialize_uint64(array_table_page_header_serial + BYTES_FOR_PAGE_LEVEL + sizeof(uint64_t), BYTES_FOR_ROOT_EPOCH) : 0,
 	};
 }
 
@@ -91,6 +98,8 @@ static inline void serialize_array_table_page_header(void* hdr_serial, const arr
 	void* array_table_page_header_serial = hdr_serial + get_offset_to_array_table_page_header_locals(attd_p);
 	serialize_uint32(array_table_page_header_serial, BYTES_FOR_PAGE_LEVEL, atph_p->level);
 	serialize_uint64(array_table_page_header_serial + BYTES_FOR_PAGE_LEVEL, sizeof(uint64_t), atph_p->first_bucket_id);
+	if(attd_p->has_root_epoch)
+		serialize_uint64(array_table_page_header_serial + BYTES_FOR_PAGE_LEVEL + sizeof(uint64_t), BYTES_FOR_ROOT_EPOCH, atph_p->epoch);
 }
 
 static inline void set_array_table_page_header(persistent_page* ppage, const array_table_page_header* atph_p, const array_table_tuple_defs* attd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
@@ -120,6 +129,8 @@ static inline void print_array_table_page_header(const persistent_page* ppage, c
 	print_common_page_header(ppage, attd_p->pas_p);
 	printf("level : %"PRIu32"\n", get_level_of_array_table_page(ppage, attd_p));
 	printf("first_bucket_id : %"PRIu64"\n", get_first_bucket_id_of_array_table_page(ppage, attd_p));
+	if(attd_p->has_root_epoch)
+		printf("epoch : %"PRIu64"\n", get_array_table_page_header(ppage, attd_p).epoch);
 }
 
 #endif
\ No newline at end of file
@@ -10,6 +10,10 @@
 // initialize array table page
 int init_array_table_page(persistent_page* ppage, uint32_t level, uint64_t first_bucket_id, const array_table_tuple_defs* attd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// sets the epoch in the header of the page, it fails with 0, if the attd_p does not have_root_epoch
+// init_array_table_page sets it to 0, while the level_up_array_table_page and level_down_array_table_page preserve the epoch of the page
+int set_epoch_of_array_table_page(persistent_page* ppage, uint64_t epoch, const array_table_tuple_defs* attd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 // the first_bucket_id of the page is always a multiple of get_leaf_entries_refrenceable(level + 1)
 uint64_t get_first_bucket_id_for_level_containing_bucket_id_for_array_table_page(uint32_t level, uint64_t bucket_id, const array_table_tuple_defs* attd_p);
 
@@ -68,12 +72,14 @@ bucket_range get_delegated_bucket_range_for_child_index_on_array_table_page(cons
 uint32_t get_child_index_for_bucket_id_on_array_table_page(const persistent_page* ppage, uint64_t bucket_id, const array_table_tuple_defs* attd_p);
 
 // level up the arra table page, moving its contents into one of its children
+// the page keeps its own epoch
 // you must have write lock on the array_table_page to do this
 // all the page locks acquired in this function will be released on its return
 // NOTE: if the page is all NULL_PAGE_ID, then you do not need to level it up, instead re initialize as a leaf and valid first_bucket_id and insert into it
 int level_up_array_table_page(persistent_page* ppage, const array_table_tuple_defs* attd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
 // level down array table page, moving contents of its children into it
+// the page keeps its own epoch, it is not cloned from the child
 // this succeeds only if there is exactly 1 non NULL_PAGE_ID child on the page, and the page is not a leaf
 // you must have write lock on the array_table_page to do this
 // all the page locks acquired in this function will be released on its return
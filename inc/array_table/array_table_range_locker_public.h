@@ -26,6 +26,14 @@ bucket_range get_lock_range_for_array_table_range_locker(const array_table_range
 // you may set only if this returns 1
 int is_writable_array_table_range_locker(const array_table_range_locker* atrl_p);
 
+// reads the epoch from the root page of the array_table, into epoch
+// it returns 0, if the attd_p does not have_root_epoch OR if the local_root is not the root of the array_table (i.e. once the lock range has been minimized away from the root)
+int get_root_epoch_for_array_table_range_locker(const array_table_range_locker* atrl_p, uint64_t* epoch);
+
+// increments the epoch on the root page of the array_table, the atrl must be writable and its local_root must be the root of the array_table, returns 0 other wise
+// on an abort error, lock on the local root is released, then you only need to call delete_array_table_range_locker
+int increment_root_epoch_for_array_table_range_locker(array_table_range_locker* atrl_p, const void* transaction_id, int* abort_error);
+
 // you may only get, if the bucket_id is within get_lock_range_for_array_table_range_locker()
 // on an abort error, lock on the local root is released, then you only need to call delete_array_table_range_locker
 const void* get_from_array_table(array_table_range_locker* atrl_p, uint64_t bucket_id, void* preallocated_memory, const void* transaction_id, int* abort_error);
@@ -32,6 +32,10 @@ struct array_table_tuple_defs
 
 	// the maximum height of the array_table, it will never be more than this value
 	uint64_t max_array_table_height;
+
+	// if set, every page of the array_table carries an epoch in its page header, only the one on the root page is maintained
+	// the root epoch is preserved across the level_up and level_down of the root, and it changes only when incremented by the user of the array_table, it is 0 by default
+	int has_root_epoch;
 };
 
 // initializes the attributes in array_table_tuple_defs struct as per the provided parameters
@@ -42,6 +46,11 @@ struct array_table_tuple_defs
 // it also fails if record_def provided is not fixed sized
 int init_array_table_tuple_definitions(array_table_tuple_defs* attd_p, const page_access_specs* pas_p, const tuple_def* record_def);
 
+// makes every page of the array_table carry an epoch in its page header, this must be done before the array_table is created
+// the epoch takes 8 more bytes of the page header, so the entries_per_page are recomputed
+// it returns 0 (leaving attd_p unchanged), if the page can no longer hold atleast 1 leaf entry and 2 index entries
+int set_root_epoch_for_array_table_tuple_definitions(array_table_tuple_defs* attd_p);
+
 // it deallocates both the record_def and index_def and
 // then resets all the array_table_tuple_defs struct attributes to NULL or 0
 void deinit_array_table_tuple_definitions(array_table_tuple_defs* attd_p);
@@ -3,6 +3,7 @@
 
 #include<bplus_tree_iterator_public.h>
 #include<bplus_tree_tuple_definitions_public.h>
+#include<bplus_tree_statistics_public.h>
 
 #include<opaque_page_access_methods.h>
 #include<opaque_page_modification_methods.h>
@@ -50,6 +51,18 @@ int inspected_update_in_bplus_tree(uint64_t root_page_id, void* new_record, cons
 // insert may fail on an abort_error OR if a record with the same key already exists in the bplus_tree
 int insert_in_bplus_tree(uint64_t root_page_id, const void* record, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// inserts a batch of records in the bplus_tree, the records array is sorted (in place) by the keys of the records, before inserting them in that order
+// it walks down once per leaf page, and inserts all the following records of the batch that fall in its key range while holding its WRITE_LOCK
+// it walks down again only for a record that falls at or beyond the upper fence of the leaf page (the separator key in its parent) OR that needs the leaf page to be split
+// the records with the keys that already exist in the bplus_tree (or that appear again in the batch) are not inserted
+// it returns the number of records inserted, OR 0 on an abort_error
+uint32_t insert_batch_in_bplus_tree(uint64_t root_page_id, const void** records, uint32_t records_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// works just like insert_batch_in_bplus_tree, except that the records with the keys that already exist in the bplus_tree replace the existing records
+// if a key appears more than once in the batch, the record that comes last in the batch wins (the sort is stable)
+// it returns the number of records inserted or replaced, OR 0 on an abort_error
+uint32_t upsert_batch_in_bplus_tree(uint64_t root_page_id, const void** records, uint32_t records_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 // delete a record given by key
 // delete may fail on an abort_error OR if a record with the given key, does not exist in the bplus_tree
 int delete_from_bplus_tree(uint64_t root_page_id, const void* key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
@@ -58,6 +71,82 @@ int delete_from_bplus_tree(uint64_t root_page_id, const void* key, const bplus_t
 // it may fail on an abort_error, ALSO you must ensure that you are the only one who has lock on the given bplus_tree
 int destroy_bplus_tree(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
 
+// splits the complete key space of the bplus_tree into atmost partitions_count roughly equal sub-ranges (partitions)
+// the boundaries of these partitions are the separator keys read from the top most interior levels of the bplus_tree (using only READ_LOCKs), that are enough to provide (partitions_count - 1) separators
+// partition_keys must be an array of atleast (partitions_count - 1) elements, the returned keys (conforming to bpttd_p->key_def) are stored in it in ascending order, they must be free()-d by you
+// it returns the number of partition_keys (n) found, the bplus_tree is then partitioned into n+1 ranges as
+// [MIN, partition_keys[0]), [partition_keys[0], partition_keys[1]), ... , [partition_keys[n-1], MAX]
+// each of these ranges may be scanned concurrently with a separate iterator, opened with find_in_bplus_tree(partition_keys[i-1], KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS) (or MIN for the first partition), and stopped at the first tuple whose key >= partition_keys[i]
+// the partitions are only approximately equal, and the scheduling of the iterators over the partitions is left to you
+// it returns 0, on an abort_error (no partition_keys will then be allocated), or if the bplus_tree has only a leaf root page
+uint32_t get_partition_keys_for_bplus_tree(uint64_t root_page_id, uint32_t partitions_count, void** partition_keys, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// picks samples_count records uniformly at random (with replacement) from the bplus_tree, and passes each of them to record_sampled(context, record)
+// each sample is a random root to leaf walk (with READ_LOCKs, holding atmost 2 locks at any point), that picks one of the actual children of each interior page, and one of the records of the leaf page uniformly
+// the walk is then accepted with the probability = product of (fanout / max_fanout) of the pages on its path, and retried if rejected, making every record (nearly) equally likely
+// the max_fanout of each level is the largest fanout seen so far on that level (in this call), so the samples are exactly uniform only after these bounds have converged in the first few walks
+// the record passed to record_sampled is valid only until record_sampled returns, since the leaf page is unlocked right after
+// the same seed (on an unchanged bplus_tree) gives the same samples
+// for atleast half full pages, a walk is accepted with a probability of atleast (1/2) ^ height, pick max_consecutive_rejected_walks accordingly, it bounds the work done in search of each sample
+// it returns the number of samples found, this may be lesser than samples_count, on an abort_error OR if max_consecutive_rejected_walks consecutive walks get rejected
+// it returns 0 right away on an empty bplus_tree
+uint64_t sample_bplus_tree(uint64_t root_page_id, uint64_t samples_count, uint64_t seed, uint64_t max_consecutive_rejected_walks, void* context, void (*record_sampled)(void* context, const void* record), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// defragments the leaf pages of the bplus_tree, in the key order starting from the leaf page that contains the from_key (from_key = NULL implies the first leaf page)
+// each of the leaf pages is merged with the following leaf pages (under the same parent) as long as it stays within the target_fill_percent, so that the leaf pages get densely packed
+// a leaf page that lies before its previous leaf page in the page id space, is then relocated to a new page after it, so that the leaf pages get laid out in the ascending order of their page_ids
+// this relocation is done only if the page_access_methods provide get_new_page_with_write_lock_after, else the leaf pages stay at the page_ids that they were allocated at
+// the work is done for one level = 1 page at a time, holding a WRITE_LOCK on it and on atmost 3 of its leaf pages, while the concurrent readers and writers continue on the rest of the bplus_tree
+// the level = 1 page is reached with WRITE_LOCKs (just as for a delete), and once its leaf pages are done, it is merged with its sibling if it is left lesser than or equal to half full (an empty root is collapsed into its only child)
+// it visits atmost leaf_pages_budget leaf pages and returns 1, if there are more leaf pages to be defragmented, in that case the key to resume from is copied into resume_key (it must be atleast bpttd_p->max_index_record_size bytes large)
+// it returns 0, once the last leaf page has been defragmented OR on an abort_error
+int defragment_bplus_tree(uint64_t root_page_id, uint32_t target_fill_percent, uint64_t leaf_pages_budget, const void* from_key, void* resume_key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// rebuilds the bplus_tree fully packed (bottom up, from a read-only scan over its records), the root page stays at the same root_page_id
+// the pages of the packed copy are allocated level by level (all the leaf pages in the key order first), so they get contiguous page_ids if your page allocator hands them out in the ascending order
+// the packed root is then copied into the root page, and all the other pages of the old bplus_tree are freed
+// it is a bulk loaded rebuild only, the result is a regular bplus_tree that is still searched with find_in_bplus_tree (with the usual latching), any writes to it only make it lose its packing
+// use it for the bplus_trees that are only read after being built, ALSO like destroy_bplus_tree, you must ensure that you are the only one who has lock on the given bplus_tree
+// it returns 1 on success, and 0 on an abort_error
+int rebuild_packed_bplus_tree(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// compresses the cold leaf pages of the bplus_tree, using the page_codec of the bpttd_p (bpttd_p->codec), through the compress_page method of the page_access_methods
+// a leaf page is compressed only if it is unlocked and not modified in the last cold_after_modifications_count page modifications, and the page_access_methods decode it back when it gets locked again
+// the leaf pages are visited in the key order with READ_LOCKs, and each of them is compressed only after its lock is released (with the lock held on the next leaf page instead)
+// the bpttd_p must stay initialized (and at the same address), as long as any of the pages of this bplus_tree remain compressed
+// it returns the number of leaf pages compressed, it returns 0 right away if the page_access_methods do not provide compress_page
+uint64_t compress_cold_leaf_pages_of_bplus_tree(uint64_t root_page_id, uint64_t cold_after_modifications_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+typedef struct bplus_tree_export_writer bplus_tree_export_writer;
+struct bplus_tree_export_writer
+{
+	void* context;
+
+	// must write all of the size bytes of data (to a file, socket or a buffer), and return 1, else return 0 to fail the export
+	int (*write)(void* context, const void* data, uint32_t size);
+};
+
+typedef struct bplus_tree_import_reader bplus_tree_import_reader;
+struct bplus_tree_import_reader
+{
+	void* context;
+
+	// must read exactly size bytes into data, and return 1, else return 0 (on the end of the stream or an error) to fail the import
+	int (*read)(void* context, void* data, uint32_t size);
+};
+
+// streams all the records of the bplus_tree in the order of their keys (with a read-only scan), to the bptew_p
+// the stream is made of blocks of size prefixed records, each block carrying a checksum of its contents
+// the records are buffered a whole leaf page at a time, and the bptew_p is called only with no locks held on the bplus_tree (the scan is repositioned past the last exported record after each write)
+// so the stream is not a consistent snapshot, if the bplus_tree is being modified concurrently
+// it returns 1 on success, it returns 0 if the bptew_p fails OR on an abort_error
+int export_bplus_tree(uint64_t root_page_id, const bplus_tree_export_writer* bptew_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// builds a new bplus_tree from a stream produced by export_bplus_tree (with the same bpttd_p), and returns its root_page_id
+// the records are packed into the leaf pages as they are read (bottom up, just like rebuild_packed_bplus_tree), without walking down the bplus_tree for each record
+// it returns NULL_PAGE_ID if the stream is malformed or corrupt (the pages built until then are freed) OR on an abort_error
+uint64_t import_bplus_tree(const bplus_tree_import_reader* bptir_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 // prints all the pages in the bplus_tree
 // it may return an abort_error, unable to print all of the bplus_tree pages
 void print_bplus_tree(uint64_t root_page_id, int only_leaf_pages, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
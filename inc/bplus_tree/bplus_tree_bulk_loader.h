@@ -0,0 +1,59 @@
+#ifndef BPLUS_TREE_BULK_LOADER_H
+#define BPLUS_TREE_BULK_LOADER_H
+
+#include<stdint.h>
+
+#include<persistent_page.h>
+#include<bplus_tree_tuple_definitions.h>
+#include<opaque_page_access_methods.h>
+#include<opaque_page_modification_methods.h>
+
+/*
+	bplus_tree_bulk_loader builds a new bplus_tree bottom up, from records appended to it in the strictly ascending order of their keys
+	the leaf pages are packed full and linked as they are built, then each interior level is built (full packed) in one go from the index entries of the level below it
+	so the pages get allocated level by level, leaf level first and root last
+	all the pages it builds are private to it, until the root_page_id is returned by finish_bplus_tree_bulk_loader
+*/
+
+typedef struct bplus_tree_bulk_loader bplus_tree_bulk_loader;
+struct bplus_tree_bulk_loader
+{
+	// the leaf page being filled, it is WRITE_LOCKed, NULL_persistent_page if no record has been appended yet
+	persistent_page curr_leaf_page;
+
+	// index entries for all the pages of the level being built (one for each page), each bpttd_p->max_index_record_size bytes apart
+	// the key of the first index entry is never used, its child becomes the least_keys_page_id of the first page of the level above
+	void* index_entries;
+	uint64_t index_entries_count;
+	uint64_t index_entries_capacity;
+
+	// page_ids of all the pages allocated so far, to free them if the bulk load is discarded
+	uint64_t* allocated_page_ids;
+	uint64_t allocated_page_ids_count;
+	uint64_t allocated_page_ids_capacity;
+
+	const bplus_tree_tuple_defs* bpttd_p;
+
+	const page_access_methods* pam_p;
+
+	const page_modification_methods* pmm_p;
+};
+
+void initialize_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p);
+
+// appends a record to the last leaf page, allocating a new leaf page when it is full
+// it fails with a 0, if the record can not be inserted in this bplus_tree OR if its key is not greater than the key of the previous record OR on an abort_error
+int append_record_to_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* record, const void* transaction_id, int* abort_error);
+
+// builds the interior levels and returns the root_page_id of the new bplus_tree, an empty bplus_tree is created if no records were appended
+// it returns NULL_PAGE_ID on an abort_error, then you must still call deinitialize_bplus_tree_bulk_loader
+uint64_t finish_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error);
+
+// frees all the pages built so far, call it only if you do not intend to finish the bulk load
+// it must not be called after an abort_error (the pages allocated then go away with the rollback of the transaction)
+void discard_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error);
+
+// releases the lock on the curr_leaf_page (if any) and frees the memory held by the bulk loader
+void deinitialize_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error);
+
+#endif
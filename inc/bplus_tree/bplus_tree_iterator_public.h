@@ -7,6 +7,9 @@
 #include<bplus_tree_walk_down_custom_lock_type.h>
 #include<find_position.h>
 
+#include<user_value.h>
+#include<tuple.h>
+
 typedef struct bplus_tree_iterator bplus_tree_iterator;
 
 // returns NULL if bpi_p is writable OR on an abort error
@@ -43,6 +46,15 @@ const void* get_tuple_bplus_tree_iterator(bplus_tree_iterator* bpi_p);
 // on an abort_error, all the lps pages will be unlocked by the bplus_tree_iterator
 int prev_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* transaction_id, int* abort_error);
 
+// reads the elements at element_ids (element_count of them) of upto max_tuples tuples, starting at the current tuple and only from the current leaf page, into the column major arrays columns
+// i.e. columns[j][i] is set to the value of the element_ids[j] element of the ith tuple read, each of the columns[j] must be an array of atleast max_tuples user_values
+// this lets a scan that only needs a few elements, process each of them in a tight loop over a contiguous array
+// it is a convenience copy only, the leaf pages keep their row major layout (there are no per column minipages), so every tuple read is still accessed on the page
+// the cursor is left at the last tuple read, so that next_bplus_tree_iterator moves to the first tuple after this batch
+// the values pointing into the page (like strings and blobs) are valid only until next_*, prev_*, remove_from_*, update_at_* and delete_* functions are not called
+// it returns the number of tuples read, it returns 0 if the cursor does not point to a tuple
+uint32_t get_projected_batch_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const positional_accessor* element_ids, uint32_t element_count, user_value** columns, uint32_t max_tuples);
+
 // all locks held by the iterator will be released before, the iterator is destroyed/deleted
 // releasing locks may result in an abort_error
 void delete_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* transaction_id, int* abort_error);
@@ -56,6 +68,13 @@ void debug_print_lock_stack_for_bplus_tree_iterator(bplus_tree_iterator* bpi_p);
 // here f_pos1 = MIN, refers to the -infinity, and f_pos2 = MAX refers to +infiniy
 int narrow_down_range_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* key1, find_position f_pos1, const void* key2, find_position f_pos2, uint32_t key_element_count_concerned, const void* transaction_id, int* abort_error);
 
+// repositions the iterator, as if it was freshly opened with find_in_bplus_tree(key, key_element_count_concerned, find_pos) with the same parameters
+// an unstacked iterator first checks if the key falls on the current leaf page or on the next few leaf pages (using only the next page pointers), else it walks down from the root
+// a stacked iterator walks down only from the lowest locked interior page, whose child_index to be followed remains the same, (if the root page is no longer locked, then it walks down from the root)
+// this makes it cheap to seek forward by small distances, as required by merge-joins and skip-scans
+// on an abort_error, all the locks are released, then you only need to call delete_bplus_tree_iterator
+int seek_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const void* transaction_id, int* abort_error);
+
 // below functions can be used with only writable iterator
 
 typedef enum bplus_tree_after_remove_operation bplus_tree_after_remove_operation;
@@ -93,9 +112,6 @@ int insert_using_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* tup
 
 // you can use the below function only to update only a fixed length non-key column
 
-#include<user_value.h>
-#include<tuple.h>
-
 // update a non_key column inplace at the place that the bplus_tree_iterator is pointing to
 // ADVISED 	:: only update columns that do not change the tuple size on the page, else the page may become less than half full and this can not be fixed without a merge, and you can not mrege with an iterator
 //			:: also attempting to update to a element value that can increase the tuple size, may even fail, because the slot for the tuple is not big enough
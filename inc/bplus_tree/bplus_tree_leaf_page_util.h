@@ -41,4 +41,8 @@ int can_merge_bplus_tree_leaf_pages(const persistent_page* page1, const persiste
 // if this function returns a 1, then it is left on to the calling function to delete the corresponding parent entry of the page that is next to page1
 int merge_bplus_tree_leaf_pages(persistent_page* page1, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// same as merge_bplus_tree_leaf_pages(), but the page next to page1 (page2) is passed already WRITE_LOCKed by the caller
+// lock on page1 is not released, while the lock on page2 is always released (OR the page2 is freed on a successfull merge), and *page2_p is set to a NULL persistent_page
+int merge_bplus_tree_leaf_pages_with_locked_next_page(persistent_page* page1, persistent_page* page2_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 #endif
\ No newline at end of file
@@ -14,4 +14,9 @@
 // so do call release_all_locks_and_deinitialize_stack_reenterable once you are done with the stack
 int merge_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// same as merge_and_unlock_pages_up(), but the top of the locked_pages_stack must be an interior page, whose entries have already been deleted by the caller
+// so no entry is deleted from it, it is only merged with its sibling (if it is not more than half full) OR collapsed into its only child (if it is the root with no entries)
+// and then the merge propagates up as usual
+int merge_interior_page_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef BPLUS_TREE_PAGE_CODEC_H
+#define BPLUS_TREE_PAGE_CODEC_H
+
+#include<page_codec.h>
+
+#include<bplus_tree_tuple_definitions_public.h>
+
+/*
+**	page_codec for the pages of a bplus_tree
+**	on a page with fixed sized tuples, every tuple is xor-ed with the tuple preceding it (the tuples are sorted, so the neighbours share most of their bytes)
+**	then only the non zero bytes of the page are stored, each group of 8 bytes as a 1 byte mask of its non zero bytes followed by them
+**	on a leaf page, with a single UINT or INT key, the keys are first taken out of the tuples, and stored as a frame of reference, i.e. the least key on the page and the deltas of all the keys from it, bit-packed at the bit width of the greatest delta
+**	this only shrinks the encoded (cold) pages, the pages in memory keep the layout of the tuple store
+**	the pages with variable sized tuples (or the pages it can not make sense of) are only stripped off their zero bytes
+*/
+
+// returns the page_codec for the pages of the bplus_tree defined by bpttd_p, bpttd_p becomes its context
+page_codec get_page_codec_for_bplus_tree(const bplus_tree_tuple_defs* bpttd_p);
+
+#endif
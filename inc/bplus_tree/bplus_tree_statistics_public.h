@@ -0,0 +1,66 @@
+#ifndef BPLUS_TREE_STATISTICS_PUBLIC_H
+#define BPLUS_TREE_STATISTICS_PUBLIC_H
+
+#include<stdint.h>
+
+#include<bplus_tree_tuple_definitions_public.h>
+
+#include<opaque_page_access_methods.h>
+
+typedef struct bplus_tree_level_statistics bplus_tree_level_statistics;
+struct bplus_tree_level_statistics
+{
+	// number of pages at this level
+	uint64_t page_count;
+
+	// number of tuples on all the pages at this level (for the leaf level, it is the number of records in the bplus_tree)
+	uint64_t tuple_count;
+
+	// sum of the corresponding spaces (in bytes) on all the pages at this level
+	// fill factor of the level = space_occupied / space_allotted
+	uint64_t space_occupied;
+	uint64_t space_allotted;
+	uint64_t space_fragmented;
+
+	// number of pages at this level that were actually read to compute the above statistics
+	// if pages_read < page_count, then all the above attributes except page_count are extrapolated from the pages_read
+	uint64_t pages_read;
+};
+
+typedef struct bplus_tree_statistics bplus_tree_statistics;
+struct bplus_tree_statistics
+{
+	// number of levels in the bplus_tree, i.e. (level of the root page + 1)
+	uint32_t height;
+
+	// array of height elements, levels[0] is the leaf level and levels[height - 1] is the level of the root page
+	bplus_tree_level_statistics* levels;
+
+	// approximate equi-depth histogram, its boundaries are the separator keys read from the top most interior levels of the bplus_tree
+	// the keys (conforming to bpttd_p->key_def) are in ascending order, and the histogram has (quantile_keys_count + 1) buckets
+	// [MIN, quantile_keys[0]), [quantile_keys[0], quantile_keys[1]), ... , [quantile_keys[quantile_keys_count - 1], MAX]
+	// each bucket has approximately (levels[0].tuple_count / (quantile_keys_count + 1)) records
+	uint32_t quantile_keys_count;
+	void** quantile_keys;
+};
+
+// computes statistics for the bplus_tree, all interior pages are read, (with READ_LOCKs, while holding locks on their parents, like print_bplus_tree)
+// only every leaf_sampling_interval-th leaf page is read, i.e. pass leaf_sampling_interval = 1, to read all the leaf pages, and get exact statistics for the leaf level
+// the statistics are a snapshot only as good as the concurrent modifications permit, so treat them as approximate
+// quantiles_count is the number of buckets you would like to have in the histogram, pass 0 or 1 to not build a histogram
+// returns 1 for success, and 0 on an abort_error (in which case nothing is allocated in bpts_p)
+// on success, you must call deinitialize_bplus_tree_statistics() on bpts_p, once you are done with it
+int get_statistics_bplus_tree(uint64_t root_page_id, uint32_t leaf_sampling_interval, uint32_t quantiles_count, bplus_tree_statistics* bpts_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// returns approximate number of records in the range [key1, key2), using the histogram in bpts_p
+// key1 = NULL and key2 = NULL, refer to -infinity and +infinity respectively
+// a non-empty range that falls inside a single bucket of the histogram, is estimated to have half of the records of that bucket
+uint64_t get_approximate_record_count_in_range_bplus_tree(const bplus_tree_statistics* bpts_p, const void* key1, const void* key2, const bplus_tree_tuple_defs* bpttd_p);
+
+// frees all memory held by the bpts_p
+void deinitialize_bplus_tree_statistics(bplus_tree_statistics* bpts_p);
+
+// print the bplus_tree_statistics
+void print_bplus_tree_statistics(const bplus_tree_statistics* bpts_p, const bplus_tree_tuple_defs* bpttd_p);
+
+#endif
@@ -5,6 +5,8 @@
 #include<inttypes.h>
 
 #include<page_access_specification.h>
+#include<tuple_keys_comparator.h>
+#include<page_codec.h>
 
 typedef struct bplus_tree_tuple_defs bplus_tree_tuple_defs;
 struct bplus_tree_tuple_defs
@@ -21,6 +23,9 @@ struct bplus_tree_tuple_defs
 	// compare direction for the keys, array of ASC/DESC
 	const compare_direction* key_compare_direction;
 
+	// comparator picked for the types of the key elements, use it in place of compare_tuples(), to compare the keys of the records, index entries and key tuples
+	tuple_keys_comparator key_comparator;
+
 	// ith element_def in index_def has the same type, name and size as the key_element_ids[i] th element_def in record_def
 
 	// tuple definition of the leaf pages in the bplus_tree
@@ -40,6 +45,10 @@ struct bplus_tree_tuple_defs
 
 	// precomputed value of max_index_record_size (for the tuple that goes into interior pages of the bplus_tree) that can be inserted into a bplus_tree defined using this bplus_tree_tuple_defs struct
 	uint32_t max_index_record_size;
+
+	// page_codec that knows the layout of the pages of the bplus_tree, it is used to compress its cold pages, see compress_cold_leaf_pages_of_bplus_tree()
+	// its context is this very bplus_tree_tuple_defs struct, so the struct must not be moved or deinitialized, while any page of the bplus_tree remains compressed
+	page_codec codec;
 };
 
 // initializes the attributes in bplus_tree_tuple_defs struct as per the provided parameters
@@ -23,6 +23,14 @@
 // on an abort error, it will return an empty locked pages stack, with no pages kept locked
 locked_pages_stack initialize_locked_pages_stack_for_walk_down(uint64_t root_page_id, int lock_type, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
 
+// capacity of the inline_memory, that the point operations (insert, delete and update) keep on their call stack for their locked_pages_stack
+#define LOCKED_PAGES_STACK_INLINE_CAPACITY 16
+
+// same as initialize_locked_pages_stack_for_walk_down(), but the stack is made in the inline_memory (of inline_capacity locked_page_info s), if the tree is not taller than inline_capacity
+// only a taller tree gets its stack allocated, as before
+// the inline_memory must outlive the stack, so such a stack must never be handed over to a bplus_tree_iterator
+locked_pages_stack initialize_locked_pages_stack_for_walk_down_with_memory(uint64_t root_page_id, int lock_type, locked_page_info* inline_memory, uint32_t inline_capacity, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
 // below are walk down functions
 // you must lock atleast the root page, in the locked_pages_stack_p, before calling these functions
 // no page locks are kept acquired on an abort
@@ -33,6 +41,11 @@ int walk_down_locking_parent_pages_for_split_insert(locked_pages_stack* locked_p
 #define walk_down_locking_parent_pages_for_split_insert_using_key(locked_pages_stack_p, key, bpttd_p, pam_p, transaction_id, abort_error)       walk_down_locking_parent_pages_for_split_insert(locked_pages_stack_p, key, 1, bpttd_p, pam_p, transaction_id, abort_error)
 #define walk_down_locking_parent_pages_for_split_insert_using_record(locked_pages_stack_p, record, bpttd_p, pam_p, transaction_id, abort_error) walk_down_locking_parent_pages_for_split_insert(locked_pages_stack_p, record, 0, bpttd_p, pam_p, transaction_id, abort_error)
 
+// same as walk_down_locking_parent_pages_for_split_insert(), but it also copies the upper fence of the leaf page reached into upper_fence (of atleast bpttd_p->max_index_record_size bytes)
+// the upper fence is the index entry (conforming to bpttd_p->index_def) that follows the path taken at the lowest interior page that has one, all the keys on the leaf page are lesser than it
+// has_upper_fence is set to 0, if the leaf page reached is the last leaf page (or the root), as it has no upper fence
+int walk_down_locking_parent_pages_for_split_insert_with_upper_fence(locked_pages_stack* locked_pages_stack_p, const void* key_OR_record, int is_key, void* upper_fence, int* has_upper_fence, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
 // get count of parent pages for the locked pages stack, that can be unlocked if we are sure of performing a split_insert in the locked leaf
 // it is agnostic of the tuple to be inserted, it does not check leaf page
 uint32_t count_unlockable_parent_pages_for_split_insert(const locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p);
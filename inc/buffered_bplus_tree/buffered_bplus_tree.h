@@ -0,0 +1,79 @@
+#ifndef BUFFERED_BPLUS_TREE_H
+#define BUFFERED_BPLUS_TREE_H
+
+#include<buffered_bplus_tree_tuple_definitions_public.h>
+
+#include<bplus_tree.h>
+
+#include<opaque_page_access_methods.h>
+#include<opaque_page_modification_methods.h>
+
+/*
+	A buffered_bplus_tree is a write optimized bplus_tree, made of a page_table whose first 2 buckets point to the root pages of 2 bplus_trees.
+	The first one holds the records, and the second one (the message buffer) holds the messages, i.e. the puts and the removals of the records not yet applied to the first one.
+
+	A put or a remove only writes a message for its key in the message buffer (replacing the older message for that key, if any), that is small enough to stay cached.
+	Once the height of the message buffer grows beyond max_buffer_height, all of its messages are flushed into the bplus_tree of the records, in the order of their keys.
+	The puts are flushed in batches with upsert_batch_in_bplus_tree, that walks down once per leaf page of the records, instead of once per record.
+	A point lookup looks for the message for its key first, and only if there is none, it looks in the bplus_tree of the records.
+
+	This is the message buffer of the root node of a B-epsilon tree only, the interior pages of the bplus_tree of the records do not carry any buffers.
+	The scans are not merged with the messages, so flush the buffered_bplus_tree, before scanning the bplus_tree of the records with find_in_bplus_tree.
+
+	The root pages of the 2 bplus_trees never move, so read them only once (using get_root_page_ids_for_buffered_bplus_tree) and cache them.
+	A flush holds a WRITE_LOCK on the root page of the page_table, so there is atmost 1 flush at a time, while the puts, removes and lookups continue.
+	The puts and the removes are blind, i.e. they never read the bplus_tree of the records, so they do not tell if there was a record for their key.
+*/
+
+typedef struct buffered_bplus_tree_root_page_ids buffered_bplus_tree_root_page_ids;
+struct buffered_bplus_tree_root_page_ids
+{
+	// root page of the page_table of the buffered_bplus_tree
+	uint64_t root_page_id;
+
+	// root page of the bplus_tree of the records
+	uint64_t records_root_page_id;
+
+	// root page of the bplus_tree of the messages
+	uint64_t message_buffer_root_page_id;
+};
+
+// returns pointer to the root page of the page_table of the newly created buffered_bplus_tree
+uint64_t get_new_buffered_bplus_tree(const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// reads the root page ids of the 2 bplus_trees of the buffered_bplus_tree at root_page_id, into root_page_ids
+// it returns 0, only on an abort_error
+int get_root_page_ids_for_buffered_bplus_tree(uint64_t root_page_id, buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// below functions take the root_page_ids read using get_root_page_ids_for_buffered_bplus_tree
+
+// puts the record (inserting it OR replacing the record with the same key), as a message in the message buffer
+// a record whose message does not fit in the message buffer, is put directly in the bplus_tree of the records
+// it may flush the buffered_bplus_tree, if the message buffer grows beyond max_buffer_height
+// it fails with 0, on an abort_error OR if the record can not be inserted in the bplus_tree of the records
+int put_in_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// removes the record with the given key (conforming to bbpttd_p->bpttd.key_def), as a message in the message buffer
+// it may flush the buffered_bplus_tree, if the message buffer grows beyond max_buffer_height
+// it fails with 0, only on an abort_error
+int remove_from_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// finds the record with the given key (conforming to bbpttd_p->bpttd.key_def), and copies it into record (that must be atleast bbpttd_p->bpttd.max_record_size bytes large)
+// the message for the key is looked for first, and then the bplus_tree of the records, holding a READ_LOCK on atmost 1 leaf page at a time
+// it returns 1 if the record was found, it returns 0, if there is no record for the key (or it was removed) OR on an abort_error
+int find_in_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// flushes all the messages of the message buffer into the bplus_tree of the records, and removes them from the message buffer
+// a message replaced by a put or a remove, while it was being flushed, stays in the message buffer (for the next flush)
+// it returns 1 on success, and 0 on an abort_error
+int flush_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// frees all the pages occupied by the buffered_bplus_tree
+// it may fail on an abort_error, ALSO you must ensure that you are the only one who has lock on the given buffered_bplus_tree
+int destroy_buffered_bplus_tree(uint64_t root_page_id, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// prints all the pages in the buffered_bplus_tree
+// it may return an abort_error, unable to print all of the buffered_bplus_tree pages
+void print_buffered_bplus_tree(uint64_t root_page_id, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef BUFFERED_BPLUS_TREE_TUPLE_DEFINITIONS_PUBLIC_H
+#define BUFFERED_BPLUS_TREE_TUPLE_DEFINITIONS_PUBLIC_H
+
+#include<tuple.h>
+#include<inttypes.h>
+
+#include<bplus_tree_tuple_definitions_public.h>
+#include<page_table_tuple_definitions_public.h>
+
+typedef struct buffered_bplus_tree_tuple_defs buffered_bplus_tree_tuple_defs;
+struct buffered_bplus_tree_tuple_defs
+{
+	// the message buffer is flushed into the bplus_tree, as soon as its height grows beyond max_buffer_height
+	// i.e. with max_buffer_height = 1, the message buffer is flushed as soon as it outgrows a single (root) leaf page
+	uint32_t max_buffer_height;
+
+	// tuple_definition for the bplus_tree holding the records
+	bplus_tree_tuple_defs bpttd;
+
+	// a message is the key elements of its record (at positions 0 to key_element_count - 1), followed by a blob holding the whole record
+	// a message with an empty blob is a removal message for its key
+	tuple_def* message_def;
+
+	// STATIC_POSITION(0) to STATIC_POSITION(key_element_count - 1), i.e. the key_element_ids of the messages
+	positional_accessor* message_key_element_ids;
+
+	// tuple_definition for the bplus_tree holding the messages (the message buffer), it is ordered on the same keys as the bplus_tree
+	bplus_tree_tuple_defs message_bpttd;
+
+	// tuple_definition for the array of the root page ids of the bplus_tree and the message buffer
+	page_table_tuple_defs pttd;
+};
+
+// initializes the attributes in buffered_bplus_tree_tuple_defs struct as per the provided parameters
+// the parameter pas_p must point to the pas attribute of the data_access_method that you are using it with
+// it relies on bpttd, message_bpttd and pttd for most of its functionality
+// returns 1 for success, it fails with 0, if max_buffer_height == 0
+// it also fails if init_bplus_tree_tuple_definitions (for the records or for the messages) or init_page_table_tuple_definitions fails
+int init_buffered_bplus_tree_tuple_definitions(buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, const compare_direction* key_compare_direction, uint32_t key_element_count, uint32_t max_buffer_height);
+
+// builds the message for the record into message, OR a removal message for the key (conforming to bpttd.key_def), if record == NULL
+// message must be atleast message_bpttd.max_record_size bytes large
+// it returns 0, if the message does not fit in the message buffer
+int build_message_using_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p, const void* key, const void* record, void* message);
+
+// returns pointer to the record carried by the message, it returns NULL for a removal message
+// the returned record is valid only as long as the message is
+const void* get_record_from_message_using_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p, const void* message);
+
+// it deallocates bpttd, message_bpttd, pttd, message_def and message_key_element_ids
+// then resets all the buffered_bplus_tree_tuple_defs struct attributes to NULL or 0
+void deinit_buffered_bplus_tree_tuple_definitions(buffered_bplus_tree_tuple_defs* bbpttd_p);
+
+// print buffered_bplus_tree_tuple_definitions
+void print_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p);
+
+#endif
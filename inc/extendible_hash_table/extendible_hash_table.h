@@ -0,0 +1,48 @@
+#ifndef EXTENDIBLE_HASH_TABLE_H
+#define EXTENDIBLE_HASH_TABLE_H
+
+#include<extendible_hash_table_tuple_definitions_public.h>
+
+#include<opaque_page_access_methods.h>
+#include<opaque_page_modification_methods.h>
+
+/*
+	extendible_hash_table is a hash index for fixed sized records, with unique keys
+	it is made of a directory (a page_table) of 2 ^ global_depth entries, each pointing to a bucket, and page_table[2 ^ global_depth] = root_page_id
+	each bucket is an array_table with a single leaf page of ehttd_p->attd.leaf_entries_per_page slots, that are open addressed (with linear probing) by the key's hash_value
+	a bucket with local_depth = d, is pointed to by all the 2 ^ (global_depth - d) directory entries that share the least significant d bits of the hash_value
+	so a point lookup reads only the directory entry and the bucket page, and never walks a chain of overflow pages
+	a full bucket is split in two (doubling the directory, only if its local_depth == global_depth), the buckets are never merged
+	the local_depth is capped at 20 (and so is the global_depth), so a skewed hash can not grow the directory beyond 2^20 entries
+	and its bits stay clear of the most significant 32 bits of the hash_value, that pick the slot to start probing the bucket from
+	a split write locks the whole directory (and not just the directory entries of the bucket being split), so the splits are serialized with each other and with all the lookups
+*/
+
+// returns pointer to the root page of the newly created extendible_hash_table, with a single bucket
+uint64_t get_new_extendible_hash_table(const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// finds the record with the given key, and copies it into the record (if record != NULL), it must be atleast get_minimum_tuple_size(ehttd_p->attd.record_def) bytes large
+// the directory is read locked only until the bucket is locked, the bucket is then read locked and searched
+// it returns 1 if the record was found, else it returns 0, it also returns 0 on an abort_error
+int find_in_extendible_hash_table(uint64_t root_page_id, const void* key, void* record, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// insert record in extendible_hash_table
+// the directory is read locked only until the bucket is write locked, and if the bucket is full it is retried with the directory write locked to split the bucket
+// insert may fail on an abort_error OR if a record with the same key already exists in the extendible_hash_table
+// OR if the bucket is full of records with the same hash_value as the record OR if the bucket needs a split beyond the maximum local_depth of 20
+int insert_in_extendible_hash_table(uint64_t root_page_id, const void* record, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// delete a record given by key
+// the records following it (on its probe sequence) are shifted back into its slot, so no tombstones are left in the bucket
+// delete may fail on an abort_error OR if a record with the given key, does not exist in the extendible_hash_table
+int delete_from_extendible_hash_table(uint64_t root_page_id, const void* key, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// frees all the pages occupied by the extendible_hash_table
+// it may fail on an abort_error, ALSO you must ensure that you are the only one who has lock on the given extendible_hash_table
+int destroy_extendible_hash_table(uint64_t root_page_id, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// prints the directory and all the buckets of the extendible_hash_table
+// it may return an abort_error, unable to print all of the extendible_hash_table pages
+void print_extendible_hash_table(uint64_t root_page_id, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+#endif
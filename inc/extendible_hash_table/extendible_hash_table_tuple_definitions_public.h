@@ -0,0 +1,60 @@
+#ifndef EXTENDIBLE_HASH_TABLE_TUPLE_DEFINITIONS_PUBLIC_H
+#define EXTENDIBLE_HASH_TABLE_TUPLE_DEFINITIONS_PUBLIC_H
+
+#include<tuple.h>
+#include<inttypes.h>
+
+#include<array_table_tuple_definitions_public.h>
+#include<page_table_tuple_definitions_public.h>
+
+typedef struct extendible_hash_table_tuple_defs extendible_hash_table_tuple_defs;
+struct extendible_hash_table_tuple_defs
+{
+	// number of elements considered as keys
+	uint32_t key_element_count;
+
+	// element ids of the keys (as per their element_ids in attd.record_def)
+	const positional_accessor* key_element_ids;
+
+	// tuple definition of the key to be used with this extendible_hash_table
+	// for all of find, insert and delete functionalities
+	// shallow tuple_def with containees from the record_def
+	tuple_def* key_def;
+
+	// initial value of the hasher to hash tuples
+	tuple_hasher hasher;
+
+	// tuple_definition for the buckets of the extendible_hash_table
+	// each bucket is an array_table of a single leaf page, with attd.leaf_entries_per_page slots
+	array_table_tuple_defs attd;
+
+	// tuple_definition for the directory of the extendible_hash_table
+	page_table_tuple_defs pttd;
+};
+
+// initializes the attributes in extendible_hash_table_tuple_defs struct as per the provided parameters
+// the parameter pas_p must point to the pas attribute of the data_access_method that you are using it with
+// it allocates memory only for key_element_ids and key_def
+// it relies on attd and pttd for most of its fnctionality
+// returns 1 for success, it fails with 0, if the record_def has element_count 0 OR key_element_count == 0 OR key_element_ids == NULL OR if any of the key_element_ids is out of bounds
+// it also fails if the record_def is not fixed sized, OR if the pas_p does not pass is_valid_page_access_specs(pas_p)
+int init_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, uint32_t key_element_count, const tuple_hasher* hasher);
+
+// checks to see if a record_tuple can be inserted into a extendible_hash_table
+// note :: you can not insert a NULL record in extendible_hash_table
+int check_if_record_can_be_inserted_for_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* record_tuple);
+
+// get hash value for key, using the extendible_hash_table tuple defs
+uint64_t get_hash_value_for_key_using_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* key);
+
+// get hash value for record, using the extendible_hash_table tuple defs
+uint64_t get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* record_tuple);
+
+// it deallocates the key_def, attd and pttd
+// then resets all the extendible_hash_table_tuple_defs struct attributes to NULL or 0
+void deinit_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p);
+
+// print extendible_hash_table_tuple_definitions
+void print_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p);
+
+#endif
@@ -2,6 +2,7 @@
 #define HASH_TABLE_H
 
 #include<hash_table_tuple_definitions_public.h>
+#include<hash_table_statistics_public.h>
 
 #include<opaque_page_access_methods.h>
 #include<opaque_page_modification_methods.h>
@@ -28,13 +29,39 @@ uint64_t get_new_hash_table(uint64_t initial_bucket_count, const hash_table_tupl
 uint64_t get_bucket_count_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
 
 // increments the bucket_count of the hash_table by 1
+// the page_table is write locked only until both the new buckets are linked into it, the tuples are then moved while holding locks only on the linked_page_lists of the bucket being split and the 2 new buckets
+// so lookups on all the other buckets proceed concurrently with the split
+// a new bucket that does not get any tuple is vaccummed (set back to NULL_PAGE_ID) at the end of the split, under a fresh write lock on the page_table
 // it fails on an abort error OR if the bucket_count == UINT64_MAX
 int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// increments the bucket_count of the hash_table by new_buckets_count (or lesser, so that it does not exceed UINT64_MAX), in rounds that each multiply the bucket_count by atmost 16
+// in a round, every tuple of the buckets that get split is moved only once, directly to its bucket at the end of the round, and atmost 32 new buckets are write locked at once
+// it is a sequential bulk expand, all the splits are done one after the another by the calling thread, in the given transaction, there are no worker threads to spread them over
+// unlike expand_hash_table, the page_table stays write locked (over its whole range) until all the splits are done, so use it for a bulk rehash (for instance after a load spike), and not while the hash_table is serving lookups
+// what it saves over calling expand_hash_table new_buckets_count times, is the rescans, each tuple moves only once per round
+// it returns the number of buckets added, it returns 0 on an abort error OR if the bucket_count == UINT64_MAX OR if new_buckets_count == 0
+uint64_t expand_hash_table_by(uint64_t root_page_id, uint64_t new_buckets_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 // decrements the bucket_count of the hash_table by 1
 // it fails on an abort error OR if the bucket_count == UINT64_MAX
 int shrink_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// keeps the load of the hash_table near target_tuples_per_bucket, by performing atmost budget calls to expand_hash_table OR shrink_hash_table
+// the load is estimated by counting the tuples in atmost sample_buckets_count buckets (spread evenly across the hash_table), while holding a read lock on the whole page_table
+// it then expands the hash_table until the estimated load is atmost target_tuples_per_bucket, and shrinks it only when the estimated load falls below a quarter of target_tuples_per_bucket (so that it does not thrash between splits and merges)
+// call it periodically (or after a batch of inserts/removes) with a small budget, to keep the probes at O(1) pages without doing all the splits at once
+// it returns the number of buckets by which the hash_table was expanded OR shrunk, it returns 0 on an abort_error OR if target_tuples_per_bucket == 0 OR sample_buckets_count == 0
+uint64_t maintain_hash_table(uint64_t root_page_id, uint64_t target_tuples_per_bucket, uint64_t sample_buckets_count, uint64_t budget, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// compacts the buckets of the hash_table, in the order of their bucket_ids, starting at from_bucket_id
+// an empty bucket is vaccummed (just like with perform_vaccum_hash_table), else its pages are walked with a writable iterator, that merges every page with its next page if their tuples fit in one page
+// the page_table is write locked only until the bucket is locked, and throughout the vaccum of an empty bucket, so lookups on all the other buckets proceed concurrently
+// a bucket is always compacted completely, so atleast one bucket is compacted, even if it has more pages than the pages_budget (a pages_budget of 0 is taken as 1)
+// it visits (roughly) pages_budget pages and returns 1, if there are more buckets to be compacted, in that case the bucket_id to resume from is set in resume_bucket_id
+// it returns 0, once the last bucket has been compacted OR on an abort_error
+int compact_hash_table(uint64_t root_page_id, uint64_t from_bucket_id, uint64_t pages_budget, uint64_t* resume_bucket_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 // frees all the pages occupied by the hash_table
 // it may fail on an abort_error, ALSO you must ensure that you are the only one who has lock on the given hash_table
 int destroy_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
@@ -43,8 +70,17 @@ int destroy_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_
 // it may return an abort_error, unable to print all of the hash_table pages
 void print_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
 
+// probes the hash_table for all the keys (keys_count of them) in a single pass, calling record_found(context, key_index, record) for every record that matches keys[key_index]
+// the keys are hashed and grouped by their buckets first, then every bucket is scanned only once, matching each of its records against all the keys that hash to it
+// the records of a bucket are reported in the order they are stored, and not in the order of the keys, record is valid only until record_found returns
+// this is done with a read lock on the whole page_table (and a read lock on one bucket at a time), so the hash_table can not be expanded or shrunk while the probes are in progress
+// it returns the number of records found, it returns 0 on an abort_error (the record_found may have been called for some of the records until then)
+uint64_t multi_probe_hash_table(uint64_t root_page_id, const void* const* keys, uint32_t keys_count, void* context, void (*record_found)(void* context, uint32_t key_index, const void* record), const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
 #include<hash_table_iterator_public.h>
 
+#include<hash_table_handle_public.h>
+
 #include<hash_table_vaccum_params.h>
 
 // performs hash_table vaccum
@@ -0,0 +1,43 @@
+#ifndef HASH_TABLE_HANDLE_H
+#define HASH_TABLE_HANDLE_H
+
+#include<hash_table_iterator.h>
+
+#include<hash_table_tuple_definitions.h>
+#include<opaque_page_access_methods.h>
+#include<opaque_page_modification_methods.h>
+
+typedef struct hash_table_cached_head hash_table_cached_head;
+struct hash_table_cached_head
+{
+	uint64_t bucket_id;
+
+	// NULL_PAGE_ID for an unused entry, the buckets with NULL heads are never cached
+	uint64_t bucket_head_page_id;
+};
+
+typedef struct hash_table_handle hash_table_handle;
+struct hash_table_handle
+{
+	uint64_t root_page_id;
+
+	// epoch of the root page, when the cache was last validated
+	uint64_t epoch;
+
+	// bucket_count of the hash_table at the epoch, valid only if is_bucket_count_cached is set
+	int is_bucket_count_cached;
+	uint64_t bucket_count;
+
+	// bucket_id -> head_page_id cache, the entry for a bucket_id is at (bucket_id % cached_heads_count), it is cleared on every change of the epoch
+	uint32_t cached_heads_count;
+	hash_table_cached_head* cached_heads;
+
+	const hash_table_tuple_defs* httd_p;
+
+	const page_access_methods* pam_p;
+};
+
+// all functions on hash_table_handle are declared here, in this header file
+#include<hash_table_handle_public.h>
+
+#endif
\ No newline at end of file
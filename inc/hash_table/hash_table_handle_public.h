@@ -0,0 +1,35 @@
+#ifndef HASH_TABLE_HANDLE_PUBLIC_H
+#define HASH_TABLE_HANDLE_PUBLIC_H
+
+/*
+	A hash_table_handle is a long lived, per thread cache of the bucket_count of a hash_table and of the head_page_ids of (atmost cached_heads_count of) its buckets.
+	It lets the keyed probes skip the walk down the page_table, from its root to its leaf page, for the bucket_count and then for the head_page_id of the bucket.
+
+	The cache is validated by the epoch stored in the root page of the page_table of the hash_table.
+	The epoch is incremented (under a write lock on the root) on every change of the bucket_count (expand/shrink), before a bucket_head_page_id is freed (vaccum, compact) and on every writable iterator opened without a key.
+	So a probe through a hash_table_handle still takes a read lock on the root, reads the epoch, and only if it matches the one the cache was filled at, the cached values are used.
+	The head page of the bucket is locked before the lock on the root is released, just as a probe without the handle would lock it before releasing its lock on the page_table.
+
+	A hash_table_handle is not thread safe, and it does not hold any locks between the calls.
+	The epoch is a part of the root page, so it is rolled back with the transaction that incremented it, delete the hash_table_handles of the hash_table after an abort of a transaction that modified it.
+*/
+
+typedef struct hash_table_handle hash_table_handle;
+
+// creates a new hash_table_handle for the hash_table at root_page_id, caching atmost cached_heads_count head_page_ids of its buckets
+// httd_p and pam_p must outlive the hash_table_handle, it does not access the hash_table, until it is used
+// returns NULL if cached_heads_count == 0, OR if httd_p or pam_p is NULL
+hash_table_handle* get_new_hash_table_handle(uint64_t root_page_id, uint32_t cached_heads_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p);
+
+// returns the bucket_count of the hash_table, just like get_bucket_count_hash_table, but from the cache if the epoch has not changed
+uint64_t get_bucket_count_using_hash_table_handle(hash_table_handle* hth_p, const void* transaction_id, int* abort_error);
+
+// creates a new hash_table_iterator for the key, just like get_new_hash_table_iterator, using the cached bucket_count and the cached head_page_id of the bucket if the epoch has not changed
+// a writable iterator over an empty (NULL) bucket needs a write lock on the page_table to insert into it, so that is opened without the cache
+// returns NULL if the key is NULL OR on an abort_error
+hash_table_iterator* get_new_hash_table_iterator_using_hash_table_handle(hash_table_handle* hth_p, const void* key, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// frees the hash_table_handle
+void delete_hash_table_handle(hash_table_handle* hth_p);
+
+#endif
\ No newline at end of file
@@ -17,6 +17,7 @@ struct hash_table_iterator
 	// the key you should be looking for
 	const void* key;
 	materialized_key mat_key; // this is the materialized version of the key (in the previous line), it is valid only if key is provided, else it must be initialized to empty struct
+	uint64_t key_hash_value; // hash_value of the key, valid only if key is provided, it is compared against the hash element of the tuples (if the httd_p has one) before comparing their keys
 
 	// range for locking the ptrl_p, only used when key == NULL
 	bucket_range lock_range;
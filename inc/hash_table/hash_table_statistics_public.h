@@ -0,0 +1,56 @@
+#ifndef HASH_TABLE_STATISTICS_PUBLIC_H
+#define HASH_TABLE_STATISTICS_PUBLIC_H
+
+#include<stdint.h>
+
+#include<hash_table_tuple_definitions_public.h>
+
+#include<opaque_page_access_methods.h>
+
+// number of elements in the chain_length_histogram, the last one counts all the longer chains
+#define HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE 16
+
+typedef struct hash_table_statistics hash_table_statistics;
+struct hash_table_statistics
+{
+	// bucket_count of the hash_table
+	uint64_t bucket_count;
+
+	// number of buckets that were actually read to compute the below statistics
+	uint64_t buckets_read;
+
+	// number of records and pages in all the buckets
+	// sum of the corresponding spaces (in bytes) on all the pages of all the buckets
+	// average fill factor of the bucket pages = space_occupied / space_allotted
+	// if buckets_read < bucket_count, then these attributes are extrapolated from the buckets_read
+	uint64_t tuple_count;
+	uint64_t page_count;
+	uint64_t space_occupied;
+	uint64_t space_allotted;
+
+	// below attributes are only for the buckets_read, and are never extrapolated
+
+	// number of buckets, that are NULL_PAGE_ID in the page_table, i.e. they have no pages
+	uint64_t null_bucket_count;
+
+	// number of buckets, that have a page but no records, a perform_vaccum_hash_table() (OR compact_hash_table()) is due for them
+	uint64_t empty_bucket_count;
+
+	// length (in pages) of the longest chain
+	uint64_t max_chain_length;
+
+	// chain_length_histogram[i] = number of buckets with a chain of i pages (chain_length_histogram[0] = null_bucket_count)
+	// chain_length_histogram[HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE - 1] counts all the chains of atleast (HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE - 1) pages
+	uint64_t chain_length_histogram[HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE];
+};
+
+// computes statistics for the hash_table, all pages of every bucket_sampling_interval-th bucket are read (with a read lock on the whole page_table and one bucket at a time)
+// i.e. pass bucket_sampling_interval = 1, to read all the buckets, and get exact statistics
+// the page_table is read locked throughout, so the hash_table can not be expanded or shrunk while the statistics are being computed
+// returns 1 for success, and 0 on an abort_error
+int get_statistics_hash_table(uint64_t root_page_id, uint64_t bucket_sampling_interval, hash_table_statistics* htts_p, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// print the hash_table_statistics
+void print_hash_table_statistics(const hash_table_statistics* htts_p);
+
+#endif
@@ -13,4 +13,22 @@ int64_t get_floor_log_base_2(uint64_t x);
 // this function also returns the floor(log(bucket_count) bas 2), in the floor_log_2 variable
 uint64_t get_hash_table_split_index(uint64_t bucket_count, int64_t* floor_log_2);
 
+// returns 1, if the element_id is the same as OR is contained in (or contains) any of the key elements
+int is_key_element_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, positional_accessor element_id);
+
+// returns 1, if the httd_p has a hash element AND the element_id is the same as OR is contained in (or contains) it
+int is_hash_element_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, positional_accessor element_id);
+
+// same as check_if_record_can_be_inserted_for_hash_table_tuple_definitions(), for a record_tuple whose key is already known to be equal to a key with the hash_value key_hash_value
+// so the hash element (if any) is checked against the key_hash_value, without hashing the record_tuple again
+int check_if_record_can_be_inserted_with_hash_value_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t key_hash_value);
+
+// returns 1, if the httd_p does not have a hash element OR if the hash_value stored in the record_tuple is equal to hash_value
+// this is a cheap pre-filter for the records, before their keys are compared
+int may_match_hash_value_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t hash_value);
+
+// returns the fingerprint of the hash_value, that the pages of the buckets keep in their tuples_filter, for the records with this hash_value
+// the bucket_index is picked by the lower bits of the hash_value, so the fingerprint is made of its higher bits, to tell apart the records of the same bucket
+uint64_t get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(uint64_t hash_value);
+
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include<linked_page_list_tuple_definitions_public.h>
 #include<page_table_tuple_definitions_public.h>
+#include<tuple_keys_comparator.h>
 
 typedef struct hash_table_tuple_defs hash_table_tuple_defs;
 struct hash_table_tuple_defs
@@ -16,6 +17,9 @@ struct hash_table_tuple_defs
 	// element ids of the keys (as per their element_ids in lpltd.record_def)
 	const positional_accessor* key_element_ids;
 
+	// comparator picked for the types of the key elements, use it in place of compare_tuples(), to compare the keys of the records and key tuples
+	tuple_keys_comparator key_comparator;
+
 	// tuple definition of the key to be used with this bplus_tree
 	// for all of find, insert, update and delete functionalities
 	// shallow tuple_def with containees from the record_def
@@ -24,7 +28,14 @@ struct hash_table_tuple_defs
 	// initial value of the hasher to hash tuples
 	tuple_hasher hasher;
 
+	// optional element of the record, that stores the hash_value of its key, it is unused if has_hash_element == 0
+	// when set, the splits route the records using the stored hash_value instead of rehashing their keys
+	// and the keyed iterators compare it against the hash_value of their key, before comparing the keys
+	int has_hash_element;
+	positional_accessor hash_element_id;
+
 	// tuple_definiton for the buckets of the hash_table
+	// every bucket page keeps a filter of the fingerprints of the hash_values of its records, so a keyed iterator skips the pages of the bucket, that can not have its key
 	linked_page_list_tuple_defs lpltd;
 
 	// tuple_definition for the bucket-pointers of the hash_table
@@ -36,9 +47,21 @@ struct hash_table_tuple_defs
 // it allocates memory only for key_element_ids and key_def
 // it relies on lpltd and pttd for most of its fnctionality
 // returns 1 for success, it fails with 0, if the record_def has element_count 0 OR key_element_count == 0 OR key_element_ids == NULL OR if any of the key_element_ids is out of bounds
-// it also fails if the pas_p does not pass is_valid_page_access_specs(pas_p)
+// it also fails if the pas_p does not pass is_valid_page_access_specs(pas_p) OR if the records do not fit on a bucket page
+// the lpltd's fingerprint function refers back to the httd_p, so the httd_p must not be moved (copied) once initialized
 int init_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, uint32_t key_element_count, const tuple_hasher* hasher);
 
+// makes the hash_table store the hash_value of the key of every record in its element at hash_element_id, this must be done before the hash_table is created
+// the element must be a non-key UINT element of 8 bytes, and the records must have it set with set_hash_value_in_record_using_hash_table_tuple_definitions(), before they are inserted
+// hash_element_id is stored as is (just like the key_element_ids), so its positions must outlive the httd_p
+// the element may be NULLable, but a record with a NULL in it has no stored hash_value, so it is never matched and can not be inserted
+// it returns 0 (leaving httd_p unchanged), if the element at hash_element_id is not accessible OR is not a UINT of 8 bytes OR is a key element
+int set_hash_element_for_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, positional_accessor hash_element_id);
+
+// computes the hash_value of the key of the record_tuple, and stores it in the hash element of the record_tuple
+// it returns 0, if the httd_p does not have a hash element
+int set_hash_value_in_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, void* record_tuple);
+
 // checks to see if a record_tuple can be inserted into a hash_table
 // note :: you can not insert a NULL record in hash_table
 int check_if_record_can_be_inserted_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple);
@@ -50,14 +73,32 @@ int extract_key_from_record_tuple_using_hash_table_tuple_definitions(const hash_
 uint64_t get_hash_value_for_key_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* key);
 
 // get hash value for record, using the hash_table tuple defs
+// if the httd_p has a hash element, then the hash_value stored in the record_tuple is returned
 uint64_t get_hash_value_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple);
 
+// get bucket_index for a hash_value (of a key or a record), at the given bucket_count
+// use it when the hash_value is already known, so that the key is not hashed again
+uint64_t get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(uint64_t hash_value, uint64_t bucket_count);
+
 // get bucket_index for key, using the hash_table tuple defs
 uint64_t get_bucket_index_for_key_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* key, uint64_t bucket_count);
 
 // get bucket_index for record, using the hash_table tuple defs
 uint64_t get_bucket_index_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t bucket_count);
 
+// batch versions of the above functions, for when many keys (or records) need to be hashed or bucketed at once
+// hash_values (and bucket_indices) must be arrays of atleast keys_count (or records_count or hash_values_count) elements
+// the hash_values are the same as the ones returned by get_hash_value_for_key/record_using_hash_table_tuple_definitions()
+// these two are only convenience wrappers, they call the configured hasher (through hash_tuple()) once for every key, there is no vectorized hash kernel behind them
+// they only save the per call copying of the hasher and the per record check for the hash element
+void get_hash_values_for_keys_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* const* keys, uint32_t keys_count, uint64_t* hash_values);
+void get_hash_values_for_records_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* const* record_tuples, uint32_t records_count, uint64_t* hash_values);
+
+// the bucket_indices are the same as the ones returned by get_bucket_index_for_key/record_using_hash_table_tuple_definitions(), for the given bucket_count
+// it can be called in place, i.e. with bucket_indices == hash_values
+// unlike the two above, its loop is free of branches and function calls, so the compiler may vectorize it
+void get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions(const uint64_t* hash_values, uint32_t hash_values_count, uint64_t bucket_count, uint64_t* bucket_indices);
+
 // it deallocates the key_element_ids, key_def, lpltd and pttd
 // then resets all the hash_table_tuple_defs struct attributes to NULL or 0
 void deinit_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p);
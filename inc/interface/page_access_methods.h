@@ -4,6 +4,7 @@
 #include<stdint.h>
 
 #include<page_access_specification.h>
+#include<page_codec.h>
 
 /*
 **	This structure defines functions that provide page level access methods to the storage model to access the database in pages of fixed size
@@ -99,6 +100,26 @@ struct page_access_methods
 
 	// context to be passed on every page access
 	void* context;
+
+	// the attributes below are optional methods, they are placed after all the mandatory ones, so that the layout of the above attributes remains the same for the older implementations
+	// set each of them to NULL, if you do not implement it, TupleIndexer then falls back to using the mandatory methods above
+	// an implementation that predates them must zero initialize this struct (with calloc() or a "= {}" initializer), so that they read as NULL
+
+	// non-blocking variants of the acquire_page_with_*_lock functions, they must never wait for a lock held by some other thread
+	// if the lock can not be acquired immediately, they must return NULL without setting the abort_error, any other failure must set the abort_error
+	void* (*try_acquire_page_with_reader_lock)(void* context, const void* transaction_id, uint64_t page_id, int* abort_error);
+	void* (*try_acquire_page_with_writer_lock)(void* context, const void* transaction_id, uint64_t page_id, int* abort_error);
+
+	// same as get_new_page_with_write_lock, but the page_id_returned must be greater than the after_page_id
+	// if there is no such page that can be handed out, it must return NULL without setting the abort_error, any other failure must set the abort_error
+	// it is used to lay out the leaf pages of a bplus_tree in the ascending order of their page_ids, while defragmenting it
+	void* (*get_new_page_with_write_lock_after)(void* context, const void* transaction_id, uint64_t after_page_id, uint64_t* page_id_returned, int* abort_error);
+
+	// compresses the page at page_id with the codec, only if it is not locked (nor waited on) by anyone, and it was not modified in the last cold_after_modifications_count page modifications (of any page)
+	// it returns 1 if the page was compressed, else it returns 0 without setting the abort_error (the page was locked, hot, free, already compressed or it did not compress well enough)
+	// the page is decoded with the same codec when it is locked again, so the codec (and its context) must stay valid until then, or until the page is freed
+	// you may call this function, even if you don't have lock on the page (just like free_page), but not while you hold a lock on it
+	int (*compress_page)(void* context, const void* transaction_id, uint64_t page_id, uint64_t cold_after_modifications_count, const page_codec* codec, int* abort_error);
 };
 
 // Lock transitions allowed for any page in the data store
@@ -112,7 +133,10 @@ struct page_access_methods
 **
 **	  N -> R 		by calling acquire_page_with_reader_lock
 **	  R -> N 		by calling release_reader_lock_on_page
+**	  N -> R 		by calling try_acquire_page_with_reader_lock (only if it returns a non NULL page)
 **	  N -> W 		by calling acquire_page_with_writer_lock
+**	  N -> W 		by calling get_new_page_with_write_lock OR get_new_page_with_write_lock_after (only if it returns a non NULL page)
+**	  N -> W 		by calling try_acquire_page_with_writer_lock (only if it returns a non NULL page)
 **	  W -> N 		by calling release_writer_lock_on_page
 **	  W -> R 		by calling downgrade_writer_lock_to_reader_lock_on_page
 **	  R -> W 		by calling upgrade_reader_lock_to_writer_lock_on_page
@@ -0,0 +1,31 @@
+#ifndef PAGE_CODEC_H
+#define PAGE_CODEC_H
+
+#include<stdint.h>
+
+/*
+**	a page_codec encodes a page into a (hopefully) smaller form, that the page_access_methods may keep in place of a cold page
+**	and decodes it back, byte for byte, when the page is locked again, so the users of the page_access_methods never see an encoded page
+**
+**	a data structure may provide a page_codec that knows the layout of its pages (through its tuple definitions), and encodes them better than a generic codec could
+**	the encode_page function must only return an encoded page, that the decode_page function turns back into the exact same page_size bytes
+*/
+
+typedef struct page_codec page_codec;
+struct page_codec
+{
+	// context to be passed on every call to the functions below
+	const void* context;
+
+	// encodes the page (of page_size bytes) into the encoded buffer (of max_encoded_size bytes)
+	// it returns the number of bytes of the encoded buffer used, OR 0 if the page could not be encoded in max_encoded_size bytes
+	uint32_t (*encode_page)(const void* context, const void* page, uint32_t page_size, void* encoded, uint32_t max_encoded_size);
+
+	// decodes the encoded page (as returned by the encode_page function) into the page (of page_size bytes)
+	void (*decode_page)(const void* context, void* page, uint32_t page_size, const void* encoded);
+};
+
+// a page_codec for any page, it only encodes the runs of zero bytes (mostly the unused space of the page) as their lengths
+extern const page_codec zero_run_page_codec;
+
+#endif
@@ -13,6 +13,17 @@
 
 page_access_methods* get_new_unWALed_in_memory_data_store(const page_access_specs* pas_suggested);
 
+// compresses (in memory) all the unlocked pages, that were not modified in the last cold_after_modifications_count page modifications (of any page) in this data store
+// the pages mostly left unused (like the leaf pages of a bplus_tree holding cold data) compress well, while the pages that do not compress to atmost 3/4th of the page_size are left as is
+// a compressed page is decompressed in place when it gets locked again, so the users of the page_access_methods never see the compressed page
+// the pages are encoded with the zero_run_page_codec, a data structure that knows the layout of its pages, may compress them with its own page_codec through the compress_page of the page_access_methods
+// it returns the number of pages compressed by this call
+uint64_t compress_cold_pages_in_unWALed_in_memory_data_store(page_access_methods* pam_p, uint64_t cold_after_modifications_count);
+
+// returns the number of pages allocated and not yet freed in this data store
+// tests may use it to check that a data structure frees all its pages, once destroyed
+uint64_t get_used_pages_count_in_unWALed_in_memory_data_store(page_access_methods* pam_p);
+
 int close_and_destroy_unWALed_in_memory_data_store(page_access_methods* pam_p);
 
 #endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef LINKED_PAGE_LIST_ITERATOR_PUBLIC_H
 #define LINKED_PAGE_LIST_ITERATOR_PUBLIC_H
 
+#include<user_value.h>
+#include<tuple.h>
+
 typedef struct linked_page_list_iterator linked_page_list_iterator;
 
 typedef enum linked_page_list_state linked_page_list_state;
@@ -52,6 +55,21 @@ int can_insert_without_split_at_linked_page_list_iterator(const linked_page_list
 // get tuple at curr_tuple_index of the curr_page for the linked_page_list iterator
 const void* get_tuple_linked_page_list_iterator(const linked_page_list_iterator* lpli_p);
 
+// reads the elements at element_ids (element_count of them) of upto max_tuples tuples, starting at the current tuple and only from the curr_page, into the column major arrays columns
+// i.e. columns[j][i] is set to the value of the element_ids[j] element of the ith tuple read, each of the columns[j] must be an array of atleast max_tuples user_values
+// the cursor is left at the last tuple read, the values pointing into the page are valid only until the iterator is moved or modified
+// like get_projected_batch_bplus_tree_iterator, it is a convenience copy only, the pages keep their row major layout
+// it returns the number of tuples read, it returns 0 if the curr_page is empty
+uint32_t get_projected_batch_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const positional_accessor* element_ids, uint32_t element_count, user_value** columns, uint32_t max_tuples);
+
+// returns the space (in bytes) occupied by all the tuples on the curr_page, and sets (*space_allotted) to the space allotted to all the tuples on the curr_page
+// their ratio is the fill factor of the curr_page
+uint32_t get_space_occupied_on_curr_page_linked_page_list_iterator(const linked_page_list_iterator* lpli_p, uint32_t* space_allotted);
+
+// returns the number of tuples on the curr_page, that are at or after the curr_tuple_index (i.e. all the tuples of the curr_page, if the cursor is at its first tuple)
+// it returns 0 if the curr_page is empty
+uint32_t get_tuple_count_from_curr_tuple_in_curr_page_linked_page_list_iterator(const linked_page_list_iterator* lpli_p);
+
 void delete_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error);
 
 typedef enum linked_page_list_relative_insert_pos linked_page_list_relative_insert_pos;
@@ -75,6 +93,19 @@ int next_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void
 // on an abort error, lock on the curr_page is also released, then you only need to call delete_linked_page_list_iterator
 int prev_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error);
 
+// go to the first tuple of the next page, skipping the rest of the tuples of the curr_page
+// for a writable iterator, the curr_page may get merged with the next page instead (just as in next_linked_page_list_iterator), the cursor then points to the first tuple that was on the next page
+// returns 1 for success, it returns 0, if the curr_page is the tail page OR if there are no tuples in the linked_page_list
+// on an abort error, lock on the curr_page is also released, then you only need to call delete_linked_page_list_iterator
+int next_page_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error);
+
+// moves forward, page by page (using next_page_linked_page_list_iterator), until the curr_page may have a tuple with the given fingerprint, as per the tuples_filter of the page
+// the cursor is not moved, if the curr_page itself may have such a tuple, else it is left at the first tuple of the page that may have it
+// it returns 0, if no page until the tail page may have such a tuple, the cursor is then left at the tail tuple (or as is, if there are no tuples in the linked_page_list)
+// it always returns 1, without moving, if the lpltd_p does not have a get_tuple_fingerprint
+// on an abort error, lock on the curr_page is also released, then you only need to call delete_linked_page_list_iterator
+int skip_pages_without_fingerprint_linked_page_list_iterator(linked_page_list_iterator* lpli_p, uint64_t fingerprint, const void* transaction_id, int* abort_error);
+
 typedef enum linked_page_list_go_after_operation linked_page_list_go_after_operation;
 enum linked_page_list_go_after_operation
 {
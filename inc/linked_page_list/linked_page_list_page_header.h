@@ -22,8 +22,14 @@ struct linked_page_list_page_header
 
 	// page_id of previous page of this page
 	uint64_t prev_page_id;
+
+	// filter of the fingerprints of the tuples on this page, it is present only if the lpltd_p has a get_tuple_fingerprint
+	uint64_t tuples_filter;
 };
 
+// number of bytes for the tuples_filter in the page header
+#define BYTES_FOR_TUPLES_FILTER 8
+
 #define sizeof_LINKED_PAGE_LIST_PAGE_HEADER get_offset_to_end_of_linked_page_list_page_header
 
 static inline uint32_t get_offset_to_end_of_linked_page_list_page_header(const linked_page_list_tuple_defs* lpltd_p);
@@ -44,7 +50,7 @@ static inline void print_linked_page_list_page_header(const persistent_page* ppa
 
 static inline uint32_t get_offset_to_end_of_linked_page_list_page_header(const linked_page_list_tuple_defs* lpltd_p)
 {
-	return get_offset_to_end_of_common_page_header(lpltd_p->pas_p) + (2 * lpltd_p->pas_p->page_id_width);
+	return get_offset_to_end_of_common_page_header(lpltd_p->pas_p) + (2 * lpltd_p->pas_p->page_id_width) + ((lpltd_p->get_tuple_fingerprint != NULL) ? BYTES_FOR_TUPLES_FILTER : 0);
 }
 
 static inline uint64_t get_next_page_id_of_linked_page_list_page(const persistent_page* ppage, const linked_page_list_tuple_defs* lpltd_p)
@@ -69,6 +75,7 @@ static inline linked_page_list_page_header get_linked_page_list_page_header(cons
 		.parent = get_common_page_header(ppage, lpltd_p->pas_p),
 		.next_page_id = deserialize_uint64(linked_page_list_page_header_serial, lpltd_p->pas_p->page_id_width),
 		.prev_page_id = deserialize_uint64(linked_page_list_page_header_serial + lpltd_p->pas_p->page_id_width, lpltd_p->pas_p->page_id_width),
+		.tuples_filter = (lpltd_p->get_tuple_fingerprint != NULL) ? deserialize_uint64(linked_page_list_page_header_serial + (2 * lpltd_p->pas_p->page_id_width), BYTES_FOR_TUPLES_FILTER) : 0,
 	};
 }
 
@@ -79,6 +86,8 @@ static inline void serialize_linked_page_list_page_header(void* hdr_serial, cons
 	void* linked_page_list_page_header_serial = hdr_serial + get_offset_to_linked_page_list_page_header_locals(lpltd_p);
 	serialize_uint64(linked_page_list_page_header_serial, lpltd_p->pas_p->page_id_width, lplph_p->next_page_id);
 	serialize_uint64(linked_page_list_page_header_serial + lpltd_p->pas_p->page_id_width, lpltd_p->pas_p->page_id_width, lplph_p->prev_page_id);
+	if(lpltd_p->get_tuple_fingerprint != NULL)
+		serialize_uint64(linked_page_list_page_header_serial + (2 * lpltd_p->pas_p->page_id_width), BYTES_FOR_TUPLES_FILTER, lplph_p->tuples_filter);
 }
 
 static inline void set_linked_page_list_page_header(persistent_page* ppage, const linked_page_list_page_header* lplph_p, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
@@ -108,6 +117,8 @@ static inline void print_linked_page_list_page_header(const persistent_page* ppa
 	print_common_page_header(ppage, lpltd_p->pas_p);
 	printf("next_page_id : %"PRIu64"\n", get_next_page_id_of_linked_page_list_page(ppage, lpltd_p));
 	printf("prev_page_id : %"PRIu64"\n", get_prev_page_id_of_linked_page_list_page(ppage, lpltd_p));
+	if(lpltd_p->get_tuple_fingerprint != NULL)
+		printf("tuples_filter : %016"PRIx64"\n", get_linked_page_list_page_header(ppage, lpltd_p).tuples_filter);
 }
 
 #endif
\ No newline at end of file
@@ -51,4 +51,15 @@ int can_merge_linked_page_list_pages(const persistent_page* page1, const persist
 #define MERGE_INTO_PAGE2 1
 int merge_linked_page_list_pages(persistent_page* page1, persistent_page* page2, int merge_into, const linked_page_list_tuple_defs* lpltd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
 
+// the below functions maintain the tuples_filter in the page header, they do nothing (OR always let the page through) if the lpltd_p does not have a get_tuple_fingerprint
+
+// returns 1, if the page may have a tuple with the given fingerprint, i.e. all the bits of the fingerprint are set in the tuples_filter of the page
+int may_contain_fingerprint_linked_page_list_page(const persistent_page* ppage, uint64_t fingerprint, const linked_page_list_tuple_defs* lpltd_p);
+
+// adds the fingerprint of the tuple to the tuples_filter of the page, the page is not modified if the bits of the fingerprint are already set (OR the tuple is NULL)
+void add_tuple_to_tuples_filter_of_linked_page_list_page(persistent_page* ppage, const void* tuple, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// recomputes the tuples_filter of the page from the tuples on it, this drops the fingerprints of the tuples that were removed from it
+void rebuild_tuples_filter_of_linked_page_list_page(persistent_page* ppage, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
 #endif
\ No newline at end of file
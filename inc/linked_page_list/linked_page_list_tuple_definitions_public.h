@@ -17,6 +17,11 @@ struct linked_page_list_tuple_defs
 
 	// maximum size of the record, that can be inserted into this linked_page_list
 	uint32_t max_record_size;
+
+	// optional fingerprint of a (non NULL) tuple, if set every page of the linked_page_list carries a filter of the fingerprints of its tuples in its page header
+	// so that a search for the tuples of a given fingerprint can skip the pages that can not have them, it is NULL by default
+	uint64_t (*get_tuple_fingerprint)(const void* fingerprint_context, const void* tuple);
+	const void* fingerprint_context;
 };
 
 // initializes the attributes in linked_page_list_tuple_defs struct as per the provided parameters
@@ -27,6 +32,12 @@ struct linked_page_list_tuple_defs
 // it also fails if all of the record_def' records does not fit on the page
 int init_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lpltd_p, const page_access_specs* pas_p, const tuple_def* record_def);
 
+// makes every page of the linked_page_list carry a filter of the fingerprints (as returned by get_tuple_fingerprint) of its tuples, this must be done before the linked_page_list is created
+// the filter is set on every insert and update, and rebuilt on every split and merge of the pages, it is never cleared on a remove, so it may only let a page through that no longer has the fingerprint
+// the filter takes 8 more bytes of the page header, so the max_record_size is recomputed
+// it returns 0 (leaving lpltd_p unchanged), if the record_def's records no longer fit on the page OR get_tuple_fingerprint == NULL
+int set_tuple_fingerprint_for_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lpltd_p, const void* fingerprint_context, uint64_t (*get_tuple_fingerprint)(const void* fingerprint_context, const void* tuple));
+
 // checks to see if a record_tuple can be inserted into a linked_page_list
 // note :: you can insert a NULL record in linked_page_list, and this functions will always succeed on a NULL
 int check_if_record_can_be_inserted_for_linked_page_list_tuple_definitions(const linked_page_list_tuple_defs* lpltd_p, const void* record_tuple);
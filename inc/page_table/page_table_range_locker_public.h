@@ -26,6 +26,14 @@ bucket_range get_lock_range_for_page_table_range_locker(const page_table_range_l
 // you may set only if this returns 1
 int is_writable_page_table_range_locker(const page_table_range_locker* ptrl_p);
 
+// reads the epoch from the root page of the page_table, into epoch
+// it returns 0, if the pttd_p does not have a root epoch OR if the local_root is not the root of the page_table (i.e. once the lock range has been minimized away from the root)
+int get_root_epoch_for_page_table_range_locker(const page_table_range_locker* ptrl_p, uint64_t* epoch);
+
+// increments the epoch on the root page of the page_table, the ptrl must be writable and its local_root must be the root of the page_table, returns 0 other wise
+// on an abort error, lock on the local root is released, then you only need to call delete_page_table_range_locker
+int increment_root_epoch_for_page_table_range_locker(page_table_range_locker* ptrl_p, const void* transaction_id, int* abort_error);
+
 // you may only get, if the bucket_id is within get_lock_range_for_page_table_range_locker()
 // on an abort error, lock on the local root is released, then you only need to call delete_page_table_range_locker
 uint64_t get_from_page_table(page_table_range_locker* ptrl_p, uint64_t bucket_id, const void* transaction_id, int* abort_error);
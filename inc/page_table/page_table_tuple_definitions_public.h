@@ -28,6 +28,10 @@ struct page_table_tuple_defs
 // it also fails if the pas_p does not pass is_valid_page_access_specs(pas_p)
 int init_page_table_tuple_definitions(page_table_tuple_defs* pttd_p, const page_access_specs* pas_p);
 
+// makes the root page of the page_table carry an epoch (see set_root_epoch_for_array_table_tuple_definitions), this must be done before the page_table is created
+// returns 1 for success, it fails with 0 (leaving pttd_p unchanged)
+int set_root_epoch_for_page_table_tuple_definitions(page_table_tuple_defs* pttd_p);
+
 // it deallocates the entry_def and
 // then resets all the page_table_tuple_defs struct attributes to NULL or 0
 void deinit_page_table_tuple_definitions(page_table_tuple_defs* pttd_p);
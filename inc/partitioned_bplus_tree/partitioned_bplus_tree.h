@@ -0,0 +1,58 @@
+#ifndef PARTITIONED_BPLUS_TREE_H
+#define PARTITIONED_BPLUS_TREE_H
+
+#include<partitioned_bplus_tree_tuple_definitions_public.h>
+
+#include<bplus_tree.h>
+
+#include<opaque_page_access_methods.h>
+#include<opaque_page_modification_methods.h>
+#include<find_position.h>
+
+/*
+	A partitioned_bplus_tree is just a page_table, whose first partitions_count buckets point to the root pages of independent bplus_trees (partitions).
+	A record belongs to the partition = hash(first partitioning_key_element_count key elements) % partitions_count.
+
+	Since the root page of a bplus_tree never moves, this page_table is never modified after the creation of the partitioned_bplus_tree.
+	So you read it only once (using get_partition_root_page_ids_for_partitioned_bplus_tree) and cache the partition_root_page_ids,
+	then the point operations only lock the pages of a single partition, and do not contend on any common root page.
+*/
+
+// returns pointer to the root page of the page_table of the newly created partitioned_bplus_tree
+uint64_t get_new_partitioned_bplus_tree(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// reads the root page ids of all the partitions into partition_root_page_ids (an array of atleast pbpttd_p->partitions_count elements)
+// it returns 0, only on an abort_error
+int get_partition_root_page_ids_for_partitioned_bplus_tree(uint64_t root_page_id, uint64_t* partition_root_page_ids, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// below functions work exactly like their bplus_tree counterparts, on the partition that the record/key belongs to
+// the partition_root_page_ids must be the one read using get_partition_root_page_ids_for_partitioned_bplus_tree
+
+int insert_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* record, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+int delete_from_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+int inspected_update_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, void* new_record, const update_inspector* ui_p, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+// returns a bplus_tree_iterator over only the partition that the key belongs to
+// use it for point lookups and for the scans over the records having the same first partitioning_key_element_count key elements as the key
+// the key_element_count_concerned must be atleast pbpttd_p->partitioning_key_element_count, else NULL is returned
+// it may return NULL, on an abort_error
+bplus_tree_iterator* find_in_partition_of_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, int is_stacked, int lock_type, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error);
+
+#include<partitioned_bplus_tree_iterator_public.h>
+
+// returns a read-only partitioned_bplus_tree_iterator, that scans the records of all the partitions in the order of their keys
+// it is positioned as if find_in_bplus_tree(key, key_element_count_concerned, find_pos) was called on a single bplus_tree holding all the records
+// it may return NULL, only on an abort_error
+partitioned_bplus_tree_iterator* find_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// frees all the pages occupied by the partitioned_bplus_tree
+// it may fail on an abort_error, ALSO you must ensure that you are the only one who has lock on the given partitioned_bplus_tree
+int destroy_partitioned_bplus_tree(uint64_t root_page_id, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+// prints all the pages in the partitioned_bplus_tree
+// it may return an abort_error, unable to print all of the partitioned_bplus_tree pages
+void print_partitioned_bplus_tree(uint64_t root_page_id, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+#endif
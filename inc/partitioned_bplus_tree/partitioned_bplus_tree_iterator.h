@@ -0,0 +1,36 @@
+#ifndef PARTITIONED_BPLUS_TREE_ITERATOR_H
+#define PARTITIONED_BPLUS_TREE_ITERATOR_H
+
+#include<stdint.h>
+
+#include<bplus_tree_iterator_public.h>
+#include<partitioned_bplus_tree_tuple_definitions_public.h>
+#include<opaque_page_access_methods.h>
+#include<find_position.h>
+
+typedef struct partitioned_bplus_tree_iterator partitioned_bplus_tree_iterator;
+struct partitioned_bplus_tree_iterator
+{
+	// set if the scan moves to greater keys
+	int is_ascending;
+
+	// array of pbpttd_p->partitions_count iterators, one for each partition
+	// an iterator is deleted and set to NULL, as soon as its partition has no more records to scan
+	bplus_tree_iterator** partition_iterators;
+
+	// index of the partition_iterator, that points to the current tuple
+	// it is equal to pbpttd_p->partitions_count, if the scan has reached its end
+	uint64_t curr_partition_index;
+
+	const partitioned_bplus_tree_tuple_defs* pbpttd_p;
+
+	const page_access_methods* pam_p;
+};
+
+// opens a read-only unstacked bplus_tree_iterator on each of the partitions at key, and merges them
+// it may return NULL, only on an abort_error
+partitioned_bplus_tree_iterator* get_new_partitioned_bplus_tree_iterator(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
+
+#include<partitioned_bplus_tree_iterator_public.h>
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef PARTITIONED_BPLUS_TREE_ITERATOR_PUBLIC_H
+#define PARTITIONED_BPLUS_TREE_ITERATOR_PUBLIC_H
+
+// this iterator can only be used to read the records of the partitioned_bplus_tree, in the order of their keys
+// it merges the records of all the partitions, holding a READ_LOCK on atmost one leaf page of each of the partitions
+
+typedef struct partitioned_bplus_tree_iterator partitioned_bplus_tree_iterator;
+
+// returns pointer to the current tuple that the cursor points to
+// it returns NULL, when the partitioned_bplus_tree_iterator has reached the end
+// the pointer to the tuple returned by this function is valid only until next_* and delete_* functions are not called
+const void* get_tuple_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p);
+
+// it moves the cursor by a tuple, in the direction of the scan
+// i.e. to the next greater key for find_pos = MIN, GREATER_THAN or GREATER_THAN_EQUALS
+// and to the next lesser key for find_pos = MAX, LESSER_THAN or LESSER_THAN_EQUALS
+// returns 1 for success, it returns 0, if there are no records to move to
+// on an abort_error, all the locks held by the iterator are released, then you only need to call delete_partitioned_bplus_tree_iterator
+int next_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p, const void* transaction_id, int* abort_error);
+
+// all locks held by the iterator will be released before, the iterator is destroyed/deleted
+// releasing locks may result in an abort_error
+void delete_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p, const void* transaction_id, int* abort_error);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PARTITIONED_BPLUS_TREE_TUPLE_DEFINITIONS_PUBLIC_H
+#define PARTITIONED_BPLUS_TREE_TUPLE_DEFINITIONS_PUBLIC_H
+
+#include<tuple.h>
+#include<inttypes.h>
+
+#include<bplus_tree_tuple_definitions_public.h>
+#include<page_table_tuple_definitions_public.h>
+
+typedef struct partitioned_bplus_tree_tuple_defs partitioned_bplus_tree_tuple_defs;
+struct partitioned_bplus_tree_tuple_defs
+{
+	// number of partitions (i.e. independent bplus_trees) in the partitioned_bplus_tree
+	// this is fixed for the life time of the partitioned_bplus_tree
+	uint64_t partitions_count;
+
+	// number of leading key elements that are hashed to pick the partition for a record/key
+	// it must be in range [1, bpttd.key_element_count]
+	// all records sharing these many leading key elements, fall in the same partition
+	uint32_t partitioning_key_element_count;
+
+	// initial value of the hasher to hash the partitioning key elements
+	tuple_hasher hasher;
+
+	// tuple_definition for each of the partitions
+	bplus_tree_tuple_defs bpttd;
+
+	// tuple_definition for the array of the root page ids of the partitions
+	page_table_tuple_defs pttd;
+};
+
+// initializes the attributes in partitioned_bplus_tree_tuple_defs struct as per the provided parameters
+// the parameter pas_p must point to the pas attribute of the data_access_method that you are using it with
+// it relies on bpttd and pttd for most of its functionality
+// returns 1 for success, it fails with 0, if partitions_count == 0 OR partitioning_key_element_count is not in range [1, key_element_count]
+// it also fails if init_bplus_tree_tuple_definitions or init_page_table_tuple_definitions fails
+int init_partitioned_bplus_tree_tuple_definitions(partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, const compare_direction* key_compare_direction, uint32_t key_element_count, uint32_t partitioning_key_element_count, uint64_t partitions_count, const tuple_hasher* hasher);
+
+// get partition index for key, using the partitioned_bplus_tree tuple defs
+// the key must have atleast partitioning_key_element_count elements
+uint64_t get_partition_index_for_key_using_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const void* key);
+
+// get partition index for record, using the partitioned_bplus_tree tuple defs
+uint64_t get_partition_index_for_record_using_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const void* record_tuple);
+
+// it deallocates bpttd and pttd
+// then resets all the partitioned_bplus_tree_tuple_defs struct attributes to NULL or 0
+void deinit_partitioned_bplus_tree_tuple_definitions(partitioned_bplus_tree_tuple_defs* pbpttd_p);
+
+// print partitioned_bplus_tree_tuple_definitions
+void print_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p);
+
+#endif
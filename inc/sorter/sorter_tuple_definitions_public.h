@@ -6,6 +6,7 @@
 
 #include<linked_page_list_tuple_definitions_public.h>
 #include<page_table_tuple_definitions_public.h>
+#include<tuple_keys_comparator.h>
 
 typedef struct sorter_tuple_defs sorter_tuple_defs;
 struct sorter_tuple_defs
@@ -19,6 +20,9 @@ struct sorter_tuple_defs
 	// compare direction for the keys, array of ASC/DESC
 	const compare_direction* key_compare_direction;
 
+	// comparator picked for the types of the key elements, use it in place of compare_tuples(), to compare the keys of the records
+	tuple_keys_comparator key_comparator;
+
 	// tuple definition of the records
 	const tuple_def* record_def;
 
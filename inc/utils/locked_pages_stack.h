@@ -24,6 +24,10 @@ data_definitions_value_arraylist(locked_pages_stack, locked_page_info)
 
 int initialize_locked_pages_stack(locked_pages_stack* lps, cy_uint capacity);
 
+// the locked_pages_stack uses the given memory (of atleast capacity locked_page_info s), which it never reallocates or frees
+// the memory must outlive the locked_pages_stack, and the stack can not grow beyond capacity
+int initialize_locked_pages_stack_with_memory(locked_pages_stack* lps, cy_uint capacity, locked_page_info data_ps_p[]);
+
 void deinitialize_locked_pages_stack(locked_pages_stack* lps);
 
 // returns number of locked_page_info s inside the stack
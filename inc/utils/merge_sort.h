@@ -0,0 +1,15 @@
+#ifndef MERGE_SORT_H
+#define MERGE_SORT_H
+
+#include<stdint.h>
+#include<stddef.h>
+
+// compares the elements at e1 and e2 (pointers to the elements in the array being sorted), returning < 0, 0 or > 0, as per the ordering of e1 with respect to e2
+typedef int (*element_comparator)(const void* context, const void* e1, const void* e2);
+
+// sorts elements[0 .. element_count-1] (each of element_size bytes) in ascending order, as per compare(context, e1, e2)
+// it is a bottom up merge sort, so it is stable (keeping the equal elements in their given order) and needs no recursion
+// temp is the auxiliary array, it must have space for atleast element_count elements, its contents are undefined after the call
+void merge_sort_elements(void* elements, void* temp, uint32_t element_count, size_t element_size, const void* context, element_comparator compare);
+
+#endif
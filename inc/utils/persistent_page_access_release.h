@@ -12,10 +12,20 @@
 // returns a NULL persistent_page on failure
 persistent_page get_new_persistent_page_with_write_lock(const page_access_methods* pam_p, const void* transaction_id, int* abort_error);
 
+// get new persistent page with write lock on it, whose page_id is greater than the after_page_id
+// returns a NULL persistent_page on failure, there is no such page if it returns a NULL persistent_page without an abort_error
+// if the pam_p does not provide get_new_page_with_write_lock_after, then this function always returns a NULL persistent_page without an abort_error
+persistent_page get_new_persistent_page_with_write_lock_after(const page_access_methods* pam_p, const void* transaction_id, uint64_t after_page_id, int* abort_error);
+
 // acquire appropriate lock type on page and get persistent page
 // returns a NULL persistent_page on failure
 persistent_page acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int* abort_error);
 
+// attempt to acquire appropriate lock type on page and get persistent page, without waiting for the lock
+// returns a NULL persistent_page on failure, the lock could not be acquired immediately if it returns a NULL persistent_page without an abort_error
+// if the pam_p does not provide the non-blocking variants, then this function waits for the lock exactly as acquire_persistent_page_with_lock() does
+persistent_page try_acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int* abort_error);
+
 // downgrade writer lock on persistent page to reader lock
 int downgrade_to_reader_lock_on_persistent_page(const page_access_methods* pam_p, const void* transaction_id, persistent_page* ppage, int opts, int* abort_error); // acceptable options : WAS_MODIFIED
 
@@ -27,4 +37,9 @@ int release_lock_on_persistent_page(const page_access_methods* pam_p, const void
 
 int free_persistent_page(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int* abort_error);
 
+// compresses the page at page_id with the codec, if it is unlocked and cold, you must not hold a lock on the page, while calling this function
+// it returns 1 if the page was compressed, a 0 without an abort_error implies that the page was not compressed
+// if the pam_p does not provide compress_page, then this function always returns 0 without an abort_error
+int compress_persistent_page(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, uint64_t cold_after_modifications_count, const page_codec* codec, int* abort_error);
+
 #endif
\ No newline at end of file
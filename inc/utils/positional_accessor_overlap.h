@@ -0,0 +1,13 @@
+#ifndef POSITIONAL_ACCESSOR_OVERLAP_H
+#define POSITIONAL_ACCESSOR_OVERLAP_H
+
+#include<tuple.h>
+
+// returns 1, if the element at pa1 is the same as OR is contained in (or contains) the element at pa2
+// i.e. if the shorter of the 2 positional_accessors is a prefix of the other
+int are_overlapping_positional_accessors(positional_accessor pa1, positional_accessor pa2);
+
+// returns 1, if pa overlaps with any of the pas_count positional_accessors in pas
+int is_overlapping_any_positional_accessor(const positional_accessor* pas, uint32_t pas_count, positional_accessor pa);
+
+#endif
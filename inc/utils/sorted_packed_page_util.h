@@ -9,6 +9,7 @@
 */
 
 #include<tuple.h>
+#include<tuple_keys_comparator.h>
 #include<persistent_page.h>
 #include<opaque_page_modification_methods.h>
 
@@ -20,6 +21,7 @@
 **	uint32_t*             tuple_keys_to_compare           -> the indices of the element_defs in the tpl_def, that ppage is sorted on, (for find operations you may provide lesser number of keys)
 **	compare_direction*    tuple_keys_compare_direction    -> the sort direction of each of the elements as in tuple_keys_to_compare, in the order of comparison
 **	uint32_t              keys_count                      -> the number of elements in tuple_keys_to_compare and tuple_keys_to_compare_direction
+**	tuple_keys_comparator key_comparator                  -> comparator picked once by the caller for the types of the keys (like the key_comparator of the bplus_tree_tuple_defs), compare_tuples works for any keys
 **
 ** above attributes define what is there on the page
 **
@@ -45,7 +47,7 @@
 // than the index returns is right after these tuples that compare equals to the "tuple" parameter
 uint32_t find_insertion_point_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple
 								);
 
@@ -54,7 +56,7 @@ uint32_t find_insertion_point_in_sorted_packed_page(
 // returns the index the new tuple is inserted on
 int insert_to_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t* index,
 									const page_modification_methods* pmm_p,
@@ -65,7 +67,7 @@ int insert_to_sorted_packed_page(
 // checks to ensure that the position for the insertion of the new tuple will not disturn the tuple sort ordering
 int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index
 								);
@@ -74,7 +76,7 @@ int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 // returns 1, if tuple was inserted
 int insert_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index,
 									const page_modification_methods* pmm_p,
@@ -86,7 +88,7 @@ int insert_at_in_sorted_packed_page(
 // returns 1, if tuple was updated
 int update_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index,
 									const page_modification_methods* pmm_p,
@@ -109,7 +111,7 @@ int delete_in_sorted_packed_page(
 // returns the number of tuples inserted
 uint32_t insert_all_from_sorted_packed_page(
 									persistent_page* ppage_dest, const persistent_page* ppage_src, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									uint32_t start_index, uint32_t last_index,
 									const page_modification_methods* pmm_p,
 									const void* transaction_id,
@@ -135,21 +137,21 @@ int delete_all_in_sorted_packed_page(
 // returns index of the tuple found
 uint32_t find_first_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
 // returns index of the tuple found
 uint32_t find_last_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
 // returns index of the tuple found at the greatest index that is lesser than the key
 uint32_t find_preceding_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
@@ -157,7 +159,7 @@ uint32_t find_preceding_in_sorted_packed_page(
 // if there are tuples that compare equal to the key, then the last index of the tuple that compare equal to the key is returned
 uint32_t find_preceding_equals_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
@@ -165,14 +167,14 @@ uint32_t find_preceding_equals_in_sorted_packed_page(
 // if there are tuples that compare equal to the key, then the first index of the tuple that compare equal to the key is returned
 uint32_t find_succeeding_equals_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
 // returns index of the tuple found at the least index that is greater than the key
 uint32_t find_succeeding_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								);
 
@@ -236,7 +238,7 @@ void reverse_sort_order_on_sorted_packed_page(
 // creates a page into its sorted_packed_page form
 void sort_and_convert_to_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const page_modification_methods* pmm_p,
 									const void* transaction_id,
 									int* abort_error
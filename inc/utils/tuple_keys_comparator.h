@@ -0,0 +1,30 @@
+#ifndef TUPLE_KEYS_COMPARATOR_H
+#define TUPLE_KEYS_COMPARATOR_H
+
+#include<tuple.h>
+
+/*
+	a tuple_keys_comparator takes the same parameters and returns the same result as compare_tuples()
+	compare_tuples() dispatches on the data_type_info of every element it compares
+	so for the most common key shapes, a kernel specialized for the types of its key elements is picked once (when the tuple_defs of a data structure are initialized)
+
+	the specialized kernels are for
+	 * a single UINT or INT key element
+	 * two UINT or INT key elements (in any combination)
+	 * a single fixed length STRING key element
+	and for any other key shape compare_tuples() itself is used
+
+	the kernels still read the key elements through get_value_from_element_from_tuple() (the element layout is private to the tuple_def)
+	what they skip is the per element type dispatch and the generic user_value comparison of compare_tuples()
+	an element that can not be read is compared as a NULL
+*/
+
+typedef int (*tuple_keys_comparator)(const void* tup1, const tuple_def* def1, const positional_accessor* element_ids1, const void* tup2, const tuple_def* def2, const positional_accessor* element_ids2, const compare_direction* cmp_dir, uint32_t element_count);
+
+// returns the comparator for comparing tuples of tuple_def, on the elements at key_element_ids (key_element_count of them)
+// the returned comparator may then be called to compare these tuples, with any tuple whose elements at element_ids2 are of the same types (like a key tuple or an index entry)
+// it may be called for fewer than key_element_count elements (for a prefix of the keys), but never for more
+// element_ids = NULL (for either tuple) implies the first element_count elements, and cmp_dir = NULL implies all ASC, just as in compare_tuples()
+tuple_keys_comparator get_tuple_keys_comparator(const tuple_def* tpl_def, const positional_accessor* key_element_ids, uint32_t key_element_count);
+
+#endif
@@ -27,6 +27,24 @@ int init_array_table_page(persistent_page* ppage, uint32_t level, uint64_t first
 	hdr.parent.type = ARRAY_TABLE_PAGE;
 	hdr.level = level;
 	hdr.first_bucket_id = first_bucket_id;
+	hdr.epoch = 0;
+	set_array_table_page_header(ppage, &hdr, attd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+int set_epoch_of_array_table_page(persistent_page* ppage, uint64_t epoch, const array_table_tuple_defs* attd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(!attd_p->has_root_epoch)
+		return 0;
+
+	array_table_page_header hdr = get_array_table_page_header(ppage, attd_p);
+	if(hdr.epoch == epoch)
+		return 1;
+
+	hdr.epoch = epoch;
 	set_array_table_page_header(ppage, &hdr, attd_p, pmm_p, transaction_id, abort_error);
 	if(*abort_error)
 		return 0;
@@ -372,6 +390,14 @@ int level_up_array_table_page(persistent_page* ppage, const array_table_tuple_de
 	if(*abort_error)
 		return 0;
 
+	// the page may be the root, so it keeps its epoch
+	if(attd_p->has_root_epoch)
+	{
+		set_epoch_of_array_table_page(ppage, old_hdr.epoch, attd_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+	}
+
 	// from this point on, level of ppage is > 0 (because we incremented it), hence we can operate on it with index_def and index page access functions
 
 	// if we needed to copy contents of the ppage onto its child, then make an entry for it on this promoted ppage
@@ -407,6 +433,9 @@ int level_down_array_table_page(persistent_page* ppage, const array_table_tuple_
 		}
 	}
 
+	// the page may be the root, so it must keep its epoch, and not take the one cloned from its child
+	uint64_t epoch = get_array_table_page_header(ppage, attd_p).epoch;
+
 	// get write lock on this only_child_page
 	persistent_page only_child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, only_child_page_id, WRITE_LOCK, abort_error);
 	if(*abort_error)
@@ -423,6 +452,16 @@ int level_down_array_table_page(persistent_page* ppage, const array_table_tuple_
 		return 0;
 	}
 
+	if(attd_p->has_root_epoch)
+	{
+		set_epoch_of_array_table_page(ppage, epoch, attd_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &only_child_page, NONE_OPTION, abort_error);
+			return 0;
+		}
+	}
+
 	// free the only_child_page
 	release_lock_on_persistent_page(pam_p, transaction_id, &only_child_page, FREE_PAGE, abort_error);
 	if(*abort_error)
@@ -147,6 +147,36 @@ int is_writable_array_table_range_locker(const array_table_range_locker* atrl_p)
 	return atrl_p->pmm_p != NULL;
 }
 
+int get_root_epoch_for_array_table_range_locker(const array_table_range_locker* atrl_p, uint64_t* epoch)
+{
+	// the epoch is maintained only on the root page
+	if(!atrl_p->attd_p->has_root_epoch || atrl_p->local_root.page_id != atrl_p->root_page_id)
+		return 0;
+
+	(*epoch) = get_array_table_page_header(&(atrl_p->local_root), atrl_p->attd_p).epoch;
+	return 1;
+}
+
+int increment_root_epoch_for_array_table_range_locker(array_table_range_locker* atrl_p, const void* transaction_id, int* abort_error)
+{
+	if(!is_writable_array_table_range_locker(atrl_p))
+		return 0;
+
+	uint64_t epoch;
+	if(!get_root_epoch_for_array_table_range_locker(atrl_p, &epoch))
+		return 0;
+
+	// the epoch wraps around on an overflow, it only ever needs to be compared for equality
+	set_epoch_of_array_table_page(&(atrl_p->local_root), epoch + 1, atrl_p->attd_p, atrl_p->pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+	{
+		release_lock_on_persistent_page(atrl_p->pam_p, transaction_id, &(atrl_p->local_root), NONE_OPTION, abort_error);
+		return 0;
+	}
+
+	return 1;
+}
+
 // release lock on the persistent_page, and ensure that local_root is not unlocked
 // only used in get and set functions (and find_non_NULL_in_array_table)
 static void release_lock_on_persistent_page_while_preventing_local_root_unlocking(persistent_page* ppage, array_table_range_locker* atrl_p, const void* transaction_id, int* abort_error)
@@ -266,6 +296,17 @@ int set_in_array_table(array_table_range_locker* atrl_p, uint64_t bucket_id, con
 					goto ABORT_ERROR;
 				}
 
+				// the page may be the root, so it keeps its epoch
+				if(atrl_p->attd_p->has_root_epoch)
+				{
+					set_epoch_of_array_table_page(&curr_page, hdr.epoch, atrl_p->attd_p, atrl_p->pmm_p, transaction_id, abort_error);
+					if(*abort_error)
+					{
+						release_lock_on_persistent_page_while_preventing_local_root_unlocking(&curr_page, atrl_p, transaction_id, abort_error);
+						goto ABORT_ERROR;
+					}
+				}
+
 				uint32_t child_index = get_child_index_for_bucket_id_on_array_table_page(&curr_page, bucket_id, atrl_p->attd_p);
 				set_record_entry_at_child_index_in_array_table_leaf_page(&curr_page, child_index, record, atrl_p->attd_p, atrl_p->pmm_p, transaction_id, abort_error);
 				if(*abort_error)
@@ -8,52 +8,23 @@
 
 #include<stdlib.h>
 
-int init_array_table_tuple_definitions(array_table_tuple_defs* attd_p, const page_access_specs* pas_p, const tuple_def* record_def)
+// computes the entries_per_page, the power_table and the max_array_table_height of the attd_p, all of which depend on the size of the page header
+// it fails with 0, if the page can not hold atleast 1 leaf entry and 2 index entries
+static int compute_entries_per_page(array_table_tuple_defs* attd_p)
 {
-	// zero initialize attd_p
-	(*attd_p) = (array_table_tuple_defs){};
-
-	// check id page_access_specs struct is valid
-	if(!is_valid_page_access_specs(pas_p))
-		return 0;
-
-	// initialize page_access_specs for the attd
-	attd_p->pas_p = pas_p;
-
-	// this can only be done after setting the pas_p attribute of attd
-	// there must be room for atleast some bytes after the array_table_page_header
-	if(!can_page_header_fit_on_persistent_page(sizeof_ARRAY_TABLE_PAGE_HEADER(attd_p), attd_p->pas_p->page_size))
-		return 0;
-
-	// if the record_def is not fixed sized, then fail
-	if(!is_fixed_sized_tuple_def(record_def))
-		return 0;
-
-	// initialize index_def
-	attd_p->index_def = &(pas_p->page_id_tuple_def);
-
-	// copy record_def
-	attd_p->record_def = record_def;
-
 	// number of entries that can fit on the leaf page
 	attd_p->leaf_entries_per_page = get_maximum_tuple_count_on_persistent_page(sizeof_ARRAY_TABLE_PAGE_HEADER(attd_p), attd_p->pas_p->page_size, &(attd_p->record_def->size_def));
 
 	// there has to be atleast 1 entries per page for leaf pages
 	if(attd_p->leaf_entries_per_page < 1)
-	{
-		deinit_array_table_tuple_definitions(attd_p);
 		return 0;
-	}
 
 	// number of entries that can fit on the index (interior) page
 	attd_p->index_entries_per_page = get_maximum_tuple_count_on_persistent_page(sizeof_ARRAY_TABLE_PAGE_HEADER(attd_p), attd_p->pas_p->page_size, &(attd_p->index_def->size_def));
 
 	// there has to be atleast 2 entries per page for index_pages, for it to be a tree
 	if(attd_p->index_entries_per_page < 2)
-	{
-		deinit_array_table_tuple_definitions(attd_p);
 		return 0;
-	}
 
 	// build power_table
 	initialize_power_table(&(attd_p->power_table_for_index_entries_per_page), attd_p->index_entries_per_page);
@@ -80,6 +51,61 @@ int init_array_table_tuple_definitions(array_table_tuple_defs* attd_p, const pag
 	return 1;
 }
 
+int init_array_table_tuple_definitions(array_table_tuple_defs* attd_p, const page_access_specs* pas_p, const tuple_def* record_def)
+{
+	// zero initialize attd_p
+	(*attd_p) = (array_table_tuple_defs){};
+
+	// check id page_access_specs struct is valid
+	if(!is_valid_page_access_specs(pas_p))
+		return 0;
+
+	// initialize page_access_specs for the attd
+	attd_p->pas_p = pas_p;
+
+	// this can only be done after setting the pas_p attribute of attd
+	// there must be room for atleast some bytes after the array_table_page_header
+	if(!can_page_header_fit_on_persistent_page(sizeof_ARRAY_TABLE_PAGE_HEADER(attd_p), attd_p->pas_p->page_size))
+		return 0;
+
+	// if the record_def is not fixed sized, then fail
+	if(!is_fixed_sized_tuple_def(record_def))
+		return 0;
+
+	// initialize index_def
+	attd_p->index_def = &(pas_p->page_id_tuple_def);
+
+	// copy record_def
+	attd_p->record_def = record_def;
+
+	if(!compute_entries_per_page(attd_p))
+	{
+		deinit_array_table_tuple_definitions(attd_p);
+		return 0;
+	}
+
+	return 1;
+}
+
+int set_root_epoch_for_array_table_tuple_definitions(array_table_tuple_defs* attd_p)
+{
+	if(attd_p->has_root_epoch)
+		return 1;
+
+	// the header size depends on the has_root_epoch, so work on a copy, until the entries_per_page are known to be valid
+	array_table_tuple_defs attd_with_root_epoch = (*attd_p);
+	attd_with_root_epoch.has_root_epoch = 1;
+
+	if(!can_page_header_fit_on_persistent_page(sizeof_ARRAY_TABLE_PAGE_HEADER(&attd_with_root_epoch), attd_with_root_epoch.pas_p->page_size))
+		return 0;
+
+	if(!compute_entries_per_page(&attd_with_root_epoch))
+		return 0;
+
+	(*attd_p) = attd_with_root_epoch;
+	return 1;
+}
+
 int get_leaf_entries_refrenceable_by_entry_at_given_level_using_array_table_tuple_definitions(const array_table_tuple_defs* attd_p, uint64_t level, uint64_t* result)
 {
 	// every leaf page entry references only 1 leaf entry, which is itself
@@ -109,6 +135,7 @@ void deinit_array_table_tuple_definitions(array_table_tuple_defs* attd_p)
 	attd_p->index_def = NULL;
 	attd_p->leaf_entries_per_page = 0;
 	attd_p->index_entries_per_page = 0;
+	attd_p->has_root_epoch = 0;
 }
 
 void print_array_table_tuple_definitions(const array_table_tuple_defs* attd_p)
@@ -134,4 +161,6 @@ void print_array_table_tuple_definitions(const array_table_tuple_defs* attd_p)
 	printf("index_entries_per_page = %"PRIu64"\n", attd_p->index_entries_per_page);
 
 	printf("max_array_table_height = %"PRIu64"\n", attd_p->max_array_table_height);
+
+	printf("has_root_epoch = %d\n", attd_p->has_root_epoch);
 }
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include<bplus_tree_bulk_loader.h>
+
+#include<bplus_tree.h>
+
+#include<bplus_tree_leaf_page_util.h>
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_leaf_page_header.h>
+#include<bplus_tree_interior_page_header.h>
+#include<bplus_tree_index_tuple_functions_util.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<stdlib.h>
+
+// returns the pointer to the index_entry at index in the index_entries buffer
+static void* get_index_entry_of_bplus_tree_bulk_loader(void* index_entries, uint64_t index, const bplus_tree_tuple_defs* bpttd_p)
+{
+	return index_entries + (index * bpttd_p->max_index_record_size);
+}
+
+// grows the buffer (of element_size sized elements) to hold atleast one more element
+static void* expand_buffer_of_bplus_tree_bulk_loader(void* buffer, uint64_t* capacity, uint64_t element_size)
+{
+	(*capacity) = ((*capacity) == 0) ? 16 : (2 * (*capacity));
+	buffer = realloc(buffer, (*capacity) * element_size);
+	if(buffer == NULL)
+		exit(-1);
+	return buffer;
+}
+
+// allocates a new WRITE_LOCKed page, and remembers its page_id, so that it can be freed on a discard
+static persistent_page get_new_page_for_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error)
+{
+	persistent_page ppage = get_new_persistent_page_with_write_lock(bpbl_p->pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return ppage;
+
+	if(bpbl_p->allocated_page_ids_count == bpbl_p->allocated_page_ids_capacity)
+		bpbl_p->allocated_page_ids = expand_buffer_of_bplus_tree_bulk_loader(bpbl_p->allocated_page_ids, &(bpbl_p->allocated_page_ids_capacity), sizeof(uint64_t));
+	bpbl_p->allocated_page_ids[bpbl_p->allocated_page_ids_count++] = ppage.page_id;
+
+	return ppage;
+}
+
+// appends a copy of index_entry to index_entries, with its child_page_id set to child_page_id
+static void append_index_entry_for_bplus_tree_bulk_loader(void** index_entries, uint64_t* index_entries_count, uint64_t* index_entries_capacity, const void* index_entry, uint64_t child_page_id, const bplus_tree_tuple_defs* bpttd_p)
+{
+	if((*index_entries_count) == (*index_entries_capacity))
+		(*index_entries) = expand_buffer_of_bplus_tree_bulk_loader((*index_entries), index_entries_capacity, bpttd_p->max_index_record_size);
+
+	void* new_index_entry = get_index_entry_of_bplus_tree_bulk_loader((*index_entries), (*index_entries_count), bpttd_p);
+	memory_move(new_index_entry, index_entry, get_tuple_size(bpttd_p->index_def, index_entry));
+	set_child_page_id_in_index_tuple(new_index_entry, child_page_id, bpttd_p);
+
+	(*index_entries_count)++;
+}
+
+void initialize_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	bpbl_p->curr_leaf_page = get_NULL_persistent_page(pam_p);
+	bpbl_p->index_entries = NULL;
+	bpbl_p->index_entries_count = 0;
+	bpbl_p->index_entries_capacity = 0;
+	bpbl_p->allocated_page_ids = NULL;
+	bpbl_p->allocated_page_ids_count = 0;
+	bpbl_p->allocated_page_ids_capacity = 0;
+	bpbl_p->bpttd_p = bpttd_p;
+	bpbl_p->pam_p = pam_p;
+	bpbl_p->pmm_p = pmm_p;
+}
+
+// allocates a new leaf page, links it after the curr_leaf_page (releasing the lock on it), and makes it the curr_leaf_page
+// the index_entry for the new leaf page is built from the record, that will be its first record
+static int start_new_leaf_page_for_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* record, const void* transaction_id, int* abort_error)
+{
+	const bplus_tree_tuple_defs* bpttd_p = bpbl_p->bpttd_p;
+
+	persistent_page new_leaf_page = get_new_page_for_bplus_tree_bulk_loader(bpbl_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	init_bplus_tree_leaf_page(&new_leaf_page, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	if(!is_persistent_page_NULL(&(bpbl_p->curr_leaf_page), bpbl_p->pam_p))
+	{
+		bplus_tree_leaf_page_header new_leaf_hdr = get_bplus_tree_leaf_page_header(&new_leaf_page, bpttd_p);
+		new_leaf_hdr.prev_page_id = bpbl_p->curr_leaf_page.page_id;
+		set_bplus_tree_leaf_page_header(&new_leaf_page, &new_leaf_hdr, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		bplus_tree_leaf_page_header curr_leaf_hdr = get_bplus_tree_leaf_page_header(&(bpbl_p->curr_leaf_page), bpttd_p);
+		curr_leaf_hdr.next_page_id = new_leaf_page.page_id;
+		set_bplus_tree_leaf_page_header(&(bpbl_p->curr_leaf_page), &curr_leaf_hdr, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &(bpbl_p->curr_leaf_page), NONE_OPTION, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	bpbl_p->curr_leaf_page = new_leaf_page;
+
+	// the index_entry for this leaf page
+	void* index_entry = malloc(bpttd_p->max_index_record_size);
+	if(index_entry == NULL)
+		exit(-1);
+	build_index_entry_from_record_tuple_using_bplus_tree_tuple_definitions(bpttd_p, record, new_leaf_page.page_id, index_entry);
+	append_index_entry_for_bplus_tree_bulk_loader(&(bpbl_p->index_entries), &(bpbl_p->index_entries_count), &(bpbl_p->index_entries_capacity), index_entry, new_leaf_page.page_id, bpttd_p);
+	free(index_entry);
+
+	return 1;
+
+	ABORT_ERROR:;
+	release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &new_leaf_page, NONE_OPTION, abort_error);
+	return 0;
+}
+
+int append_record_to_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* record, const void* transaction_id, int* abort_error)
+{
+	const bplus_tree_tuple_defs* bpttd_p = bpbl_p->bpttd_p;
+
+	if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(bpttd_p, record))
+		return 0;
+
+	if(is_persistent_page_NULL(&(bpbl_p->curr_leaf_page), bpbl_p->pam_p))
+	{
+		if(!start_new_leaf_page_for_bplus_tree_bulk_loader(bpbl_p, record, transaction_id, abort_error))
+			return 0;
+	}
+	else
+	{
+		// the record must come strictly after the last record appended
+		uint32_t tuple_count = get_tuple_count_on_persistent_page(&(bpbl_p->curr_leaf_page), bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+		const void* last_record = get_nth_tuple_on_persistent_page(&(bpbl_p->curr_leaf_page), bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), tuple_count - 1);
+		if(bpttd_p->key_comparator(record, bpttd_p->record_def, bpttd_p->key_element_ids, last_record, bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count) <= 0)
+			return 0;
+	}
+
+	if(append_tuple_on_persistent_page(bpbl_p->pmm_p, transaction_id, &(bpbl_p->curr_leaf_page), bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), record, abort_error))
+		return 1;
+	if(*abort_error)
+		return 0;
+
+	// the curr_leaf_page is full, the record goes to a new leaf page, it will surely fit there
+	if(!start_new_leaf_page_for_bplus_tree_bulk_loader(bpbl_p, record, transaction_id, abort_error))
+		return 0;
+
+	append_tuple_on_persistent_page(bpbl_p->pmm_p, transaction_id, &(bpbl_p->curr_leaf_page), bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), record, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+// builds one interior level (at level) over the pages of the index_entries, packing each of the interior pages full
+// the index_entries are then replaced by the index_entries of the interior pages built
+static int build_interior_level_for_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, uint32_t level, const void* transaction_id, int* abort_error)
+{
+	const bplus_tree_tuple_defs* bpttd_p = bpbl_p->bpttd_p;
+
+	void* parent_index_entries = NULL;
+	uint64_t parent_index_entries_count = 0;
+	uint64_t parent_index_entries_capacity = 0;
+
+	persistent_page curr_page = get_NULL_persistent_page(bpbl_p->pam_p);
+
+	for(uint64_t i = 0; i < bpbl_p->index_entries_count; i++)
+	{
+		const void* index_entry = get_index_entry_of_bplus_tree_bulk_loader(bpbl_p->index_entries, i, bpttd_p);
+
+		if(!is_persistent_page_NULL(&curr_page, bpbl_p->pam_p))
+		{
+			if(append_tuple_on_persistent_page(bpbl_p->pmm_p, transaction_id, &curr_page, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def), index_entry, abort_error))
+				continue;
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			// curr_page is full, and it is not the last page of the level
+			release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+
+		// start a new interior page, with the child of this index_entry as its least_keys_page_id, and this index_entry moves up to the parent level
+		curr_page = get_new_page_for_bplus_tree_bulk_loader(bpbl_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		init_bplus_tree_interior_page(&curr_page, level, 0, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		bplus_tree_interior_page_header hdr = get_bplus_tree_interior_page_header(&curr_page, bpttd_p);
+		hdr.least_keys_page_id = get_child_page_id_from_index_tuple(index_entry, bpttd_p);
+		set_bplus_tree_interior_page_header(&curr_page, &hdr, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		append_index_entry_for_bplus_tree_bulk_loader(&parent_index_entries, &parent_index_entries_count, &parent_index_entries_capacity, index_entry, curr_page.page_id, bpttd_p);
+	}
+
+	// the page built last, is the last page of the level
+	{
+		bplus_tree_interior_page_header hdr = get_bplus_tree_interior_page_header(&curr_page, bpttd_p);
+		hdr.is_last_page_of_level = 1;
+		set_bplus_tree_interior_page_header(&curr_page, &hdr, bpttd_p, bpbl_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	free(bpbl_p->index_entries);
+	bpbl_p->index_entries = parent_index_entries;
+	bpbl_p->index_entries_count = parent_index_entries_count;
+	bpbl_p->index_entries_capacity = parent_index_entries_capacity;
+
+	return 1;
+
+	ABORT_ERROR:;
+	if(!is_persistent_page_NULL(&curr_page, bpbl_p->pam_p))
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+	free(parent_index_entries);
+	return 0;
+}
+
+uint64_t finish_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error)
+{
+	const bplus_tree_tuple_defs* bpttd_p = bpbl_p->bpttd_p;
+
+	// no records were appended, so build an empty bplus_tree
+	if(is_persistent_page_NULL(&(bpbl_p->curr_leaf_page), bpbl_p->pam_p))
+		return get_new_bplus_tree(bpttd_p, bpbl_p->pam_p, bpbl_p->pmm_p, transaction_id, abort_error);
+
+	release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &(bpbl_p->curr_leaf_page), NONE_OPTION, abort_error);
+	if(*abort_error)
+		return bpttd_p->pas_p->NULL_PAGE_ID;
+
+	// keep building levels, until a level has only 1 page, that is the root
+	for(uint32_t level = 1; bpbl_p->index_entries_count > 1; level++)
+	{
+		if(!build_interior_level_for_bplus_tree_bulk_loader(bpbl_p, level, transaction_id, abort_error))
+			return bpttd_p->pas_p->NULL_PAGE_ID;
+	}
+
+	return get_child_page_id_from_index_tuple(get_index_entry_of_bplus_tree_bulk_loader(bpbl_p->index_entries, 0, bpttd_p), bpttd_p);
+}
+
+void discard_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error)
+{
+	if(!is_persistent_page_NULL(&(bpbl_p->curr_leaf_page), bpbl_p->pam_p))
+	{
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &(bpbl_p->curr_leaf_page), NONE_OPTION, abort_error);
+		if(*abort_error)
+			return;
+	}
+
+	// no one else knows about these pages, so they can be freed in any order
+	for(uint64_t i = 0; i < bpbl_p->allocated_page_ids_count; i++)
+	{
+		persistent_page ppage = acquire_persistent_page_with_lock(bpbl_p->pam_p, transaction_id, bpbl_p->allocated_page_ids[i], WRITE_LOCK, abort_error);
+		if(*abort_error)
+			return;
+
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &ppage, FREE_PAGE, abort_error);
+		if(*abort_error)
+		{
+			release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &ppage, NONE_OPTION, abort_error);
+			return;
+		}
+	}
+	bpbl_p->allocated_page_ids_count = 0;
+}
+
+void deinitialize_bplus_tree_bulk_loader(bplus_tree_bulk_loader* bpbl_p, const void* transaction_id, int* abort_error)
+{
+	if(!is_persistent_page_NULL(&(bpbl_p->curr_leaf_page), bpbl_p->pam_p))
+		release_lock_on_persistent_page(bpbl_p->pam_p, transaction_id, &(bpbl_p->curr_leaf_page), NONE_OPTION, abort_error);
+
+	free(bpbl_p->index_entries);
+	free(bpbl_p->allocated_page_ids);
+}
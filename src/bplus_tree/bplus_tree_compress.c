@@ -0,0 +1,92 @@
+#include<bplus_tree.h>
+
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_page_header.h>
+#include<bplus_tree_leaf_page_header.h>
+
+#include<persistent_page_functions.h>
+
+uint64_t compress_cold_leaf_pages_of_bplus_tree(uint64_t root_page_id, uint64_t cold_after_modifications_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// this is an optional method of the pam, without it no page can be compressed
+	if(pam_p->compress_page == NULL)
+		return 0;
+
+	uint64_t leaf_pages_compressed = 0;
+
+	// get lock on the root page of the bplus_tree
+	persistent_page curr_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, READ_LOCK, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// walk down to the first leaf page, always taking the least keys child
+	while(!is_bplus_tree_leaf_page(&curr_page, bpttd_p))
+	{
+		uint64_t child_page_id = get_child_page_id_by_child_index(&curr_page, ALL_LEAST_KEYS_CHILD_INDEX, bpttd_p);
+		persistent_page child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_page_id, READ_LOCK, abort_error);
+		if(*abort_error)
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+			return 0;
+		}
+
+		// we only need to hold lock on the child page from here on
+		release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &child_page, NONE_OPTION, abort_error);
+			return 0;
+		}
+		curr_page = child_page;
+	}
+
+	// the root page is never compressed, it is locked by every operation on the bplus_tree
+	int is_root_page = (curr_page.page_id == root_page_id);
+
+	while(1)
+	{
+		uint64_t next_page_id = get_next_page_id_of_bplus_tree_leaf_page(&curr_page, bpttd_p);
+
+		// lock the next leaf page, before releasing the lock on the current one, so that the walk stays on the leaf pages of this bplus_tree
+		persistent_page next_page = get_NULL_persistent_page(pam_p);
+		if(next_page_id != bpttd_p->pas_p->NULL_PAGE_ID)
+		{
+			next_page = acquire_persistent_page_with_lock(pam_p, transaction_id, next_page_id, READ_LOCK, abort_error);
+			if(*abort_error)
+			{
+				release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+				return leaf_pages_compressed;
+			}
+		}
+
+		uint64_t curr_page_id = curr_page.page_id;
+		release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+		{
+			if(!is_persistent_page_NULL(&next_page, pam_p))
+				release_lock_on_persistent_page(pam_p, transaction_id, &next_page, NONE_OPTION, abort_error);
+			return leaf_pages_compressed;
+		}
+
+		// the page may have been modified (or even freed) since we released our lock on it, the pam only compresses it if it is still cold and unlocked
+		// and the codec falls back to only stripping off the zero bytes, for a page it does not recognize as a leaf page of this bplus_tree
+		if(!is_root_page)
+		{
+			leaf_pages_compressed += compress_persistent_page(pam_p, transaction_id, curr_page_id, cold_after_modifications_count, &(bpttd_p->codec), abort_error);
+			if(*abort_error)
+			{
+				if(!is_persistent_page_NULL(&next_page, pam_p))
+					release_lock_on_persistent_page(pam_p, transaction_id, &next_page, NONE_OPTION, abort_error);
+				return leaf_pages_compressed;
+			}
+		}
+
+		if(is_persistent_page_NULL(&next_page, pam_p))
+			break;
+
+		curr_page = next_page;
+		is_root_page = 0;
+	}
+
+	return leaf_pages_compressed;
+}
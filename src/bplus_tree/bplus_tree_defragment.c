@@ -0,0 +1,385 @@
+#include<bplus_tree.h>
+
+#include<bplus_tree_walk_down.h>
+#include<bplus_tree_merge_util.h>
+#include<bplus_tree_leaf_page_util.h>
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_page_header.h>
+#include<bplus_tree_leaf_page_header.h>
+#include<bplus_tree_interior_page_header.h>
+#include<storage_capacity_page_util.h>
+#include<sorted_packed_page_util.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<invalid_tuple_indices.h>
+
+#include<stdlib.h>
+
+// walks down from the root page (locked in the locked_pages_stack) to the level = 1 page that leads to the key, WRITE_LOCKing all the pages on the way
+// just as walk_down_locking_parent_pages_for_merge() does, the locks above a page are released, if that page will not require a merge on losing the entry that we followed
+// so the level = 1 page at the top of the stack can later be merged, with its ancestors that would get merged along with it
+// key == NULL, walks down to the first level = 1 page
+// it returns 0 with an empty locked_pages_stack, if the root is a leaf page OR on an abort_error
+static int walk_down_locking_parent_pages_for_merge_up_to_level_1(locked_pages_stack* locked_pages_stack_p, const void* key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	while(1)
+	{
+		locked_page_info* curr_locked_page = get_top_of_locked_pages_stack(locked_pages_stack_p);
+
+		uint32_t level = get_level_of_bplus_tree_page(&(curr_locked_page->ppage), bpttd_p);
+
+		// there are no level = 1 pages to be found, this happens only if the root is a leaf page
+		if(level == 0)
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &(curr_locked_page->ppage), NONE_OPTION, abort_error);
+			pop_from_locked_pages_stack(locked_pages_stack_p);
+			return 0;
+		}
+
+		if(level == 1)
+			return 1;
+
+		// figure out which child page to go to next
+		curr_locked_page->child_index = (key == NULL) ? ALL_LEAST_KEYS_CHILD_INDEX : find_child_index_for_key(&(curr_locked_page->ppage), key, bpttd_p->key_element_count, bpttd_p);
+
+		// if the entry at child_index is deleted and that does not require the curr_locked_page to be merged, then release all locks above curr_locked_page
+		if(!may_require_merge_or_redistribution_for_delete_for_bplus_tree_interior_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, bpttd_p->index_def, curr_locked_page->child_index))
+		{
+			while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 1)
+			{
+				locked_page_info* bottom = get_bottom_of_locked_pages_stack(locked_pages_stack_p);
+				release_lock_on_persistent_page(pam_p, transaction_id, &(bottom->ppage), NONE_OPTION, abort_error);
+				pop_bottom_from_locked_pages_stack(locked_pages_stack_p);
+
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+		}
+
+		uint64_t child_page_id = get_child_page_id_by_child_index(&(curr_locked_page->ppage), curr_locked_page->child_index, bpttd_p);
+		persistent_page child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_page_id, WRITE_LOCK, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		push_to_locked_pages_stack(locked_pages_stack_p, &INIT_LOCKED_PAGE_INFO(child_page, INVALID_TUPLE_INDEX));
+	}
+
+	ABORT_ERROR :;
+	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
+	{
+		locked_page_info* bottom = get_bottom_of_locked_pages_stack(locked_pages_stack_p);
+		release_lock_on_persistent_page(pam_p, transaction_id, &(bottom->ppage), NONE_OPTION, abort_error);
+		pop_bottom_from_locked_pages_stack(locked_pages_stack_p);
+	}
+	return 0;
+}
+
+static int is_leaf_page_lesser_than_fill_percent(const persistent_page* ppage, uint32_t fill_percent, const bplus_tree_tuple_defs* bpttd_p)
+{
+	uint64_t space_occupied = get_space_occupied_by_all_tuples_on_persistent_page(ppage, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+	uint64_t space_allotted = get_space_allotted_to_all_tuples_on_persistent_page(ppage, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+	return (space_occupied * 100) < (space_allotted * fill_percent);
+}
+
+// releases lock on the ppage only if it is not NULL
+static void release_lock_if_not_NULL(persistent_page* ppage, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	if(!is_persistent_page_NULL(ppage, pam_p))
+		release_lock_on_persistent_page(pam_p, transaction_id, ppage, NONE_OPTION, abort_error);
+}
+
+// moves the contents of the curr_leaf_page (at child_index in the parent_page) to the new_leaf_page, and links the new_leaf_page in its place
+// the prev_leaf_page is the leaf page to the left of the curr_leaf_page, the next leaf page (if any) is WRITE_LOCKed and released by this function
+// on success, the curr_leaf_page is freed and the new_leaf_page becomes the curr_leaf_page
+// on an abort_error, the new_leaf_page is released and the curr_leaf_page is left as is, for the caller to release it
+static int relocate_leaf_page(persistent_page* parent_page, uint32_t child_index, persistent_page* prev_leaf_page, persistent_page* curr_leaf_page, persistent_page new_leaf_page, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	clone_persistent_page(pmm_p, transaction_id, &new_leaf_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), curr_leaf_page, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// link the new_leaf_page, in place of the curr_leaf_page, between its prev and next pages
+	{
+		bplus_tree_leaf_page_header prev_leaf_page_hdr = get_bplus_tree_leaf_page_header(prev_leaf_page, bpttd_p);
+		prev_leaf_page_hdr.next_page_id = new_leaf_page.page_id;
+		set_bplus_tree_leaf_page_header(prev_leaf_page, &prev_leaf_page_hdr, bpttd_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+	if(has_next_leaf_page(curr_leaf_page, bpttd_p))
+	{
+		// this is left to right order, so we can wait for this lock
+		persistent_page next_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_next_page_id_of_bplus_tree_leaf_page(curr_leaf_page, bpttd_p), WRITE_LOCK, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		bplus_tree_leaf_page_header next_page_hdr = get_bplus_tree_leaf_page_header(&next_page, bpttd_p);
+		next_page_hdr.prev_page_id = new_leaf_page.page_id;
+		set_bplus_tree_leaf_page_header(&next_page, &next_page_hdr, bpttd_p, pmm_p, transaction_id, abort_error);
+		release_lock_on_persistent_page(pam_p, transaction_id, &next_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	// point the parent_page to the new_leaf_page
+	if(child_index == ALL_LEAST_KEYS_CHILD_INDEX)
+	{
+		bplus_tree_interior_page_header parent_page_hdr = get_bplus_tree_interior_page_header(parent_page, bpttd_p);
+		parent_page_hdr.least_keys_page_id = new_leaf_page.page_id;
+		set_bplus_tree_interior_page_header(parent_page, &parent_page_hdr, bpttd_p, pmm_p, transaction_id, abort_error);
+	}
+	else
+	{
+		// since this update is to a fixed_length UINT type, it must either end in success OR in abort_error
+		// index def will always have (key_element_count + 1) number of elements, this last one at index key_element_count will always be the child_page_id
+		set_element_in_tuple_in_place_on_persistent_page(pmm_p, transaction_id, parent_page, bpttd_p->pas_p->page_size, bpttd_p->index_def,
+													child_index,
+													STATIC_POSITION(bpttd_p->key_element_count),
+													&((const user_value){.uint_value = new_leaf_page.page_id}),
+													abort_error);
+	}
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// free the curr_leaf_page, no one could have its page_id now, without having locked one of the pages that we hold
+	release_lock_on_persistent_page(pam_p, transaction_id, curr_leaf_page, FREE_PAGE, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	(*curr_leaf_page) = new_leaf_page;
+	return 1;
+
+	ABORT_ERROR:;
+	release_lock_on_persistent_page(pam_p, transaction_id, &new_leaf_page, NONE_OPTION, abort_error);
+	return 0;
+}
+
+int defragment_bplus_tree(uint64_t root_page_id, uint32_t target_fill_percent, uint64_t leaf_pages_budget, const void* from_key, void* resume_key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	target_fill_percent = min(target_fill_percent, 100);
+	leaf_pages_budget = max(leaf_pages_budget, 1);
+
+	// the key to walk down with, to reach the next leaf page to be defragmented, NULL implies the first leaf page
+	void* curr_key = NULL;
+	if(from_key != NULL)
+	{
+		curr_key = malloc(bpttd_p->max_index_record_size); // key would be no bigger than the max_index_record_size
+		if(curr_key == NULL)
+			exit(-1);
+		memory_move(curr_key, from_key, get_tuple_size(bpttd_p->key_def, from_key));
+	}
+
+	uint64_t leaf_pages_visited = 0;
+
+	// set if there are leaf pages beyond the curr_key, that are yet to be defragmented
+	int has_more = 0;
+
+	// all the pages that we may hold locks on, all of them are WRITE_LOCKed except the next_page, while looking for the key to resume from
+	// the level = 1 page is at the top of the locked_pages_stack, and below it are its ancestors that may need to be merged along with it
+	locked_pages_stack locked_pages_stack = ((locked_pages_stack){});
+	persistent_page prev_leaf_page = get_NULL_persistent_page(pam_p); // already defragmented leaf page, left to the curr_leaf_page
+	persistent_page curr_leaf_page = get_NULL_persistent_page(pam_p); // leaf page being defragmented
+	persistent_page next_page = get_NULL_persistent_page(pam_p); // page to the right of curr_leaf_page
+
+	// defragment leaf pages of one level = 1 page at a time, holding WRITE_LOCK on it, so that no inserts, deletes or updates could enter its children
+	while(1)
+	{
+		locked_pages_stack = initialize_locked_pages_stack_for_walk_down(root_page_id, WRITE_LOCK, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		int found_level_1_page = walk_down_locking_parent_pages_for_merge_up_to_level_1(&locked_pages_stack, curr_key, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// root is a leaf page, there is nothing to be defragmented
+		if(!found_level_1_page)
+		{
+			release_all_locks_and_deinitialize_stack_reenterable(&locked_pages_stack, pam_p, transaction_id, abort_error);
+			break;
+		}
+
+		// the stack is not pushed to or popped from, until we are done with this parent_page
+		persistent_page* parent_page = &(get_top_of_locked_pages_stack(&locked_pages_stack)->ppage);
+
+		uint32_t child_index = (curr_key == NULL) ? ALL_LEAST_KEYS_CHILD_INDEX : find_child_index_for_key(parent_page, curr_key, bpttd_p->key_element_count, bpttd_p);
+
+		// we need lock on the leaf page to the left of the curr_leaf_page, if we are to relocate the curr_leaf_page
+		if(child_index != ALL_LEAST_KEYS_CHILD_INDEX)
+		{
+			// it is a child of parent_page, we can safely lock it, before locking the curr_leaf_page (this is left to right order)
+			prev_leaf_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_child_page_id_by_child_index(parent_page, child_index - 1, bpttd_p), WRITE_LOCK, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+
+		curr_leaf_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_child_page_id_by_child_index(parent_page, child_index, bpttd_p), WRITE_LOCK, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		if(child_index == ALL_LEAST_KEYS_CHILD_INDEX && has_prev_leaf_page(&curr_leaf_page, bpttd_p))
+		{
+			// this one belongs to some other parent and lies to the left of the curr_leaf_page, so we only try to lock it
+			// on a failure, we just do not relocate the curr_leaf_page
+			prev_leaf_page = try_acquire_persistent_page_with_lock(pam_p, transaction_id, get_prev_page_id_of_bplus_tree_leaf_page(&curr_leaf_page, bpttd_p), WRITE_LOCK, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+
+		while(1)
+		{
+			leaf_pages_visited++;
+
+			uint32_t parent_tuple_count = get_tuple_count_on_persistent_page(parent_page, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def));
+
+			// merge the following leaf pages (with the same parent) into the curr_leaf_page, as long as it stays within the target_fill_percent
+			while(child_index + 1 < parent_tuple_count && is_leaf_page_lesser_than_fill_percent(&curr_leaf_page, target_fill_percent, bpttd_p))
+			{
+				// the next page is WRITE_LOCKed once, and the same lock is used to measure it and to merge it
+				next_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_child_page_id_by_child_index(parent_page, child_index + 1, bpttd_p), WRITE_LOCK, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				uint64_t space_occupied_after_merge = get_space_occupied_by_all_tuples_on_persistent_page(&curr_leaf_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def))
+													+ get_space_occupied_by_all_tuples_on_persistent_page(&next_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+				uint64_t space_allotted = get_space_allotted_to_all_tuples_on_persistent_page(&curr_leaf_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+
+				if((space_occupied_after_merge * 100) > (space_allotted * target_fill_percent))
+				{
+					release_lock_on_persistent_page(pam_p, transaction_id, &next_page, NONE_OPTION, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+					break;
+				}
+
+				// this releases (or frees) the next_page, in all cases
+				if(!merge_bplus_tree_leaf_pages_with_locked_next_page(&curr_leaf_page, &next_page, bpttd_p, pam_p, pmm_p, transaction_id, abort_error))
+				{
+					if(*abort_error)
+						goto ABORT_ERROR;
+					break;
+				}
+
+				// the merged page is gone, so delete its entry from the parent_page
+				delete_in_sorted_packed_page(parent_page, bpttd_p->pas_p->page_size, bpttd_p->index_def, child_index + 1, pmm_p, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				parent_tuple_count--;
+			}
+
+			// relocate the curr_leaf_page to a new page, if it lies before its prev page in the page id space
+			// the new page is asked for after the prev page, so that a scan over the leaf pages, visits them in the ascending order of their page_ids
+			if(!is_persistent_page_NULL(&prev_leaf_page, pam_p) && curr_leaf_page.page_id < prev_leaf_page.page_id)
+			{
+				persistent_page new_leaf_page = get_new_persistent_page_with_write_lock_after(pam_p, transaction_id, prev_leaf_page.page_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// a NULL new_leaf_page without an abort_error implies that there is no page after the prev_leaf_page to be had, so the curr_leaf_page stays where it is
+				if(!is_persistent_page_NULL(&new_leaf_page, pam_p))
+				{
+					relocate_leaf_page(parent_page, child_index, &prev_leaf_page, &curr_leaf_page, new_leaf_page, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+				}
+			}
+
+			// we are done with the children of this parent_page OR we have run out of the budget
+			if(child_index + 1 >= parent_tuple_count || leaf_pages_visited >= leaf_pages_budget)
+				break;
+
+			// move to the next child of the parent_page
+			next_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_child_page_id_by_child_index(parent_page, child_index + 1, bpttd_p), WRITE_LOCK, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			release_lock_if_not_NULL(&prev_leaf_page, pam_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			prev_leaf_page = curr_leaf_page;
+			curr_leaf_page = next_page;
+			next_page = get_NULL_persistent_page(pam_p);
+			child_index++;
+		}
+
+		release_lock_if_not_NULL(&prev_leaf_page, pam_p, transaction_id, abort_error);
+		prev_leaf_page = get_NULL_persistent_page(pam_p);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// the first key of the next leaf page is where we resume from
+		// it is read while we still hold lock on the curr_leaf_page, since it may be empty, we loop until we find a non empty leaf page
+		// the parent_page stays locked, this is still top to bottom and left to right order
+		has_more = 0;
+		while(has_next_leaf_page(&curr_leaf_page, bpttd_p))
+		{
+			next_page = acquire_persistent_page_with_lock(pam_p, transaction_id, get_next_page_id_of_bplus_tree_leaf_page(&curr_leaf_page, bpttd_p), READ_LOCK, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			release_lock_on_persistent_page(pam_p, transaction_id, &curr_leaf_page, NONE_OPTION, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			curr_leaf_page = next_page;
+			next_page = get_NULL_persistent_page(pam_p);
+
+			if(get_tuple_count_on_persistent_page(&curr_leaf_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def)) > 0)
+			{
+				if(curr_key == NULL)
+				{
+					curr_key = malloc(bpttd_p->max_index_record_size); // key would be no bigger than the max_index_record_size
+					if(curr_key == NULL)
+						exit(-1);
+				}
+				const void* first_record = get_nth_tuple_on_persistent_page(&curr_leaf_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), 0);
+				extract_key_from_record_tuple_using_bplus_tree_tuple_definitions(bpttd_p, first_record, curr_key);
+				has_more = 1;
+				break;
+			}
+		}
+		release_lock_on_persistent_page(pam_p, transaction_id, &curr_leaf_page, NONE_OPTION, abort_error);
+		curr_leaf_page = get_NULL_persistent_page(pam_p);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// the parent_page may have lost most of its entries to the merges above, so it is merged with its sibling, just as a delete would do it
+		// the merge then propagates up to its ancestors, and an empty root is collapsed into its only child
+		merge_interior_page_and_unlock_pages_up(root_page_id, &locked_pages_stack, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		release_all_locks_and_deinitialize_stack_reenterable(&locked_pages_stack, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		if(!has_more || leaf_pages_visited >= leaf_pages_budget)
+			break;
+	}
+
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	if(has_more)
+		memory_move(resume_key, curr_key, get_tuple_size(bpttd_p->key_def, curr_key));
+
+	if(curr_key != NULL)
+		free(curr_key);
+
+	return has_more;
+
+	ABORT_ERROR:;
+	release_lock_if_not_NULL(&next_page, pam_p, transaction_id, abort_error);
+	release_lock_if_not_NULL(&curr_leaf_page, pam_p, transaction_id, abort_error);
+	release_lock_if_not_NULL(&prev_leaf_page, pam_p, transaction_id, abort_error);
+	release_all_locks_and_deinitialize_stack_reenterable(&locked_pages_stack, pam_p, transaction_id, abort_error);
+
+	if(curr_key != NULL)
+		free(curr_key);
+
+	return 0;
+}
@@ -9,10 +9,11 @@ int delete_from_bplus_tree(uint64_t root_page_id, const void* key, const bplus_t
 {
 	int deleted = 0;
 
-	// create a locked_pages_stack
+	// create a locked_pages_stack, in memory on this call stack for any tree that is not taller than LOCKED_PAGES_STACK_INLINE_CAPACITY
+	locked_page_info locked_pages_stack_memory[LOCKED_PAGES_STACK_INLINE_CAPACITY];
 	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
 
-	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down(root_page_id, WRITE_LOCK, bpttd_p, pam_p, transaction_id, abort_error);
+	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down_with_memory(root_page_id, WRITE_LOCK, locked_pages_stack_memory, LOCKED_PAGES_STACK_INLINE_CAPACITY, bpttd_p, pam_p, transaction_id, abort_error);
 	if(*abort_error) // on abort no pages were kept locked
 		return 0;
 
@@ -28,7 +29,7 @@ int delete_from_bplus_tree(uint64_t root_page_id, const void* key, const bplus_t
 	// find index of last record that has the given key on the page
 	uint32_t found_index = find_last_in_sorted_packed_page(
 										&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
-										bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+										bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 										key, bpttd_p->key_def, NULL
 									);
 
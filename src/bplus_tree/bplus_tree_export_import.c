@@ -0,0 +1,278 @@
+#include<bplus_tree.h>
+
+#include<bplus_tree_bulk_loader.h>
+#include<bplus_tree_iterator.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<serial_int.h>
+
+#include<stdlib.h>
+
+/*
+	the export stream is :
+	[8 bytes magic][4 bytes version]
+	followed by blocks of :
+	[4 bytes payload_size][4 bytes tuple_count][8 bytes checksum of payload][payload]
+	where the payload is tuple_count records each prefixed by its 4 byte size, all integers are serialized with serialize_uint*
+	and it ends with a block that has payload_size = 0 and tuple_count = 0
+*/
+
+static const char EXPORT_STREAM_MAGIC[8] = "TIBPTREE";
+
+#define EXPORT_STREAM_VERSION 1
+
+#define EXPORT_STREAM_HEADER_SIZE (sizeof(EXPORT_STREAM_MAGIC) + 4)
+
+#define EXPORT_BLOCK_HEADER_SIZE 16
+
+// a block is written out, once its payload grows to this size
+#define EXPORT_BLOCK_PAYLOAD_SIZE (UINT32_C(64) * 1024)
+
+// the importer refuses blocks larger than this, to not malloc arbitrary sizes read from a corrupt stream
+#define MAX_IMPORT_BLOCK_PAYLOAD_SIZE (UINT32_C(64) * 1024 * 1024)
+
+// FNV-1a over the payload of a block
+static uint64_t get_checksum_for_export_block(const void* payload, uint32_t payload_size)
+{
+	uint64_t checksum = UINT64_C(14695981039346656037);
+	for(uint32_t i = 0; i < payload_size; i++)
+	{
+		checksum ^= ((const unsigned char*)payload)[i];
+		checksum *= UINT64_C(1099511628211);
+	}
+	return checksum;
+}
+
+// writes the block header and the payload, it returns 0 if the writer fails
+static int write_export_block(const bplus_tree_export_writer* bptew_p, const void* payload, uint32_t payload_size, uint32_t tuple_count)
+{
+	char block_header[EXPORT_BLOCK_HEADER_SIZE];
+	serialize_uint32(block_header, 4, payload_size);
+	serialize_uint32(block_header + 4, 4, tuple_count);
+	serialize_uint64(block_header + 8, 8, get_checksum_for_export_block(payload, payload_size));
+
+	if(!bptew_p->write(bptew_p->context, block_header, EXPORT_BLOCK_HEADER_SIZE))
+		return 0;
+
+	if(payload_size > 0 && !bptew_p->write(bptew_p->context, payload, payload_size))
+		return 0;
+
+	return 1;
+}
+
+int export_bplus_tree(uint64_t root_page_id, const bplus_tree_export_writer* bptew_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	{
+		char stream_header[EXPORT_STREAM_HEADER_SIZE];
+		memory_move(stream_header, EXPORT_STREAM_MAGIC, sizeof(EXPORT_STREAM_MAGIC));
+		serialize_uint32(stream_header + sizeof(EXPORT_STREAM_MAGIC), 4, EXPORT_STREAM_VERSION);
+		if(!bptew_p->write(bptew_p->context, stream_header, EXPORT_STREAM_HEADER_SIZE))
+			return 0;
+	}
+
+	// a read-only scan over all the records of the bplus_tree, in the order of their keys
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	int result = 0;
+
+	// the payload is only written out between the leaf pages, so it may grow past EXPORT_BLOCK_PAYLOAD_SIZE by the records of a leaf page
+	uint32_t payload_capacity = EXPORT_BLOCK_PAYLOAD_SIZE + 4 + bpttd_p->max_record_size;
+	void* payload = malloc(payload_capacity);
+	if(payload == NULL)
+		exit(-1);
+	uint32_t payload_size = 0;
+	uint32_t tuple_count = 0;
+
+	// the key of the last record exported, to reposition the scan after a block is written
+	void* last_key = malloc(bpttd_p->max_index_record_size);
+	if(last_key == NULL)
+		exit(-1);
+
+	const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+	while(record != NULL)
+	{
+		// copy out the rest of the current leaf page into the payload
+		uint32_t leaf_tuple_count = get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+		while(1)
+		{
+			uint32_t record_size = get_tuple_size(bpttd_p->record_def, record);
+			if(payload_size + 4 + record_size > payload_capacity)
+			{
+				payload_capacity = 2 * (payload_size + 4 + record_size);
+				payload = realloc(payload, payload_capacity);
+				if(payload == NULL)
+					exit(-1);
+			}
+			serialize_uint32(payload + payload_size, 4, record_size);
+			memory_move(payload + payload_size + 4, record, record_size);
+			payload_size += (4 + record_size);
+			tuple_count++;
+
+			// the next_bplus_tree_iterator call below, moves to the next leaf page
+			if(bpi_p->curr_tuple_index + 1 >= leaf_tuple_count)
+				break;
+
+			next_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+
+			record = get_tuple_bplus_tree_iterator(bpi_p);
+		}
+
+		if(payload_size >= EXPORT_BLOCK_PAYLOAD_SIZE)
+		{
+			// the bptew_p may be slow (a file or a socket), so release the lock on the leaf page before writing the block
+			// and then reposition the scan just past the last record exported
+			extract_key_from_record_tuple_using_bplus_tree_tuple_definitions(bpttd_p, record, last_key);
+
+			delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+			bpi_p = NULL;
+			if(*abort_error)
+				goto EXIT;
+
+			if(!write_export_block(bptew_p, payload, payload_size, tuple_count))
+				goto EXIT;
+			payload_size = 0;
+			tuple_count = 0;
+
+			bpi_p = find_in_bplus_tree(root_page_id, last_key, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+		else
+		{
+			if(!next_bplus_tree_iterator(bpi_p, transaction_id, abort_error))
+				break;
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		record = get_tuple_bplus_tree_iterator(bpi_p);
+	}
+	if(*abort_error)
+		goto EXIT;
+
+	// release the locks, before the last writes
+	delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+	bpi_p = NULL;
+	if(*abort_error)
+		goto EXIT;
+
+	if(tuple_count > 0 && !write_export_block(bptew_p, payload, payload_size, tuple_count))
+		goto EXIT;
+
+	// the terminating empty block
+	if(!write_export_block(bptew_p, NULL, 0, 0))
+		goto EXIT;
+
+	result = 1;
+
+	EXIT:;
+	if(bpi_p != NULL)
+		delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+	free(last_key);
+	free(payload);
+
+	if(*abort_error)
+		return 0;
+
+	return result;
+}
+
+uint64_t import_bplus_tree(const bplus_tree_import_reader* bptir_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	{
+		char stream_header[EXPORT_STREAM_HEADER_SIZE];
+		if(!bptir_p->read(bptir_p->context, stream_header, EXPORT_STREAM_HEADER_SIZE))
+			return bpttd_p->pas_p->NULL_PAGE_ID;
+		if(memory_compare(stream_header, EXPORT_STREAM_MAGIC, sizeof(EXPORT_STREAM_MAGIC)) != 0 || deserialize_uint32(stream_header + sizeof(EXPORT_STREAM_MAGIC), 4) != EXPORT_STREAM_VERSION)
+			return bpttd_p->pas_p->NULL_PAGE_ID;
+	}
+
+	bplus_tree_bulk_loader bpbl;
+	initialize_bplus_tree_bulk_loader(&bpbl, bpttd_p, pam_p, pmm_p);
+
+	uint64_t root_page_id = bpttd_p->pas_p->NULL_PAGE_ID;
+
+	void* payload = NULL;
+	uint32_t payload_capacity = 0;
+
+	while(1)
+	{
+		char block_header[EXPORT_BLOCK_HEADER_SIZE];
+		if(!bptir_p->read(bptir_p->context, block_header, EXPORT_BLOCK_HEADER_SIZE))
+			goto FORMAT_ERROR;
+
+		uint32_t payload_size = deserialize_uint32(block_header, 4);
+		uint32_t tuple_count = deserialize_uint32(block_header + 4, 4);
+		uint64_t checksum = deserialize_uint64(block_header + 8, 8);
+
+		// the terminating empty block
+		if(payload_size == 0 && tuple_count == 0)
+			break;
+
+		if(payload_size > MAX_IMPORT_BLOCK_PAYLOAD_SIZE)
+			goto FORMAT_ERROR;
+
+		if(payload_size > payload_capacity)
+		{
+			payload_capacity = payload_size;
+			payload = realloc(payload, payload_capacity);
+			if(payload == NULL)
+				exit(-1);
+		}
+
+		if(!bptir_p->read(bptir_p->context, payload, payload_size))
+			goto FORMAT_ERROR;
+
+		if(checksum != get_checksum_for_export_block(payload, payload_size))
+			goto FORMAT_ERROR;
+
+		uint32_t offset = 0;
+		for(uint32_t i = 0; i < tuple_count; i++)
+		{
+			if(payload_size - offset < 4)
+				goto FORMAT_ERROR;
+			uint32_t record_size = deserialize_uint32(payload + offset, 4);
+			offset += 4;
+
+			// the size prefix must be the true size of the record it prefixes
+			if(record_size > payload_size - offset || record_size < get_minimum_tuple_size(bpttd_p->record_def) || record_size > bpttd_p->max_record_size)
+				goto FORMAT_ERROR;
+			const void* record = payload + offset;
+			if(get_tuple_size(bpttd_p->record_def, record) != record_size)
+				goto FORMAT_ERROR;
+			offset += record_size;
+
+			// fails for the records that do not fit this bplus_tree OR that are not in the strictly ascending order of their keys
+			if(!append_record_to_bplus_tree_bulk_loader(&bpbl, record, transaction_id, abort_error))
+			{
+				if(*abort_error)
+					goto EXIT;
+				goto FORMAT_ERROR;
+			}
+		}
+
+		if(offset != payload_size)
+			goto FORMAT_ERROR;
+	}
+
+	root_page_id = finish_bplus_tree_bulk_loader(&bpbl, transaction_id, abort_error);
+	goto EXIT;
+
+	FORMAT_ERROR:;
+	discard_bplus_tree_bulk_loader(&bpbl, transaction_id, abort_error);
+
+	EXIT:;
+	deinitialize_bplus_tree_bulk_loader(&bpbl, transaction_id, abort_error);
+	free(payload);
+
+	if(*abort_error)
+		return bpttd_p->pas_p->NULL_PAGE_ID;
+
+	return root_page_id;
+}
@@ -4,6 +4,9 @@
 #include<bplus_tree_split_insert_util.h>
 #include<persistent_page_functions.h>
 #include<sorted_packed_page_util.h>
+#include<merge_sort.h>
+
+#include<stdlib.h>
 
 int insert_in_bplus_tree(uint64_t root_page_id, const void* record, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
 {
@@ -12,10 +15,11 @@ int insert_in_bplus_tree(uint64_t root_page_id, const void* record, const bplus_
 	if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(bpttd_p, record))
 		return 0;
 
-	// create a locked_pages_stack
+	// create a locked_pages_stack, in memory on this call stack for any tree that is not taller than LOCKED_PAGES_STACK_INLINE_CAPACITY
+	locked_page_info locked_pages_stack_memory[LOCKED_PAGES_STACK_INLINE_CAPACITY];
 	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
 
-	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down(root_page_id, WRITE_LOCK, bpttd_p, pam_p, transaction_id, abort_error);
+	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down_with_memory(root_page_id, WRITE_LOCK, locked_pages_stack_memory, LOCKED_PAGES_STACK_INLINE_CAPACITY, bpttd_p, pam_p, transaction_id, abort_error);
 	if(*abort_error) // on abort no pages were kept locked
 		return 0;
 
@@ -30,7 +34,7 @@ int insert_in_bplus_tree(uint64_t root_page_id, const void* record, const bplus_
 	// find index of last record that has the matching key on the page
 	uint32_t found_index = find_last_in_sorted_packed_page(
 										&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
-										bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+										bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 										record, bpttd_p->record_def, bpttd_p->key_element_ids
 									);
 
@@ -49,4 +53,201 @@ int insert_in_bplus_tree(uint64_t root_page_id, const void* record, const bplus_
 		return 0;
 
 	return inserted;
-}
\ No newline at end of file
+}
+
+// compares the records at r1_p and r2_p (pointers to the records in the batch) by their keys
+static int compare_records_by_keys(const void* context, const void* r1_p, const void* r2_p)
+{
+	const bplus_tree_tuple_defs* bpttd_p = context;
+	return bpttd_p->key_comparator(*((const void* const*)r1_p), bpttd_p->record_def, bpttd_p->key_element_ids, *((const void* const*)r2_p), bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count);
+}
+
+// inserts the batch of records, leaf page by leaf page, if replace_existing is set, then the records with the keys that already exist in the bplus_tree replace the existing ones
+static uint32_t insert_or_replace_batch_in_bplus_tree(uint64_t root_page_id, const void** records, uint32_t records_count, int replace_existing, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(records_count == 0)
+		return 0;
+
+	// sort the records, so that all the records that go to a leaf page are consecutive in the batch
+	{
+		const void** temp = malloc(sizeof(void*) * records_count);
+		if(temp == NULL)
+			exit(-1);
+		merge_sort_elements(records, temp, records_count, sizeof(const void*), bpttd_p, compare_records_by_keys);
+		free(temp);
+	}
+
+	uint32_t inserted_count = 0;
+
+	// upper fence of the leaf page that we walked down to, it is an index entry, so it is no bigger than the max_index_record_size
+	void* upper_fence = malloc(bpttd_p->max_index_record_size);
+	if(upper_fence == NULL)
+		exit(-1);
+	int has_upper_fence = 0;
+
+	// create a locked_pages_stack, in memory on this call stack for any tree that is not taller than LOCKED_PAGES_STACK_INLINE_CAPACITY
+	locked_page_info locked_pages_stack_memory[LOCKED_PAGES_STACK_INLINE_CAPACITY];
+	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
+
+	uint32_t i = 0;
+	while(i < records_count)
+	{
+		// skip the records that can not be inserted, without walking down for them
+		if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(bpttd_p, records[i]))
+		{
+			i++;
+			continue;
+		}
+
+		(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down_with_memory(root_page_id, WRITE_LOCK, locked_pages_stack_memory, LOCKED_PAGES_STACK_INLINE_CAPACITY, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error) // on abort no pages were kept locked
+		{
+			free(upper_fence);
+			return 0;
+		}
+
+		// walk down once for the leaf page of records[i], locking the parent pages that a split of this leaf page may need
+		// also fetching the upper fence of the leaf page, as the parent pages may not stay locked
+		walk_down_locking_parent_pages_for_split_insert_with_upper_fence(locked_pages_stack_p, records[i], 0, upper_fence, &has_upper_fence, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		// this has to be a leaf page
+		locked_page_info* curr_locked_page = get_top_of_locked_pages_stack(locked_pages_stack_p);
+
+		// insert all the following records in the key range of this leaf page, while they fit in it
+		// the records are sorted, so they are never lesser than the records[i] that we walked down with
+		for(int is_first_record_for_leaf_page = 1; i < records_count; is_first_record_for_leaf_page = 0)
+		{
+			if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(bpttd_p, records[i]))
+			{
+				i++;
+				continue;
+			}
+
+			// the records at or beyond the upper fence belong to the following leaf pages, so walk down again for them
+			// the leaf page without an upper fence (the last leaf page) holds all the keys beyond the ones on it
+			// we hold WRITE_LOCK on the leaf page, so its key range can not shrink by a split, until we split it ourselves
+			if(!is_first_record_for_leaf_page && has_upper_fence)
+			{
+				if(bpttd_p->key_comparator(records[i], bpttd_p->record_def, bpttd_p->key_element_ids, upper_fence, bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count) >= 0)
+					break;
+			}
+
+			// find index of last record that has the matching key on the page, if found then this record (or its duplicate from the batch) is already there
+			uint32_t found_index = find_last_in_sorted_packed_page(
+												&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
+												bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
+												records[i], bpttd_p->record_def, bpttd_p->key_element_ids
+											);
+			if(NO_TUPLE_FOUND != found_index)
+			{
+				if(!replace_existing)
+				{
+					i++;
+					continue;
+				}
+
+				// the key is the same, so the record replacing it in place keeps the leaf page sorted
+				// this fails only if the record does not fit in place of the existing one
+				int updated = update_at_in_sorted_packed_page(
+												&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
+												bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
+												records[i],
+												found_index,
+												pmm_p,
+												transaction_id,
+												abort_error
+											);
+				if(*abort_error)
+					goto EXIT;
+
+				if(updated)
+				{
+					inserted_count++;
+					i++;
+					continue;
+				}
+
+				// only the records[i] that we walked down with, may split the leaf page, so walk down again for any other record
+				if(!is_first_record_for_leaf_page)
+					break;
+
+				// delete the existing record, and insert records[i] in its place just as a new record, splitting the leaf page if required
+				delete_in_sorted_packed_page(
+												&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
+												bpttd_p->record_def,
+												found_index,
+												pmm_p,
+												transaction_id,
+												abort_error
+											);
+				if(*abort_error)
+					goto EXIT;
+			}
+
+			uint32_t insertion_index = find_insertion_point_in_sorted_packed_page(
+												&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
+												bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
+												records[i]
+											);
+
+			// this fails only if the record does not fit on the leaf page
+			int inserted = insert_at_in_sorted_packed_page(
+												&(curr_locked_page->ppage), bpttd_p->pas_p->page_size,
+												bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
+												records[i],
+												insertion_index,
+												pmm_p,
+												transaction_id,
+												abort_error
+											);
+			if(*abort_error)
+				goto EXIT;
+
+			if(inserted)
+			{
+				inserted_count++;
+				i++;
+				continue;
+			}
+
+			// the walk down kept the parent pages locked, only if the records[i] it walked down with, required a split
+			// so any other record that does not fit, has to walk down again
+			if(!is_first_record_for_leaf_page)
+				break;
+
+			// the leaf page is full, split it using the parent pages that we locked for it, and then walk down again for the next record
+			inserted_count += split_insert_and_unlock_pages_up(root_page_id, locked_pages_stack_p, records[i], insertion_index, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+			i++;
+			break;
+		}
+
+		release_all_locks_and_deinitialize_stack_reenterable(locked_pages_stack_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+		{
+			free(upper_fence);
+			return 0;
+		}
+	}
+
+	free(upper_fence);
+	return inserted_count;
+
+	EXIT:;
+	release_all_locks_and_deinitialize_stack_reenterable(locked_pages_stack_p, pam_p, transaction_id, abort_error);
+	free(upper_fence);
+	return 0;
+}
+
+uint32_t insert_batch_in_bplus_tree(uint64_t root_page_id, const void** records, uint32_t records_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	return insert_or_replace_batch_in_bplus_tree(root_page_id, records, records_count, 0, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
+
+uint32_t upsert_batch_in_bplus_tree(uint64_t root_page_id, const void** records, uint32_t records_count, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	return insert_or_replace_batch_in_bplus_tree(root_page_id, records, records_count, 1, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
@@ -39,7 +39,7 @@ uint32_t find_child_index_for_key(const persistent_page* ppage, const void* key,
 	// find preceding equals in the interior pages, by comparing against all index entries
 	uint32_t child_index = find_preceding_equals_in_sorted_packed_page(
 										ppage, bpttd_p->pas_p->page_size,
-										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned,
+										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned, bpttd_p->key_comparator,
 										key, bpttd_p->key_def, NULL
 									);
 
@@ -51,7 +51,7 @@ uint32_t find_child_index_for_record(const persistent_page* ppage, const void* r
 	// find preceding equals in the interior pages, by comparing against all index entries
 	uint32_t child_index = find_preceding_equals_in_sorted_packed_page(
 										ppage, bpttd_p->pas_p->page_size,
-										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned,
+										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned, bpttd_p->key_comparator,
 										record, bpttd_p->record_def, bpttd_p->key_element_ids
 									);
 
@@ -75,7 +75,7 @@ uint32_t find_child_index_for_key_s_predecessor(const persistent_page* ppage, co
 	// find preceding in the interior pages, by comparing against all index entries
 	uint32_t child_index = find_preceding_in_sorted_packed_page(
 										ppage, bpttd_p->pas_p->page_size,
-										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned,
+										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned, bpttd_p->key_comparator,
 										key, bpttd_p->key_def, NULL
 									);
 
@@ -87,7 +87,7 @@ uint32_t find_child_index_for_record_s_predecessor(const persistent_page* ppage,
 	// find preceding in the interior pages, by comparing against all index entries
 	uint32_t child_index = find_preceding_in_sorted_packed_page(
 										ppage, bpttd_p->pas_p->page_size,
-										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned,
+										bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned, bpttd_p->key_comparator,
 										record, bpttd_p->record_def, bpttd_p->key_element_ids
 									);
 
@@ -200,7 +200,7 @@ int split_insert_bplus_tree_interior_page(persistent_page* page1, const void* tu
 	if(tuple_to_insert_at == NO_TUPLE_FOUND)
 		tuple_to_insert_at = find_insertion_point_in_sorted_packed_page(
 									page1, bpttd_p->pas_p->page_size, 
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert
 								);
 
@@ -281,7 +281,7 @@ int split_insert_bplus_tree_interior_page(persistent_page* page1, const void* tu
 	// copy all required tuples from the page1 to page2
 	insert_all_from_sorted_packed_page(
 									&page2, page1, bpttd_p->pas_p->page_size,
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuples_stay_in_page1, page1_tuple_count - 1,
 									pmm_p,
 									transaction_id,
@@ -316,7 +316,7 @@ int split_insert_bplus_tree_interior_page(persistent_page* page1, const void* tu
 		// insert the tuple_to_insert (the new tuple) at the desired index in the page1
 		insert_at_in_sorted_packed_page(
 									page1, bpttd_p->pas_p->page_size,
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert,
 									tuple_to_insert_at,
 									pmm_p,
@@ -335,7 +335,7 @@ int split_insert_bplus_tree_interior_page(persistent_page* page1, const void* tu
 		// insert the tuple_to_insert (the new tuple) at the desired index in the page2
 		insert_at_in_sorted_packed_page(
 									&page2, bpttd_p->pas_p->page_size,
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert,
 									tuple_to_insert_at - tuples_stay_in_page1,
 									pmm_p,
@@ -465,7 +465,7 @@ int merge_bplus_tree_interior_pages(persistent_page* page1, const void* separato
 	// insert separator_parent_tuple in the page1, at the end, we will call this separator_tuple
 	insert_at_in_sorted_packed_page(
 									page1, bpttd_p->pas_p->page_size, 
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									separator_parent_tuple, 
 									get_tuple_count_on_persistent_page(page1, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def)),
 									pmm_p,
@@ -497,7 +497,7 @@ int merge_bplus_tree_interior_pages(persistent_page* page1, const void* separato
 		// only if there are any tuples to move
 		insert_all_from_sorted_packed_page(
 									page1, page2, bpttd_p->pas_p->page_size, 
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									0, tuple_count_page2 - 1,
 									pmm_p,
 									transaction_id,
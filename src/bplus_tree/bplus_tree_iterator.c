@@ -6,6 +6,8 @@
 #include<bplus_tree_leaf_page_util.h>
 #include<bplus_tree_interior_page_util.h>
 #include<bplus_tree_walk_down.h>
+#include<sorted_packed_page_util.h>
+#include<positional_accessor_overlap.h>
 
 #include<stdlib.h>
 
@@ -81,32 +83,90 @@ static int can_goto_next_leaf_page(const bplus_tree_iterator* bpi_p)
 }
 
 // makes the iterator point to prev page of the curr_leaf_page
+// tuples_to_consider is set to the number of tuples (from the start) on the new curr_leaf_page, that precede the tuples we have already visited
 // this function releases all locks on an abort_error
 // on abort_error OR on reaching end, all page locks are released, and return value is 0
-static int goto_prev_leaf_page(bplus_tree_iterator* bpi_p, const void* transaction_id, int* abort_error)
+static int goto_prev_leaf_page(bplus_tree_iterator* bpi_p, uint32_t* tuples_to_consider, const void* transaction_id, int* abort_error)
 {
-	if(bpi_p->is_stacked == 0) // iterate forward using the prev_page pointer on the leaf
+	if(bpi_p->is_stacked == 0) // iterate backward using the prev_page pointer on the leaf
 	{
 		// get the prev_page_id
 		uint64_t prev_page_id = get_prev_page_id_of_bplus_tree_leaf_page(&(bpi_p->curr_page), bpi_p->bpttd_p);
 
 		// attempt to lock the prev_leaf_page
+		// the forward scans and splits lock the leaf pages from left to right, so we must not wait for the prev_leaf_page while holding the curr_page
+		// hence we only try to lock it without waiting
 		persistent_page prev_leaf_page = get_NULL_persistent_page(bpi_p->pam_p);
 		if(prev_page_id != bpi_p->bpttd_p->pas_p->NULL_PAGE_ID)
 		{
-			prev_leaf_page = acquire_persistent_page_with_lock(bpi_p->pam_p, transaction_id, prev_page_id, (is_writable_bplus_tree_iterator(bpi_p) ? WRITE_LOCK : READ_LOCK), abort_error);
+			prev_leaf_page = try_acquire_persistent_page_with_lock(bpi_p->pam_p, transaction_id, prev_page_id, (is_writable_bplus_tree_iterator(bpi_p) ? WRITE_LOCK : READ_LOCK), abort_error);
 			if(*abort_error)
 			{
 				release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(bpi_p->curr_page), NONE_OPTION, abort_error);
 				return 0;
 			}
+
+			// we could not lock the prev_leaf_page without waiting
+			// so remember the first key on the curr_page (our fence key), release the curr_page and walk down from the root to the leaf containing its predecessor
+			if(is_persistent_page_NULL(&prev_leaf_page, bpi_p->pam_p))
+			{
+				uint32_t curr_page_tuple_count = get_tuple_count_on_persistent_page(&(bpi_p->curr_page), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
+
+				// a valid leaf page has atleast a tuple, this condition is always true for a non-empty bplus_tree
+				// if not, we have no fence key to reposition with, so we can only wait for the prev_leaf_page
+				if(curr_page_tuple_count == 0)
+				{
+					prev_leaf_page = acquire_persistent_page_with_lock(bpi_p->pam_p, transaction_id, prev_page_id, (is_writable_bplus_tree_iterator(bpi_p) ? WRITE_LOCK : READ_LOCK), abort_error);
+					if(*abort_error)
+					{
+						release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(bpi_p->curr_page), NONE_OPTION, abort_error);
+						return 0;
+					}
+				}
+				else
+				{
+					void* fence_key = malloc(bpi_p->bpttd_p->max_index_record_size); // key would be no bigger than the max_index_record_size
+					if(fence_key == NULL)
+						exit(-1);
+					extract_key_from_record_tuple_using_bplus_tree_tuple_definitions(bpi_p->bpttd_p, get_nth_tuple_on_persistent_page(&(bpi_p->curr_page), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def), 0), fence_key);
+
+					// release lock on the curr_page
+					release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(bpi_p->curr_page), NONE_OPTION, abort_error);
+					if(*abort_error)
+					{
+						free(fence_key);
+						return 0;
+					}
+
+					// walk down to the leaf page that has the predecessor of the fence_key, this releases all its locks on an abort_error
+					bpi_p->curr_page = walk_down_for_iterator_using_key(bpi_p->root_page_id, fence_key, bpi_p->bpttd_p->key_element_count, LESSER_THAN, (is_writable_bplus_tree_iterator(bpi_p) ? WRITE_LOCK : READ_LOCK), bpi_p->bpttd_p, bpi_p->pam_p, transaction_id, abort_error);
+					if(*abort_error)
+					{
+						bpi_p->curr_page = get_NULL_persistent_page(bpi_p->pam_p);
+						free(fence_key);
+						return 0;
+					}
+
+					// the leaf page may have changed in the mean time, so only consider the tuples that are lesser than the fence_key
+					uint32_t preceding_tuple_index = find_preceding_in_sorted_packed_page(
+											&(bpi_p->curr_page), bpi_p->bpttd_p->pas_p->page_size,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count, bpi_p->bpttd_p->key_comparator,
+											fence_key, bpi_p->bpttd_p->key_def, NULL
+										);
+					(*tuples_to_consider) = (preceding_tuple_index != NO_TUPLE_FOUND) ? (preceding_tuple_index + 1) : 0;
+
+					free(fence_key);
+
+					return 1;
+				}
+			}
 		}
 
 		// release lock on the curr_page
 		release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(bpi_p->curr_page), NONE_OPTION, abort_error);
 		if(*abort_error)
 		{
-			// on an abort error release lock on next_leaf_page if it is not NULL
+			// on an abort error release lock on prev_leaf_page if it is not NULL
 			if(!is_persistent_page_NULL(&prev_leaf_page, bpi_p->pam_p))
 				release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &prev_leaf_page, NONE_OPTION, abort_error);
 			return 0;
@@ -115,11 +175,20 @@ static int goto_prev_leaf_page(bplus_tree_iterator* bpi_p, const void* transacti
 		// update the curr_page
 		bpi_p->curr_page = prev_leaf_page;
 
-		// goto_next was a success if next_leaf_page is not null
-		return !is_persistent_page_NULL(&(bpi_p->curr_page), bpi_p->pam_p);
+		// goto_prev was a success if prev_leaf_page is not null
+		if(is_persistent_page_NULL(&(bpi_p->curr_page), bpi_p->pam_p))
+			return 0;
+
+		(*tuples_to_consider) = get_tuple_count_on_persistent_page(&(bpi_p->curr_page), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
+		return 1;
+	}
+	else // iterate backward using the pointers on the parent pages that are stacked
+	{
+		int result = walk_down_prev_locking_parent_pages_for_stacked_iterator(&(bpi_p->lps), bpi_p->lock_type, bpi_p->bpttd_p, bpi_p->pam_p, transaction_id, abort_error);
+		if(result)
+			(*tuples_to_consider) = get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
+		return result;
 	}
-	else // iterate forward using the pointers on the parent pages that are stacked
-		return walk_down_prev_locking_parent_pages_for_stacked_iterator(&(bpi_p->lps), bpi_p->lock_type, bpi_p->bpttd_p, bpi_p->pam_p, transaction_id, abort_error);
 }
 
 // returns if the above function will succeed
@@ -283,6 +352,35 @@ const void* get_tuple_bplus_tree_iterator(bplus_tree_iterator* bpi_p)
 	return get_nth_tuple_on_persistent_page(curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def), bpi_p->curr_tuple_index);
 }
 
+uint32_t get_projected_batch_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const positional_accessor* element_ids, uint32_t element_count, user_value** columns, uint32_t max_tuples)
+{
+	persistent_page* curr_leaf_page = get_curr_leaf_page(bpi_p);
+	if(curr_leaf_page == NULL)
+		return 0;
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
+	if(bpi_p->curr_tuple_index >= tuple_count)
+		return 0;
+
+	uint32_t tuples_read = min(max_tuples, tuple_count - bpi_p->curr_tuple_index);
+
+	// fill one column at a time, so that each of the columns is written contiguously
+	for(uint32_t j = 0; j < element_count; j++)
+	{
+		for(uint32_t i = 0; i < tuples_read; i++)
+		{
+			const void* tuple = get_nth_tuple_on_persistent_page(curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def), bpi_p->curr_tuple_index + i);
+			get_value_from_element_from_tuple(&(columns[j][i]), bpi_p->bpttd_p->record_def, element_ids[j], tuple);
+		}
+	}
+
+	// point to the last tuple read
+	if(tuples_read > 0)
+		bpi_p->curr_tuple_index += (tuples_read - 1);
+
+	return tuples_read;
+}
+
 int prev_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* transaction_id, int* abort_error)
 {
 	// you can never go prev on an empty bplus_tree
@@ -309,23 +407,20 @@ int prev_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* transaction
 			break;
 
 		// iterate to prev leaf page
-		goto_prev_leaf_page(bpi_p, transaction_id, abort_error);
+		uint32_t tuples_to_consider = 0;
+		goto_prev_leaf_page(bpi_p, &tuples_to_consider, transaction_id, abort_error);
 		if(*abort_error)
 			return 0;
 
-		// get curr_leaf_page we are pointing to
-		persistent_page* curr_leaf_page = get_curr_leaf_page(bpi_p);
-
-		uint32_t curr_leaf_page_tuple_count = get_tuple_count_on_persistent_page(curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
-
 		// a valid page has atleast a tuple, this condition is always true for a non-empty bplus_tree
-		if(curr_leaf_page_tuple_count > 0)
+		// tuples_to_consider may only be lesser than the tuple_count of the page, if we had to walk down to reach the prev leaf page
+		if(tuples_to_consider > 0)
 		{
-			bpi_p->curr_tuple_index = curr_leaf_page_tuple_count - 1;
+			bpi_p->curr_tuple_index = tuples_to_consider - 1;
 			break;
 		}
-		else
-			bpi_p->curr_tuple_index = 0;
+		else // point to before the first tuple of this page, going next from here will take us to its first tuple
+			bpi_p->curr_tuple_index = -1;
 	}
 
 	return 1;
@@ -363,7 +458,6 @@ int narrow_down_range_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void
 	return narrow_down_range_for_stacked_iterator_using_keys(&(bpi_p->lps), key1, f_pos1, key2, f_pos2, key_element_count_concerned, bpi_p->bpttd_p, bpi_p->pam_p, transaction_id, abort_error);
 }
 
-#include<sorted_packed_page_util.h>
 #include<bplus_tree_split_insert_util.h>
 #include<bplus_tree_merge_util.h>
 
@@ -476,7 +570,7 @@ int update_at_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* tuple,
 		return 0;
 
 	// if the key of incomming tuple AND the key of curr_tuple does not match fail
-	if(0 != compare_tuples(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count))
+	if(0 != bpi_p->bpttd_p->key_comparator(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count))
 		return 0;
 
 	const uint32_t new_tuple_size = get_tuple_size(bpi_p->bpttd_p->record_def, tuple);
@@ -491,7 +585,7 @@ int update_at_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* tuple,
 		// this either succeeds or aborts
 		int updated = update_at_in_sorted_packed_page(
 									get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, 
-									bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count,
+									bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count, bpi_p->bpttd_p->key_comparator,
 									tuple, 
 									bpi_p->curr_tuple_index,
 									bpi_p->pmm_p,
@@ -524,7 +618,7 @@ int update_at_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* tuple,
 		{
 			update_at_in_sorted_packed_page(
 									get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, 
-									bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count,
+									bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count, bpi_p->bpttd_p->key_comparator,
 									tuple, 
 									bpi_p->curr_tuple_index,
 									bpi_p->pmm_p,
@@ -609,7 +703,7 @@ int insert_using_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* tup
 		// find index of last record that has the matching key on the page
 		uint32_t found_index = find_last_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size,
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, bpi_p->bpttd_p->key_element_count, bpi_p->bpttd_p->key_comparator,
 											tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids
 										);
 
@@ -678,20 +772,8 @@ int update_non_key_element_in_place_at_bplus_tree_iterator(bplus_tree_iterator*
 
 	// make sure that the element that the user is trying to update in place is not a key for the bplus_tree
 	// if you allow so, it could be a disaster
-	for(uint32_t i = 0; i < bpi_p->bpttd_p->key_element_count; i++)
-	{
-		int match = 1;
-		for(uint32_t j = 0; j < min(bpi_p->bpttd_p->key_element_ids[i].positions_length, element_index.positions_length); j++)
-		{
-			if(bpi_p->bpttd_p->key_element_ids[i].positions[j] != element_index.positions[j])
-			{
-				match = 0;
-				break;
-			}
-		}
-		if(match)
-			return 0;
-	}
+	if(is_overlapping_any_positional_accessor(bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_element_count, element_index))
+		return 0;
 
 	// get current leaf page that the bplus_tree_iterator is pointing to
 	persistent_page* curr_leaf_page = get_curr_leaf_page(bpi_p);
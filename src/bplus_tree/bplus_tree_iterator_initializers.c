@@ -4,6 +4,7 @@
 #include<bplus_tree_leaf_page_util.h>
 #include<bplus_tree_interior_page_util.h>
 #include<bplus_tree_walk_down.h>
+#include<bplus_tree_page_header.h>
 #include<sorted_packed_page_util.h>
 
 #include<persistent_page_functions.h>
@@ -16,9 +17,9 @@ static int compare_curr_tuple_with_key_OR_record(bplus_tree_iterator* bpi_p, con
 	const void* curr_tuple = get_tuple_bplus_tree_iterator(bpi_p);
 
 	if(is_key)
-		return compare_tuples(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, key_OR_record, bpi_p->bpttd_p->key_def, NULL, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned);
+		return bpi_p->bpttd_p->key_comparator(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, key_OR_record, bpi_p->bpttd_p->key_def, NULL, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned);
 	else
-		return compare_tuples(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned);
+		return bpi_p->bpttd_p->key_comparator(curr_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned);
 }
 
 // fails only on an abort_error
@@ -48,13 +49,13 @@ static int adjust_position_for_bplus_tree_iterator(bplus_tree_iterator* bpi_p, c
 				if(is_key)
 					bpi_p->curr_tuple_index = find_preceding_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->key_def, NULL
 										);
 				else
 					bpi_p->curr_tuple_index = find_preceding_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids
 										);
 
@@ -66,13 +67,13 @@ static int adjust_position_for_bplus_tree_iterator(bplus_tree_iterator* bpi_p, c
 				if(is_key)
 					bpi_p->curr_tuple_index = find_preceding_equals_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->key_def, NULL
 										);
 				else
 					bpi_p->curr_tuple_index = find_preceding_equals_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids
 										);
 
@@ -84,13 +85,13 @@ static int adjust_position_for_bplus_tree_iterator(bplus_tree_iterator* bpi_p, c
 				if(is_key)
 					bpi_p->curr_tuple_index = find_succeeding_equals_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->key_def, NULL
 										);
 				else
 					bpi_p->curr_tuple_index = find_succeeding_equals_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids
 										);
 
@@ -102,13 +103,13 @@ static int adjust_position_for_bplus_tree_iterator(bplus_tree_iterator* bpi_p, c
 				if(is_key)
 					bpi_p->curr_tuple_index = find_succeeding_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->key_def, NULL
 										);
 				else
 					bpi_p->curr_tuple_index = find_succeeding_in_sorted_packed_page(
 											curr_leaf_page, bpi_p->bpttd_p->pas_p->page_size, 
-											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned,
+											bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned, bpi_p->bpttd_p->key_comparator,
 											key_OR_record, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids
 										);
 
@@ -348,6 +349,219 @@ int initialize_bplus_tree_unstacked_iterator(bplus_tree_iterator* bpi_p, uint64_
 	return adjust_position_for_bplus_tree_iterator(bpi_p, key, 1, key_element_count_concerned, find_pos, transaction_id, abort_error);
 }
 
+// maximum number of leaf pages that an unstacked iterator may hop forward, (using the next page pointers), in search of the key to seek to, before it falls back to walking down from the root
+#define MAX_LEAF_HOPS_FOR_SEEK 3
+
+// compares the nth tuple on the curr_leaf_page of the iterator with the key
+static int compare_nth_tuple_with_key(bplus_tree_iterator* bpi_p, uint32_t n, const void* key, uint32_t key_element_count_concerned)
+{
+	const void* nth_tuple = get_nth_tuple_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def), n);
+	return bpi_p->bpttd_p->key_comparator(nth_tuple, bpi_p->bpttd_p->record_def, bpi_p->bpttd_p->key_element_ids, key, bpi_p->bpttd_p->key_def, NULL, bpi_p->bpttd_p->key_compare_direction, key_element_count_concerned);
+}
+
+// returns 1, if the tuple to be pointed to by the iterator after the seek, can not be on any of the leaf pages before the curr_leaf_page
+// the curr_leaf_page must have atleast 1 tuple
+static int is_seek_result_not_before_curr_leaf_page(bplus_tree_iterator* bpi_p, const void* key, uint32_t key_element_count_concerned, find_position find_pos)
+{
+	if(!has_prev_leaf_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p))
+		return 1;
+
+	int cmp = compare_nth_tuple_with_key(bpi_p, 0, key, key_element_count_concerned);
+	switch(find_pos)
+	{
+		case LESSER_THAN :
+		case GREATER_THAN_EQUALS :
+			return cmp < 0;
+		case LESSER_THAN_EQUALS :
+		case GREATER_THAN :
+			return cmp <= 0;
+		default :
+			return 0;
+	}
+}
+
+// returns 1, if the tuple to be pointed to by the iterator after the seek, can not be on any of the leaf pages after the curr_leaf_page
+// the curr_leaf_page must have atleast 1 tuple
+static int is_seek_result_not_after_curr_leaf_page(bplus_tree_iterator* bpi_p, const void* key, uint32_t key_element_count_concerned, find_position find_pos)
+{
+	if(!has_next_leaf_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p))
+		return 1;
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def));
+	int cmp = compare_nth_tuple_with_key(bpi_p, tuple_count - 1, key, key_element_count_concerned);
+	switch(find_pos)
+	{
+		case LESSER_THAN :
+		case GREATER_THAN_EQUALS :
+			return cmp >= 0;
+		case LESSER_THAN_EQUALS :
+		case GREATER_THAN :
+			return cmp > 0;
+		default :
+			return 0;
+	}
+}
+
+// attempts to reposition the unstacked iterator within the curr_leaf_page or the next few leaf pages
+// returns 1, if the iterator is now on the leaf page, from where adjust_position_for_bplus_tree_iterator() can find the tuple to point to, else it returns 0, and you must walk down from the root
+// on an abort_error, all locks are released
+static int seek_forward_using_leaf_pages(bplus_tree_iterator* bpi_p, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const void* transaction_id, int* abort_error)
+{
+	// MIN and MAX are never in the vicinity
+	if(find_pos == MIN || find_pos == MAX)
+		return 0;
+
+	// a valid leaf page has atleast a tuple, this condition is always true for a non-empty bplus_tree
+	if(0 == get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def)))
+		return 0;
+
+	// we can only go forward without violating the lock ordering, so the result must not be behind us
+	if(!is_seek_result_not_before_curr_leaf_page(bpi_p, key, key_element_count_concerned, find_pos))
+		return 0;
+
+	// hop forward, while the result may still be ahead of the curr_leaf_page
+	// the result is not on any of the leaf pages that we leave behind
+	// though for LESSER_THAN and LESSER_THAN_EQUALS, their tuples may still qualify the find_pos, the result is the last qualifying tuple and that lies further ahead
+	uint32_t leaf_hops = 0;
+	while(!is_seek_result_not_after_curr_leaf_page(bpi_p, key, key_element_count_concerned, find_pos))
+	{
+		if(leaf_hops == MAX_LEAF_HOPS_FOR_SEEK)
+			return 0;
+
+		// point to the last tuple of this page and go next, this takes us to the first tuple on the next non-empty leaf page
+		bpi_p->curr_tuple_index = get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def)) - 1;
+		next_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+		leaf_hops++;
+
+		// if we landed on an empty leaf page, then let the caller walk down
+		if(0 == get_tuple_count_on_persistent_page(get_curr_leaf_page(bpi_p), bpi_p->bpttd_p->pas_p->page_size, &(bpi_p->bpttd_p->record_def->size_def)))
+			return 0;
+	}
+
+	return 1;
+}
+
+// returns the child_index, that walk_down_locking_parent_pages_for_stacked_iterator() would follow for the interior page ppage
+static uint32_t get_child_index_to_follow_for_seek(const persistent_page* ppage, const materialized_key* mat_key, uint32_t key_element_count_concerned, find_position find_pos, const bplus_tree_tuple_defs* bpttd_p)
+{
+	switch(find_pos)
+	{
+		case MIN :
+			return ALL_LEAST_KEYS_CHILD_INDEX;
+		case LESSER_THAN_EQUALS :
+		case GREATER_THAN :
+			return find_child_index_for_mat_key(ppage, mat_key, key_element_count_concerned, bpttd_p);
+		case LESSER_THAN :
+		case GREATER_THAN_EQUALS :
+			return find_child_index_for_mat_key_s_predecessor(ppage, mat_key, key_element_count_concerned, bpttd_p);
+		case MAX :
+		default :
+			return get_tuple_count_on_persistent_page(ppage, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def)) - 1;
+	}
+}
+
+int seek_bplus_tree_iterator(bplus_tree_iterator* bpi_p, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const void* transaction_id, int* abort_error)
+{
+	// key must be provided for all find_pos except MIN and MAX
+	if(key == NULL && find_pos != MIN && find_pos != MAX)
+		return 0;
+
+	if(key_element_count_concerned == KEY_ELEMENT_COUNT)
+		key_element_count_concerned = bpi_p->bpttd_p->key_element_count;
+
+	if(!bpi_p->is_stacked)
+	{
+		// attempt to find the key in the vicinity of the curr_leaf_page
+		if(!is_persistent_page_NULL(&(bpi_p->curr_page), bpi_p->pam_p))
+		{
+			int found_in_vicinity = seek_forward_using_leaf_pages(bpi_p, key, key_element_count_concerned, find_pos, transaction_id, abort_error);
+			if(*abort_error)
+				return 0;
+
+			if(found_in_vicinity)
+				return adjust_position_for_bplus_tree_iterator(bpi_p, key, 1, key_element_count_concerned, find_pos, transaction_id, abort_error);
+
+			// release lock on the curr_page, we will be walking down from the root
+			release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(bpi_p->curr_page), NONE_OPTION, abort_error);
+			bpi_p->curr_page = get_NULL_persistent_page(bpi_p->pam_p);
+			if(*abort_error)
+				return 0;
+		}
+
+		// walk down from the root, this initialization will succeed, since it was initialized with the same parameters before
+		return initialize_bplus_tree_unstacked_iterator(bpi_p, bpi_p->root_page_id, key, key_element_count_concerned, find_pos, bpi_p->bpttd_p, bpi_p->pam_p, bpi_p->pmm_p, transaction_id, abort_error);
+	}
+	else
+	{
+		// we can walk down from a locked parent page, only if the root page is still locked by the iterator
+		if(get_element_count_locked_pages_stack(&(bpi_p->lps)) > 0 && get_bottom_of_locked_pages_stack(&(bpi_p->lps))->ppage.page_id == bpi_p->root_page_id)
+		{
+			materialized_key mat_key;
+			if(key != NULL)
+				mat_key = materialize_key_from_tuple(key, bpi_p->bpttd_p->key_def, NULL, key_element_count_concerned);
+			else
+				mat_key = (materialized_key){};
+
+			// find the lowest interior page in the stack, whose child_index to be followed changes
+			// all pages above it are not on the path to the key, while the ones below it, are
+			cy_uint pages_to_retain = get_element_count_locked_pages_stack(&(bpi_p->lps));
+			for(cy_uint i = 0; i < get_element_count_locked_pages_stack(&(bpi_p->lps)); i++)
+			{
+				locked_page_info* lpi = get_from_bottom_of_locked_pages_stack(&(bpi_p->lps), i);
+				if(is_bplus_tree_leaf_page(&(lpi->ppage), bpi_p->bpttd_p))
+					break;
+				if(lpi->child_index != get_child_index_to_follow_for_seek(&(lpi->ppage), &mat_key, key_element_count_concerned, find_pos, bpi_p->bpttd_p))
+				{
+					pages_to_retain = i + 1;
+					break;
+				}
+			}
+
+			destroy_materialized_key(&mat_key);
+
+			// release locks on all the pages above the pages_to_retain
+			while(get_element_count_locked_pages_stack(&(bpi_p->lps)) > pages_to_retain)
+			{
+				locked_page_info* top = get_top_of_locked_pages_stack(&(bpi_p->lps));
+				release_lock_on_persistent_page(bpi_p->pam_p, transaction_id, &(top->ppage), NONE_OPTION, abort_error);
+				pop_from_locked_pages_stack(&(bpi_p->lps));
+				if(*abort_error)
+				{
+					release_all_locks_and_deinitialize_stack_reenterable(&(bpi_p->lps), bpi_p->pam_p, transaction_id, abort_error);
+					return 0;
+				}
+			}
+
+			// walk down from the top of the stack, (this is a no-op if we are still at the same leaf)
+			walk_down_locking_parent_pages_for_stacked_iterator(&(bpi_p->lps), key, 1, key_element_count_concerned, find_pos, bpi_p->lock_type, bpi_p->bpttd_p, bpi_p->pam_p, transaction_id, abort_error);
+			if(*abort_error)
+			{
+				release_all_locks_and_deinitialize_stack_reenterable(&(bpi_p->lps), bpi_p->pam_p, transaction_id, abort_error);
+				return 0;
+			}
+
+			// adjust bplus_tree_iterator position
+			adjust_position_for_bplus_tree_iterator(bpi_p, key, 1, key_element_count_concerned, find_pos, transaction_id, abort_error);
+			if(*abort_error)
+			{
+				release_all_locks_and_deinitialize_stack_reenterable(&(bpi_p->lps), bpi_p->pam_p, transaction_id, abort_error);
+				return 0;
+			}
+
+			return 1;
+		}
+
+		// release all locks and walk down from the root, this initialization will succeed, since it was initialized with the same parameters before
+		release_all_locks_and_deinitialize_stack_reenterable(&(bpi_p->lps), bpi_p->pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		return initialize_bplus_tree_stacked_iterator_using_key(bpi_p, bpi_p->root_page_id, &((locked_pages_stack){}), key, key_element_count_concerned, find_pos, bpi_p->lock_type, bpi_p->bpttd_p, bpi_p->pam_p, bpi_p->pmm_p, transaction_id, abort_error);
+	}
+}
+
 #include<stdlib.h>
 
 bplus_tree_iterator* get_new_bplus_tree_stacked_iterator(uint64_t root_page_id, const void* key, uint32_t key_element_count_concerned, find_position find_pos, int lock_type, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
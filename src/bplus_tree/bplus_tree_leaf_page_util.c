@@ -398,7 +398,7 @@ int split_insert_bplus_tree_leaf_page(persistent_page* page1, const void* tuple_
 	if(tuple_to_insert_at == NO_TUPLE_FOUND)
 		tuple_to_insert_at = find_insertion_point_in_sorted_packed_page(
 									page1, bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert
 								);
 
@@ -533,7 +533,7 @@ int split_insert_bplus_tree_leaf_page(persistent_page* page1, const void* tuple_
 	// copy all required tuples from the page1 to page2
 	insert_all_from_sorted_packed_page(
 									&page2, page1, bpttd_p->pas_p->page_size,
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuples_stay_in_page1, page1_tuple_count - 1,
 									pmm_p,
 									transaction_id,
@@ -568,7 +568,7 @@ int split_insert_bplus_tree_leaf_page(persistent_page* page1, const void* tuple_
 		// insert the tuple_to_insert (the new tuple) at the desired index in the page1
 		insert_at_in_sorted_packed_page(
 									page1, bpttd_p->pas_p->page_size,
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert, 
 									tuple_to_insert_at,
 									pmm_p,
@@ -587,7 +587,7 @@ int split_insert_bplus_tree_leaf_page(persistent_page* page1, const void* tuple_
 		// insert the tuple_to_insert (the new tuple) at the desired index in the page2
 		insert_at_in_sorted_packed_page(
 									&page2, bpttd_p->pas_p->page_size,
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									tuple_to_insert,
 									tuple_to_insert_at - tuples_stay_in_page1,
 									pmm_p,
@@ -665,7 +665,16 @@ int merge_bplus_tree_leaf_pages(persistent_page* page1, const bplus_tree_tuple_d
 			return 0;
 	}
 
-	// check if a merge can be performed, and on failure release writer lock on page2, that we just acquired
+	return merge_bplus_tree_leaf_pages_with_locked_next_page(page1, &page2, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int merge_bplus_tree_leaf_pages_with_locked_next_page(persistent_page* page1, persistent_page* page2_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// this function always releases (or frees) the page2, so we work with a local copy of it
+	persistent_page page2 = (*page2_p);
+	(*page2_p) = get_NULL_persistent_page(pam_p);
+
+	// check if a merge can be performed, and on failure release writer lock on page2
 	if(!can_merge_bplus_tree_leaf_pages(page1, &page2, bpttd_p))
 	{
 		release_lock_on_persistent_page(pam_p, transaction_id, &page2, NONE_OPTION, abort_error);
@@ -761,7 +770,7 @@ int merge_bplus_tree_leaf_pages(persistent_page* page1, const bplus_tree_tuple_d
 		// only if there are any tuples to move
 		insert_all_from_sorted_packed_page(
 									page1, &page2, bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									0, tuple_count_page2 - 1,
 									pmm_p,
 									transaction_id,
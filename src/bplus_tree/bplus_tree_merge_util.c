@@ -8,13 +8,20 @@
 
 #include<persistent_page_functions.h>
 
-int merge_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+// common body of merge_and_unlock_pages_up() and merge_interior_page_and_unlock_pages_up()
+// if delete_in_top_page is not set, then the entry at the child_index of the top interior page is not deleted, all the interior pages below it still lose the entry of their merged child
+static int merge_and_unlock_pages_up_deleting_in_top_page(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, int delete_in_top_page, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
 {
+	int is_top_page = 1;
+
 	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
 	{
 		locked_page_info curr_locked_page = *get_top_of_locked_pages_stack(locked_pages_stack_p);
 		pop_from_locked_pages_stack(locked_pages_stack_p);
 
+		int delete_in_curr_page = delete_in_top_page || !is_top_page;
+		is_top_page = 0;
+
 		if(is_bplus_tree_leaf_page(&(curr_locked_page.ppage), bpttd_p))
 		{
 			// go ahead with merging only if the page is lesser than or equal to half full AND is not root
@@ -85,14 +92,15 @@ int merge_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_
 		else // check if the curr_locked_page needs to be merged, if yes then merge it with either previous or next page
 		{
 			// perform a delete operation on the found index in this page
-			delete_in_sorted_packed_page(
-								&(curr_locked_page.ppage), bpttd_p->pas_p->page_size,
-								bpttd_p->index_def,
-								curr_locked_page.child_index,
-								pmm_p,
-								transaction_id,
-								abort_error
-							);
+			if(delete_in_curr_page)
+				delete_in_sorted_packed_page(
+									&(curr_locked_page.ppage), bpttd_p->pas_p->page_size,
+									bpttd_p->index_def,
+									curr_locked_page.child_index,
+									pmm_p,
+									transaction_id,
+									abort_error
+								);
 
 			if(*abort_error)
 			{
@@ -274,4 +282,14 @@ int merge_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_
 	}
 
 	return 1;
+}
+
+int merge_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	return merge_and_unlock_pages_up_deleting_in_top_page(root_page_id, locked_pages_stack_p, 1, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int merge_interior_page_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack* locked_pages_stack_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	return merge_and_unlock_pages_up_deleting_in_top_page(root_page_id, locked_pages_stack_p, 0, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
 }
\ No newline at end of file
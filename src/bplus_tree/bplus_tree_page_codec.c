@@ -0,0 +1,403 @@
+#include<bplus_tree_page_codec.h>
+
+#include<persistent_page_functions.h>
+#include<common_page_header.h>
+#include<serial_int.h>
+
+#include<cutlery_stds.h>
+
+#include<stdlib.h>
+
+// first byte of the encoded page, tells if the tuples were xor-ed with their preceding tuples before encoding
+// and for a FRAME_OF_REFERENCE_PAGE, if their keys were taken out of them, to be stored as bit-packed deltas from the least key on the page
+#define PLAIN_PAGE              0
+#define TUPLE_DELTA_PAGE        1
+#define FRAME_OF_REFERENCE_PAGE 2
+
+// number of bytes of the page, described by 1 mask byte of the encoding
+#define BYTES_PER_MASK 8
+
+// stores the non zero bytes of the page, it returns 0, if the encoded buffer would grow beyond max_encoded_size
+static uint32_t encode_non_zero_bytes_in_page(const void* page, uint32_t page_size, void* encoded, uint32_t max_encoded_size)
+{
+	const uint8_t* page_bytes = page;
+	uint8_t* encoded_bytes = encoded;
+
+	uint32_t encoded_size = 0;
+	for(uint32_t group_start = 0; group_start < page_size; group_start += BYTES_PER_MASK)
+	{
+		uint32_t group_size = min(BYTES_PER_MASK, page_size - group_start);
+
+		uint8_t mask = 0;
+		uint32_t non_zero_bytes = 0;
+		for(uint32_t i = 0; i < group_size; i++)
+		{
+			if(page_bytes[group_start + i] != 0)
+			{
+				mask |= (1 << i);
+				non_zero_bytes++;
+			}
+		}
+
+		if(1 + non_zero_bytes > max_encoded_size - encoded_size)
+			return 0;
+
+		encoded_bytes[encoded_size++] = mask;
+		for(uint32_t i = 0; i < group_size; i++)
+			if(page_bytes[group_start + i] != 0)
+				encoded_bytes[encoded_size++] = page_bytes[group_start + i];
+	}
+
+	return encoded_size;
+}
+
+// returns the number of bytes of the encoded buffer, that it consumed
+static uint32_t decode_non_zero_bytes_in_page(void* page, uint32_t page_size, const void* encoded)
+{
+	uint8_t* page_bytes = page;
+	const uint8_t* encoded_bytes = encoded;
+
+	for(uint32_t group_start = 0; group_start < page_size; group_start += BYTES_PER_MASK)
+	{
+		uint32_t group_size = min(BYTES_PER_MASK, page_size - group_start);
+
+		uint8_t mask = *(encoded_bytes++);
+		for(uint32_t i = 0; i < group_size; i++)
+			page_bytes[group_start + i] = ((mask >> i) & 1) ? *(encoded_bytes++) : 0;
+	}
+
+	return encoded_bytes - ((const uint8_t*)encoded);
+}
+
+// returns the tuple_def of the tuples on the page, only if it is a bplus_tree page with fixed sized tuples, whose tuples all lie with in the page, else it returns NULL
+static const tuple_def* get_fixed_sized_tuple_def_for_page(const void* page, uint32_t page_size, const bplus_tree_tuple_defs* bpttd_p)
+{
+	const persistent_page ppage = {.page = (void*)page};
+
+	const tuple_def* tpl_def = NULL;
+	switch(get_type_of_page(&ppage, bpttd_p->pas_p))
+	{
+		case BPLUS_TREE_LEAF_PAGE :
+		{
+			tpl_def = bpttd_p->record_def;
+			break;
+		}
+		case BPLUS_TREE_INTERIOR_PAGE :
+		{
+			tpl_def = bpttd_p->index_def;
+			break;
+		}
+		default :
+			return NULL;
+	}
+
+	if(!is_fixed_sized_tuple_def(tpl_def))
+		return NULL;
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(&ppage, page_size, &(tpl_def->size_def));
+	if(tuple_count > get_maximum_tuple_count_on_persistent_page(get_page_header_size_persistent_page(&ppage, page_size), page_size, &(tpl_def->size_def)))
+		return NULL;
+
+	for(uint32_t i = 0; i < tuple_count; i++)
+	{
+		const void* tuple = get_nth_tuple_on_persistent_page(&ppage, page_size, &(tpl_def->size_def), i);
+		if(tuple != NULL && (tuple < page || (tuple - page) + tpl_def->size_def.size > page_size))
+			return NULL;
+	}
+
+	return tpl_def;
+}
+
+// xors every tuple on the page, with the tuple preceding it on the preceding_tuples_page (a page with the same layout)
+// the tuples are visited in the ascending order of their indices, so passing the same page, as both, undoes the xor of the tuples with their (original) preceding tuples
+// the NULL tuples, and the tuples preceded by a NULL tuple are left as is
+static void xor_tuples_with_preceding_tuples(void* page, const void* preceding_tuples_page, uint32_t page_size, const tuple_def* tpl_def)
+{
+	const persistent_page ppage = {.page = page};
+	const persistent_page preceding_tuples_ppage = {.page = (void*)preceding_tuples_page};
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(&ppage, page_size, &(tpl_def->size_def));
+	for(uint32_t i = 1; i < tuple_count; i++)
+	{
+		uint8_t* tuple = (uint8_t*) get_nth_tuple_on_persistent_page(&ppage, page_size, &(tpl_def->size_def), i);
+		const uint8_t* preceding_tuple = get_nth_tuple_on_persistent_page(&preceding_tuples_ppage, page_size, &(tpl_def->size_def), i - 1);
+		if(tuple == NULL || preceding_tuple == NULL)
+			continue;
+
+		for(uint32_t j = 0; j < tpl_def->size_def.size; j++)
+			tuple[j] ^= preceding_tuple[j];
+	}
+}
+
+// the keys of the leaf pages can be taken out as a frame of reference, only if the key is a single UINT or INT element
+// an INT key is stored as its two's complement bits, so its deltas from the least key (picked in the order of INT) fit in a uint64_t as well
+static int has_frame_of_reference_key(const bplus_tree_tuple_defs* bpttd_p)
+{
+	if(bpttd_p->key_element_count != 1)
+		return 0;
+
+	const data_type_info* key_dti = get_type_info_for_element_from_tuple_def(bpttd_p->record_def, bpttd_p->key_element_ids[0]);
+	return key_dti->type == UINT || key_dti->type == INT;
+}
+
+// bytes before the bit-packed deltas, that hold the least key and the bit width of the deltas
+#define FRAME_OF_REFERENCE_HEADER_SIZE 9
+
+// ors value (of bits bits) into the zero initialized packed bits, at bit_offset
+static void pack_bits(uint8_t* packed, uint64_t bit_offset, uint64_t value, uint32_t bits)
+{
+	for(uint32_t i = 0; i < bits;)
+	{
+		uint32_t bit_in_byte = (bit_offset + i) % 8;
+		uint32_t bits_in_byte = min(8 - bit_in_byte, bits - i);
+		packed[(bit_offset + i) / 8] |= ((value >> i) & ((1U << bits_in_byte) - 1)) << bit_in_byte;
+		i += bits_in_byte;
+	}
+}
+
+static uint64_t unpack_bits(const uint8_t* packed, uint64_t bit_offset, uint32_t bits)
+{
+	uint64_t value = 0;
+	for(uint32_t i = 0; i < bits;)
+	{
+		uint32_t bit_in_byte = (bit_offset + i) % 8;
+		uint32_t bits_in_byte = min(8 - bit_in_byte, bits - i);
+		value |= ((uint64_t)((packed[(bit_offset + i) / 8] >> bit_in_byte) & ((1U << bits_in_byte) - 1))) << i;
+		i += bits_in_byte;
+	}
+	return value;
+}
+
+// takes the keys out of the (non NULL) tuples of the leaf page, leaving them 0, and stores them as deltas from the least key
+// the least key and the bit width of the deltas go into the FRAME_OF_REFERENCE_HEADER_SIZE bytes at header, and the deltas are bit-packed (in the order of the tuples) into packed
+// it sets the number of bytes of the packed deltas in packed_size, it fails with 0, if any of the keys is NULL OR if the packed deltas would grow beyond max_packed_size
+static int take_out_keys_as_frame_of_reference(void* page, uint32_t page_size, const bplus_tree_tuple_defs* bpttd_p, void* header, void* packed, uint32_t max_packed_size, uint32_t* packed_size)
+{
+	const persistent_page ppage = {.page = page};
+	const tuple_def* tpl_def = bpttd_p->record_def;
+	positional_accessor key_element_id = bpttd_p->key_element_ids[0];
+	int is_signed = (get_type_info_for_element_from_tuple_def(tpl_def, key_element_id)->type == INT);
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(&ppage, page_size, &(tpl_def->size_def));
+
+	uint64_t* keys = malloc(sizeof(uint64_t) * max(tuple_count, 1));
+	if(keys == NULL)
+		exit(-1);
+
+	// read all the keys, and find the least of them
+	uint32_t keys_count = 0;
+	uint64_t least_key = 0;
+	for(uint32_t i = 0; i < tuple_count; i++)
+	{
+		const void* tuple = get_nth_tuple_on_persistent_page(&ppage, page_size, &(tpl_def->size_def), i);
+		if(tuple == NULL)
+			continue;
+
+		user_value uval;
+		if(!get_value_from_element_from_tuple(&uval, tpl_def, key_element_id, tuple) || is_user_value_NULL(&uval))
+		{
+			free(keys);
+			return 0;
+		}
+
+		uint64_t key = is_signed ? ((uint64_t)uval.int_value) : uval.uint_value;
+		if(keys_count == 0 || (is_signed ? (((int64_t)key) < ((int64_t)least_key)) : (key < least_key)))
+			least_key = key;
+		keys[keys_count++] = key;
+	}
+
+	// bits needed for the greatest delta
+	uint32_t bits = 0;
+	for(uint32_t i = 0; i < keys_count; i++)
+		while(bits < 64 && ((keys[i] - least_key) >> bits) != 0)
+			bits++;
+
+	if(((((uint64_t)keys_count) * bits) + 7) / 8 > max_packed_size)
+	{
+		free(keys);
+		return 0;
+	}
+	(*packed_size) = ((((uint64_t)keys_count) * bits) + 7) / 8;
+
+	serialize_uint64(header, 8, least_key);
+	((uint8_t*)header)[8] = bits;
+
+	memory_set(packed, 0, (*packed_size));
+	for(uint32_t i = 0; i < keys_count; i++)
+		pack_bits(packed, ((uint64_t)i) * bits, keys[i] - least_key, bits);
+
+	free(keys);
+
+	// now zero the keys in the tuples
+	for(uint32_t i = 0; i < tuple_count; i++)
+	{
+		void* tuple = (void*) get_nth_tuple_on_persistent_page(&ppage, page_size, &(tpl_def->size_def), i);
+		if(tuple == NULL)
+			continue;
+
+		set_element_in_tuple(tpl_def, key_element_id, tuple, (is_signed ? &((user_value){.int_value = 0}) : &((user_value){.uint_value = 0})), UINT32_MAX);
+	}
+
+	return 1;
+}
+
+// puts back the keys taken out by take_out_keys_as_frame_of_reference(), into the (non NULL) tuples of the leaf page
+static void put_back_keys_from_frame_of_reference(void* page, uint32_t page_size, const bplus_tree_tuple_defs* bpttd_p, const void* header, const void* packed)
+{
+	const persistent_page ppage = {.page = page};
+	const tuple_def* tpl_def = bpttd_p->record_def;
+	positional_accessor key_element_id = bpttd_p->key_element_ids[0];
+	int is_signed = (get_type_info_for_element_from_tuple_def(tpl_def, key_element_id)->type == INT);
+
+	uint64_t least_key = deserialize_uint64(header, 8);
+	uint32_t bits = ((const uint8_t*)header)[8];
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(&ppage, page_size, &(tpl_def->size_def));
+	uint32_t keys_count = 0;
+	for(uint32_t i = 0; i < tuple_count; i++)
+	{
+		void* tuple = (void*) get_nth_tuple_on_persistent_page(&ppage, page_size, &(tpl_def->size_def), i);
+		if(tuple == NULL)
+			continue;
+
+		uint64_t key = least_key + unpack_bits(packed, ((uint64_t)(keys_count++)) * bits, bits);
+		set_element_in_tuple(tpl_def, key_element_id, tuple, (is_signed ? &((user_value){.int_value = (int64_t)key}) : &((user_value){.uint_value = key})), UINT32_MAX);
+	}
+}
+
+static void decode_bplus_tree_page(const void* context, void* page, uint32_t page_size, const void* encoded)
+{
+	const bplus_tree_tuple_defs* bpttd_p = context;
+
+	int page_encoding = ((const uint8_t*)encoded)[0];
+	encoded += 1;
+
+	// the least key and the bit width of the deltas of the keys
+	const void* frame_of_reference_header = NULL;
+	if(page_encoding == FRAME_OF_REFERENCE_PAGE)
+	{
+		frame_of_reference_header = encoded;
+		encoded += FRAME_OF_REFERENCE_HEADER_SIZE;
+	}
+
+	encoded += decode_non_zero_bytes_in_page(page, page_size, encoded);
+
+	if(page_encoding == PLAIN_PAGE)
+		return;
+
+	// the page header and the slots are not xor-ed, so the tuple_def is found on the decoded page, just as the encoder found it on the original page
+	const tuple_def* tpl_def = get_fixed_sized_tuple_def_for_page(page, page_size, bpttd_p);
+	if(tpl_def == NULL)
+		return;
+
+	xor_tuples_with_preceding_tuples(page, page, page_size, tpl_def);
+
+	// the bit-packed deltas of the keys follow the non zero bytes of the page
+	if(page_encoding == FRAME_OF_REFERENCE_PAGE)
+		put_back_keys_from_frame_of_reference(page, page_size, bpttd_p, frame_of_reference_header, encoded);
+}
+
+// encodes the page, with its tuples xor-ed with their preceding tuples, into encoded (past its first byte, that holds the page_encoding)
+// for a FRAME_OF_REFERENCE_PAGE, the keys are taken out of the tuples before they are xor-ed, so only the rest of the tuples are xor-ed with each other
+// work_pages must be 2 buffers of page_size each, it returns 0, if the encoding fails OR if it would not decode back to the exact same page
+static uint32_t encode_tuple_deltas_of_bplus_tree_page(int page_encoding, const void* page, uint32_t page_size, const tuple_def* tpl_def, const bplus_tree_tuple_defs* bpttd_p, void* encoded, uint32_t max_encoded_size, void* work_pages)
+{
+	void* preceding_tuples_page = work_pages;
+	void* delta_page = work_pages + page_size;
+
+	((uint8_t*)encoded)[0] = page_encoding;
+	uint32_t encoded_size = 1;
+
+	memory_move(preceding_tuples_page, page, page_size);
+
+	uint32_t packed_size = 0;
+	void* packed = NULL;
+	if(page_encoding == FRAME_OF_REFERENCE_PAGE)
+	{
+		if(max_encoded_size - encoded_size < FRAME_OF_REFERENCE_HEADER_SIZE)
+			return 0;
+
+		// the packed deltas are built in a separate buffer, and then moved to follow the non zero bytes of the page
+		packed = malloc(max_encoded_size);
+		if(packed == NULL)
+			exit(-1);
+
+		if(!take_out_keys_as_frame_of_reference(preceding_tuples_page, page_size, bpttd_p, encoded + encoded_size, packed, max_encoded_size - encoded_size - FRAME_OF_REFERENCE_HEADER_SIZE, &packed_size))
+		{
+			free(packed);
+			return 0;
+		}
+		encoded_size += FRAME_OF_REFERENCE_HEADER_SIZE;
+	}
+
+	memory_move(delta_page, preceding_tuples_page, page_size);
+	xor_tuples_with_preceding_tuples(delta_page, preceding_tuples_page, page_size, tpl_def);
+
+	uint32_t non_zero_bytes_size = encode_non_zero_bytes_in_page(delta_page, page_size, encoded + encoded_size, max_encoded_size - encoded_size - packed_size);
+	if(non_zero_bytes_size == 0)
+	{
+		free(packed);
+		return 0;
+	}
+	encoded_size += non_zero_bytes_size;
+
+	if(page_encoding == FRAME_OF_REFERENCE_PAGE)
+	{
+		memory_move(encoded + encoded_size, packed, packed_size);
+		encoded_size += packed_size;
+		free(packed);
+	}
+
+	// the page is handed back to the users of the bplus_tree only through the decode_bplus_tree_page, so make sure it decodes to the exact same bytes
+	decode_bplus_tree_page(bpttd_p, delta_page, page_size, encoded);
+	if(memory_compare(delta_page, page, page_size) != 0)
+		return 0;
+
+	return encoded_size;
+}
+
+static uint32_t encode_bplus_tree_page(const void* context, const void* page, uint32_t page_size, void* encoded, uint32_t max_encoded_size)
+{
+	const bplus_tree_tuple_defs* bpttd_p = context;
+
+	if(max_encoded_size < 1)
+		return 0;
+
+	const tuple_def* tpl_def = get_fixed_sized_tuple_def_for_page(page, page_size, bpttd_p);
+	if(tpl_def != NULL)
+	{
+		void* work_pages = malloc(2 * page_size);
+		if(work_pages == NULL)
+			exit(-1);
+
+		uint32_t encoded_size = 0;
+
+		// on the leaf pages with an integer key, try taking out the keys as a frame of reference first
+		if(tpl_def == bpttd_p->record_def && has_frame_of_reference_key(bpttd_p))
+			encoded_size = encode_tuple_deltas_of_bplus_tree_page(FRAME_OF_REFERENCE_PAGE, page, page_size, tpl_def, bpttd_p, encoded, max_encoded_size, work_pages);
+
+		if(encoded_size == 0)
+			encoded_size = encode_tuple_deltas_of_bplus_tree_page(TUPLE_DELTA_PAGE, page, page_size, tpl_def, bpttd_p, encoded, max_encoded_size, work_pages);
+
+		free(work_pages);
+
+		if(encoded_size > 0)
+			return encoded_size;
+	}
+
+	// fall back to only stripping off the zero bytes of the page
+	((uint8_t*)encoded)[0] = PLAIN_PAGE;
+	uint32_t encoded_size = encode_non_zero_bytes_in_page(page, page_size, encoded + 1, max_encoded_size - 1);
+	if(encoded_size == 0)
+		return 0;
+	return 1 + encoded_size;
+}
+
+page_codec get_page_codec_for_bplus_tree(const bplus_tree_tuple_defs* bpttd_p)
+{
+	return (page_codec){
+		.context = bpttd_p,
+		.encode_page = encode_bplus_tree_page,
+		.decode_page = decode_bplus_tree_page,
+	};
+}
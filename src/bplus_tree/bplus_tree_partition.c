@@ -0,0 +1,191 @@
+#include<bplus_tree.h>
+
+#include<locked_pages_stack.h>
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_page_header.h>
+#include<bplus_tree_tuple_definitions.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<stdlib.h>
+
+// visits (in ascending order) all the separator keys (index entries) stored in the interior pages of the bplus_tree at level >= lowest_level
+// if partition_keys == NULL, then it only counts the separator keys and returns this count
+// else it copies the separator keys that are selected for the partition boundaries (evenly spaced, assuming that there are separators_count of them) into partition_keys
+// and returns the number of keys copied into partition_keys (this may be lesser than partitions_count - 1, if the bplus_tree shrunk in the mean time)
+// all pages are locked with READ_LOCKs, the ancestors of the page being visited stay locked while visiting it, just like in print_bplus_tree
+static uint64_t visit_separators_of_top_levels(uint64_t root_page_id, uint32_t lowest_level, uint64_t separators_count, uint32_t partitions_count, void** partition_keys, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// the number of separators visited until now
+	uint64_t separators_visited = 0;
+
+	// the number of partition_keys copied until now
+	uint64_t partition_keys_copied = 0;
+
+	// create a stack
+	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
+
+	{
+		// get lock on the root page of the bplus_tree
+		persistent_page root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, READ_LOCK, abort_error);
+		if(*abort_error)
+			return 0;
+
+		// pre cache level of the root_page
+		uint32_t root_page_level = get_level_of_bplus_tree_page(&root_page, bpttd_p);
+
+		// create a stack of capacity = levels
+		if(!initialize_locked_pages_stack(locked_pages_stack_p, root_page_level + 1))
+			exit(-1);
+
+		// push the root page onto the stack
+		push_to_locked_pages_stack(locked_pages_stack_p, &INIT_LOCKED_PAGE_INFO(root_page, ALL_LEAST_KEYS_CHILD_INDEX));
+	}
+
+	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
+	{
+		locked_page_info* curr_locked_page = get_top_of_locked_pages_stack(locked_pages_stack_p);
+
+		// get tuple_count and level of the page
+		uint32_t tuple_count = get_tuple_count_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def));
+		uint32_t level = get_level_of_bplus_tree_page(&(curr_locked_page->ppage), bpttd_p);
+
+		// a separator must be visited, if the page is at the lowest_level, visit all of its tuples, else the one at child_index, before we go down to the child at child_index
+		// the separator at index i, lies between the children at index (i-1) and i, hence this gives us the separators in ascending order
+		uint32_t first_separator_index = 0;
+		uint32_t separators_on_page = 0;
+
+		// pages at the lowest_level (or leaf pages, which may appear only if the bplus_tree got shorter in the mean time) are not descended into
+		if(level <= lowest_level)
+		{
+			if(level > 0)
+			{
+				first_separator_index = 0;
+				separators_on_page = tuple_count;
+			}
+		}
+		else if(curr_locked_page->child_index == -1 || curr_locked_page->child_index < tuple_count)
+		{
+			if(curr_locked_page->child_index != -1)
+			{
+				first_separator_index = curr_locked_page->child_index;
+				separators_on_page = 1;
+			}
+		}
+
+		for(uint32_t i = first_separator_index; i < first_separator_index + separators_on_page; i++, separators_visited++)
+		{
+			if(partition_keys == NULL)
+				continue;
+
+			// the separator_index that must be copied next, for an even spread of partitions
+			// this is strictly increasing with partition_keys_copied, as long as (separators_count + 1) >= partitions_count
+			uint64_t next_selected_separator_index = (((partition_keys_copied + 1) * (separators_count + 1)) / partitions_count) - 1;
+			if(partition_keys_copied == (partitions_count - 1) || separators_visited != next_selected_separator_index)
+				continue;
+
+			const void* index_entry = get_nth_tuple_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def), i);
+
+			partition_keys[partition_keys_copied] = malloc(bpttd_p->max_index_record_size); // key would be no bigger than the max_index_record_size
+			if(partition_keys[partition_keys_copied] == NULL)
+				exit(-1);
+			extract_key_from_index_entry_using_bplus_tree_tuple_definitions(bpttd_p, index_entry, partition_keys[partition_keys_copied]);
+			partition_keys_copied++;
+		}
+
+		if(level > lowest_level && (curr_locked_page->child_index == -1 || curr_locked_page->child_index < tuple_count))
+		{
+			// then push it's child at child_index onto the stack (with child_index = -1), while incrementing its child index
+			uint64_t child_page_id = get_child_page_id_by_child_index(&(curr_locked_page->ppage), curr_locked_page->child_index++, bpttd_p);
+			persistent_page child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_page_id, READ_LOCK, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			push_to_locked_pages_stack(locked_pages_stack_p, &INIT_LOCKED_PAGE_INFO(child_page, ALL_LEAST_KEYS_CHILD_INDEX));
+		}
+		else // we are done with this page, pop it from the stack and unlock it
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &(curr_locked_page->ppage), NONE_OPTION, abort_error);
+			pop_from_locked_pages_stack(locked_pages_stack_p);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+	}
+
+	ABORT_ERROR:;
+	// release locks on all the pages, we had locks on until now
+	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
+	{
+		locked_page_info* bottom = get_bottom_of_locked_pages_stack(locked_pages_stack_p);
+		release_lock_on_persistent_page(pam_p, transaction_id, &(bottom->ppage), NONE_OPTION, abort_error);
+		pop_bottom_from_locked_pages_stack(locked_pages_stack_p);
+	}
+
+	deinitialize_locked_pages_stack(locked_pages_stack_p);
+
+	if(*abort_error)
+	{
+		// free all the partition_keys that we allocated
+		for(uint64_t i = 0; i < partition_keys_copied; i++)
+		{
+			free(partition_keys[i]);
+			partition_keys[i] = NULL;
+		}
+		return 0;
+	}
+
+	if(partition_keys == NULL)
+		return separators_visited;
+	return partition_keys_copied;
+}
+
+uint32_t get_partition_keys_for_bplus_tree(uint64_t root_page_id, uint32_t partitions_count, void** partition_keys, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// there are no boundaries to be found for lesser than 2 partitions
+	if(partitions_count < 2)
+		return 0;
+
+	uint32_t root_page_level;
+	{
+		// get lock on the root page of the bplus_tree, only to read its level
+		persistent_page root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, READ_LOCK, abort_error);
+		if(*abort_error)
+			return 0;
+
+		root_page_level = get_level_of_bplus_tree_page(&root_page, bpttd_p);
+
+		release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+			return 0;
+	}
+
+	// a bplus_tree with only a leaf root page can not be partitioned
+	if(root_page_level == 0)
+		return 0;
+
+	// go down the levels, until we find a level with atleast (partitions_count - 1) separators at or above it
+	// the level = 1 has all the separators of the bplus_tree at or above it, so we stop there regardless
+	uint32_t lowest_level = root_page_level;
+	uint64_t separators_count = 0;
+	while(1)
+	{
+		separators_count = visit_separators_of_top_levels(root_page_id, lowest_level, 0, partitions_count, NULL, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		if((separators_count + 1) >= partitions_count || lowest_level == 1)
+			break;
+
+		lowest_level--;
+	}
+
+	// if there are not enough separators, then each of them is a partition boundary
+	if((separators_count + 1) < partitions_count)
+		partitions_count = separators_count + 1;
+
+	if(partitions_count < 2)
+		return 0;
+
+	return visit_separators_of_top_levels(root_page_id, lowest_level, separators_count, partitions_count, partition_keys, bpttd_p, pam_p, transaction_id, abort_error);
+}
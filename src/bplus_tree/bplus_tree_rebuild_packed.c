@@ -0,0 +1,133 @@
+#include<bplus_tree.h>
+
+#include<bplus_tree_bulk_loader.h>
+#include<bplus_tree_page_header.h>
+
+#include<persistent_page_functions.h>
+#include<persistent_page_altered.h>
+
+// clones the contents of the src_page (a leaf or an interior page of the bplus_tree) into the dest_page
+static void clone_bplus_tree_page(persistent_page* dest_page, const persistent_page* src_page, const bplus_tree_tuple_defs* bpttd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(is_bplus_tree_leaf_page(src_page, bpttd_p))
+		clone_persistent_page(pmm_p, transaction_id, dest_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), src_page, abort_error);
+	else
+		clone_persistent_page(pmm_p, transaction_id, dest_page, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def), src_page, abort_error);
+}
+
+// builds a fully packed copy of the bplus_tree, and returns the root_page_id of the copy
+static uint64_t build_packed_copy_of_bplus_tree(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// a read-only scan over all the records of the bplus_tree, in the order of their keys
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return bpttd_p->pas_p->NULL_PAGE_ID;
+
+	bplus_tree_bulk_loader bpbl;
+	initialize_bplus_tree_bulk_loader(&bpbl, bpttd_p, pam_p, pmm_p);
+
+	uint64_t packed_root_page_id = bpttd_p->pas_p->NULL_PAGE_ID;
+
+	const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+	while(record != NULL)
+	{
+		// the records come in the strictly ascending order of their keys, and they already fit this bplus_tree, so this fails only on an abort_error
+		append_record_to_bplus_tree_bulk_loader(&bpbl, record, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		if(!next_bplus_tree_iterator(bpi_p, transaction_id, abort_error))
+			break;
+		if(*abort_error)
+			goto EXIT;
+
+		record = get_tuple_bplus_tree_iterator(bpi_p);
+	}
+	if(*abort_error)
+		goto EXIT;
+
+	// release the locks on the old bplus_tree, before the interior levels are built
+	delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+	bpi_p = NULL;
+	if(*abort_error)
+		goto EXIT;
+
+	packed_root_page_id = finish_bplus_tree_bulk_loader(&bpbl, transaction_id, abort_error);
+
+	EXIT:;
+	if(bpi_p != NULL)
+		delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+	deinitialize_bplus_tree_bulk_loader(&bpbl, transaction_id, abort_error);
+
+	if(*abort_error)
+		return bpttd_p->pas_p->NULL_PAGE_ID;
+
+	return packed_root_page_id;
+}
+
+int rebuild_packed_bplus_tree(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t packed_root_page_id = build_packed_copy_of_bplus_tree(root_page_id, bpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// the root of the bplus_tree must stay at root_page_id
+	// so the contents of the old root are moved to a new page (making it the root of the old bplus_tree, that we destroy at the end)
+	// and the contents of the packed root are moved into the root page, freeing the packed root page
+
+	persistent_page root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, WRITE_LOCK, abort_error);
+	if(*abort_error)
+		return 0;
+
+	persistent_page packed_root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, packed_root_page_id, WRITE_LOCK, abort_error);
+	if(*abort_error)
+	{
+		release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+		return 0;
+	}
+
+	persistent_page old_root_page = get_new_persistent_page_with_write_lock(pam_p, transaction_id, abort_error);
+	if(*abort_error)
+	{
+		release_lock_on_persistent_page(pam_p, transaction_id, &packed_root_page, NONE_OPTION, abort_error);
+		release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+		return 0;
+	}
+	uint64_t old_root_page_id = old_root_page.page_id;
+
+	clone_bplus_tree_page(&old_root_page, &root_page, bpttd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	clone_bplus_tree_page(&root_page, &packed_root_page, bpttd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	release_lock_on_persistent_page(pam_p, transaction_id, &packed_root_page, FREE_PAGE, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	release_lock_on_persistent_page(pam_p, transaction_id, &old_root_page, NONE_OPTION, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// now destroy the old bplus_tree, that is now rooted at old_root_page_id
+	destroy_bplus_tree(old_root_page_id, bpttd_p, pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+
+	ABORT_ERROR:;
+	if(!is_persistent_page_NULL(&packed_root_page, pam_p))
+		release_lock_on_persistent_page(pam_p, transaction_id, &packed_root_page, NONE_OPTION, abort_error);
+	if(!is_persistent_page_NULL(&old_root_page, pam_p))
+		release_lock_on_persistent_page(pam_p, transaction_id, &old_root_page, NONE_OPTION, abort_error);
+	if(!is_persistent_page_NULL(&root_page, pam_p))
+		release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include<bplus_tree.h>
+
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_page_header.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<stdlib.h>
+
+// xorshift64* pseudo random number generator, it keeps sampling reproducible for a given seed, and independent of rand()'s global state
+static uint64_t get_next_random(uint64_t* random_state)
+{
+	(*random_state) ^= (*random_state) >> 12;
+	(*random_state) ^= (*random_state) << 25;
+	(*random_state) ^= (*random_state) >> 27;
+	return (*random_state) * UINT64_C(2685821657736338717);
+}
+
+// a bplus_tree with atleast 2 children per interior page, can not be taller than this, as it can not have more than 2^64 pages
+#define MAX_BPLUS_TREE_HEIGHT 64
+
+// returns a uniformly distributed random number in [0, 1)
+static double get_next_random_fraction(uint64_t* random_state)
+{
+	return (get_next_random(random_state) >> 11) * (1.0 / (UINT64_C(1) << 53));
+}
+
+uint64_t sample_bplus_tree(uint64_t root_page_id, uint64_t samples_count, uint64_t seed, uint64_t max_consecutive_rejected_walks, void* context, void (*record_sampled)(void* context, const void* record), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// xorshift must never be seeded with a 0
+	uint64_t random_state = (seed == 0) ? UINT64_C(0x9E3779B97F4A7C15) : seed;
+
+	// the largest fanout (number of children of an interior page OR number of records on a leaf page), seen so far on any page at each level
+	// these are the fanout bounds for the acceptance correction, they only grow, and converge to the actual maximums after a few walks
+	uint32_t max_fanouts[MAX_BPLUS_TREE_HEIGHT] = {};
+
+	uint64_t samples_found = 0;
+	uint64_t consecutive_rejected_walks = 0;
+
+	while(samples_found < samples_count && consecutive_rejected_walks < max_consecutive_rejected_walks)
+	{
+		// get lock on the root page of the bplus_tree
+		persistent_page curr_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, READ_LOCK, abort_error);
+		if(*abort_error)
+			return samples_found;
+
+		// an empty bplus_tree has nothing to sample, it has only an empty leaf root page
+		if(is_bplus_tree_leaf_page(&curr_page, bpttd_p) && get_tuple_count_on_persistent_page(&curr_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def)) == 0)
+		{
+			release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+			return samples_found;
+		}
+
+		// walk down the interior pages, picking one of the actual children uniformly
+		// this reaches a leaf page with the probability = product of (1 / fanout) of the pages on its path
+		// so the walk is accepted with the probability = product of (fanout / max_fanout) of the pages on its path (including the leaf page), to make every record equally likely
+		double acceptance_probability = 1.0;
+		while(!is_bplus_tree_leaf_page(&curr_page, bpttd_p))
+		{
+			uint32_t level = min(get_level_of_bplus_tree_page(&curr_page, bpttd_p), MAX_BPLUS_TREE_HEIGHT - 1);
+			uint32_t fanout = get_tuple_count_on_persistent_page(&curr_page, bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def)) + 1;
+			max_fanouts[level] = max(max_fanouts[level], fanout);
+			acceptance_probability *= ((double)fanout) / max_fanouts[level];
+
+			// child at slot 0 is the least keys child, i.e. child_index = -1
+			uint32_t slot = get_next_random(&random_state) % fanout;
+
+			uint64_t child_page_id = get_child_page_id_by_child_index(&curr_page, slot - 1, bpttd_p);
+			persistent_page child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_page_id, READ_LOCK, abort_error);
+			if(*abort_error)
+			{
+				release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+				return samples_found;
+			}
+
+			// we only need to hold lock on the child page from here on
+			release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+			if(*abort_error)
+			{
+				release_lock_on_persistent_page(pam_p, transaction_id, &child_page, NONE_OPTION, abort_error);
+				return samples_found;
+			}
+			curr_page = child_page;
+		}
+
+		// pick a record uniformly from the leaf page, and accept or reject the walk only here
+		int rejected = 1;
+		uint32_t tuple_count = get_tuple_count_on_persistent_page(&curr_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def));
+		if(tuple_count > 0)
+		{
+			max_fanouts[0] = max(max_fanouts[0], tuple_count);
+			acceptance_probability *= ((double)tuple_count) / max_fanouts[0];
+
+			uint32_t slot = get_next_random(&random_state) % tuple_count;
+			if(get_next_random_fraction(&random_state) < acceptance_probability)
+			{
+				rejected = 0;
+				const void* record = get_nth_tuple_on_persistent_page(&curr_page, bpttd_p->pas_p->page_size, &(bpttd_p->record_def->size_def), slot);
+				record_sampled(context, record);
+			}
+		}
+
+		release_lock_on_persistent_page(pam_p, transaction_id, &curr_page, NONE_OPTION, abort_error);
+		if(*abort_error)
+			return samples_found;
+
+		if(rejected)
+			consecutive_rejected_walks++;
+		else
+		{
+			samples_found++;
+			consecutive_rejected_walks = 0;
+		}
+	}
+
+	return samples_found;
+}
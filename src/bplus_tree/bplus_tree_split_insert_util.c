@@ -34,7 +34,7 @@ int split_insert_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack*
 			{
 				insertion_index = find_insertion_point_in_sorted_packed_page(
 									&(curr_locked_page.ppage), bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									record
 								);
 			}
@@ -43,7 +43,7 @@ int split_insert_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack*
 				// this will happen only if you do not provide the inputs improperly, hence must never happen
 				if(!is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 									&(curr_locked_page.ppage), bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									record, 
 									insertion_index
 								))
@@ -54,7 +54,7 @@ int split_insert_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack*
 			uint32_t insertion_point = insertion_index;
 			inserted = insert_at_in_sorted_packed_page(
 									&(curr_locked_page.ppage), bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									record, 
 									insertion_point,
 									pmm_p,
@@ -147,7 +147,7 @@ int split_insert_and_unlock_pages_up(uint64_t root_page_id, locked_pages_stack*
 			uint32_t insertion_point = curr_locked_page.child_index + 1;
 			parent_tuple_inserted = insert_at_in_sorted_packed_page(
 									&(curr_locked_page.ppage), bpttd_p->pas_p->page_size, 
-									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->index_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									parent_insert, 
 									insertion_point,
 									pmm_p,
@@ -0,0 +1,254 @@
+#include<bplus_tree.h>
+
+#include<locked_pages_stack.h>
+#include<bplus_tree_interior_page_util.h>
+#include<bplus_tree_page_header.h>
+
+#include<persistent_page_functions.h>
+#include<tuple.h>
+
+#include<stdlib.h>
+
+// accumulate the statistics of the ppage into its level's statistics
+static void accumulate_page_into_level_statistics(bplus_tree_level_statistics* level_stats, const persistent_page* ppage, const tuple_def* def, uint32_t page_size)
+{
+	level_stats->tuple_count += get_tuple_count_on_persistent_page(ppage, page_size, &(def->size_def));
+	level_stats->space_occupied += get_space_occupied_by_all_tuples_on_persistent_page(ppage, page_size, &(def->size_def));
+	level_stats->space_allotted += get_space_allotted_to_all_tuples_on_persistent_page(ppage, page_size, &(def->size_def));
+	level_stats->space_fragmented += get_fragmentation_space_on_persistent_page(ppage, page_size, &(def->size_def));
+	level_stats->pages_read++;
+}
+
+int get_statistics_bplus_tree(uint64_t root_page_id, uint32_t leaf_sampling_interval, uint32_t quantiles_count, bplus_tree_statistics* bpts_p, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// a leaf_sampling_interval of 0, is same as reading all the leaves
+	if(leaf_sampling_interval == 0)
+		leaf_sampling_interval = 1;
+
+	(*bpts_p) = (bplus_tree_statistics){};
+
+	// the number of leaf pages that we have encountered until now, this decides which leaves are to be read
+	uint64_t leaves_encountered = 0;
+
+	// create a stack
+	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
+
+	{
+		// get lock on the root page of the bplus_tree
+		persistent_page root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_id, READ_LOCK, abort_error);
+		if(*abort_error)
+			return 0;
+
+		// pre cache level of the root_page
+		uint32_t root_page_level = get_level_of_bplus_tree_page(&root_page, bpttd_p);
+
+		bpts_p->height = root_page_level + 1;
+		bpts_p->levels = calloc(bpts_p->height, sizeof(bplus_tree_level_statistics));
+		if(bpts_p->levels == NULL)
+			exit(-1);
+
+		// create a stack of capacity = levels
+		if(!initialize_locked_pages_stack(locked_pages_stack_p, root_page_level + 1))
+			exit(-1);
+
+		// push the root page onto the stack
+		push_to_locked_pages_stack(locked_pages_stack_p, &INIT_LOCKED_PAGE_INFO(root_page, ALL_LEAST_KEYS_CHILD_INDEX));
+	}
+
+	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
+	{
+		locked_page_info* curr_locked_page = get_top_of_locked_pages_stack(locked_pages_stack_p);
+
+		uint32_t curr_page_level = get_level_of_bplus_tree_page(&(curr_locked_page->ppage), bpttd_p);
+
+		// the only leaf page that can be on the stack, is the root page
+		if(is_bplus_tree_leaf_page(&(curr_locked_page->ppage), bpttd_p))
+		{
+			bpts_p->levels[0].page_count++;
+			leaves_encountered++;
+			accumulate_page_into_level_statistics(&(bpts_p->levels[0]), &(curr_locked_page->ppage), bpttd_p->record_def, bpttd_p->pas_p->page_size);
+
+			// unlock it and pop it from the stack
+			release_lock_on_persistent_page(pam_p, transaction_id, &(curr_locked_page->ppage), NONE_OPTION, abort_error);
+			pop_from_locked_pages_stack(locked_pages_stack_p);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+		// interior pages at level = 1, we only count their child leaf pages, and read only the sampled ones, without pushing them on to the stack
+		else if(curr_page_level == 1)
+		{
+			// get tuple_count of the page
+			uint32_t tuple_count = get_tuple_count_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def));
+
+			for(uint32_t i = -1; i == -1 || i < tuple_count; i++)
+			{
+				bpts_p->levels[0].page_count++;
+				if(((leaves_encountered++) % leaf_sampling_interval) != 0)
+					continue;
+
+				uint64_t child_leaf_page_id = get_child_page_id_by_child_index(&(curr_locked_page->ppage), i, bpttd_p);
+				persistent_page child_leaf_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_leaf_page_id, READ_LOCK, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				accumulate_page_into_level_statistics(&(bpts_p->levels[0]), &child_leaf_page, bpttd_p->record_def, bpttd_p->pas_p->page_size);
+
+				release_lock_on_persistent_page(pam_p, transaction_id, &child_leaf_page, NONE_OPTION, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+
+			// account for this page, unlock it and pop it from the stack
+			bpts_p->levels[curr_page_level].page_count++;
+			accumulate_page_into_level_statistics(&(bpts_p->levels[curr_page_level]), &(curr_locked_page->ppage), bpttd_p->index_def, bpttd_p->pas_p->page_size);
+
+			release_lock_on_persistent_page(pam_p, transaction_id, &(curr_locked_page->ppage), NONE_OPTION, abort_error);
+			pop_from_locked_pages_stack(locked_pages_stack_p);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+		// interior pages at level >= 2
+		else
+		{
+			// get tuple_count of the page
+			uint32_t tuple_count = get_tuple_count_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def));
+
+			// if child index is -1 or lesser than tuple_count
+			if(curr_locked_page->child_index == -1 || curr_locked_page->child_index < tuple_count)
+			{
+				// then push it's child at child_index onto the stack (with child_index = -1), while incrementing its child index
+				uint64_t child_page_id = get_child_page_id_by_child_index(&(curr_locked_page->ppage), curr_locked_page->child_index++, bpttd_p);
+				persistent_page child_page = acquire_persistent_page_with_lock(pam_p, transaction_id, child_page_id, READ_LOCK, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				push_to_locked_pages_stack(locked_pages_stack_p, &INIT_LOCKED_PAGE_INFO(child_page, ALL_LEAST_KEYS_CHILD_INDEX));
+			}
+			else // we have read all its children, now account for this page, unlock it and pop it from the stack
+			{
+				bpts_p->levels[curr_page_level].page_count++;
+				accumulate_page_into_level_statistics(&(bpts_p->levels[curr_page_level]), &(curr_locked_page->ppage), bpttd_p->index_def, bpttd_p->pas_p->page_size);
+
+				release_lock_on_persistent_page(pam_p, transaction_id, &(curr_locked_page->ppage), NONE_OPTION, abort_error);
+				pop_from_locked_pages_stack(locked_pages_stack_p);
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+		}
+	}
+
+	ABORT_ERROR:;
+	// release locks on all the pages, we had locks on until now
+	while(get_element_count_locked_pages_stack(locked_pages_stack_p) > 0)
+	{
+		locked_page_info* bottom = get_bottom_of_locked_pages_stack(locked_pages_stack_p);
+		release_lock_on_persistent_page(pam_p, transaction_id, &(bottom->ppage), NONE_OPTION, abort_error);
+		pop_bottom_from_locked_pages_stack(locked_pages_stack_p);
+	}
+
+	deinitialize_locked_pages_stack(locked_pages_stack_p);
+
+	if(*abort_error)
+	{
+		deinitialize_bplus_tree_statistics(bpts_p);
+		return 0;
+	}
+
+	// extrapolate the statistics of the leaf level, if only a sample of it was read
+	if(bpts_p->levels[0].pages_read > 0 && bpts_p->levels[0].pages_read < bpts_p->levels[0].page_count)
+	{
+		bplus_tree_level_statistics* leaf_stats = &(bpts_p->levels[0]);
+		leaf_stats->tuple_count = (leaf_stats->tuple_count * leaf_stats->page_count) / leaf_stats->pages_read;
+		leaf_stats->space_occupied = (leaf_stats->space_occupied * leaf_stats->page_count) / leaf_stats->pages_read;
+		leaf_stats->space_allotted = (leaf_stats->space_allotted * leaf_stats->page_count) / leaf_stats->pages_read;
+		leaf_stats->space_fragmented = (leaf_stats->space_fragmented * leaf_stats->page_count) / leaf_stats->pages_read;
+	}
+
+	// build the histogram
+	if(quantiles_count > 1)
+	{
+		bpts_p->quantile_keys = malloc(sizeof(void*) * (quantiles_count - 1));
+		if(bpts_p->quantile_keys == NULL)
+			exit(-1);
+
+		bpts_p->quantile_keys_count = get_partition_keys_for_bplus_tree(root_page_id, quantiles_count, bpts_p->quantile_keys, bpttd_p, pam_p, transaction_id, abort_error);
+		if(*abort_error)
+		{
+			deinitialize_bplus_tree_statistics(bpts_p);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+uint64_t get_approximate_record_count_in_range_bplus_tree(const bplus_tree_statistics* bpts_p, const void* key1, const void* key2, const bplus_tree_tuple_defs* bpttd_p)
+{
+	uint64_t record_count = bpts_p->levels[0].tuple_count;
+	uint64_t bucket_count = bpts_p->quantile_keys_count + 1;
+
+	// an empty range
+	if(key1 != NULL && key2 != NULL && bpttd_p->key_comparator(key1, bpttd_p->key_def, NULL, key2, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count) >= 0)
+		return 0;
+
+	// count the bucket boundaries that lie in [key1, key2)
+	uint64_t boundaries_in_range = 0;
+	for(uint32_t i = 0; i < bpts_p->quantile_keys_count; i++)
+	{
+		if(key1 != NULL && bpttd_p->key_comparator(bpts_p->quantile_keys[i], bpttd_p->key_def, NULL, key1, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count) < 0)
+			continue;
+		if(key2 != NULL && bpttd_p->key_comparator(bpts_p->quantile_keys[i], bpttd_p->key_def, NULL, key2, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count) >= 0)
+			continue;
+		boundaries_in_range++;
+	}
+
+	// the range completely covers the buckets between its boundaries, and we assume that it covers half of each of the 2 buckets it partially overlaps with
+	// i.e. (boundaries_in_range - 1) complete buckets + 2 halves = boundaries_in_range buckets
+	uint64_t buckets_in_range_x2 = 2 * boundaries_in_range;
+
+	// the range covering all the boundaries on either side, completely covers the first or the last bucket
+	if(key1 == NULL)
+		buckets_in_range_x2++;
+	if(key2 == NULL)
+		buckets_in_range_x2++;
+
+	// a non-empty range with no boundaries in it, lies completely inside a single bucket, we assume that it covers half of that bucket
+	if(buckets_in_range_x2 == 0)
+		buckets_in_range_x2 = 1;
+
+	uint64_t estimate = (record_count * buckets_in_range_x2) / (2 * bucket_count);
+	return min(estimate, record_count);
+}
+
+void deinitialize_bplus_tree_statistics(bplus_tree_statistics* bpts_p)
+{
+	if(bpts_p->levels != NULL)
+		free(bpts_p->levels);
+	if(bpts_p->quantile_keys != NULL)
+	{
+		for(uint32_t i = 0; i < bpts_p->quantile_keys_count; i++)
+			free(bpts_p->quantile_keys[i]);
+		free(bpts_p->quantile_keys);
+	}
+	(*bpts_p) = (bplus_tree_statistics){};
+}
+
+void print_bplus_tree_statistics(const bplus_tree_statistics* bpts_p, const bplus_tree_tuple_defs* bpttd_p)
+{
+	printf("Bplus_tree statistics :\n");
+	printf("height : %"PRIu32"\n", bpts_p->height);
+	for(uint32_t l = bpts_p->height; l > 0; l--)
+	{
+		const bplus_tree_level_statistics* level_stats = &(bpts_p->levels[l - 1]);
+		printf("level %"PRIu32" : page_count = %"PRIu64", tuple_count = %"PRIu64", fill = %"PRIu64"%%, fragmented_space = %"PRIu64", pages_read = %"PRIu64"\n", l - 1,
+			level_stats->page_count, level_stats->tuple_count,
+			((level_stats->space_allotted == 0) ? 0 : ((level_stats->space_occupied * 100) / level_stats->space_allotted)),
+			level_stats->space_fragmented, level_stats->pages_read);
+	}
+	printf("quantile_keys : %"PRIu32"\n", bpts_p->quantile_keys_count);
+	for(uint32_t i = 0; i < bpts_p->quantile_keys_count; i++)
+	{
+		printf("\t");
+		print_tuple(bpts_p->quantile_keys[i], bpttd_p->key_def);
+	}
+}
@@ -4,6 +4,7 @@
 
 #include<bplus_tree_leaf_page_header.h>
 #include<bplus_tree_interior_page_header.h>
+#include<bplus_tree_page_codec.h>
 
 #include<stdlib.h>
 #include<string.h>
@@ -41,6 +42,10 @@ int init_bplus_tree_tuple_definitions(bplus_tree_tuple_defs* bpttd_p, const page
 
 	bpttd_p->record_def = record_def;
 
+	bpttd_p->key_comparator = get_tuple_keys_comparator(record_def, key_element_ids, key_element_count);
+
+	bpttd_p->codec = get_page_codec_for_bplus_tree(bpttd_p);
+
 	// allocate memory for key_def and initialize it
 	{
 		data_type_info* index_type_info = malloc(sizeof_tuple_data_type_info(key_element_count + 1));
@@ -266,6 +271,7 @@ void deinit_bplus_tree_tuple_definitions(bplus_tree_tuple_defs* bpttd_p)
 	bpttd_p->key_def = NULL;
 	bpttd_p->max_record_size = 0;
 	bpttd_p->max_index_record_size = 0;
+	bpttd_p->codec = (page_codec){};
 }
 
 void print_bplus_tree_tuple_definitions(const bplus_tree_tuple_defs* bpttd_p)
@@ -49,10 +49,11 @@ int inspected_update_in_bplus_tree(uint64_t root_page_id, void* new_record, cons
 	if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(bpttd_p, new_record))
 		return 0;
 
-	// create a locked_pages_stack
+	// create a locked_pages_stack, in memory on this call stack for any tree that is not taller than LOCKED_PAGES_STACK_INLINE_CAPACITY
+	locked_page_info locked_pages_stack_memory[LOCKED_PAGES_STACK_INLINE_CAPACITY];
 	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
 
-	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down(root_page_id, WRITE_LOCK, bpttd_p, pam_p, transaction_id, abort_error);
+	(*locked_pages_stack_p) = initialize_locked_pages_stack_for_walk_down_with_memory(root_page_id, WRITE_LOCK, locked_pages_stack_memory, LOCKED_PAGES_STACK_INLINE_CAPACITY, bpttd_p, pam_p, transaction_id, abort_error);
 	if(*abort_error) // on abort no pages were kept locked
 		return 0;
 
@@ -68,7 +69,7 @@ int inspected_update_in_bplus_tree(uint64_t root_page_id, void* new_record, cons
 	// find index of last record that compares equal to the new_record
 	uint32_t found_index = find_last_in_sorted_packed_page(
 											concerned_leaf, bpttd_p->pas_p->page_size,
-											bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+											bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 											new_record, bpttd_p->record_def, bpttd_p->key_element_ids
 										);
 
@@ -121,7 +122,7 @@ int inspected_update_in_bplus_tree(uint64_t root_page_id, void* new_record, cons
 		if(new_record != NULL)
 		{
 			// compare key elements of new_record and new_record_key, to be sure that the key elements of the new_record were not changed
-			int key_elements_compare = compare_tuples(new_record, bpttd_p->record_def, bpttd_p->key_element_ids, new_record_key, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count);
+			int key_elements_compare = bpttd_p->key_comparator(new_record, bpttd_p->record_def, bpttd_p->key_element_ids, new_record_key, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, bpttd_p->key_element_count);
 			free(new_record_key);
 
 			// fail if key elements of the new_record were changed
@@ -209,7 +210,7 @@ int inspected_update_in_bplus_tree(uint64_t root_page_id, void* new_record, cons
 
 		result = update_at_in_sorted_packed_page(
 									concerned_leaf, bpttd_p->pas_p->page_size, 
-									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count,
+									bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count, bpttd_p->key_comparator,
 									new_record, 
 									found_index,
 									pmm_p,
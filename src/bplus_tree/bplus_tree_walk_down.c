@@ -7,6 +7,8 @@
 #include<storage_capacity_page_util.h>
 #include<materialized_key.h>
 
+#include<tuple.h>
+
 #include<invalid_tuple_indices.h>
 
 #include<stdlib.h>
@@ -66,6 +68,11 @@ static persistent_page acquire_root_page_with_lock_optimistically(uint64_t root_
 }
 
 locked_pages_stack initialize_locked_pages_stack_for_walk_down(uint64_t root_page_id, int lock_type, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	return initialize_locked_pages_stack_for_walk_down_with_memory(root_page_id, lock_type, NULL, 0, bpttd_p, pam_p, transaction_id, abort_error);
+}
+
+locked_pages_stack initialize_locked_pages_stack_for_walk_down_with_memory(uint64_t root_page_id, int lock_type, locked_page_info* inline_memory, uint32_t inline_capacity, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
 {
 	locked_pages_stack* locked_pages_stack_p = &((locked_pages_stack){});
 
@@ -77,8 +84,13 @@ locked_pages_stack initialize_locked_pages_stack_for_walk_down(uint64_t root_pag
 	// get level of the root_page
 	uint32_t root_page_level = get_level_of_bplus_tree_page(&root_page, bpttd_p);
 
-	// create a stack of capacity = levels
-	if(!initialize_locked_pages_stack(locked_pages_stack_p, root_page_level + 1))
+	// create a stack of capacity = levels, or use all of the inline_memory if it can hold all the levels
+	if(inline_memory != NULL && root_page_level + 1 <= inline_capacity)
+	{
+		if(!initialize_locked_pages_stack_with_memory(locked_pages_stack_p, inline_capacity, inline_memory))
+			exit(-1);
+	}
+	else if(!initialize_locked_pages_stack(locked_pages_stack_p, root_page_level + 1))
 		exit(-1);
 
 	// push the root page onto the stack
@@ -89,6 +101,14 @@ locked_pages_stack initialize_locked_pages_stack_for_walk_down(uint64_t root_pag
 
 int walk_down_locking_parent_pages_for_split_insert(locked_pages_stack* locked_pages_stack_p, const void* key_OR_record, int is_key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
 {
+	return walk_down_locking_parent_pages_for_split_insert_with_upper_fence(locked_pages_stack_p, key_OR_record, is_key, NULL, NULL, bpttd_p, pam_p, transaction_id, abort_error);
+}
+
+int walk_down_locking_parent_pages_for_split_insert_with_upper_fence(locked_pages_stack* locked_pages_stack_p, const void* key_OR_record, int is_key, void* upper_fence, int* has_upper_fence, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	if(has_upper_fence != NULL)
+		(*has_upper_fence) = 0;
+
 	materialized_key mat_key;
 	if(is_key)
 		mat_key = materialize_key_from_tuple(key_OR_record, bpttd_p->key_def, NULL, bpttd_p->key_element_count);
@@ -107,6 +127,19 @@ int walk_down_locking_parent_pages_for_split_insert(locked_pages_stack* locked_p
 		// figure out which child page to go to next
 		curr_locked_page->child_index = find_child_index_for_mat_key(&(curr_locked_page->ppage), &mat_key, bpttd_p->key_element_count, bpttd_p);
 
+		// the index entry right after the child_index, if any, bounds the keys of the child page from above, and it is tighter than the one from any of the parent pages
+		// (ALL_LEAST_KEYS_CHILD_INDEX + 1) == 0, so the first index entry bounds the least keys child
+		if(upper_fence != NULL)
+		{
+			uint32_t fence_index = curr_locked_page->child_index + 1;
+			if(fence_index < get_tuple_count_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def)))
+			{
+				const void* fence_index_entry = get_nth_tuple_on_persistent_page(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, &(bpttd_p->index_def->size_def), fence_index);
+				memory_move(upper_fence, fence_index_entry, get_tuple_size(bpttd_p->index_def, fence_index_entry));
+				(*has_upper_fence) = 1;
+			}
+		}
+
 		// if you reach here, then curr_locked_page is not a leaf page
 		// if curr_locked_page will not require a split, then release locks on all the parent pages of curr_locked_page
 		if(!may_require_split_for_insert_for_bplus_tree(&(curr_locked_page->ppage), bpttd_p->pas_p->page_size, bpttd_p->index_def))
@@ -755,9 +788,9 @@ int narrow_down_range_for_stacked_iterator(locked_pages_stack* locked_pages_stac
 	if(f_pos1 != MIN && f_pos2 != MAX)
 	{
 		// key_OR_record1 must be <= key_OR_record2
-		if(is_key && compare_tuples(key_OR_record1, bpttd_p->key_def, NULL, key_OR_record2, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned) > 0)
+		if(is_key && bpttd_p->key_comparator(key_OR_record1, bpttd_p->key_def, NULL, key_OR_record2, bpttd_p->key_def, NULL, bpttd_p->key_compare_direction, key_element_count_concerned) > 0)
 			return 0;
-		else if(!is_key && compare_tuples(key_OR_record1, bpttd_p->record_def, bpttd_p->key_element_ids, key_OR_record2, bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, key_element_count_concerned) > 0)
+		else if(!is_key && bpttd_p->key_comparator(key_OR_record1, bpttd_p->record_def, bpttd_p->key_element_ids, key_OR_record2, bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, key_element_count_concerned) > 0)
 			return 0;
 	}
 
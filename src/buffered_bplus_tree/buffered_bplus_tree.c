@@ -0,0 +1,445 @@
+#include<buffered_bplus_tree.h>
+
+#include<bplus_tree_page_header.h>
+#include<persistent_page_access_release.h>
+
+#include<page_table.h>
+
+#include<cutlery_stds.h>
+
+#include<stdlib.h>
+
+// buckets of the page_table, holding the root page ids of the 2 bplus_trees
+#define RECORDS_ROOT_BUCKET        0
+#define MESSAGE_BUFFER_ROOT_BUCKET 1
+
+// number of messages read from the message buffer, and then applied to the bplus_tree of the records, at once by a flush
+#define MESSAGES_PER_FLUSH_BATCH 256
+
+uint64_t get_new_buffered_bplus_tree(const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// create a new page_table for the buffered_bplus_tree
+	uint64_t root_page_id = get_new_page_table(&(bbpttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return bbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	// take a range lock on the page table, to set the root_page_ids of the 2 bplus_trees
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, (bucket_range){RECORDS_ROOT_BUCKET, MESSAGE_BUFFER_ROOT_BUCKET}, &(bbpttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return bbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	{
+		uint64_t records_root_page_id = get_new_bplus_tree(&(bbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		set_in_page_table(ptrl_p, RECORDS_ROOT_BUCKET, records_root_page_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		uint64_t message_buffer_root_page_id = get_new_bplus_tree(&(bbpttd_p->message_bpttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		set_in_page_table(ptrl_p, MESSAGE_BUFFER_ROOT_BUCKET, message_buffer_root_page_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+
+	EXIT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, since we only performed set calls with non NULL_PAGE_IDs
+	if(*abort_error)
+		return bbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	return root_page_id;
+}
+
+int get_root_page_ids_for_buffered_bplus_tree(uint64_t root_page_id, buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// take a range lock on the page table
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, (bucket_range){RECORDS_ROOT_BUCKET, MESSAGE_BUFFER_ROOT_BUCKET}, &(bbpttd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	root_page_ids->root_page_id = root_page_id;
+
+	root_page_ids->records_root_page_id = get_from_page_table(ptrl_p, RECORDS_ROOT_BUCKET, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	root_page_ids->message_buffer_root_page_id = get_from_page_table(ptrl_p, MESSAGE_BUFFER_ROOT_BUCKET, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	EXIT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only perforned a read
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+// writes the new_record, replacing the record with the same key (if any)
+static int overwriter_update_inspect(const void* context, const tuple_def* record_def, const void* old_record, void** new_record, void (*cancel_update_callback)(void* cancel_update_callback_context, const void* transaction_id, int* abort_error), void* cancel_update_callback_context, const void* transaction_id, int* abort_error)
+{
+	return 1;
+}
+
+static const update_inspector overwriter_update_inspector = {
+	.context = NULL,
+	.update_inspect = overwriter_update_inspect,
+};
+
+// deletes the message, only if it is still the flushed message (the context), i.e. it was not replaced by a put or a remove, while it was being flushed
+static int flushed_message_deleter_update_inspect(const void* context, const tuple_def* record_def, const void* old_record, void** new_record, void (*cancel_update_callback)(void* cancel_update_callback_context, const void* transaction_id, int* abort_error), void* cancel_update_callback_context, const void* transaction_id, int* abort_error)
+{
+	const void* flushed_message = context;
+
+	if(old_record == NULL)
+		return 0;
+
+	uint32_t old_record_size = get_tuple_size(record_def, old_record);
+	if(old_record_size != get_tuple_size(record_def, flushed_message) || memory_compare(old_record, flushed_message, old_record_size) != 0)
+		return 0;
+
+	(*new_record) = NULL;
+	return 1;
+}
+
+// takes a WRITE_LOCK on the root page of the page_table, it is held by the flushes (and the puts and removes that skip the message buffer), so that only 1 of them runs at a time
+// it returns NULL, only on an abort_error
+static page_table_range_locker* lock_for_flush(const buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_ids->root_page_id, (bucket_range){RECORDS_ROOT_BUCKET, MESSAGE_BUFFER_ROOT_BUCKET}, &(bbpttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return NULL;
+	return ptrl_p;
+}
+
+// applies the put of the record (or the removal of the key, if record == NULL) directly to the bplus_tree of the records, for a message that does not fit in the message buffer
+// the older message for the key is deleted first, else it would shadow this put or removal, until it gets flushed
+static int apply_to_records(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, const void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// a flush in progress could otherwise apply the older message for the key, after this put or removal
+	page_table_range_locker* ptrl_p = lock_for_flush(root_page_ids, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// key will never be bigger than the largest index_record
+	void* record_key = NULL;
+	if(record != NULL)
+	{
+		record_key = malloc(bbpttd_p->bpttd.max_index_record_size);
+		if(record_key == NULL)
+			exit(-1);
+		extract_key_from_record_tuple_using_bplus_tree_tuple_definitions(&(bbpttd_p->bpttd), record, record_key);
+		key = record_key;
+	}
+
+	// the key_def of the message buffer has the same elements as the key_def of the bplus_tree of the records
+	delete_from_bplus_tree(root_page_ids->message_buffer_root_page_id, key, &(bbpttd_p->message_bpttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	// the overwriter_update_inspector never modifies the new_record, so the record is passed as is
+	if(record != NULL)
+		inspected_update_in_bplus_tree(root_page_ids->records_root_page_id, (void*)record, &overwriter_update_inspector, &(bbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+	else
+		delete_from_bplus_tree(root_page_ids->records_root_page_id, key, &(bbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	EXIT:;
+	if(record_key != NULL)
+		free(record_key);
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we did not modify the page_table
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+// returns the height of the message buffer, i.e. (level of its root page + 1), it returns 0, only on an abort_error
+static uint32_t get_height_of_message_buffer(const buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	persistent_page root_page = acquire_persistent_page_with_lock(pam_p, transaction_id, root_page_ids->message_buffer_root_page_id, READ_LOCK, abort_error);
+	if(*abort_error)
+		return 0;
+
+	uint32_t height = get_level_of_bplus_tree_page(&root_page, &(bbpttd_p->message_bpttd)) + 1;
+
+	release_lock_on_persistent_page(pam_p, transaction_id, &root_page, NONE_OPTION, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return height;
+}
+
+// writes the message for the put of the record (or for the removal of the key, if record == NULL), and flushes the message buffer if it has grown beyond max_buffer_height
+static int write_message(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, const void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	void* message = malloc(bbpttd_p->message_bpttd.max_record_size);
+	if(message == NULL)
+		exit(-1);
+
+	if(!build_message_using_buffered_bplus_tree_tuple_definitions(bbpttd_p, key, record, message))
+	{
+		free(message);
+		return apply_to_records(root_page_ids, key, record, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	}
+
+	// the message replaces the older message for its key, if any
+	inspected_update_in_bplus_tree(root_page_ids->message_buffer_root_page_id, message, &overwriter_update_inspector, &(bbpttd_p->message_bpttd), pam_p, pmm_p, transaction_id, abort_error);
+	free(message);
+	if(*abort_error)
+		return 0;
+
+	uint32_t message_buffer_height = get_height_of_message_buffer(root_page_ids, bbpttd_p, pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	if(message_buffer_height > bbpttd_p->max_buffer_height)
+	{
+		flush_buffered_bplus_tree(root_page_ids, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+	}
+
+	return 1;
+}
+
+int put_in_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(&(bbpttd_p->bpttd), record))
+		return 0;
+
+	return write_message(root_page_ids, NULL, record, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int remove_from_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	return write_message(root_page_ids, key, NULL, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int find_in_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const void* key, void* record, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	int found = 0;
+
+	// look for the message for the key first, it is always newer than the record in the bplus_tree of the records
+	{
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_ids->message_buffer_root_page_id, key, KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS, 0, READ_LOCK, &(bbpttd_p->message_bpttd), pam_p, NULL, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		const void* message = get_tuple_bplus_tree_iterator(bpi_p);
+		int has_message = (message != NULL && 0 == bbpttd_p->message_bpttd.key_comparator(message, bbpttd_p->message_def, bbpttd_p->message_key_element_ids, key, bbpttd_p->message_bpttd.key_def, NULL, bbpttd_p->message_bpttd.key_compare_direction, bbpttd_p->message_bpttd.key_element_count));
+		if(has_message)
+		{
+			// a removal message carries no record
+			const void* message_record = get_record_from_message_using_buffered_bplus_tree_tuple_definitions(bbpttd_p, message);
+			if(message_record != NULL)
+			{
+				memory_move(record, message_record, get_tuple_size(bbpttd_p->bpttd.record_def, message_record));
+				found = 1;
+			}
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		if(has_message)
+			return found;
+	}
+
+	// there is no message for the key, so look in the bplus_tree of the records
+	{
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_ids->records_root_page_id, key, KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS, 0, READ_LOCK, &(bbpttd_p->bpttd), pam_p, NULL, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		const void* found_record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(found_record != NULL && 0 == bbpttd_p->bpttd.key_comparator(found_record, bbpttd_p->bpttd.record_def, bbpttd_p->bpttd.key_element_ids, key, bbpttd_p->bpttd.key_def, NULL, bbpttd_p->bpttd.key_compare_direction, bbpttd_p->bpttd.key_element_count))
+		{
+			memory_move(record, found_record, get_tuple_size(bbpttd_p->bpttd.record_def, found_record));
+			found = 1;
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+	}
+
+	return found;
+}
+
+// applies the messages (sorted by their keys) to the bplus_tree of the records
+// the removals are applied one by one, while all the puts are applied as 1 batch, that walks down once per leaf page
+static int apply_messages_to_records(const buffered_bplus_tree_root_page_ids* root_page_ids, void* const* messages, uint32_t messages_count, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	const void** records = malloc(sizeof(void*) * messages_count);
+	if(records == NULL)
+		exit(-1);
+	uint32_t records_count = 0;
+
+	// key will never be bigger than the largest index_record
+	void* key = malloc(bbpttd_p->message_bpttd.max_index_record_size);
+	if(key == NULL)
+		exit(-1);
+
+	for(uint32_t i = 0; i < messages_count; i++)
+	{
+		const void* record = get_record_from_message_using_buffered_bplus_tree_tuple_definitions(bbpttd_p, messages[i]);
+		if(record != NULL)
+		{
+			records[records_count++] = record;
+			continue;
+		}
+
+		// the key_def of the message buffer has the same elements as the key_def of the bplus_tree of the records
+		extract_key_from_record_tuple_using_bplus_tree_tuple_definitions(&(bbpttd_p->message_bpttd), messages[i], key);
+		delete_from_bplus_tree(root_page_ids->records_root_page_id, key, &(bbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+
+	if(records_count > 0)
+	{
+		upsert_batch_in_bplus_tree(root_page_ids->records_root_page_id, records, records_count, &(bbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+
+	EXIT:;
+	free(key);
+	free(records);
+
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+int flush_buffered_bplus_tree(const buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	page_table_range_locker* ptrl_p = lock_for_flush(root_page_ids, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// copies of the messages of the current batch
+	void** messages = malloc(sizeof(void*) * MESSAGES_PER_FLUSH_BATCH);
+	if(messages == NULL)
+		exit(-1);
+	uint32_t messages_count = 0;
+
+	while(1)
+	{
+		// read the next batch of messages, the messages of the last batch have been deleted, so the batch always starts at the first message
+		{
+			bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_ids->message_buffer_root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, &(bbpttd_p->message_bpttd), pam_p, NULL, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+
+			while(messages_count < MESSAGES_PER_FLUSH_BATCH && !is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+			{
+				const void* message = get_tuple_bplus_tree_iterator(bpi_p);
+				if(message != NULL)
+				{
+					uint32_t message_size = get_tuple_size(bbpttd_p->message_def, message);
+					messages[messages_count] = malloc(message_size);
+					if(messages[messages_count] == NULL)
+						exit(-1);
+					memory_move(messages[messages_count++], message, message_size);
+				}
+
+				next_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+				if(*abort_error)
+				{
+					delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+					goto EXIT;
+				}
+			}
+
+			delete_bplus_tree_iterator(bpi_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		if(messages_count == 0)
+			break;
+
+		if(!apply_messages_to_records(root_page_ids, messages, messages_count, bbpttd_p, pam_p, pmm_p, transaction_id, abort_error))
+			goto EXIT;
+
+		// delete the flushed messages from the message buffer, unless they were replaced in the meantime
+		for(uint32_t i = 0; i < messages_count; i++)
+		{
+			inspected_update_in_bplus_tree(root_page_ids->message_buffer_root_page_id, messages[i], &((update_inspector){.context = messages[i], .update_inspect = flushed_message_deleter_update_inspect}), &(bbpttd_p->message_bpttd), pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		int was_last_batch = (messages_count < MESSAGES_PER_FLUSH_BATCH);
+
+		for(uint32_t i = 0; i < messages_count; i++)
+			free(messages[i]);
+		messages_count = 0;
+
+		// the messages written after this flush started, are left for the next flush
+		if(was_last_batch)
+			break;
+	}
+
+	EXIT:;
+	for(uint32_t i = 0; i < messages_count; i++)
+		free(messages[i]);
+	free(messages);
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we did not modify the page_table
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+int destroy_buffered_bplus_tree(uint64_t root_page_id, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	buffered_bplus_tree_root_page_ids root_page_ids;
+	if(!get_root_page_ids_for_buffered_bplus_tree(root_page_id, &root_page_ids, bbpttd_p, pam_p, transaction_id, abort_error))
+		return 0;
+
+	destroy_bplus_tree(root_page_ids.records_root_page_id, &(bbpttd_p->bpttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	destroy_bplus_tree(root_page_ids.message_buffer_root_page_id, &(bbpttd_p->message_bpttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	destroy_page_table(root_page_id, &(bbpttd_p->pttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+void print_buffered_bplus_tree(uint64_t root_page_id, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	printf("\n\nBuffered_bplus_tree @ root_page_id = %"PRIu64"\n\n", root_page_id);
+
+	print_page_table(root_page_id, 0, &(bbpttd_p->pttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return;
+
+	buffered_bplus_tree_root_page_ids root_page_ids;
+	if(!get_root_page_ids_for_buffered_bplus_tree(root_page_id, &root_page_ids, bbpttd_p, pam_p, transaction_id, abort_error))
+		return;
+
+	printf("\nrecords :\n");
+	print_bplus_tree(root_page_ids.records_root_page_id, 0, &(bbpttd_p->bpttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return;
+
+	printf("\nmessage buffer :\n");
+	print_bplus_tree(root_page_ids.message_buffer_root_page_id, 0, &(bbpttd_p->message_bpttd), pam_p, transaction_id, abort_error);
+}
@@ -0,0 +1,163 @@
+#include<buffered_bplus_tree_tuple_definitions_public.h>
+
+#include<stdlib.h>
+#include<string.h>
+
+int init_buffered_bplus_tree_tuple_definitions(buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, const compare_direction* key_compare_direction, uint32_t key_element_count, uint32_t max_buffer_height)
+{
+	// zero initialize bbpttd_p
+	(*bbpttd_p) = (buffered_bplus_tree_tuple_defs){};
+
+	// basic parameter check
+	if(max_buffer_height == 0)
+		return 0;
+
+	bbpttd_p->max_buffer_height = max_buffer_height;
+
+	if(!init_bplus_tree_tuple_definitions(&(bbpttd_p->bpttd), pas_p, record_def, key_element_ids, key_compare_direction, key_element_count))
+	{
+		deinit_buffered_bplus_tree_tuple_definitions(bbpttd_p);
+		return 0;
+	}
+
+	// allocate memory for message_def and initialize it
+	{
+		// a blob type for the whole record, that could possibly span a complete page
+		data_type_info* record_blob_type_info = malloc(sizeof(data_type_info));
+		if(record_blob_type_info == NULL)
+			exit(-1);
+		(*record_blob_type_info) = get_variable_length_blob_type("record", pas_p->page_size);
+
+		data_type_info* message_type_info = malloc(sizeof_tuple_data_type_info(key_element_count + 1));
+		if(message_type_info == NULL)
+			exit(-1);
+		initialize_tuple_data_type_info(message_type_info, "temp_message_def", 1, pas_p->page_size, key_element_count + 1);
+
+		for(uint32_t i = 0; i < key_element_count; i++)
+		{
+			message_type_info->containees[i].field_name[0] = '\0'; // field name here is redundant
+			message_type_info->containees[i].al.type_info = (data_type_info*) get_type_info_for_element_from_tuple_def(record_def, key_element_ids[i]);
+		}
+
+		strcpy(message_type_info->containees[key_element_count].field_name, "record");
+		message_type_info->containees[key_element_count].al.type_info = record_blob_type_info;
+
+		bbpttd_p->message_def = malloc(sizeof(tuple_def));
+		if(bbpttd_p->message_def == NULL)
+			exit(-1);
+		if(!initialize_tuple_def(bbpttd_p->message_def, message_type_info))
+		{
+			free(bbpttd_p->message_def);
+			free(message_type_info);
+			free(record_blob_type_info);
+			bbpttd_p->message_def = NULL; // avoid double free due to below call
+			deinit_buffered_bplus_tree_tuple_definitions(bbpttd_p);
+			return 0;
+		}
+	}
+
+	// the key elements are the leading elements of the message, the positions are allocated right after the positional_accessors, so that they get freed with them
+	{
+		bbpttd_p->message_key_element_ids = malloc((sizeof(positional_accessor) + sizeof(uint32_t)) * key_element_count);
+		if(bbpttd_p->message_key_element_ids == NULL)
+			exit(-1);
+
+		uint32_t* positions = (uint32_t*)(bbpttd_p->message_key_element_ids + key_element_count);
+		for(uint32_t i = 0; i < key_element_count; i++)
+		{
+			positions[i] = i;
+			bbpttd_p->message_key_element_ids[i] = (positional_accessor){.positions_length = 1, .positions = positions + i};
+		}
+	}
+
+	if(!init_bplus_tree_tuple_definitions(&(bbpttd_p->message_bpttd), pas_p, bbpttd_p->message_def, bbpttd_p->message_key_element_ids, key_compare_direction, key_element_count))
+	{
+		deinit_buffered_bplus_tree_tuple_definitions(bbpttd_p);
+		return 0;
+	}
+
+	if(!init_page_table_tuple_definitions(&(bbpttd_p->pttd), pas_p))
+	{
+		deinit_buffered_bplus_tree_tuple_definitions(bbpttd_p);
+		return 0;
+	}
+
+	return 1;
+}
+
+int build_message_using_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p, const void* key, const void* record, void* message)
+{
+	const uint32_t max_message_size = bbpttd_p->message_bpttd.max_record_size;
+
+	init_tuple(bbpttd_p->message_def, message);
+
+	// copy the key elements from the record (or from the key) into the message
+	for(uint32_t i = 0; i < bbpttd_p->bpttd.key_element_count; i++)
+	{
+		int can_set_in_message = 0;
+		if(record != NULL)
+			can_set_in_message = set_element_in_tuple_from_tuple(bbpttd_p->message_def, STATIC_POSITION(i), message, bbpttd_p->bpttd.record_def, bbpttd_p->bpttd.key_element_ids[i], record, max_message_size - get_tuple_size(bbpttd_p->message_def, message));
+		else
+			can_set_in_message = set_element_in_tuple_from_tuple(bbpttd_p->message_def, STATIC_POSITION(i), message, bbpttd_p->bpttd.key_def, STATIC_POSITION(i), key, max_message_size - get_tuple_size(bbpttd_p->message_def, message));
+		if(!can_set_in_message)
+			return 0;
+	}
+
+	// a removal message carries an empty blob, a record is never 0 bytes
+	user_value record_blob = {.blob_value = "", .blob_size = 0};
+	if(record != NULL)
+		record_blob = (user_value){.blob_value = record, .blob_size = get_tuple_size(bbpttd_p->bpttd.record_def, record)};
+	if(!set_element_in_tuple(bbpttd_p->message_def, STATIC_POSITION(bbpttd_p->bpttd.key_element_count), message, &record_blob, max_message_size - get_tuple_size(bbpttd_p->message_def, message)))
+		return 0;
+
+	return check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(&(bbpttd_p->message_bpttd), message);
+}
+
+const void* get_record_from_message_using_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p, const void* message)
+{
+	user_value record_blob;
+	if(!get_value_from_element_from_tuple(&record_blob, bbpttd_p->message_def, STATIC_POSITION(bbpttd_p->bpttd.key_element_count), message) || is_user_value_NULL(&record_blob))
+		return NULL;
+
+	if(record_blob.blob_size == 0)
+		return NULL;
+
+	return record_blob.blob_value;
+}
+
+void deinit_buffered_bplus_tree_tuple_definitions(buffered_bplus_tree_tuple_defs* bbpttd_p)
+{
+	// the message_def is built only after the bpttd, so its key_element_count is still valid here
+	if(bbpttd_p->message_def)
+	{
+		if(bbpttd_p->message_def->type_info)
+		{
+			free(bbpttd_p->message_def->type_info->containees[bbpttd_p->bpttd.key_element_count].al.type_info);
+			free(bbpttd_p->message_def->type_info);
+		}
+		free(bbpttd_p->message_def);
+	}
+	if(bbpttd_p->message_key_element_ids)
+		free(bbpttd_p->message_key_element_ids);
+
+	deinit_bplus_tree_tuple_definitions(&(bbpttd_p->bpttd));
+	deinit_bplus_tree_tuple_definitions(&(bbpttd_p->message_bpttd));
+	deinit_page_table_tuple_definitions(&(bbpttd_p->pttd));
+	bbpttd_p->message_def = NULL;
+	bbpttd_p->message_key_element_ids = NULL;
+	bbpttd_p->max_buffer_height = 0;
+}
+
+void print_buffered_bplus_tree_tuple_definitions(const buffered_bplus_tree_tuple_defs* bbpttd_p)
+{
+	printf("Buffered_bplus_tree tuple defs:\n");
+
+	printf("max_buffer_height = %"PRIu32"\n", bbpttd_p->max_buffer_height);
+
+	print_bplus_tree_tuple_definitions(&(bbpttd_p->bpttd));
+
+	printf("message_bpttd : ");
+	print_bplus_tree_tuple_definitions(&(bbpttd_p->message_bpttd));
+
+	print_page_table_tuple_definitions(&(bbpttd_p->pttd));
+}
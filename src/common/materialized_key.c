@@ -8,13 +8,11 @@ materialized_key materialize_key_from_tuple(const void* tuple, const tuple_def*
 
 	mat_key.key_element_count = key_element_count;
 
-	mat_key.key_dtis = malloc(sizeof(data_type_info*) * key_element_count);
-	if(mat_key.key_dtis == NULL)
-		exit(-1);
-
-	mat_key.keys = malloc(sizeof(user_value) * key_element_count);
+	// keys and key_dtis share a single allocation (keys first, since they need the stricter alignment), it is made on every walk down
+	mat_key.keys = malloc((sizeof(user_value) + sizeof(data_type_info*)) * key_element_count);
 	if(mat_key.keys == NULL)
 		exit(-1);
+	mat_key.key_dtis = (data_type_info const **)(mat_key.keys + key_element_count);
 
 	for(uint32_t i = 0; i < key_element_count; i++)
 	{
@@ -28,8 +26,8 @@ materialized_key materialize_key_from_tuple(const void* tuple, const tuple_def*
 void destroy_materialized_key(materialized_key* mat_key)
 {
 	mat_key->key_element_count = 0;
-	if(mat_key->key_dtis != NULL)
-		free((void*)(mat_key->key_dtis));
+	mat_key->key_dtis = NULL;
 	if(mat_key->keys != NULL)
 		free((void*)(mat_key->keys));
+	mat_key->keys = NULL;
 }
\ No newline at end of file
@@ -0,0 +1,572 @@
+#include<extendible_hash_table.h>
+
+#include<page_table.h>
+#include<array_table.h>
+
+#include<stdlib.h>
+
+// the bucket (a single leaf page array_table) is always locked over all of its slots
+#define BUCKET_RANGE(ehttd_p) ((bucket_range){0, (ehttd_p)->attd.leaf_entries_per_page - 1})
+
+// the local_depth of a bucket is capped at 20, a split beyond it fails the insert
+// else a bucket full of records that agree on many of their least significant hash bits (a skewed hash), would be split again and again, doubling the directory every time
+// the global_depth never exceeds the largest local_depth, so the directory is capped at 2^20 entries, and its directory_index bits never overlap with the 32 bits that pick the home slot in the bucket
+#define MAX_LOCAL_DEPTH 20
+
+// the directory_size is always a power of 2, so its least significant bits pick the directory entry
+static uint64_t get_directory_index(uint64_t hash_value, uint64_t directory_size)
+{
+	return hash_value & (directory_size - 1);
+}
+
+// the slot to start probing the bucket from, it is picked by the most significant bits, as the least significant ones are the same for all the records of a bucket
+static uint64_t get_home_slot_in_bucket(uint64_t hash_value, const extendible_hash_table_tuple_defs* ehttd_p)
+{
+	return (hash_value >> 32) % ehttd_p->attd.leaf_entries_per_page;
+}
+
+// the directory_size is the index of the only non NULL_PAGE_ID entry that points back to the root_page_id
+static uint64_t get_directory_size(page_table_range_locker* ptrl_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t directory_size;
+	find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &directory_size, MAX, transaction_id, abort_error);
+	return directory_size;
+}
+
+// returns 2 ^ local_depth of the bucket at the directory_index, the ptrl_p must be holding a lock on the WHOLE_BUCKET_RANGE
+// all the directory entries that point to this bucket, share the least significant local_depth bits with the directory_index
+static uint64_t get_local_depth_mask(page_table_range_locker* ptrl_p, uint64_t directory_index, uint64_t bucket_page_id, uint64_t directory_size, const void* transaction_id, int* abort_error)
+{
+	uint64_t local_depth_mask = directory_size;
+	while(local_depth_mask > 1)
+	{
+		uint64_t buddy_page_id = get_from_page_table(ptrl_p, directory_index ^ (local_depth_mask >> 1), transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+		if(buddy_page_id != bucket_page_id)
+			break;
+		local_depth_mask >>= 1;
+	}
+	return local_depth_mask;
+}
+
+// probes the bucket for the key (conforming to key_def and key_element_ids), starting at the home slot of the hash_value
+// returns the record if found and its slot in the (*slot)
+// else returns NULL, with (*slot) set to the empty slot that ended the probe, it is set to leaf_entries_per_page if the bucket is full
+static const void* probe_bucket(array_table_range_locker* atrl_p, const void* key, const tuple_def* key_def, const positional_accessor* key_element_ids, uint64_t hash_value, uint64_t* slot, const extendible_hash_table_tuple_defs* ehttd_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t home_slot = get_home_slot_in_bucket(hash_value, ehttd_p);
+	for(uint64_t i = 0; i < ehttd_p->attd.leaf_entries_per_page; i++)
+	{
+		(*slot) = (home_slot + i) % ehttd_p->attd.leaf_entries_per_page;
+
+		const void* record = get_from_array_table(atrl_p, (*slot), NULL, transaction_id, abort_error);
+		if(*abort_error)
+			return NULL;
+
+		// the records are never left behind an empty slot on their probe sequence, so the key is not in this bucket
+		if(record == NULL)
+			return NULL;
+
+		if(0 == compare_tuples(record, ehttd_p->attd.record_def, ehttd_p->key_element_ids, key, key_def, key_element_ids, NULL, ehttd_p->key_element_count))
+			return record;
+	}
+
+	(*slot) = ehttd_p->attd.leaf_entries_per_page;
+	return NULL;
+}
+
+// places the record in the first empty slot of its probe sequence, without looking for a duplicate
+// returns 0, only if the bucket is full OR on an abort_error
+static int place_record_in_bucket(array_table_range_locker* atrl_p, const void* record, uint64_t hash_value, const extendible_hash_table_tuple_defs* ehttd_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t home_slot = get_home_slot_in_bucket(hash_value, ehttd_p);
+	for(uint64_t i = 0; i < ehttd_p->attd.leaf_entries_per_page; i++)
+	{
+		uint64_t slot = (home_slot + i) % ehttd_p->attd.leaf_entries_per_page;
+
+		const void* slot_record = get_from_array_table(atrl_p, slot, NULL, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+
+		if(slot_record == NULL)
+			return set_in_array_table(atrl_p, slot, record, transaction_id, abort_error);
+	}
+	return 0;
+}
+
+// locks the bucket that the hash_value belongs to, the directory is read locked only until the bucket is locked
+// the bucket is write locked if pmm_p != NULL, else it is read locked
+// returns NULL only on an abort_error
+static array_table_range_locker* lock_bucket_for_hash_value(uint64_t root_page_id, uint64_t hash_value, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	array_table_range_locker* atrl_p = NULL;
+
+	// take a read lock on the directory
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(ehttd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return NULL;
+
+	uint64_t directory_size = get_directory_size(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	uint64_t directory_index = get_directory_index(hash_value, directory_size);
+
+	// we only need the one directory entry now
+	minimize_lock_range_for_page_table_range_locker(ptrl_p, (bucket_range){directory_index, directory_index}, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	uint64_t bucket_page_id = get_from_page_table(ptrl_p, directory_index, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	// lock the bucket, before releasing the lock on the directory, so that it can not be split in between
+	atrl_p = get_new_array_table_range_locker(bucket_page_id, BUCKET_RANGE(ehttd_p), &(ehttd_p->attd), pam_p, pmm_p, transaction_id, abort_error);
+
+	EXIT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed a read
+	if(*abort_error)
+	{
+		if(atrl_p != NULL)
+			delete_array_table_range_locker(atrl_p, NULL, NULL, transaction_id, abort_error);
+		return NULL;
+	}
+	return atrl_p;
+}
+
+uint64_t get_new_extendible_hash_table(const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// create a new page_table for the directory
+	uint64_t root_page_id = get_new_page_table(&(ehttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return ehttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	// create the first bucket, with global_depth = local_depth = 0
+	uint64_t bucket_page_id = get_new_array_table(&(ehttd_p->attd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return ehttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, (bucket_range){0, 1}, &(ehttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return ehttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	// page_table[0] = bucket_page_id
+	set_in_page_table(ptrl_p, 0, bucket_page_id, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	// page_table[1] = root_page_id, i.e. directory_size = 1
+	set_in_page_table(ptrl_p, 1, root_page_id, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	EXIT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, since we only performed set calls
+	if(*abort_error)
+		return ehttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	return root_page_id;
+}
+
+int find_in_extendible_hash_table(uint64_t root_page_id, const void* key, void* record, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t hash_value = get_hash_value_for_key_using_extendible_hash_table_tuple_definitions(ehttd_p, key);
+
+	array_table_range_locker* atrl_p = lock_bucket_for_hash_value(root_page_id, hash_value, ehttd_p, pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	uint64_t slot;
+	const void* found_record = probe_bucket(atrl_p, key, ehttd_p->key_def, NULL, hash_value, &slot, ehttd_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	if(found_record != NULL && record != NULL)
+		memory_move(record, found_record, get_minimum_tuple_size(ehttd_p->attd.record_def));
+
+	EXIT:;
+	delete_array_table_range_locker(atrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed a read
+	if(*abort_error)
+		return 0;
+
+	return found_record != NULL;
+}
+
+// inserts the record, with the directory write locked, splitting the bucket (and doubling the directory) until the record fits
+static int split_and_insert_in_extendible_hash_table(uint64_t root_page_id, const void* record, uint64_t hash_value, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// zero initialize all local variables of the function
+	int result = 0;
+	page_table_range_locker* ptrl_p = NULL;
+	array_table_range_locker* split_buckets[2] = {};
+	void* split_records = NULL;
+
+	uint32_t record_size = get_minimum_tuple_size(ehttd_p->attd.record_def);
+
+	// take a write lock on the directory
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(ehttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	while(1)
+	{
+		uint64_t directory_size = get_directory_size(ptrl_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		uint64_t directory_index = get_directory_index(hash_value, directory_size);
+
+		uint64_t bucket_page_id = get_from_page_table(ptrl_p, directory_index, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		split_buckets[0] = get_new_array_table_range_locker(bucket_page_id, BUCKET_RANGE(ehttd_p), &(ehttd_p->attd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		// some other insert may have split the bucket or a delete may have made room in it, so probe it again
+		uint64_t slot;
+		const void* found_record = probe_bucket(split_buckets[0], record, ehttd_p->attd.record_def, ehttd_p->key_element_ids, hash_value, &slot, ehttd_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		if(found_record != NULL)
+		{
+			result = 0;
+			goto EXIT;
+		}
+
+		if(slot < ehttd_p->attd.leaf_entries_per_page)
+		{
+			result = set_in_array_table(split_buckets[0], slot, record, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+			goto EXIT;
+		}
+
+		// the bucket is full, it needs to be split
+		// but if all its records have the same hash_value as the record, no number of splits will ever make room for it
+		int all_hash_values_identical = 1;
+		for(uint64_t i = 0; i < ehttd_p->attd.leaf_entries_per_page && all_hash_values_identical; i++)
+		{
+			const void* bucket_record = get_from_array_table(split_buckets[0], i, NULL, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+
+			all_hash_values_identical = (hash_value == get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(ehttd_p, bucket_record));
+		}
+		if(all_hash_values_identical)
+		{
+			result = 0;
+			goto EXIT;
+		}
+
+		uint64_t local_depth_mask = get_local_depth_mask(ptrl_p, directory_index, bucket_page_id, directory_size, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		// the split would take the local_depth beyond MAX_LOCAL_DEPTH
+		if(local_depth_mask >= (UINT64_C(1) << MAX_LOCAL_DEPTH))
+		{
+			result = 0;
+			goto EXIT;
+		}
+
+		// if local_depth == global_depth, double the directory
+		if(local_depth_mask == directory_size)
+		{
+			// page_table[directory_size + i] = page_table[i], this also overwrites the old sentinel at page_table[directory_size]
+			for(uint64_t i = 0; i < directory_size; i++)
+			{
+				uint64_t page_id = get_from_page_table(ptrl_p, i, transaction_id, abort_error);
+				if(*abort_error)
+					goto EXIT;
+
+				set_in_page_table(ptrl_p, directory_size + i, page_id, transaction_id, abort_error);
+				if(*abort_error)
+					goto EXIT;
+			}
+
+			directory_size *= 2;
+
+			// page_table[directory_size] = root_page_id
+			set_in_page_table(ptrl_p, directory_size, root_page_id, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		// create the new bucket, for the records that have the local_depth-th bit of their hash_value set
+		uint64_t new_bucket_page_id = get_new_array_table(&(ehttd_p->attd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		// point half of the directory entries of the old bucket to the new bucket
+		for(uint64_t i = (directory_index & (local_depth_mask - 1)) | local_depth_mask; i < directory_size; i += (2 * local_depth_mask))
+		{
+			set_in_page_table(ptrl_p, i, new_bucket_page_id, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		split_buckets[1] = get_new_array_table_range_locker(new_bucket_page_id, BUCKET_RANGE(ehttd_p), &(ehttd_p->attd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		// copy out all the records of the old bucket and empty it, since their probe sequences change
+		if(split_records == NULL)
+		{
+			split_records = malloc(ehttd_p->attd.leaf_entries_per_page * record_size);
+			if(split_records == NULL)
+				exit(-1);
+		}
+
+		for(uint64_t i = 0; i < ehttd_p->attd.leaf_entries_per_page; i++)
+		{
+			get_from_array_table(split_buckets[0], i, split_records + i * record_size, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+
+			set_in_array_table(split_buckets[0], i, NULL, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		// place each of them in the bucket, given by the local_depth-th bit of its hash_value
+		for(uint64_t i = 0; i < ehttd_p->attd.leaf_entries_per_page; i++)
+		{
+			const void* split_record = split_records + i * record_size;
+			uint64_t split_record_hash_value = get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(ehttd_p, split_record);
+
+			// this never fails, as the bucket it goes to can not have more records than the old bucket had
+			place_record_in_bucket(split_buckets[(split_record_hash_value & local_depth_mask) ? 1 : 0], split_record, split_record_hash_value, ehttd_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto EXIT;
+		}
+
+		// release both the buckets and retry, the record may still not fit if all the records went to the same bucket
+		for(int i = 0; i < 2; i++)
+		{
+			delete_array_table_range_locker(split_buckets[i], NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, the bucket is a single leaf page
+			split_buckets[i] = NULL;
+			if(*abort_error)
+				goto EXIT;
+		}
+	}
+
+	EXIT:;
+	for(int i = 0; i < 2; i++)
+		if(split_buckets[i] != NULL)
+			delete_array_table_range_locker(split_buckets[i], NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, the bucket is a single leaf page
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, the directory only grows
+	if(split_records != NULL)
+		free(split_records);
+
+	if(*abort_error)
+		return 0;
+
+	return result;
+}
+
+int insert_in_extendible_hash_table(uint64_t root_page_id, const void* record, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// check that the record could be inserted
+	if(!check_if_record_can_be_inserted_for_extendible_hash_table_tuple_definitions(ehttd_p, record))
+		return 0;
+
+	uint64_t hash_value = get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(ehttd_p, record);
+
+	// first try with only a read lock on the directory, this succeeds unless the bucket is full
+	array_table_range_locker* atrl_p = lock_bucket_for_hash_value(root_page_id, hash_value, ehttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	int result = 0;
+	int bucket_full = 0;
+
+	uint64_t slot;
+	const void* found_record = probe_bucket(atrl_p, record, ehttd_p->attd.record_def, ehttd_p->key_element_ids, hash_value, &slot, ehttd_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	if(found_record != NULL)
+		result = 0;
+	else if(slot < ehttd_p->attd.leaf_entries_per_page)
+	{
+		result = set_in_array_table(atrl_p, slot, record, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+	else
+		bucket_full = 1;
+
+	EXIT:;
+	delete_array_table_range_locker(atrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, the bucket is a single leaf page
+	if(*abort_error)
+		return 0;
+
+	if(bucket_full)
+		return split_and_insert_in_extendible_hash_table(root_page_id, record, hash_value, ehttd_p, pam_p, pmm_p, transaction_id, abort_error);
+
+	return result;
+}
+
+int delete_from_extendible_hash_table(uint64_t root_page_id, const void* key, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t hash_value = get_hash_value_for_key_using_extendible_hash_table_tuple_definitions(ehttd_p, key);
+
+	array_table_range_locker* atrl_p = lock_bucket_for_hash_value(root_page_id, hash_value, ehttd_p, pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	int result = 0;
+	void* shifted_record = NULL;
+
+	uint64_t hole_slot;
+	const void* found_record = probe_bucket(atrl_p, key, ehttd_p->key_def, NULL, hash_value, &hole_slot, ehttd_p, transaction_id, abort_error);
+	if(*abort_error || found_record == NULL)
+		goto EXIT;
+
+	uint32_t record_size = get_minimum_tuple_size(ehttd_p->attd.record_def);
+	shifted_record = malloc(record_size);
+	if(shifted_record == NULL)
+		exit(-1);
+
+	// backward shift, move every following record of the probe run, that may not be left behind the hole, into the hole
+	for(uint64_t i = 1; i < ehttd_p->attd.leaf_entries_per_page; i++)
+	{
+		uint64_t slot = (hole_slot + i) % ehttd_p->attd.leaf_entries_per_page;
+
+		if(NULL == get_from_array_table(atrl_p, slot, shifted_record, transaction_id, abort_error))
+			break;
+		if(*abort_error)
+			goto EXIT;
+
+		uint64_t home_slot = get_home_slot_in_bucket(get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(ehttd_p, shifted_record), ehttd_p);
+
+		// the record can move to the hole, only if its home_slot is not cyclically in (hole_slot, slot]
+		uint64_t distance_from_home = (slot + ehttd_p->attd.leaf_entries_per_page - home_slot) % ehttd_p->attd.leaf_entries_per_page;
+		uint64_t distance_from_hole = (slot + ehttd_p->attd.leaf_entries_per_page - hole_slot) % ehttd_p->attd.leaf_entries_per_page;
+		if(distance_from_home < distance_from_hole)
+			continue;
+
+		set_in_array_table(atrl_p, hole_slot, shifted_record, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+
+		hole_slot = slot;
+		i = 0;
+	}
+	if(*abort_error)
+		goto EXIT;
+
+	// empty the last hole
+	result = set_in_array_table(atrl_p, hole_slot, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	EXIT:;
+	delete_array_table_range_locker(atrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, the bucket is a single leaf page
+	if(shifted_record != NULL)
+		free(shifted_record);
+
+	if(*abort_error)
+		return 0;
+
+	return result;
+}
+
+int destroy_extendible_hash_table(uint64_t root_page_id, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// take a range lock on the directory
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(ehttd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	uint64_t directory_size = get_directory_size(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+	// destroy each bucket only once, at the least directory_index that points to it
+	for(uint64_t directory_index = 0; directory_index < directory_size; directory_index++)
+	{
+		uint64_t bucket_page_id = get_from_page_table(ptrl_p, directory_index, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+		uint64_t local_depth_mask = get_local_depth_mask(ptrl_p, directory_index, bucket_page_id, directory_size, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+		if(directory_index >= local_depth_mask)
+			continue;
+
+		destroy_array_table(bucket_page_id, &(ehttd_p->attd), pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, since we are anyway destroying it
+	if(*abort_error)
+		return 0;
+
+	// now you may destroy the directory
+	destroy_page_table(root_page_id, &(ehttd_p->pttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+
+	DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	return 0;
+}
+
+void print_extendible_hash_table(uint64_t root_page_id, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// take a range lock on the directory
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(ehttd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return ;
+
+	uint64_t directory_size = get_directory_size(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+	printf("\n\nExtendible_hash_table @ root_page_id = %"PRIu64", and directory_size = %"PRIu64"\n\n", root_page_id, directory_size);
+
+	// print each bucket only once, at the least directory_index that points to it
+	for(uint64_t directory_index = 0; directory_index < directory_size; directory_index++)
+	{
+		uint64_t bucket_page_id = get_from_page_table(ptrl_p, directory_index, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+		uint64_t local_depth_mask = get_local_depth_mask(ptrl_p, directory_index, bucket_page_id, directory_size, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+
+		if(directory_index >= local_depth_mask)
+		{
+			printf("%"PRIu64" -> SAME_AS %"PRIu64"\n\n", directory_index, directory_index & (local_depth_mask - 1));
+			continue;
+		}
+
+		printf("%"PRIu64" -> %"PRIu64" (local_depth_mask = %"PRIu64")\n\n", directory_index, bucket_page_id, local_depth_mask);
+		print_array_table(bucket_page_id, 1, &(ehttd_p->attd), pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we are only reading
+	if(*abort_error)
+		return ;
+
+	return ;
+
+	DELETE_DIRECTORY_RANGE_LOCKER_AND_ABORT:;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	return ;
+}
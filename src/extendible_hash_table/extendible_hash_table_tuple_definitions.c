@@ -0,0 +1,144 @@
+#include<extendible_hash_table_tuple_definitions_public.h>
+
+#include<stdlib.h>
+
+int init_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, uint32_t key_element_count, const tuple_hasher* hasher)
+{
+	// zero initialize ehttd_p
+	(*ehttd_p) = (extendible_hash_table_tuple_defs){};
+
+	// basic parameter check
+	if(key_element_count == 0 || key_element_ids == NULL || record_def == NULL)
+		return 0;
+
+	// check id page_access_specs struct is valid
+	if(!is_valid_page_access_specs(pas_p))
+		return 0;
+
+	// if positional accessor is invalid catch it here
+	if(!are_all_positions_accessible_for_tuple_def(record_def, key_element_ids, key_element_count))
+		return 0;
+
+	ehttd_p->hasher = (*hasher);
+
+	ehttd_p->key_element_count = key_element_count;
+
+	ehttd_p->key_element_ids = key_element_ids;
+
+	// initialize key def
+
+	// allocate memory for key_def and initialize it
+	{
+		data_type_info* key_type_info = malloc(sizeof_tuple_data_type_info(key_element_count));
+		if(key_type_info == NULL)
+			exit(-1);
+		initialize_tuple_data_type_info(key_type_info, "temp_key_def", 1, pas_p->page_size, key_element_count);
+
+		for(uint32_t i = 0; i < key_element_count; i++)
+		{
+			key_type_info->containees[i].field_name[0] = '\0'; // field name here is redundant
+			key_type_info->containees[i].al.type_info = (data_type_info*) get_type_info_for_element_from_tuple_def(record_def, key_element_ids[i]);
+		}
+
+		ehttd_p->key_def = malloc(sizeof(tuple_def));
+		if(ehttd_p->key_def == NULL)
+			exit(-1);
+		if(!initialize_tuple_def(ehttd_p->key_def, key_type_info))
+		{
+			free(ehttd_p->key_def);
+			free(key_type_info);
+			ehttd_p->key_def = NULL; // avoid double free due to below call
+			deinit_extendible_hash_table_tuple_definitions(ehttd_p);
+			return 0;
+		}
+	}
+
+	// this fails if the record_def is not fixed sized
+	if(!init_array_table_tuple_definitions(&(ehttd_p->attd), pas_p, record_def))
+	{
+		deinit_extendible_hash_table_tuple_definitions(ehttd_p);
+		return 0;
+	}
+
+	if(!init_page_table_tuple_definitions(&(ehttd_p->pttd), pas_p))
+	{
+		deinit_extendible_hash_table_tuple_definitions(ehttd_p);
+		return 0;
+	}
+
+	return 1;
+}
+
+int check_if_record_can_be_inserted_for_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* record_tuple)
+{
+	if(record_tuple == NULL)
+		return 0;
+
+	// if atleast one key element is OUT_OF_BOUNDS then fail
+	if(!are_all_positions_accessible_for_tuple(record_tuple, ehttd_p->attd.record_def, ehttd_p->key_element_ids, ehttd_p->key_element_count))
+		return 0;
+
+	// the record_def is fixed sized, so any record would fit in a slot of the bucket
+	return 1;
+}
+
+uint64_t get_hash_value_for_key_using_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* key)
+{
+	tuple_hasher local_hasher = ehttd_p->hasher;
+	return hash_tuple(key, ehttd_p->key_def, NULL, &local_hasher, ehttd_p->key_element_count);
+}
+
+uint64_t get_hash_value_for_record_using_extendible_hash_table_tuple_definitions(const extendible_hash_table_tuple_defs* ehttd_p, const void* record_tuple)
+{
+	tuple_hasher local_hasher = ehttd_p->hasher;
+	return hash_tuple(record_tuple, ehttd_p->attd.record_def, ehttd_p->key_element_ids, &local_hasher, ehttd_p->key_element_count);
+}
+
+void deinit_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p)
+{
+	if(ehttd_p->key_def)
+	{
+		if(ehttd_p->key_def->type_info)
+			free(ehttd_p->key_def->type_info);
+		free(ehttd_p->key_def);
+	}
+
+	deinit_array_table_tuple_definitions(&(ehttd_p->attd));
+	deinit_page_table_tuple_definitions(&(ehttd_p->pttd));
+	ehttd_p->key_element_count = 0;
+	ehttd_p->key_element_ids = NULL;
+	ehttd_p->key_def = NULL;
+}
+
+void print_extendible_hash_table_tuple_definitions(extendible_hash_table_tuple_defs* ehttd_p)
+{
+	printf("Extendible_hash_table tuple defs:\n");
+
+	printf("key_element_count = %"PRIu32"\n", ehttd_p->key_element_count);
+
+	printf("key_element_ids = ");
+	if(ehttd_p->key_element_ids)
+	{
+		printf("{ ");
+		for(uint32_t i = 0; i < ehttd_p->key_element_count; i++)
+		{
+			printf("{ ");
+			for(uint32_t j = 0; j < ehttd_p->key_element_ids[i].positions_length; j++)
+				printf("%u, ", ehttd_p->key_element_ids[i].positions[j]);
+			printf(" }, ");
+		}
+		printf(" }\n");
+	}
+	else
+		printf("NULL\n");
+
+	printf("key_def = ");
+	if(ehttd_p->key_def)
+		print_tuple_def(ehttd_p->key_def);
+	else
+		printf("NULL\n");
+
+	print_array_table_tuple_definitions(&(ehttd_p->attd));
+
+	print_page_table_tuple_definitions(&(ehttd_p->pttd));
+}
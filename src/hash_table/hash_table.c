@@ -5,6 +5,10 @@
 #include<page_table.h>
 #include<linked_page_list.h>
 
+#include<merge_sort.h>
+
+#include<stdlib.h>
+
 uint64_t get_new_hash_table(uint64_t initial_bucket_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
 {
 	// initial_bucket_count can not be 0
@@ -66,6 +70,50 @@ struct hash_table_bucket
 	linked_page_list_iterator* bucket_iterator;		// defaults to NULL, unless the iterator is not initialized
 };
 
+// vaccums the bucket at bucket_id, i.e. if its linked_page_list exists and is empty, then it is destroyed and the bucket is set to NULL_PAGE_ID in the page_table
+// ptrl_p must be a writable page_table_range_locker, with the root of the page_table as its local_root, and no lock must be held on the linked_page_list of this bucket
+// it returns 1, if the bucket was vaccummed
+static int vaccum_bucket_if_empty(page_table_range_locker* ptrl_p, uint64_t bucket_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t bucket_head_page_id = get_from_page_table(ptrl_p, bucket_id, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	if(bucket_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
+		return 0;
+
+	// open a linked_page_list_iterator at bucket_head_page_id
+	linked_page_list_iterator* lpli_p = get_new_linked_page_list_iterator(bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	int is_bucket_empty = is_empty_linked_page_list(lpli_p);
+
+	// release lock on lpli_p
+	delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	if(!is_bucket_empty)
+		return 0;
+
+	// the bucket_head_page_id is about to be freed, so invalidate the hash_table_handles, that may have it cached
+	increment_root_epoch_for_page_table_range_locker(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// destroy the linked_page_list
+	destroy_linked_page_list(bucket_head_page_id, &(httd_p->lpltd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	set_in_page_table(ptrl_p, bucket_id, httd_p->pttd.pas_p->NULL_PAGE_ID, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
 int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
 {
 	// zero initialize all local variables of the function
@@ -107,6 +155,11 @@ int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	if(*abort_error)
 		goto ABORT_ERROR;
 
+	// the bucket_count changed and the head of split_hash_buckets[0] gets replaced, so invalidate the hash_table_handles, while we still hold the lock on the root
+	increment_root_epoch_for_page_table_range_locker(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
 	// now we only need to work with split_hash_buckets [0] and [1]
 	minimize_lock_range_for_page_table_range_locker(ptrl_p, (bucket_range){split_hash_buckets[0].bucket_id, split_hash_buckets[1].bucket_id}, transaction_id, abort_error);
 	if(*abort_error)
@@ -140,6 +193,33 @@ int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	if(*abort_error)
 		goto ABORT_ERROR;
 
+	// create both the split_hash_buckets upfront, and link them into the page_table, while we still hold the lock on it
+	// if the split_content is empty, both of them stay NULL
+	for(int i = 0; i < sizeof(split_hash_buckets)/sizeof(split_hash_buckets[0]) && !is_empty_linked_page_list(split_content); i++)
+	{
+		// create a new linked_page_list bucket
+		split_hash_buckets[i].bucket_head_page_id = get_new_linked_page_list(&(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// page_table[split_hash_buckets[i].bucket_id] = split_hash_buckets[i].bucket_head_page_id
+		set_in_page_table(ptrl_p, split_hash_buckets[i].bucket_id, split_hash_buckets[i].bucket_head_page_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// open a new bucket iterator for the ith split_hash_bucket
+		split_hash_buckets[i].bucket_iterator = get_new_linked_page_list_iterator(split_hash_buckets[i].bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	// now we hold locks on all the 3 linked_page_lists involved in the split, and the split_content is not reachable from the page_table anymore
+	// so release the lock on the page_table, before moving any tuples, this lets the lookups on all the other buckets (and the expand/shrink calls) proceed, while we split
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum needed, because we have only been seting new non null values here
+	ptrl_p = NULL;
+	if(*abort_error)
+		goto ABORT_ERROR;
+
 	// iterate while split_content still has tuples
 	while(!is_empty_linked_page_list(split_content))
 	{
@@ -160,50 +240,6 @@ int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 			if(split_hash_buckets[i].bucket_id != bucket_id)
 				continue;
 
-			// there is quite a bit of work that needs to be done, if the corresponding iterator is NULL
-			if(split_hash_buckets[i].bucket_iterator == NULL)
-			{
-				// create a new linked_page_list bucket
-				split_hash_buckets[i].bucket_head_page_id = get_new_linked_page_list(&(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
-				if(*abort_error)
-					goto ABORT_ERROR;
-
-				// page_table[split_hash_buckets[i].bucket_id] = split_hash_buckets[i].bucket_head_page_id
-				set_in_page_table(ptrl_p, split_hash_buckets[i].bucket_id, split_hash_buckets[i].bucket_head_page_id, transaction_id, abort_error);
-				if(*abort_error)
-					goto ABORT_ERROR;
-
-				// open a new bucket iterator for the ith split_hash_bucket
-				split_hash_buckets[i].bucket_iterator = get_new_linked_page_list_iterator(split_hash_buckets[i].bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
-				if(*abort_error)
-					goto ABORT_ERROR;
-
-				// now based on the currently open iterators of the split_hash_buckets, we shrink or completely destroy the ptrl iterator
-				bucket_range new_range = {UINT64_MAX, 0};
-				for(int j = 0; j < sizeof(split_hash_buckets)/sizeof(split_hash_buckets[0]); j++)
-				{
-					if(split_hash_buckets[j].bucket_iterator != NULL)
-						continue;
-
-					new_range.first_bucket_id = min(new_range.first_bucket_id, split_hash_buckets[j].bucket_id);
-					new_range.last_bucket_id = max(new_range.last_bucket_id, split_hash_buckets[j].bucket_id);
-				}
-
-				if(new_range.first_bucket_id > new_range.last_bucket_id)
-				{
-					delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum needed, because we have only been seting new non null values here
-					ptrl_p = NULL;
-					if(*abort_error)
-						goto ABORT_ERROR;
-				}
-				else
-				{
-					minimize_lock_range_for_page_table_range_locker(ptrl_p, new_range, transaction_id, abort_error);
-					if(*abort_error)
-						goto ABORT_ERROR;
-				}
-			}
-
 			// insert the tuple into the bucket_iterator and break out of this loop
 			int inserted = insert_at_linked_page_list_iterator(split_hash_buckets[i].bucket_iterator, record_tuple, INSERT_BEFORE_LINKED_PAGE_LIST_ITERATOR, transaction_id, abort_error);
 			if(*abort_error)
@@ -248,7 +284,60 @@ int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	if(*abort_error)
 		goto ABORT_ERROR;
 
-	// now we can clean up any remaining ressources including the ptrl_p, and the split_hash_buckets[0 and 1].bucket_iterator-s
+	// a split_hash_bucket that did not get any tuple is left empty, release the locks on both of them, and remember the empty ones
+	int is_split_hash_bucket_empty[2] = {};
+	for(int i = 0; i < sizeof(split_hash_buckets)/sizeof(split_hash_buckets[0]); i++)
+	{
+		if(split_hash_buckets[i].bucket_iterator == NULL)
+			continue;
+
+		is_split_hash_bucket_empty[i] = is_empty_linked_page_list(split_hash_buckets[i].bucket_iterator);
+
+		delete_linked_page_list_iterator(split_hash_buckets[i].bucket_iterator, transaction_id, abort_error);
+		split_hash_buckets[i].bucket_iterator = NULL;
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	// vaccum the empty split_hash_buckets right away, else no insert or remove would ever ask for their vaccum
+	// the page_table is always locked before the buckets, so it is locked again here, and the vaccum checks the emptiness again, as the buckets were unlocked in the meantime
+	if(is_split_hash_bucket_empty[0] || is_split_hash_bucket_empty[1])
+	{
+		ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// the bucket_count may have been changed by a concurrent expand/shrink, so the bucket must still exist to be vaccummed
+		uint64_t curr_bucket_count;
+		find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &curr_bucket_count, MAX, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		for(int i = 0; i < sizeof(split_hash_buckets)/sizeof(split_hash_buckets[0]); i++)
+		{
+			if(!is_split_hash_bucket_empty[i] || split_hash_buckets[i].bucket_id >= curr_bucket_count)
+				continue;
+
+			int vaccummed = vaccum_bucket_if_empty(ptrl_p, split_hash_buckets[i].bucket_id, httd_p, pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			// and the page_table vaccum, for the page_table pages left empty by the above set
+			if(vaccummed)
+			{
+				perform_vaccum_page_table_range_locker(ptrl_p, split_hash_buckets[i].bucket_id, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+		}
+
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we have locked the whole bucket range, so no need for vaccum
+		ptrl_p = NULL;
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	// now we can clean up any remaining ressources
 
 	result = 1;
 	goto EXIT;
@@ -268,6 +357,204 @@ int expand_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	return result;
 }
 
+// returns the number of lower bits of the hash_value, that map records to the bucket_id, when the hash_table has bucket_count buckets
+// every record of the bucket_id then goes to one of the buckets bucket_id + j * 2^bits (for j >= 0), on expanding the hash_table
+static int64_t get_bits_for_bucket_of_hash_table(uint64_t bucket_id, uint64_t bucket_count)
+{
+	int64_t fl2;
+	uint64_t split_index = get_hash_table_split_index(bucket_count, &fl2);
+	return (bucket_id < split_index || bucket_id >= (UINT64_C(1) << fl2)) ? (fl2 + 1) : fl2;
+}
+
+// each round of expand_hash_table_by multiplies the bucket_count by atmost this factor
+// then 2^bits of every bucket being split is more than half of the bucket_count at the start of the round, so it is split into atmost 2 * EXPAND_HASH_TABLE_BY_MAX_FANOUT buckets
+// this bounds the number of linked_page_lists that are write locked at once, while a bucket is being split
+#define EXPAND_HASH_TABLE_BY_MAX_FANOUT 16
+
+uint64_t expand_hash_table_by(uint64_t root_page_id, uint64_t new_buckets_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// zero initialize all local variables of the function
+	uint64_t result = 0;
+	page_table_range_locker* ptrl_p = NULL;
+	linked_page_list_iterator* split_content = NULL;
+	hash_table_bucket split_hash_buckets[2 * EXPAND_HASH_TABLE_BY_MAX_FANOUT] = {}; uint64_t split_hash_buckets_count = 0;
+
+	// take a range lock on the page table, it is held until all the buckets are split
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// get the current bucket_count of the hash_table
+	uint64_t old_bucket_count;
+	find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &old_bucket_count, MAX, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// the bucket_count can not go beyond UINT64_MAX
+	new_buckets_count = min(new_buckets_count, UINT64_MAX - old_bucket_count);
+	if(new_buckets_count == 0)
+	{
+		result = 0;
+		goto EXIT;
+	}
+	uint64_t new_bucket_count = old_bucket_count + new_buckets_count;
+
+	// the bucket_count changes and the heads of the buckets being split get replaced, so invalidate the hash_table_handles
+	increment_root_epoch_for_page_table_range_locker(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// expand in rounds, each round moves the tuples of the buckets that get split directly to their buckets at the end of the round
+	// so every tuple is moved atmost once per round, unlike calling expand_hash_table new_buckets_count times, that may move it upto once for every doubling of the bucket_count
+	uint64_t bucket_count = old_bucket_count;
+	while(bucket_count < new_bucket_count)
+	{
+		uint64_t round_bucket_count = (bucket_count > (new_bucket_count / EXPAND_HASH_TABLE_BY_MAX_FANOUT)) ? new_bucket_count : (bucket_count * EXPAND_HASH_TABLE_BY_MAX_FANOUT);
+
+		// page_table[bucket_count] = NULL
+		set_in_page_table(ptrl_p, bucket_count, httd_p->pttd.pas_p->NULL_PAGE_ID, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// page_table[round_bucket_count] = root_page_id
+		set_in_page_table(ptrl_p, round_bucket_count, root_page_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		for(uint64_t bucket_id = 0; bucket_id < bucket_count; bucket_id++)
+		{
+			int64_t bits = get_bits_for_bucket_of_hash_table(bucket_id, bucket_count);
+			if(bits >= 64)
+				continue;
+
+			// the bucket_id gets split only if its first split bucket bucket_id + 2^bits exists at the round_bucket_count
+			if((bucket_id + (UINT64_C(1) << bits)) >= round_bucket_count)
+				continue;
+
+			uint64_t split_content_head_page_id = get_from_page_table(ptrl_p, bucket_id, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			if(split_content_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
+				continue;
+
+			// page_table[bucket_id] = NULL, it will be recreated if any of the tuples still belong to it
+			set_in_page_table(ptrl_p, bucket_id, httd_p->pttd.pas_p->NULL_PAGE_ID, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			// split_hash_buckets[j] is for the bucket bucket_id + j * 2^bits, its linked_page_list is created only when the first tuple is moved to it
+			split_hash_buckets_count = ((round_bucket_count - 1 - bucket_id) >> bits) + 1;
+			for(uint64_t j = 0; j < split_hash_buckets_count; j++)
+				split_hash_buckets[j] = (hash_table_bucket){.bucket_id = bucket_id + (j << bits)};
+
+			// open a linked_page_list iterator for the split_content_head_page_id
+			split_content = get_new_linked_page_list_iterator(split_content_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			// iterate while split_content still has tuples
+			while(!is_empty_linked_page_list(split_content))
+			{
+				// fetch the next tuple to be processed
+				const void* record_tuple = get_tuple_linked_page_list_iterator(split_content);
+
+				if(record_tuple == NULL)
+					goto SKIP_TUPLE;
+
+				// calculate the bucket_id for the record_tuple, at the round_bucket_count, it is always bucket_id + j * 2^bits
+				uint64_t to_bucket_id = get_bucket_index_for_record_using_hash_table_tuple_definitions(httd_p, record_tuple, round_bucket_count);
+				hash_table_bucket* to_bucket = &(split_hash_buckets[(to_bucket_id - bucket_id) >> bits]);
+
+				// if it does not exist yet, create a new linked_page_list bucket for it
+				if(to_bucket->bucket_iterator == NULL)
+				{
+					to_bucket->bucket_head_page_id = get_new_linked_page_list(&(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+
+					// page_table[to_bucket->bucket_id] = to_bucket->bucket_head_page_id
+					set_in_page_table(ptrl_p, to_bucket->bucket_id, to_bucket->bucket_head_page_id, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+
+					to_bucket->bucket_iterator = get_new_linked_page_list_iterator(to_bucket->bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+				}
+
+				// insert the tuple into the bucket_iterator
+				int inserted = insert_at_linked_page_list_iterator(to_bucket->bucket_iterator, record_tuple, INSERT_BEFORE_LINKED_PAGE_LIST_ITERATOR, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// go back to the head, just as in expand_hash_table
+				if(inserted)
+				{
+					prev_linked_page_list_iterator(to_bucket->bucket_iterator, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+				}
+
+				SKIP_TUPLE:;
+				if(!is_at_last_tuple_in_curr_page_linked_page_list_iterator(split_content)) // if not the last tuple on the current page, then go next
+				{
+					next_linked_page_list_iterator(split_content, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+				}
+				else // else remove current page and go next
+				{
+					remove_all_in_curr_page_from_linked_page_list_iterator(split_content, GO_NEXT_AFTER_LINKED_PAGE_ITERATOR_OPERATION, transaction_id, abort_error);
+					if(*abort_error)
+						goto ABORT_ERROR;
+				}
+			}
+
+			// now we can delete the iterator, and destroy the linked_page_list corresponding to the split_content
+			delete_linked_page_list_iterator(split_content, transaction_id, abort_error);
+			split_content = NULL;
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			destroy_linked_page_list(split_content_head_page_id, &(httd_p->lpltd), pam_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			// release the locks on the buckets built from this split_content
+			while(split_hash_buckets_count > 0)
+			{
+				hash_table_bucket* htb = &(split_hash_buckets[--split_hash_buckets_count]);
+				if(htb->bucket_iterator == NULL)
+					continue;
+
+				delete_linked_page_list_iterator(htb->bucket_iterator, transaction_id, abort_error);
+				htb->bucket_iterator = NULL;
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+		}
+
+		bucket_count = round_bucket_count;
+	}
+
+	result = new_buckets_count;
+	goto EXIT;
+
+	EXIT:;
+	ABORT_ERROR:;
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum needed, we had the lock on the whole bucket range
+	if(split_content != NULL)
+		delete_linked_page_list_iterator(split_content, transaction_id, abort_error);
+	for(uint64_t i = 0; i < split_hash_buckets_count; i++)
+		if(split_hash_buckets[i].bucket_iterator != NULL)
+			delete_linked_page_list_iterator(split_hash_buckets[i].bucket_iterator, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+	return result;
+}
+
 int shrink_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
 {
 	int result = 0;
@@ -306,6 +593,11 @@ int shrink_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	if(*abort_error)
 		goto ABORT_ERROR;
 
+	// the bucket_count changed and the bucket at bucket_count gets merged away, so invalidate the hash_table_handles, while we still hold the lock on the root
+	increment_root_epoch_for_page_table_range_locker(ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
 	// if this merge_bucket_head_id is NULL, then we are done
 	if(merge_bucket_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
 	{
@@ -353,6 +645,262 @@ int shrink_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	return result;
 }
 
+// counts the tuples in the bucket, a page at a time, lpli_p must be pointing to the first tuple of the bucket
+static uint64_t count_tuples_in_bucket(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t tuple_count = 0;
+	while(1)
+	{
+		tuple_count += get_tuple_count_from_curr_tuple_in_curr_page_linked_page_list_iterator(lpli_p);
+
+		if(!next_page_linked_page_list_iterator(lpli_p, transaction_id, abort_error))
+			break;
+	}
+	if(*abort_error)
+		return 0;
+	return tuple_count;
+}
+
+// returns the smallest n, such that estimated_tuple_count / (bucket_count + n) <= tuples_per_bucket, capped at budget
+static uint64_t get_buckets_to_add_for_load(double estimated_tuple_count, uint64_t bucket_count, double tuples_per_bucket, uint64_t budget)
+{
+	double x = (estimated_tuple_count / tuples_per_bucket) - bucket_count;
+	if(x <= 0)
+		return 0;
+	if(x >= budget)
+		return budget;
+	uint64_t n = x;
+	if(n < x)
+		n++;
+	return min(n, budget);
+}
+
+uint64_t maintain_hash_table(uint64_t root_page_id, uint64_t target_tuples_per_bucket, uint64_t sample_buckets_count, uint64_t budget, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(target_tuples_per_bucket == 0 || sample_buckets_count == 0)
+		return 0;
+
+	page_table_range_locker* ptrl_p = NULL;
+	linked_page_list_iterator* lpli_p = NULL;
+
+	// take a read lock on the page table, to get the bucket_count and to sample the buckets
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	// get the current bucket_count of the hash_table
+	uint64_t bucket_count;
+	find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &bucket_count, MAX, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// sample every sample_stride-th bucket
+	// this picks the split and the unsplit buckets of the linear hashing in the same proportion, as they exist in the hash_table
+	sample_buckets_count = min(sample_buckets_count, bucket_count);
+	uint64_t sample_stride = bucket_count / sample_buckets_count;
+
+	uint64_t sampled_tuple_count = 0;
+	for(uint64_t i = 0; i < sample_buckets_count; i++)
+	{
+		uint64_t bucket_head_page_id = get_from_page_table(ptrl_p, i * sample_stride, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// an empty bucket
+		if(bucket_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
+			continue;
+
+		// open a read-only linked_page_list_iterator at bucket_head_page_id
+		lpli_p = get_new_linked_page_list_iterator(bucket_head_page_id, &(httd_p->lpltd), pam_p, NULL, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		sampled_tuple_count += count_tuples_in_bucket(lpli_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+		lpli_p = NULL;
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
+	// release the lock on the page table, expand_hash_table and shrink_hash_table need to take a write lock on it
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed reads
+	ptrl_p = NULL;
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	double estimated_tuple_count = (((double)sampled_tuple_count) / sample_buckets_count) * bucket_count;
+
+	uint64_t buckets_to_expand = 0;
+	uint64_t buckets_to_shrink = 0;
+	if(estimated_tuple_count > ((double)target_tuples_per_bucket) * bucket_count)
+		buckets_to_expand = get_buckets_to_add_for_load(estimated_tuple_count, bucket_count, target_tuples_per_bucket, budget);
+	else if(estimated_tuple_count * 4 < ((double)target_tuples_per_bucket) * bucket_count)
+	{
+		// shrink back only upto the bucket_count, that makes the load half of target_tuples_per_bucket
+		double x = bucket_count - (estimated_tuple_count * 2 / target_tuples_per_bucket);
+		if(x >= 1)
+			buckets_to_shrink = (x >= budget) ? budget : ((uint64_t)x);
+		buckets_to_shrink = min(buckets_to_shrink, bucket_count - 1);
+	}
+
+	uint64_t buckets_changed = 0;
+
+	while(buckets_changed < buckets_to_expand)
+	{
+		int expanded = expand_hash_table(root_page_id, httd_p, pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+		if(!expanded)
+			break;
+		buckets_changed++;
+	}
+
+	while(buckets_changed < buckets_to_shrink)
+	{
+		int shrunk = shrink_hash_table(root_page_id, httd_p, pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+		if(!shrunk)
+			break;
+		buckets_changed++;
+	}
+
+	return buckets_changed;
+
+	ABORT_ERROR:;
+	if(lpli_p != NULL)
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	return 0;
+}
+
+int compact_hash_table(uint64_t root_page_id, uint64_t from_bucket_id, uint64_t pages_budget, uint64_t* resume_bucket_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	page_table_range_locker* ptrl_p = NULL;
+	linked_page_list_iterator* lpli_p = NULL;
+
+	// atleast one bucket is always compacted, else a caller looping until it returns 0, would never finish with a 0 pages_budget
+	pages_budget = max(pages_budget, 1);
+
+	uint64_t pages_visited = 0;
+	uint64_t bucket_id = from_bucket_id;
+
+	while(pages_visited < pages_budget)
+	{
+		// take a write lock on the page table, only while this bucket is being compacted, so that it can be set to NULL_PAGE_ID and the page_table can be vaccummed
+		ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// get the current bucket_count of the hash_table
+		uint64_t bucket_count;
+		find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &bucket_count, MAX, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// all the buckets are compacted
+		if(bucket_id >= bucket_count)
+		{
+			delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed reads
+			ptrl_p = NULL;
+			if(*abort_error)
+				goto ABORT_ERROR;
+			return 0;
+		}
+
+		uint64_t bucket_head_page_id = get_from_page_table(ptrl_p, bucket_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		if(bucket_head_page_id != httd_p->pttd.pas_p->NULL_PAGE_ID)
+		{
+			lpli_p = get_new_linked_page_list_iterator(bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			if(is_empty_linked_page_list(lpli_p))
+			{
+				delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+				lpli_p = NULL;
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// the bucket_head_page_id is about to be freed, so invalidate the hash_table_handles, that may have it cached
+				increment_root_epoch_for_page_table_range_locker(ptrl_p, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// this is the hash_table vaccum of perform_vaccum_hash_table(), destroy the empty linked_page_list and set it's entry in page_table as NULL
+				destroy_linked_page_list(bucket_head_page_id, &(httd_p->lpltd), pam_p, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				set_in_page_table(ptrl_p, bucket_id, httd_p->pttd.pas_p->NULL_PAGE_ID, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// and the page_table vaccum, for the page_table pages left empty by the above set
+				perform_vaccum_page_table_range_locker(ptrl_p, bucket_id, transaction_id, abort_error);
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				pages_visited++;
+			}
+			else
+			{
+				// the page_table is no longer needed, the bucket stays locked by the lpli_p
+				delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we did not modify the page_table
+				ptrl_p = NULL;
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				// walk the bucket page by page, a writable iterator merges the curr_page with the next page on every next call that moves across them, if their tuples fit in a page
+				do
+				{
+					pages_visited++;
+				}
+				while(next_page_linked_page_list_iterator(lpli_p, transaction_id, abort_error));
+				if(*abort_error)
+					goto ABORT_ERROR;
+
+				delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+				lpli_p = NULL;
+				if(*abort_error)
+					goto ABORT_ERROR;
+			}
+		}
+		else
+			pages_visited++; // a NULL bucket is counted as a page visited, so that a run of them does not go on beyond the budget
+
+		if(ptrl_p != NULL)
+		{
+			delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we have locked the whole bucket range, so no need for vaccum
+			ptrl_p = NULL;
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+
+		// this was the last bucket
+		if(bucket_id == UINT64_MAX - 1)
+			return 0;
+		bucket_id++;
+	}
+
+	(*resume_bucket_id) = bucket_id;
+	return 1;
+
+	ABORT_ERROR:;
+	if(lpli_p != NULL)
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	return 0;
+}
+
 int destroy_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
 {
 	// take a range lock on the page table, to get the bucket_count
@@ -446,13 +994,45 @@ void print_hash_table(uint64_t root_page_id, const hash_table_tuple_defs* httd_p
 	return ;
 }
 
-int perform_vaccum_hash_table(uint64_t root_page_id, const hash_table_vaccum_params* htvp, uint32_t params_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+typedef struct hash_table_probe hash_table_probe;
+struct hash_table_probe
 {
+	uint64_t bucket_id;		// bucket that the key hashes to
+	uint64_t hash_value;	// hash_value of the key
+	uint32_t key_index;		// index of the key in the keys array passed by the user
+};
+
+// compares the probes at p1 and p2 by their bucket_id, so that the probes of a bucket are grouped together
+static int compare_probes_by_bucket_id(const void* context, const void* p1, const void* p2)
+{
+	uint64_t b1 = ((const hash_table_probe*)p1)->bucket_id;
+	uint64_t b2 = ((const hash_table_probe*)p2)->bucket_id;
+	return (b1 > b2) - (b1 < b2);
+}
+
+uint64_t multi_probe_hash_table(uint64_t root_page_id, const void* const* keys, uint32_t keys_count, void* context, void (*record_found)(void* context, uint32_t key_index, const void* record), const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	if(keys_count == 0)
+		return 0;
+
+	uint64_t records_found = 0;
 	page_table_range_locker* ptrl_p = NULL;
 	linked_page_list_iterator* lpli_p = NULL;
 
-	// take a range lock on the page table, to get the bucket_count
-	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	// probes and the auxiliary array for sorting them, in a single allocation
+	hash_table_probe* probes = malloc(sizeof(hash_table_probe) * keys_count * 2);
+	if(probes == NULL)
+		exit(-1);
+
+	// hash all the keys in one batch, before any locks are taken, their bucket_ids are computed in place later
+	uint64_t* hash_values = malloc(sizeof(uint64_t) * keys_count * 2);
+	if(hash_values == NULL)
+		exit(-1);
+	uint64_t* bucket_ids = hash_values + keys_count;
+	get_hash_values_for_keys_using_hash_table_tuple_definitions(httd_p, keys, keys_count, hash_values);
+
+	// take a read lock on the page table, it is held until all the buckets are scanned, so that the bucket_count stays the same
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, NULL, transaction_id, abort_error);
 	if(*abort_error)
 		goto ABORT_ERROR;
 
@@ -462,47 +1042,135 @@ int perform_vaccum_hash_table(uint64_t root_page_id, const hash_table_vaccum_par
 	if(*abort_error)
 		goto ABORT_ERROR;
 
-	for(uint32_t i = 0; i < params_count; i++)
+	// bucket all the keys and group them by their buckets
+	get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions(hash_values, keys_count, bucket_count, bucket_ids);
+	for(uint32_t i = 0; i < keys_count; i++)
 	{
-		if(htvp->hash_table_vaccum_needed)
+		probes[i].key_index = i;
+		probes[i].hash_value = hash_values[i];
+		probes[i].bucket_id = bucket_ids[i];
+	}
+	merge_sort_elements(probes, probes + keys_count, keys_count, sizeof(hash_table_probe), NULL, compare_probes_by_bucket_id);
+
+	// probes[group_start .. group_end-1] all hash to the same bucket
+	for(uint32_t group_start = 0, group_end = 0; group_start < keys_count; group_start = group_end)
+	{
+		while(group_end < keys_count && probes[group_end].bucket_id == probes[group_start].bucket_id)
+			group_end++;
+
+		uint64_t bucket_head_page_id = get_from_page_table(ptrl_p, probes[group_start].bucket_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// an empty bucket, none of the keys of this group exist
+		if(bucket_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
+			continue;
+
+		// open a read-only linked_page_list_iterator at bucket_head_page_id
+		lpli_p = get_new_linked_page_list_iterator(bucket_head_page_id, &(httd_p->lpltd), pam_p, NULL, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		// for a group of a single key, the pages of the bucket that can not have it are skipped (as a keyed hash_table_iterator does)
+		// with more keys, the filter of a page rarely rules out all of them, so the pages are just scanned
+		int is_single_key_group = (group_end - group_start == 1);
+		uint64_t single_key_fingerprint = get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(probes[group_start].hash_value);
+
+		if(is_single_key_group)
 		{
-			uint64_t curr_bucket_id = get_bucket_index_for_key_using_hash_table_tuple_definitions(httd_p, htvp[i].hash_table_vaccum_key, bucket_count);
+			skip_pages_without_fingerprint_linked_page_list_iterator(lpli_p, single_key_fingerprint, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
 
-			uint64_t curr_bucket_head_page_id = get_from_page_table(ptrl_p, curr_bucket_id, transaction_id, abort_error);
+		// scan the bucket once, matching each record against all the keys of the group
+		while(!is_empty_linked_page_list(lpli_p))
+		{
+			const void* record = get_tuple_linked_page_list_iterator(lpli_p);
+
+			for(uint32_t i = group_start; record != NULL && i < group_end; i++)
+			{
+				// cheap pre-filter, if the httd_p has a hash element
+				if(!may_match_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, record, probes[i].hash_value))
+					continue;
+
+				if(0 != httd_p->key_comparator(record, httd_p->lpltd.record_def, httd_p->key_element_ids, keys[probes[i].key_index], httd_p->key_def, NULL, NULL, httd_p->key_element_count))
+					continue;
+
+				record_found(context, probes[i].key_index, record);
+				records_found++;
+			}
+
+			if(is_at_tail_tuple_linked_page_list_iterator(lpli_p))
+				break;
+
+			int crosses_page = is_single_key_group && is_at_last_tuple_in_curr_page_linked_page_list_iterator(lpli_p);
+
+			next_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
 			if(*abort_error)
 				goto ABORT_ERROR;
 
-			if(curr_bucket_head_page_id != httd_p->pttd.pas_p->NULL_PAGE_ID)
+			if(crosses_page)
 			{
-				// open a linked_page_list_iterator at bucket_head_page_id
-				lpli_p = get_new_linked_page_list_iterator(curr_bucket_head_page_id, &(httd_p->lpltd), pam_p, pmm_p, transaction_id, abort_error);
+				skip_pages_without_fingerprint_linked_page_list_iterator(lpli_p, single_key_fingerprint, transaction_id, abort_error);
 				if(*abort_error)
 					goto ABORT_ERROR;
+			}
+		}
 
-				int is_curr_bucket_empty = is_empty_linked_page_list(lpli_p);
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+		lpli_p = NULL;
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
 
-				// release lock on lpli_p
-				delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
-				lpli_p = NULL;
-				if(*abort_error)
-					goto ABORT_ERROR;
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed reads
+	ptrl_p = NULL;
+	if(*abort_error)
+		goto ABORT_ERROR;
 
-				// if the corresponding linked_page_list exists and is empty, then delete it and set it's entry in page_table as NULL
-				if(is_curr_bucket_empty)
-				{
-					// destroy the linked_page_list
-					destroy_linked_page_list(curr_bucket_head_page_id, &(httd_p->lpltd), pam_p, transaction_id, abort_error);
-					if(*abort_error)
-						goto ABORT_ERROR;
+	free(probes);
+	free(hash_values);
+	return records_found;
 
-					set_in_page_table(ptrl_p, curr_bucket_id, httd_p->pttd.pas_p->NULL_PAGE_ID, transaction_id, abort_error);
-					if(*abort_error)
-						goto ABORT_ERROR;
-				}
-			}
+	ABORT_ERROR:;
+	if(lpli_p != NULL)
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	free(probes);
+	free(hash_values);
+	return 0;
+}
+
+int perform_vaccum_hash_table(uint64_t root_page_id, const hash_table_vaccum_params* htvp, uint32_t params_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	page_table_range_locker* ptrl_p = NULL;
+
+	// take a range lock on the page table, to get the bucket_count
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// get the current bucket_count of the hash_table
+	uint64_t bucket_count;
+	find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &bucket_count, MAX, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	for(uint32_t i = 0; i < params_count; i++)
+	{
+		if(htvp[i].hash_table_vaccum_needed)
+		{
+			uint64_t curr_bucket_id = get_bucket_index_for_key_using_hash_table_tuple_definitions(httd_p, htvp[i].hash_table_vaccum_key, bucket_count);
+
+			// if the corresponding linked_page_list exists and is empty, then delete it and set it's entry in page_table as NULL
+			vaccum_bucket_if_empty(ptrl_p, curr_bucket_id, httd_p, pam_p, pmm_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
 		}
 
-		if(htvp->page_table_vaccum_needed)
+		if(htvp[i].page_table_vaccum_needed)
 		{
 			perform_vaccum_page_table_range_locker(ptrl_p, htvp[i].page_table_vaccum_bucket_id, transaction_id, abort_error);
 			if(*abort_error)
@@ -520,7 +1188,5 @@ int perform_vaccum_hash_table(uint64_t root_page_id, const hash_table_vaccum_par
 	ABORT_ERROR:;
 	if(ptrl_p)
 		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
-	if(lpli_p)
-		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include<hash_table_handle.h>
+
+#include<linked_page_list.h>
+
+#include<stdlib.h>
+
+hash_table_handle* get_new_hash_table_handle(uint64_t root_page_id, uint32_t cached_heads_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	// the following 2 must be present
+	if(httd_p == NULL || pam_p == NULL)
+		return NULL;
+
+	// there must be room to cache atleast 1 head, and the root page must carry the epoch to validate the cache against
+	if(cached_heads_count == 0 || !httd_p->pttd.attd.has_root_epoch)
+		return NULL;
+
+	hash_table_handle* hth_p = malloc(sizeof(hash_table_handle));
+	if(hth_p == NULL)
+		exit(-1);
+
+	hth_p->cached_heads = malloc(sizeof(hash_table_cached_head) * cached_heads_count);
+	if(hth_p->cached_heads == NULL)
+		exit(-1);
+
+	hth_p->root_page_id = root_page_id;
+	hth_p->cached_heads_count = cached_heads_count;
+	hth_p->httd_p = httd_p;
+	hth_p->pam_p = pam_p;
+
+	// nothing is cached yet
+	hth_p->epoch = 0;
+	hth_p->is_bucket_count_cached = 0;
+	for(uint32_t i = 0; i < hth_p->cached_heads_count; i++)
+		hth_p->cached_heads[i] = (hash_table_cached_head){.bucket_id = 0, .bucket_head_page_id = httd_p->pttd.pas_p->NULL_PAGE_ID};
+
+	return hth_p;
+}
+
+// validates the cache against the epoch on the root page, clearing it if the epoch has changed, and then returns the bucket_count (from the cache, if it was valid)
+// ptrl_p must have the root of the page_table as its local_root
+// on an abort error, lock on the local root is released, then you only need to call delete_page_table_range_locker
+static uint64_t validate_and_get_bucket_count(hash_table_handle* hth_p, page_table_range_locker* ptrl_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t epoch;
+	get_root_epoch_for_page_table_range_locker(ptrl_p, &epoch);
+
+	if(epoch != hth_p->epoch)
+	{
+		hth_p->epoch = epoch;
+		hth_p->is_bucket_count_cached = 0;
+		for(uint32_t i = 0; i < hth_p->cached_heads_count; i++)
+			hth_p->cached_heads[i].bucket_head_page_id = hth_p->httd_p->pttd.pas_p->NULL_PAGE_ID;
+	}
+
+	if(!hth_p->is_bucket_count_cached)
+	{
+		find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &(hth_p->bucket_count), MAX, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+		hth_p->is_bucket_count_cached = 1;
+	}
+
+	return hth_p->bucket_count;
+}
+
+uint64_t get_bucket_count_using_hash_table_handle(hash_table_handle* hth_p, const void* transaction_id, int* abort_error)
+{
+	// take a read lock on the root of the page table, to validate the cache
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(hth_p->root_page_id, WHOLE_BUCKET_RANGE, &(hth_p->httd_p->pttd), hth_p->pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	uint64_t bucket_count = validate_and_get_bucket_count(hth_p, ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+	{
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed a read
+		return 0;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed a read
+	if(*abort_error)
+		return 0;
+
+	return bucket_count;
+}
+
+hash_table_iterator* get_new_hash_table_iterator_using_hash_table_handle(hash_table_handle* hth_p, const void* key, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(key == NULL)
+		return NULL;
+
+	hash_table_iterator* hti_p = malloc(sizeof(hash_table_iterator));
+	if(hti_p == NULL)
+		exit(-1);
+
+	hti_p->root_page_id = hth_p->root_page_id;
+	hti_p->key = key;
+	hti_p->lock_range = WHOLE_BUCKET_RANGE;
+	hti_p->httd_p = hth_p->httd_p;
+	hti_p->pam_p = hth_p->pam_p;
+	hti_p->pmm_p = pmm_p;
+
+	hti_p->ptrl_p = NULL;
+	hti_p->lpli_p = NULL;
+
+	hti_p->mat_key = materialize_key_from_tuple(hti_p->key, hti_p->httd_p->key_def, NULL, hti_p->httd_p->key_element_count);
+	hti_p->key_hash_value = get_hash_value_for_key_using_hash_table_tuple_definitions(hti_p->httd_p, hti_p->key);
+
+	// take a read lock on the root of the page table, this lock is held until the bucket is locked
+	hti_p->ptrl_p = get_new_page_table_range_locker(hti_p->root_page_id, WHOLE_BUCKET_RANGE, &(hti_p->httd_p->pttd), hti_p->pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		goto DELETE_EVERYTHING_AND_ABORT;
+
+	hti_p->bucket_count = validate_and_get_bucket_count(hth_p, hti_p->ptrl_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto DELETE_EVERYTHING_AND_ABORT;
+
+	hti_p->curr_bucket_id = get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(hti_p->key_hash_value, hti_p->bucket_count);
+
+	hash_table_cached_head* cached_head = &(hth_p->cached_heads[hti_p->curr_bucket_id % hth_p->cached_heads_count]);
+
+	uint64_t curr_bucket_head_page_id;
+	if(cached_head->bucket_head_page_id != hti_p->httd_p->pttd.pas_p->NULL_PAGE_ID && cached_head->bucket_id == hti_p->curr_bucket_id)
+		curr_bucket_head_page_id = cached_head->bucket_head_page_id;
+	else
+	{
+		// walk down the page_table to the bucket, just as get_new_hash_table_iterator would
+		minimize_lock_range_for_page_table_range_locker(hti_p->ptrl_p, (bucket_range){hti_p->curr_bucket_id, hti_p->curr_bucket_id}, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_EVERYTHING_AND_ABORT;
+
+		curr_bucket_head_page_id = get_from_page_table(hti_p->ptrl_p, hti_p->curr_bucket_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_EVERYTHING_AND_ABORT;
+
+		// the epoch was read before this walk, so the head is cached for an epoch, that is not newer than the one it was read at
+		if(curr_bucket_head_page_id != hti_p->httd_p->pttd.pas_p->NULL_PAGE_ID)
+			(*cached_head) = (hash_table_cached_head){.bucket_id = hti_p->curr_bucket_id, .bucket_head_page_id = curr_bucket_head_page_id};
+	}
+
+	if(curr_bucket_head_page_id != hti_p->httd_p->pttd.pas_p->NULL_PAGE_ID)
+	{
+		// open a linked_page_list_iterator at bucket_head_page_id, before releasing the lock on the page_table
+		hti_p->lpli_p = get_new_linked_page_list_iterator(curr_bucket_head_page_id, &(hti_p->httd_p->lpltd), hti_p->pam_p, hti_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_EVERYTHING_AND_ABORT;
+
+		// skip the leading pages of the bucket, that can not have the key
+		skip_pages_without_fingerprint_linked_page_list_iterator(hti_p->lpli_p, get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(hti_p->key_hash_value), transaction_id, abort_error);
+		if(*abort_error)
+			goto DELETE_EVERYTHING_AND_ABORT;
+
+		// close the hti_p->ptrl_p
+		delete_page_table_range_locker(hti_p->ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum required here, we did not modify anything
+		hti_p->ptrl_p = NULL;
+		if(*abort_error)
+			goto DELETE_EVERYTHING_AND_ABORT;
+
+		return hti_p;
+	}
+
+	// the bucket is empty, a read-only iterator keeps the read lock on the page_table (for the bucket), just as get_new_hash_table_iterator would
+	if(hti_p->pmm_p == NULL)
+		return hti_p;
+
+	// a writable iterator needs a write lock on the page_table, to insert into the empty bucket, so it is opened without the cache
+	delete_page_table_range_locker(hti_p->ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum required here, we did not modify anything
+	hti_p->ptrl_p = NULL;
+	if(*abort_error)
+		goto DELETE_EVERYTHING_AND_ABORT;
+	destroy_materialized_key(&(hti_p->mat_key));
+	free(hti_p);
+
+	return get_new_hash_table_iterator(hth_p->root_page_id, WHOLE_BUCKET_RANGE, key, hth_p->httd_p, hth_p->pam_p, pmm_p, transaction_id, abort_error);
+
+	DELETE_EVERYTHING_AND_ABORT:;
+	if(hti_p->ptrl_p)
+		delete_page_table_range_locker(hti_p->ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum required here, since we are aborting
+	if(hti_p->lpli_p)
+		delete_linked_page_list_iterator(hti_p->lpli_p, transaction_id, abort_error);
+	destroy_materialized_key(&(hti_p->mat_key));
+	free(hti_p);
+	return NULL;
+}
+
+void delete_hash_table_handle(hash_table_handle* hth_p)
+{
+	free(hth_p->cached_heads);
+	free(hth_p);
+}
\ No newline at end of file
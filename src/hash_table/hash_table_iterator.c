@@ -28,11 +28,17 @@ hash_table_iterator* get_new_hash_table_iterator(uint64_t root_page_id, bucket_r
 	hti_p->ptrl_p = NULL;
 	hti_p->lpli_p = NULL;
 
-	// initialize mat_key
+	// initialize mat_key and key_hash_value
 	if(hti_p->key == NULL)
+	{
 		hti_p->mat_key = (materialized_key){};
+		hti_p->key_hash_value = 0;
+	}
 	else
+	{
 		hti_p->mat_key = materialize_key_from_tuple(hti_p->key, hti_p->httd_p->key_def, NULL, hti_p->httd_p->key_element_count);
+		hti_p->key_hash_value = get_hash_value_for_key_using_hash_table_tuple_definitions(hti_p->httd_p, hti_p->key);
+	}
 
 	if(hti_p->key != NULL)
 	{
@@ -51,7 +57,8 @@ hash_table_iterator* get_new_hash_table_iterator(uint64_t root_page_id, bucket_r
 				goto DELETE_EVERYTHING_AND_ABORT;
 
 			// get the bucket for the key
-			hti_p->curr_bucket_id = get_bucket_index_for_key_using_hash_table_tuple_definitions(hti_p->httd_p, hti_p->key, hti_p->bucket_count);
+			// the key_hash_value is already computed, so the key is not hashed again
+			hti_p->curr_bucket_id = get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(hti_p->key_hash_value, hti_p->bucket_count);
 
 			// once the curr_bucket_id is calculated, we do not need to deal with any other buckets, if we were provided with key
 			minimize_lock_range_for_page_table_range_locker(hti_p->ptrl_p, (bucket_range){hti_p->curr_bucket_id, hti_p->curr_bucket_id}, transaction_id, abort_error);
@@ -69,6 +76,11 @@ hash_table_iterator* get_new_hash_table_iterator(uint64_t root_page_id, bucket_r
 				if(*abort_error)
 					goto DELETE_EVERYTHING_AND_ABORT;
 
+				// skip the leading pages of the bucket, that can not have the key
+				skip_pages_without_fingerprint_linked_page_list_iterator(hti_p->lpli_p, get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(hti_p->key_hash_value), transaction_id, abort_error);
+				if(*abort_error)
+					goto DELETE_EVERYTHING_AND_ABORT;
+
 				// close the hti_p->ptrl_p
 				delete_page_table_range_locker(hti_p->ptrl_p, NULL, NULL, transaction_id, abort_error); // no vaccum required here, we did not modify anything
 				hti_p->ptrl_p = NULL;
@@ -115,6 +127,14 @@ hash_table_iterator* get_new_hash_table_iterator(uint64_t root_page_id, bucket_r
 		// make curr_bucket_id point to the first bucket in the range
 		hti_p->curr_bucket_id = hti_p->lock_range.first_bucket_id;
 
+		// a writable iterator, may free the heads of the buckets that it empties, so invalidate the hash_table_handles, before the lock on the root is released
+		if(hti_p->pmm_p != NULL)
+		{
+			increment_root_epoch_for_page_table_range_locker(hti_p->ptrl_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto DELETE_EVERYTHING_AND_ABORT;
+		}
+
 		// minimize the lock range to the preferred one
 		minimize_lock_range_for_page_table_range_locker(hti_p->ptrl_p, hti_p->lock_range, transaction_id, abort_error);
 		if(*abort_error)
@@ -155,6 +175,7 @@ hash_table_iterator* clone_hash_table_iterator(const hash_table_iterator* hti_p,
 	clone_p->root_page_id = hti_p->root_page_id;
 	clone_p->key = hti_p->key;
 	clone_p->mat_key = hti_p->mat_key; // key remains the same, so mat_key can also be copied, possibly pointing to contents in the same key
+	clone_p->key_hash_value = hti_p->key_hash_value;
 	clone_p->lock_range = hti_p->lock_range;
 	clone_p->curr_bucket_id = hti_p->curr_bucket_id;
 	clone_p->ptrl_p = NULL;
@@ -227,6 +248,10 @@ const void* get_tuple_hash_table_iterator(const hash_table_iterator* hti_p)
 	if(record == NULL)
 		return NULL;
 
+	// if the key is provided, and the stored hash_value of the record does not match that of the key, then the keys can not match either
+	if(hti_p->key != NULL && !may_match_hash_value_for_record_using_hash_table_tuple_definitions(hti_p->httd_p, record, hti_p->key_hash_value))
+		return NULL;
+
 	// if the key is provided, and the key does not match for this record then wew return NULL
 	if(hti_p->key != NULL && 0 != compare_tuple_with_user_value(record, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, hti_p->mat_key.keys, hti_p->mat_key.key_dtis, NULL, hti_p->httd_p->key_element_count))
 		return NULL;
@@ -278,10 +303,22 @@ int next_hash_table_iterator(hash_table_iterator* hti_p, int can_jump_bucket, co
 		return 1;
 	}
 
+	// with a key, moving off the last tuple of the curr_page, is moving to a page that may not have the key
+	int crosses_page = (hti_p->key != NULL) && is_at_last_tuple_in_curr_page_linked_page_list_iterator(hti_p->lpli_p);
+
 	// goto next tuple in the same bucket
 	int result = next_linked_page_list_iterator(hti_p->lpli_p, transaction_id, abort_error);
 	if(*abort_error)
 		goto ABORT_ERROR;
+
+	// skip the pages that can not have the key, this may leave the cursor at the tail tuple of the bucket, which then does not match the key
+	if(result && crosses_page)
+	{
+		skip_pages_without_fingerprint_linked_page_list_iterator(hti_p->lpli_p, get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(hti_p->key_hash_value), transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
 	return result;
 
 	ABORT_ERROR:;
@@ -364,6 +401,10 @@ int insert_in_hash_table_iterator(hash_table_iterator* hti_p, const void* tuple,
 	if(0 != compare_tuple_with_user_value(tuple, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, hti_p->mat_key.keys, hti_p->mat_key.key_dtis, NULL, hti_p->httd_p->key_element_count))
 		return 0;
 
+	// if the tuple can not be inserted (OR does not carry the hash_value of its key), then fail
+	if(!check_if_record_can_be_inserted_with_hash_value_for_hash_table_tuple_definitions(hti_p->httd_p, tuple, hti_p->key_hash_value))
+		return 0;
+
 	// if a linked_page_list at the curr_bucket_id does not exist then create one
 	// and make the iterator point from ptrl_p to lpli_p, for the given key
 	if(hti_p->lpli_p == NULL)
@@ -417,7 +458,11 @@ int update_at_hash_table_iterator(hash_table_iterator* hti_p, const void* tuple,
 		return 0;
 
 	// ensure that the key(curr_tuple) == key(tuple)
-	if(0 != compare_tuples(tuple, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, curr_tuple, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, NULL, hti_p->httd_p->key_element_count))
+	if(0 != hti_p->httd_p->key_comparator(tuple, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, curr_tuple, hti_p->httd_p->lpltd.record_def, hti_p->httd_p->key_element_ids, NULL, hti_p->httd_p->key_element_count))
+		return 0;
+
+	// the new tuple must carry the same hash_value as the curr_tuple, since their keys are equal
+	if(hti_p->httd_p->has_hash_element && !may_match_hash_value_for_record_using_hash_table_tuple_definitions(hti_p->httd_p, tuple, get_hash_value_for_record_using_hash_table_tuple_definitions(hti_p->httd_p, curr_tuple)))
 		return 0;
 
 	// go ahead with the actual update
@@ -514,20 +559,12 @@ int update_non_key_element_in_place_at_hash_table_iterator(hash_table_iterator*
 
 	// make sure that the element that the user is trying to update in place is not a key for the hash_table
 	// if you allow so, it could be a disaster
-	for(uint32_t i = 0; i < hti_p->httd_p->key_element_count; i++)
-	{
-		int match = 1;
-		for(uint32_t j = 0; j < min(hti_p->httd_p->key_element_ids[i].positions_length, element_index.positions_length); j++)
-		{
-			if(hti_p->httd_p->key_element_ids[i].positions[j] != element_index.positions[j])
-			{
-				match = 0;
-				break;
-			}
-		}
-		if(match)
-			return 0;
-	}
+	if(is_key_element_for_hash_table_tuple_definitions(hti_p->httd_p, element_index))
+		return 0;
+
+	// the same goes for the hash element, that stores the hash_value of the key
+	if(is_hash_element_for_hash_table_tuple_definitions(hti_p->httd_p, element_index))
+		return 0;
 
 	// go ahead with the actual update
 	// you may not access curr_tuple beyond the below call
@@ -0,0 +1,138 @@
+#include<hash_table.h>
+
+#include<page_table.h>
+#include<linked_page_list.h>
+
+// accumulate all the pages of the bucket, that the lpli_p points to, into the statistics
+static void accumulate_bucket_into_hash_table_statistics(hash_table_statistics* htts_p, linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t chain_length = 0;
+	uint64_t tuple_count = 0;
+	while(1)
+	{
+		uint32_t space_allotted;
+		htts_p->space_occupied += get_space_occupied_on_curr_page_linked_page_list_iterator(lpli_p, &space_allotted);
+		htts_p->space_allotted += space_allotted;
+		chain_length++;
+
+		tuple_count += get_tuple_count_from_curr_tuple_in_curr_page_linked_page_list_iterator(lpli_p);
+
+		if(!next_page_linked_page_list_iterator(lpli_p, transaction_id, abort_error))
+			break;
+	}
+	if(*abort_error)
+		return ;
+
+	htts_p->tuple_count += tuple_count;
+	htts_p->page_count += chain_length;
+	if(tuple_count == 0)
+		htts_p->empty_bucket_count++;
+	htts_p->max_chain_length = max(htts_p->max_chain_length, chain_length);
+	htts_p->chain_length_histogram[min(chain_length, HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE - 1)]++;
+}
+
+// scales the value summed over the buckets_read buckets, up to all the bucket_count buckets
+// it is computed in double, like in maintain_hash_table, since (value * bucket_count) may not fit in an uint64_t, and the result is capped at UINT64_MAX
+static uint64_t extrapolate_to_all_buckets(uint64_t value, uint64_t buckets_read, uint64_t bucket_count)
+{
+	double extrapolated = (((double)value) / buckets_read) * bucket_count;
+	if(extrapolated >= ((double)UINT64_MAX))
+		return UINT64_MAX;
+	return (uint64_t)extrapolated;
+}
+
+int get_statistics_hash_table(uint64_t root_page_id, uint64_t bucket_sampling_interval, hash_table_statistics* htts_p, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// a bucket_sampling_interval of 0, is same as reading all the buckets
+	if(bucket_sampling_interval == 0)
+		bucket_sampling_interval = 1;
+
+	(*htts_p) = (hash_table_statistics){};
+
+	page_table_range_locker* ptrl_p = NULL;
+	linked_page_list_iterator* lpli_p = NULL;
+
+	// take a read lock on the page table, it is held until all the buckets are read, so that the bucket_count stays the same
+	ptrl_p = get_new_page_table_range_locker(root_page_id, WHOLE_BUCKET_RANGE, &(httd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// get the current bucket_count of the hash_table
+	find_non_NULL_PAGE_ID_in_page_table(ptrl_p, &(htts_p->bucket_count), MAX, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	for(uint64_t bucket_id = 0; bucket_id < htts_p->bucket_count; bucket_id += bucket_sampling_interval)
+	{
+		uint64_t bucket_head_page_id = get_from_page_table(ptrl_p, bucket_id, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
+		htts_p->buckets_read++;
+
+		if(bucket_head_page_id == httd_p->pttd.pas_p->NULL_PAGE_ID)
+		{
+			htts_p->null_bucket_count++;
+			htts_p->chain_length_histogram[0]++;
+		}
+		else
+		{
+			lpli_p = get_new_linked_page_list_iterator(bucket_head_page_id, &(httd_p->lpltd), pam_p, NULL, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			accumulate_bucket_into_hash_table_statistics(htts_p, lpli_p, transaction_id, abort_error);
+			if(*abort_error)
+				goto ABORT_ERROR;
+
+			delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+			lpli_p = NULL;
+			if(*abort_error)
+				goto ABORT_ERROR;
+		}
+
+		// avoid the overflow of the bucket_id, for a very large bucket_sampling_interval
+		if(htts_p->bucket_count - bucket_id <= bucket_sampling_interval)
+			break;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only performed reads
+	ptrl_p = NULL;
+	if(*abort_error)
+		goto ABORT_ERROR;
+
+	// extrapolate the statistics, if only a sample of the buckets was read
+	if(htts_p->buckets_read > 0 && htts_p->buckets_read < htts_p->bucket_count)
+	{
+		htts_p->tuple_count = extrapolate_to_all_buckets(htts_p->tuple_count, htts_p->buckets_read, htts_p->bucket_count);
+		htts_p->page_count = extrapolate_to_all_buckets(htts_p->page_count, htts_p->buckets_read, htts_p->bucket_count);
+		htts_p->space_occupied = extrapolate_to_all_buckets(htts_p->space_occupied, htts_p->buckets_read, htts_p->bucket_count);
+		htts_p->space_allotted = extrapolate_to_all_buckets(htts_p->space_allotted, htts_p->buckets_read, htts_p->bucket_count);
+	}
+
+	return 1;
+
+	ABORT_ERROR:;
+	if(lpli_p != NULL)
+		delete_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+	if(ptrl_p != NULL)
+		delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // we are facing abort, so no need for vaccum
+	(*htts_p) = (hash_table_statistics){};
+	return 0;
+}
+
+void print_hash_table_statistics(const hash_table_statistics* htts_p)
+{
+	printf("Hash_table statistics :\n");
+	printf("bucket_count = %"PRIu64", buckets_read = %"PRIu64"\n", htts_p->bucket_count, htts_p->buckets_read);
+	printf("tuple_count = %"PRIu64", page_count = %"PRIu64", fill = %"PRIu64"%%\n", htts_p->tuple_count, htts_p->page_count,
+		((htts_p->space_allotted == 0) ? 0 : ((htts_p->space_occupied * 100) / htts_p->space_allotted)));
+	printf("null_buckets = %"PRIu64", empty_buckets = %"PRIu64", max_chain_length = %"PRIu64"\n", htts_p->null_bucket_count, htts_p->empty_bucket_count, htts_p->max_chain_length);
+	printf("chain_length_histogram :\n");
+	for(uint32_t i = 0; i < HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE; i++)
+	{
+		if(htts_p->chain_length_histogram[i] == 0)
+			continue;
+		printf("\t%s%"PRIu32" pages : %"PRIu64"\n", ((i == HASH_TABLE_CHAIN_LENGTH_HISTOGRAM_SIZE - 1) ? ">= " : ""), i, htts_p->chain_length_histogram[i]);
+	}
+}
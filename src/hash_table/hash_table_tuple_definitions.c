@@ -1,7 +1,15 @@
 #include<hash_table_tuple_definitions.h>
 
+#include<positional_accessor_overlap.h>
+
 #include<stdlib.h>
 
+// get_tuple_fingerprint for the lpltd of the hash_table, fingerprint_context is the httd_p
+static uint64_t get_fingerprint_for_record(const void* httd_p, const void* record_tuple)
+{
+	return get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(get_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, record_tuple));
+}
+
 int init_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, uint32_t key_element_count, const tuple_hasher* hasher)
 {
 	// zero initialize httd_p
@@ -25,6 +33,8 @@ int init_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, const page_
 
 	httd_p->key_element_ids = key_element_ids;
 
+	httd_p->key_comparator = get_tuple_keys_comparator(record_def, key_element_ids, key_element_count);
+
 	// initialize key def
 
 	// allocate memory for key_def and initialize it
@@ -59,12 +69,72 @@ int init_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, const page_
 		return 0;
 	}
 
+	// let the bucket pages carry the filter of the fingerprints of their records
+	if(!set_tuple_fingerprint_for_linked_page_list_tuple_definitions(&(httd_p->lpltd), httd_p, get_fingerprint_for_record))
+	{
+		deinit_hash_table_tuple_definitions(httd_p);
+		return 0;
+	}
+
 	if(!init_page_table_tuple_definitions(&(httd_p->pttd), pas_p))
 	{
 		deinit_hash_table_tuple_definitions(httd_p);
 		return 0;
 	}
 
+	// the root page carries an epoch, that changes with every change of the bucket_count and with every bucket_head_page_id that gets freed (see hash_table_handle.h)
+	if(!set_root_epoch_for_page_table_tuple_definitions(&(httd_p->pttd)))
+	{
+		deinit_hash_table_tuple_definitions(httd_p);
+		return 0;
+	}
+
+	return 1;
+}
+
+static uint64_t compute_hash_value_for_record(const hash_table_tuple_defs* httd_p, const void* record_tuple)
+{
+	tuple_hasher local_hasher = httd_p->hasher;
+	return hash_tuple(record_tuple, httd_p->lpltd.record_def, httd_p->key_element_ids, &local_hasher, httd_p->key_element_count);
+}
+
+// reads the hash_value stored in the hash element of the record_tuple into (*hash_value)
+// it returns 0, if the hash element could not be read OR is NULL, such a record has no stored hash_value
+static int get_stored_hash_value_for_record(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t* hash_value)
+{
+	user_value uval;
+	if(!get_value_from_element_from_tuple(&uval, httd_p->lpltd.record_def, httd_p->hash_element_id, record_tuple) || is_user_value_NULL(&uval))
+		return 0;
+	(*hash_value) = uval.uint_value;
+	return 1;
+}
+
+int is_key_element_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, positional_accessor element_id)
+{
+	return is_overlapping_any_positional_accessor(httd_p->key_element_ids, httd_p->key_element_count, element_id);
+}
+
+int is_hash_element_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, positional_accessor element_id)
+{
+	return httd_p->has_hash_element && are_overlapping_positional_accessors(httd_p->hash_element_id, element_id);
+}
+
+int set_hash_element_for_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p, positional_accessor hash_element_id)
+{
+	if(!are_all_positions_accessible_for_tuple_def(httd_p->lpltd.record_def, &hash_element_id, 1))
+		return 0;
+
+	// the hash_value is stored as is, so the element must be a UINT wide enough to hold all of it
+	const data_type_info* hash_element_dti = get_type_info_for_element_from_tuple_def(httd_p->lpltd.record_def, hash_element_id);
+	if(hash_element_dti->type != UINT || hash_element_dti->size != sizeof(uint64_t))
+		return 0;
+
+	// the hash_value is computed over the key elements, so it can not be one of them
+	if(is_key_element_for_hash_table_tuple_definitions(httd_p, hash_element_id))
+		return 0;
+
+	httd_p->has_hash_element = 1;
+	httd_p->hash_element_id = hash_element_id;
 	return 1;
 }
 
@@ -77,6 +147,26 @@ int check_if_record_can_be_inserted_for_hash_table_tuple_definitions(const hash_
 	if(!are_all_positions_accessible_for_tuple(record_tuple, httd_p->lpltd.record_def, httd_p->key_element_ids, httd_p->key_element_count))
 		return 0;
 
+	// the stored hash_value must be the hash_value of its key, else it will be routed to a wrong bucket on a split
+	if(httd_p->has_hash_element)
+	{
+		uint64_t stored_hash_value;
+		if(!get_stored_hash_value_for_record(httd_p, record_tuple, &stored_hash_value) || stored_hash_value != compute_hash_value_for_record(httd_p, record_tuple))
+			return 0;
+	}
+
+	return check_if_record_can_be_inserted_for_linked_page_list_tuple_definitions(&(httd_p->lpltd), record_tuple);
+}
+
+int check_if_record_can_be_inserted_with_hash_value_for_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t key_hash_value)
+{
+	if(record_tuple == NULL)
+		return 0;
+
+	// the key elements were already compared with the key, so they are accessible, and the stored hash_value only needs to be compared with the key_hash_value
+	if(!may_match_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, record_tuple, key_hash_value))
+		return 0;
+
 	return check_if_record_can_be_inserted_for_linked_page_list_tuple_definitions(&(httd_p->lpltd), record_tuple);
 }
 
@@ -127,16 +217,41 @@ uint64_t get_hash_value_for_key_using_hash_table_tuple_definitions(const hash_ta
 
 uint64_t get_hash_value_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple)
 {
-	tuple_hasher local_hasher = httd_p->hasher;
-	return hash_tuple(record_tuple, httd_p->lpltd.record_def, httd_p->key_element_ids, &local_hasher, httd_p->key_element_count);
+	// a record without a stored hash_value, can not be in the hash_table, but we still hash it correctly
+	uint64_t stored_hash_value;
+	if(httd_p->has_hash_element && get_stored_hash_value_for_record(httd_p, record_tuple, &stored_hash_value))
+		return stored_hash_value;
+	return compute_hash_value_for_record(httd_p, record_tuple);
 }
 
-uint64_t get_bucket_index_for_key_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* key, uint64_t bucket_count)
+int set_hash_value_in_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, void* record_tuple)
+{
+	if(!httd_p->has_hash_element)
+		return 0;
+
+	// the hash element is a fixed width UINT, so this set happens in place
+	return set_element_in_tuple(httd_p->lpltd.record_def, httd_p->hash_element_id, record_tuple, &((const user_value){.uint_value = compute_hash_value_for_record(httd_p, record_tuple)}), UINT32_MAX);
+}
+
+int may_match_hash_value_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t hash_value)
+{
+	if(!httd_p->has_hash_element)
+		return 1;
+
+	// a NULL hash element never matches
+	uint64_t stored_hash_value;
+	return get_stored_hash_value_for_record(httd_p, record_tuple, &stored_hash_value) && stored_hash_value == hash_value;
+}
+
+uint64_t get_fingerprint_for_hash_value_using_hash_table_tuple_definitions(uint64_t hash_value)
 {
-	// fetch the hash_value of the key first
-	uint64_t hash_value = get_hash_value_for_key_using_hash_table_tuple_definitions(httd_p, key);
+	// the top 12 bits, the tuples_filter only uses 12 bits of a fingerprint
+	return hash_value >> 52;
+}
 
-	// fetch and cache, the split_index and the floor_log_2 values of the bucket_count
+uint64_t get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(uint64_t hash_value, uint64_t bucket_count)
+{
+	// fetch the split_index and the floor_log_2 values of the bucket_count
 	int64_t fl2;
 	uint64_t split_index = get_hash_table_split_index(bucket_count, &fl2);
 
@@ -156,29 +271,58 @@ uint64_t get_bucket_index_for_key_using_hash_table_tuple_definitions(const hash_
 	return bucket_index;
 }
 
+uint64_t get_bucket_index_for_key_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* key, uint64_t bucket_count)
+{
+	return get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(get_hash_value_for_key_using_hash_table_tuple_definitions(httd_p, key), bucket_count);
+}
+
 uint64_t get_bucket_index_for_record_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* record_tuple, uint64_t bucket_count)
 {
-	// fetch the hash_value of the key first
-	uint64_t hash_value = get_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, record_tuple);
+	return get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(get_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, record_tuple), bucket_count);
+}
+
+void get_hash_values_for_keys_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* const* keys, uint32_t keys_count, uint64_t* hash_values)
+{
+	for(uint32_t i = 0; i < keys_count; i++)
+	{
+		tuple_hasher local_hasher = httd_p->hasher;
+		hash_values[i] = hash_tuple(keys[i], httd_p->key_def, NULL, &local_hasher, httd_p->key_element_count);
+	}
+}
+
+void get_hash_values_for_records_using_hash_table_tuple_definitions(const hash_table_tuple_defs* httd_p, const void* const* record_tuples, uint32_t records_count, uint64_t* hash_values)
+{
+	// the check for the hash element is made once for the whole batch
+	if(httd_p->has_hash_element)
+	{
+		for(uint32_t i = 0; i < records_count; i++)
+		{
+			if(!get_stored_hash_value_for_record(httd_p, record_tuples[i], &(hash_values[i])))
+				hash_values[i] = compute_hash_value_for_record(httd_p, record_tuples[i]);
+		}
+	}
+	else
+	{
+		for(uint32_t i = 0; i < records_count; i++)
+			hash_values[i] = compute_hash_value_for_record(httd_p, record_tuples[i]);
+	}
+}
 
-	// fetch and cache, the split_index and the floor_log_2 values of the bucket_count
+void get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions(const uint64_t* hash_values, uint32_t hash_values_count, uint64_t bucket_count, uint64_t* bucket_indices)
+{
+	// the split_index and the floor_log_2 values are computed only once for the whole batch
 	int64_t fl2;
 	uint64_t split_index = get_hash_table_split_index(bucket_count, &fl2);
 
-	// use the below hash_value to bucket_index conversion by default
-	uint64_t bucket_index = hash_value % (UINT64_C(1) << fl2);
+	// both the masks for the hash_value to bucket_index conversion, so that the loop below is free of branches and function calls
+	uint64_t low_mask = (UINT64_C(1) << fl2) - 1;
+	uint64_t high_mask = ((fl2+1) < 64) ? ((UINT64_C(1) << (fl2+1)) - 1) : UINT64_MAX;
 
-	// if this bucket was aleady split, then use the new hash_value to bucket_index conversion value
-	if(bucket_index < split_index)
+	for(uint32_t i = 0; i < hash_values_count; i++)
 	{
-		// below if condition is mathematically equivalent to hash_value % (2^(fl2+1))
-		if((fl2+1) < 64)
-			bucket_index = hash_value % (UINT64_C(1) << (fl2+1));
-		else
-			bucket_index = hash_value;
+		uint64_t bucket_index = hash_values[i] & low_mask;
+		bucket_indices[i] = (bucket_index < split_index) ? (hash_values[i] & high_mask) : bucket_index;
 	}
-
-	return bucket_index;
 }
 
 void deinit_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p)
@@ -195,6 +339,8 @@ void deinit_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p)
 	httd_p->key_element_count = 0;
 	httd_p->key_element_ids = NULL;
 	httd_p->key_def = NULL;
+	httd_p->has_hash_element = 0;
+	httd_p->hash_element_id = (positional_accessor){};
 }
 
 void print_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p)
@@ -219,6 +365,15 @@ void print_hash_table_tuple_definitions(hash_table_tuple_defs* httd_p)
 	else
 		printf("NULL\n");
 
+	printf("has_hash_element = %d\n", httd_p->has_hash_element);
+	if(httd_p->has_hash_element)
+	{
+		printf("hash_element_id = { ");
+		for(uint32_t j = 0; j < httd_p->hash_element_id.positions_length; j++)
+			printf("%u, ", httd_p->hash_element_id.positions[j]);
+		printf(" }\n");
+	}
+
 	printf("key_def = ");
 	if(httd_p->key_def)
 		print_tuple_def(httd_p->key_def);
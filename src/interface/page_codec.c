@@ -0,0 +1,109 @@
+#include<page_codec.h>
+
+#include<serial_int.h>
+
+#include<cutlery_stds.h>
+
+/*
+**	the zero run encoding of a page is a sequence of runs, each with a 1 byte type and a 4 byte length
+**	a LITERAL_RUN is followed by length bytes of the page, while a ZERO_RUN stands for length zero bytes
+*/
+
+#define LITERAL_RUN 0
+#define ZERO_RUN    1
+
+#define RUN_HEADER_SIZE 5
+
+// zero runs shorter than this are cheaper to be stored as part of the literal run
+#define MIN_ZERO_RUN_LENGTH 16
+
+// appends a run to the encoded buffer, it fails with 0, if the encoded buffer would grow beyond max_encoded_size
+static int append_run_to_encoded_page(void* encoded, uint32_t* encoded_size, uint32_t max_encoded_size, int run_type, const void* data, uint32_t length)
+{
+	if(length == 0)
+		return 1;
+
+	uint32_t run_size = RUN_HEADER_SIZE + ((run_type == LITERAL_RUN) ? length : 0);
+	if(run_size > max_encoded_size - (*encoded_size))
+		return 0;
+
+	serialize_uint32(encoded + (*encoded_size), 1, run_type);
+	serialize_uint32(encoded + (*encoded_size) + 1, 4, length);
+	if(run_type == LITERAL_RUN)
+		memory_move(encoded + (*encoded_size) + RUN_HEADER_SIZE, data, length);
+	(*encoded_size) += run_size;
+
+	return 1;
+}
+
+static uint32_t encode_zero_runs_in_page(const void* page, uint32_t page_size, void* encoded, uint32_t max_encoded_size)
+{
+	uint32_t encoded_size = 0;
+
+	uint32_t literal_start = 0;
+	uint32_t i = 0;
+	while(i < page_size)
+	{
+		if(((const char*)page)[i] != 0)
+		{
+			i++;
+			continue;
+		}
+
+		uint32_t zeros_end = i;
+		while(zeros_end < page_size && ((const char*)page)[zeros_end] == 0)
+			zeros_end++;
+
+		if(zeros_end - i >= MIN_ZERO_RUN_LENGTH)
+		{
+			if(!append_run_to_encoded_page(encoded, &encoded_size, max_encoded_size, LITERAL_RUN, page + literal_start, i - literal_start)
+			|| !append_run_to_encoded_page(encoded, &encoded_size, max_encoded_size, ZERO_RUN, NULL, zeros_end - i))
+				return 0;
+			literal_start = zeros_end;
+		}
+
+		i = zeros_end;
+	}
+
+	if(!append_run_to_encoded_page(encoded, &encoded_size, max_encoded_size, LITERAL_RUN, page + literal_start, page_size - literal_start))
+		return 0;
+
+	return encoded_size;
+}
+
+static void decode_zero_runs_in_page(void* page, uint32_t page_size, const void* encoded)
+{
+	uint32_t page_offset = 0;
+	while(page_offset < page_size)
+	{
+		int run_type = deserialize_uint32(encoded, 1);
+		uint32_t length = deserialize_uint32(encoded + 1, 4);
+		encoded += RUN_HEADER_SIZE;
+
+		if(run_type == LITERAL_RUN)
+		{
+			memory_move(page + page_offset, encoded, length);
+			encoded += length;
+		}
+		else
+			memory_set(page + page_offset, 0, length);
+
+		page_offset += length;
+	}
+}
+
+static uint32_t encode_page_with_zero_runs(const void* context, const void* page, uint32_t page_size, void* encoded, uint32_t max_encoded_size)
+{
+	return encode_zero_runs_in_page(page, page_size, encoded, max_encoded_size);
+}
+
+static void decode_page_with_zero_runs(const void* context, void* page, uint32_t page_size, const void* encoded)
+{
+	decode_zero_runs_in_page(page, page_size, encoded);
+}
+
+const page_codec zero_run_page_codec = {
+	.context = NULL,
+	.encode_page = encode_page_with_zero_runs,
+	.decode_page = decode_page_with_zero_runs,
+};
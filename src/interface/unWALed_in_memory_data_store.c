@@ -24,8 +24,18 @@ struct page_descriptor
 	int is_free;
 
 	// this will be NULL for a free page_desc
+	// it is also NULL for a compressed page, until it gets locked again
 	void* page_memory;
 
+	// compressed contents of a cold page, while it is not locked by anyone, else NULL
+	void* compressed_page_memory;
+
+	// the codec that the compressed_page_memory was encoded with, it decodes the page when it gets locked again
+	const page_codec* codec;
+
+	// value of modifications_count of the context, when this page was last modified
+	uint64_t last_modified_at;
+
 #ifdef CHECK_WAS_MODIFIED_BIT
 	// the below pointer will be used to allocate page_size memory,
 	// and will hold its previous value, while you modify the page_memory
@@ -56,6 +66,9 @@ page_descriptor* get_new_page_descriptor(uint64_t page_id, pthread_mutex_t* glob
 	page_desc->page_id = page_id;
 	page_desc->is_free = 1;	// because initially page_memory = NULL
 	page_desc->page_memory = NULL;
+	page_desc->compressed_page_memory = NULL;
+	page_desc->codec = NULL;
+	page_desc->last_modified_at = 0;
 #ifdef CHECK_WAS_MODIFIED_BIT
 	page_desc->previous_page_memory = NULL;
 #endif
@@ -149,8 +162,64 @@ struct memory_store_context
 	// to maintain the number to read_locks and write_locks currently active
 	uint64_t active_read_locks_count;
 	uint64_t active_write_locks_count;
+
+	// incremented every time a write lock is released (or downgraded) with the WAS_MODIFIED flag, it serves as a clock to find the cold pages
+	uint64_t modifications_count;
 };
 
+// returns a newly allocated compressed copy of the page (encoded by the codec), it returns NULL if the page does not compress to atmost 3/4th of the page_size
+static void* get_compressed_copy_of_page(const void* page, uint32_t page_size, const page_codec* codec)
+{
+	uint32_t max_compressed_size = page_size - (page_size / 4);
+
+	void* compressed = malloc(max_compressed_size);
+	if(compressed == NULL)
+		return NULL;
+
+	uint32_t compressed_size = codec->encode_page(codec->context, page, page_size, compressed, max_compressed_size);
+	if(compressed_size == 0 || compressed_size > max_compressed_size)
+	{
+		free(compressed);
+		return NULL;
+	}
+
+	// give back the unused memory
+	void* compressed_shrunk = realloc(compressed, compressed_size);
+	return (compressed_shrunk != NULL) ? compressed_shrunk : compressed;
+}
+
+// returns the page_memory of a locked page, decompressing it if it is compressed
+// it returns NULL, only if the memory to decompress the page into could not be allocated
+static void* get_uncompressed_page_memory_unsafe(memory_store_context* cntxt, page_descriptor* page_desc)
+{
+	if(page_desc->compressed_page_memory == NULL)
+		return page_desc->page_memory;
+
+	page_desc->page_memory = allocate_page(cntxt->page_size);
+	if(page_desc->page_memory == NULL)
+		return NULL;
+
+	#ifdef CHECK_WAS_MODIFIED_BIT
+		page_desc->previous_page_memory = allocate_page(cntxt->page_size);
+		if(page_desc->previous_page_memory == NULL)
+		{
+			deallocate_page(page_desc->page_memory);
+			page_desc->page_memory = NULL;
+			return NULL;
+		}
+	#endif
+
+	page_desc->codec->decode_page(page_desc->codec->context, page_desc->page_memory, cntxt->page_size, page_desc->compressed_page_memory);
+	free(page_desc->compressed_page_memory);
+	page_desc->compressed_page_memory = NULL;
+	page_desc->codec = NULL;
+
+	// the release and upgrade/downgrade lock calls find the page by its new page_memory
+	insert_in_hashmap(&(cntxt->page_memory_map), page_desc);
+
+	return page_desc->page_memory;
+}
+
 #define MIN_BUCKET_COUNT 128
 
 static int discard_trailing_free_page_descs_unsafe(memory_store_context* cntxt)
@@ -223,6 +292,14 @@ static int run_free_page_management_unsafe(memory_store_context* cntxt, page_des
 				page_desc->previous_page_memory = NULL;
 			#endif
 		}
+
+		// a compressed page, that is being freed without being locked
+		if(page_desc->compressed_page_memory != NULL)
+		{
+			free(page_desc->compressed_page_memory);
+			page_desc->compressed_page_memory = NULL;
+			page_desc->codec = NULL;
+		}
 	}
 
 	// if the page_desc does not exist in the free_page_desc and it is not referenced any waiters
@@ -241,16 +318,26 @@ static int run_free_page_management_unsafe(memory_store_context* cntxt, page_des
 	return freed;
 }
 
-static void* get_new_page_with_write_lock(void* context, const void* transaction_id, uint64_t* page_id_returned, int* abort_error)
+// common body of get_new_page_with_write_lock() and get_new_page_with_write_lock_after()
+// if has_min_page_id is set, then only a page with page_id greater than the min_page_id is handed out
+// no_such_page is set, if there is no page_descriptor that could be handed out, else a NULL return implies a failure to allocate page memory
+static void* get_new_page_with_write_lock_greater_than(memory_store_context* cntxt, int has_min_page_id, uint64_t min_page_id, uint64_t* page_id_returned, int* no_such_page)
 {
-	memory_store_context* cntxt = context;
-
 	void* page_ptr = NULL;
 
 	pthread_mutex_lock(&(cntxt->global_lock));
 
-		// get page_descriptor from free_page_descs, with the lowest page_id
-		page_descriptor* page_desc = (page_descriptor*)find_smallest_in_bst(&(cntxt->free_page_descs));
+		page_descriptor* page_desc = NULL;
+
+		if(!has_min_page_id) // get page_descriptor from free_page_descs, with the lowest page_id
+			page_desc = (page_descriptor*)find_smallest_in_bst(&(cntxt->free_page_descs));
+		else
+		{
+			// get page_descriptor from free_page_descs, with the lowest page_id greater than min_page_id
+			// walk from the largest free page_id downwards, the last one visited is the one we want
+			for(page_descriptor* free_desc = (page_descriptor*)find_largest_in_bst(&(cntxt->free_page_descs)); free_desc != NULL && free_desc->page_id > min_page_id; free_desc = (page_descriptor*)get_inorder_prev_of_in_bst(&(cntxt->free_page_descs), free_desc))
+				page_desc = free_desc;
+		}
 
 		if(page_desc != NULL)
 		{
@@ -259,6 +346,7 @@ static void* get_new_page_with_write_lock(void* context, const void* transaction
 		}
 		else
 		{
+			// a new page_descriptor always gets a page_id greater than that of all the existing pages, so it is greater than the min_page_id too
 			if(get_element_count_hashmap(&(cntxt->page_id_map)) < cntxt->MAX_PAGE_COUNT)
 			{
 				// create a new page_descriptor for the new unseen page
@@ -290,6 +378,7 @@ static void* get_new_page_with_write_lock(void* context, const void* transaction
 			{
 				// this page_descriptor is now not free
 				page_desc->is_free = 0;
+				page_desc->last_modified_at = cntxt->modifications_count;
 
 				// insert this page in the page_memory_map, so that they future calls to release or upgrade/downgrade lock calls can find it
 				insert_in_hashmap(&(cntxt->page_memory_map), page_desc);
@@ -318,6 +407,8 @@ static void* get_new_page_with_write_lock(void* context, const void* transaction
 				discard_trailing_free_page_descs_unsafe(cntxt);
 			}
 		}
+		else
+			(*no_such_page) = 1;
 
 		// on success increment the active write locks count
 		if(page_ptr != NULL)
@@ -325,10 +416,6 @@ static void* get_new_page_with_write_lock(void* context, const void* transaction
 
 	pthread_mutex_unlock(&(cntxt->global_lock));
 
-	// set error if returning failure
-	if(page_ptr == NULL)
-		(*abort_error) = 1;
-
 	// if, we took a write lock on it, so copy the previous contents to the previous_page_memory
 	#ifdef CHECK_WAS_MODIFIED_BIT
 		if(page_ptr != NULL)
@@ -338,6 +425,30 @@ static void* get_new_page_with_write_lock(void* context, const void* transaction
 	return page_ptr;
 }
 
+static void* get_new_page_with_write_lock(void* context, const void* transaction_id, uint64_t* page_id_returned, int* abort_error)
+{
+	int no_such_page = 0;
+	void* page_ptr = get_new_page_with_write_lock_greater_than(context, 0, 0, page_id_returned, &no_such_page);
+
+	// set error if returning failure, running out of pages is a failure too
+	if(page_ptr == NULL)
+		(*abort_error) = 1;
+
+	return page_ptr;
+}
+
+static void* get_new_page_with_write_lock_after(void* context, const void* transaction_id, uint64_t after_page_id, uint64_t* page_id_returned, int* abort_error)
+{
+	int no_such_page = 0;
+	void* page_ptr = get_new_page_with_write_lock_greater_than(context, 1, after_page_id, page_id_returned, &no_such_page);
+
+	// not having a page after the after_page_id is not an error
+	if(page_ptr == NULL && !no_such_page)
+		(*abort_error) = 1;
+
+	return page_ptr;
+}
+
 static void* acquire_page_with_reader_lock(void* context, const void* transaction_id, uint64_t page_id, int* abort_error)
 {
 	memory_store_context* cntxt = context;
@@ -363,7 +474,11 @@ static void* acquire_page_with_reader_lock(void* context, const void* transactio
 					run_free_page_management_unsafe(cntxt, page_desc);
 				}
 				else
-					page_ptr = page_desc->page_memory;
+				{
+					page_ptr = get_uncompressed_page_memory_unsafe(cntxt, page_desc);
+					if(page_ptr == NULL)
+						read_unlock(&(page_desc->page_lock));
+				}
 			}
 		}
 
@@ -405,7 +520,11 @@ static void* acquire_page_with_writer_lock(void* context, const void* transactio
 					run_free_page_management_unsafe(cntxt, page_desc);
 				}
 				else
-					page_ptr = page_desc->page_memory;
+				{
+					page_ptr = get_uncompressed_page_memory_unsafe(cntxt, page_desc);
+					if(page_ptr == NULL)
+						write_unlock(&(page_desc->page_lock));
+				}
 			}
 		}
 
@@ -428,6 +547,106 @@ static void* acquire_page_with_writer_lock(void* context, const void* transactio
 	return page_ptr;
 }
 
+static void* try_acquire_page_with_reader_lock(void* context, const void* transaction_id, uint64_t page_id, int* abort_error)
+{
+	memory_store_context* cntxt = context;
+
+	void* page_ptr = NULL;
+
+	// set if the page does not exist or is free, the lock being held by some other thread is not an error
+	int page_not_found = 1;
+
+	pthread_mutex_lock(&(cntxt->global_lock));
+
+		page_descriptor* page_desc = (page_descriptor*)find_equals_in_hashmap(&(cntxt->page_id_map), &((page_descriptor){.page_id = page_id}));
+
+		// attempt to acquire a lock if such a page_descriptor exists and is not free
+		if(page_desc != NULL && (!(page_desc->is_free)))
+		{
+			page_not_found = 0;
+
+			// we never wait here, so the page can not get freed while we are acquiring the lock
+			int lock_acquired = read_lock(&(page_desc->page_lock), READ_PREFERRING, NON_BLOCKING);
+
+			if(lock_acquired)
+			{
+				page_ptr = get_uncompressed_page_memory_unsafe(cntxt, page_desc);
+
+				// failing to decompress the page is an error, unlike the lock being held by some other thread
+				if(page_ptr == NULL)
+				{
+					read_unlock(&(page_desc->page_lock));
+					page_not_found = 1;
+				}
+			}
+		}
+
+		// on success increment the active read locks count
+		if(page_ptr != NULL)
+			cntxt->active_read_locks_count++;
+
+	pthread_mutex_unlock(&(cntxt->global_lock));
+
+	// set error only if the page was not found
+	if(page_ptr == NULL && page_not_found)
+		(*abort_error) = 1;
+
+	return page_ptr;
+}
+
+static void* try_acquire_page_with_writer_lock(void* context, const void* transaction_id, uint64_t page_id, int* abort_error)
+{
+	memory_store_context* cntxt = context;
+
+	void* page_ptr = NULL;
+
+	// set if the page does not exist or is free, the lock being held by some other thread is not an error
+	int page_not_found = 1;
+
+	pthread_mutex_lock(&(cntxt->global_lock));
+
+		page_descriptor* page_desc = (page_descriptor*)find_equals_in_hashmap(&(cntxt->page_id_map), &((page_descriptor){.page_id = page_id}));
+
+		// attempt to acquire a lock if such a page_descriptor exists and is not free
+		if(page_desc != NULL && (!(page_desc->is_free)))
+		{
+			page_not_found = 0;
+
+			// we never wait here, so the page can not get freed while we are acquiring the lock
+			int lock_acquired = write_lock(&(page_desc->page_lock), NON_BLOCKING);
+
+			if(lock_acquired)
+			{
+				page_ptr = get_uncompressed_page_memory_unsafe(cntxt, page_desc);
+
+				// failing to decompress the page is an error, unlike the lock being held by some other thread
+				if(page_ptr == NULL)
+				{
+					write_unlock(&(page_desc->page_lock));
+					page_not_found = 1;
+				}
+			}
+		}
+
+		// on success increment the active write locks count
+		if(page_ptr != NULL)
+			cntxt->active_write_locks_count++;
+
+	pthread_mutex_unlock(&(cntxt->global_lock));
+
+	// set error only if the page was not found
+	if(page_ptr == NULL && page_not_found)
+		(*abort_error) = 1;
+
+	// if, we took a write lock on it, so copy the previous contents to the previous_page_memory
+	#ifdef CHECK_WAS_MODIFIED_BIT
+		if(page_ptr != NULL)
+			memory_move(page_desc->previous_page_memory, page_desc->page_memory, cntxt->page_size);
+	#endif
+
+	return page_ptr;
+}
+
 static int downgrade_writer_lock_to_reader_lock_on_page(void* context, const void* transaction_id, void* pg_ptr, int opts, int* abort_error)
 {
 	memory_store_context* cntxt = context;
@@ -455,6 +674,9 @@ static int downgrade_writer_lock_to_reader_lock_on_page(void* context, const voi
 		{
 			cntxt->active_write_locks_count--;
 			cntxt->active_read_locks_count++;
+
+			if(opts & WAS_MODIFIED)
+				page_desc->last_modified_at = ++(cntxt->modifications_count);
 		}
 
 	pthread_mutex_unlock(&(cntxt->global_lock));
@@ -540,8 +762,13 @@ static int release_writer_lock_on_page(void* context, const void* transaction_id
 
 		// on success decrement the active write locks count
 		if(lock_released)
+		{
 			cntxt->active_write_locks_count--;
 
+			if(opts & WAS_MODIFIED)
+				page_desc->last_modified_at = ++(cntxt->modifications_count);
+		}
+
 	pthread_mutex_unlock(&(cntxt->global_lock));
 
 	// set error if returning failure
@@ -616,6 +843,56 @@ static int free_page(void* context, const void* transaction_id, uint64_t page_id
 	return is_freed;
 }
 
+// compresses the page with the codec, only if it is unlocked (with no waiters), and is cold
+// it returns 1, if the page was compressed
+static int compress_page_if_cold_unsafe(memory_store_context* cntxt, page_descriptor* page_desc, uint64_t cold_after_modifications_count, const page_codec* codec)
+{
+	// skip free pages, the already compressed pages and the pages that are (or are about to be) locked
+	if(page_desc->is_free || page_desc->page_memory == NULL)
+		return 0;
+	if(is_read_locked(&(page_desc->page_lock)) || is_write_locked(&(page_desc->page_lock)) || has_waiters(&(page_desc->page_lock)))
+		return 0;
+
+	// skip the pages modified recently
+	if(cntxt->modifications_count - page_desc->last_modified_at < cold_after_modifications_count)
+		return 0;
+
+	page_desc->compressed_page_memory = get_compressed_copy_of_page(page_desc->page_memory, cntxt->page_size, codec);
+	if(page_desc->compressed_page_memory == NULL)
+		return 0;
+	page_desc->codec = codec;
+
+	remove_from_hashmap(&(cntxt->page_memory_map), page_desc);
+
+	deallocate_page(page_desc->page_memory);
+	page_desc->page_memory = NULL;
+
+	#ifdef CHECK_WAS_MODIFIED_BIT
+		deallocate_page(page_desc->previous_page_memory);
+		page_desc->previous_page_memory = NULL;
+	#endif
+
+	return 1;
+}
+
+static int compress_page(void* context, const void* transaction_id, uint64_t page_id, uint64_t cold_after_modifications_count, const page_codec* codec, int* abort_error)
+{
+	memory_store_context* cntxt = context;
+
+	int is_compressed = 0;
+
+	pthread_mutex_lock(&(cntxt->global_lock));
+
+		page_descriptor* page_desc = (page_descriptor*)find_equals_in_hashmap(&(cntxt->page_id_map), &((page_descriptor){.page_id = page_id}));
+
+		if(page_desc != NULL)
+			is_compressed = compress_page_if_cold_unsafe(cntxt, page_desc, cold_after_modifications_count, codec);
+
+	pthread_mutex_unlock(&(cntxt->global_lock));
+
+	return is_compressed;
+}
+
 #include<page_layout_unaltered.h>
 
 static int is_valid_page_access_specs_as_params(const page_access_specs* pas_p)
@@ -647,6 +924,11 @@ page_access_methods* get_new_unWALed_in_memory_data_store(const page_access_spec
 	pam_p->release_reader_lock_on_page = release_reader_lock_on_page;
 	pam_p->release_writer_lock_on_page = release_writer_lock_on_page;
 	pam_p->free_page = free_page;
+
+	pam_p->try_acquire_page_with_reader_lock = try_acquire_page_with_reader_lock;
+	pam_p->try_acquire_page_with_writer_lock = try_acquire_page_with_writer_lock;
+	pam_p->get_new_page_with_write_lock_after = get_new_page_with_write_lock_after;
+	pam_p->compress_page = compress_page;
 	
 	pam_p->context = malloc(sizeof(memory_store_context));
 	if(pam_p->context == NULL)
@@ -680,9 +962,48 @@ page_access_methods* get_new_unWALed_in_memory_data_store(const page_access_spec
 	}
 	cntxt->active_read_locks_count = 0;
 	cntxt->active_write_locks_count = 0;
+	cntxt->modifications_count = 0;
 	return pam_p;
 }
 
+uint64_t compress_cold_pages_in_unWALed_in_memory_data_store(page_access_methods* pam_p, uint64_t cold_after_modifications_count)
+{
+	memory_store_context* cntxt = pam_p->context;
+
+	uint64_t pages_compressed = 0;
+
+	pthread_mutex_lock(&(cntxt->global_lock));
+
+		// page_ids are always dense, from 0 to total_pages - 1
+		uint64_t total_pages = get_element_count_hashmap(&(cntxt->page_id_map));
+		for(uint64_t page_id = 0; page_id < total_pages; page_id++)
+		{
+			page_descriptor* page_desc = (page_descriptor*)find_equals_in_hashmap(&(cntxt->page_id_map), &((page_descriptor){.page_id = page_id}));
+			if(page_desc == NULL)
+				continue;
+
+			pages_compressed += compress_page_if_cold_unsafe(cntxt, page_desc, cold_after_modifications_count, &zero_run_page_codec);
+		}
+
+	pthread_mutex_unlock(&(cntxt->global_lock));
+
+	return pages_compressed;
+}
+
+uint64_t get_used_pages_count_in_unWALed_in_memory_data_store(page_access_methods* pam_p)
+{
+	memory_store_context* cntxt = pam_p->context;
+
+	pthread_mutex_lock(&(cntxt->global_lock));
+
+		// total_pages = get_element_count_hashmap(page_id_map), and the free ones are accounted in free_pages_count
+		uint64_t used_pages_count = get_element_count_hashmap(&(cntxt->page_id_map)) - cntxt->free_pages_count;
+
+	pthread_mutex_unlock(&(cntxt->global_lock));
+
+	return used_pages_count;
+}
+
 static void delete_notified_page_descriptor(void* resource_p, const void* data)
 {
 	if(((page_descriptor*)(data))->page_memory != NULL)
@@ -691,6 +1012,8 @@ static void delete_notified_page_descriptor(void* resource_p, const void* data)
 		if(((page_descriptor*)(data))->previous_page_memory != NULL)
 			deallocate_page(((page_descriptor*)(data))->previous_page_memory);
 	#endif
+	if(((page_descriptor*)(data))->compressed_page_memory != NULL)
+		free(((page_descriptor*)(data))->compressed_page_memory);
 	delete_page_descriptor(((page_descriptor*)(data)));
 }
 
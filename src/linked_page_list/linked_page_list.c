@@ -2,6 +2,7 @@
 
 #include<linked_page_list_page_header.h>
 #include<linked_page_list_node_util.h>
+#include<linked_page_list_page_tuples_util.h>
 
 #include<persistent_page_functions.h>
 
@@ -149,6 +150,11 @@ int merge_linked_page_lists(uint64_t lpl1_head_page_id, uint64_t lpl2_head_page_
 				goto ABORT_ERROR;
 		}
 
+		// lpl1_head now has the tuples of lpl2_head
+		rebuild_tuples_filter_of_linked_page_list_page(&lpl1_head, lpltd_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+
 		if(is_dual_node_linked_page_list(&lpl2_head, lpltd_p))
 		{
 			// grab lock on the next of lpl2
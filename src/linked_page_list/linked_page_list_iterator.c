@@ -191,6 +191,48 @@ const void* get_tuple_linked_page_list_iterator(const linked_page_list_iterator*
 	return get_nth_tuple_on_persistent_page(get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def), lpli_p->curr_tuple_index);
 }
 
+uint32_t get_projected_batch_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const positional_accessor* element_ids, uint32_t element_count, user_value** columns, uint32_t max_tuples)
+{
+	const persistent_page* curr_page = get_from_ref(&(lpli_p->curr_page));
+
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(curr_page, lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def));
+	if(lpli_p->curr_tuple_index >= tuple_count)
+		return 0;
+
+	uint32_t tuples_read = min(max_tuples, tuple_count - lpli_p->curr_tuple_index);
+
+	// fill one column at a time, so that each of the columns is written contiguously
+	for(uint32_t j = 0; j < element_count; j++)
+	{
+		for(uint32_t i = 0; i < tuples_read; i++)
+		{
+			const void* tuple = get_nth_tuple_on_persistent_page(curr_page, lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def), lpli_p->curr_tuple_index + i);
+			get_value_from_element_from_tuple(&(columns[j][i]), lpli_p->lpltd_p->record_def, element_ids[j], tuple);
+		}
+	}
+
+	// point to the last tuple read
+	if(tuples_read > 0)
+		lpli_p->curr_tuple_index += (tuples_read - 1);
+
+	return tuples_read;
+}
+
+uint32_t get_space_occupied_on_curr_page_linked_page_list_iterator(const linked_page_list_iterator* lpli_p, uint32_t* space_allotted)
+{
+	const persistent_page* curr_page = get_from_ref(&(lpli_p->curr_page));
+	(*space_allotted) = get_space_allotted_to_all_tuples_on_persistent_page(curr_page, lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def));
+	return get_space_occupied_by_all_tuples_on_persistent_page(curr_page, lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def));
+}
+
+uint32_t get_tuple_count_from_curr_tuple_in_curr_page_linked_page_list_iterator(const linked_page_list_iterator* lpli_p)
+{
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def));
+	if(lpli_p->curr_tuple_index >= tuple_count)
+		return 0;
+	return tuple_count - lpli_p->curr_tuple_index;
+}
+
 void delete_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error)
 {
 	if(!is_persistent_page_NULL(&(lpli_p->head_page), lpli_p->pam_p))
@@ -225,7 +267,12 @@ int insert_OR_split_insert_on_page_of_linked_page_list(linked_page_list_iterator
 		goto ABORT_ERROR;
 	// if inserted, return success
 	if(inserted)
+	{
+		add_tuple_to_tuples_filter_of_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), tuple, lpli_p->lpltd_p, lpli_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
 		return 1;
+	}
 
 	// a resilient insert failed, so now we will need to split this page
 
@@ -341,6 +388,9 @@ int insert_at_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const
 	if(is_empty_linked_page_list(lpli_p))
 	{
 		append_tuple_on_persistent_page_resiliently(lpli_p->pmm_p, transaction_id, get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def), tuple, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+		add_tuple_to_tuples_filter_of_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), tuple, lpli_p->lpltd_p, lpli_p->pmm_p, transaction_id, abort_error);
 		if(*abort_error)
 			goto ABORT_ERROR;
 		lpli_p->curr_tuple_index = 0;
@@ -858,6 +908,39 @@ int next_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void
 	return 0;
 }
 
+int next_page_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error)
+{
+	// there is no next page to go to
+	if(is_empty_linked_page_list(lpli_p) || is_at_tail_page_linked_page_list_iterator(lpli_p))
+		return 0;
+
+	// point to the last tuple of the curr_page (the curr_page is not the only page, so it is never empty), and let next_linked_page_list_iterator move across the pages
+	lpli_p->curr_tuple_index = get_tuple_count_on_persistent_page(get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def)) - 1;
+
+	return next_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+}
+
+int skip_pages_without_fingerprint_linked_page_list_iterator(linked_page_list_iterator* lpli_p, uint64_t fingerprint, const void* transaction_id, int* abort_error)
+{
+	while(!may_contain_fingerprint_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), fingerprint, lpli_p->lpltd_p))
+	{
+		// no more pages to go to, park the cursor at the tail tuple
+		if(is_empty_linked_page_list(lpli_p) || is_at_tail_page_linked_page_list_iterator(lpli_p))
+		{
+			if(!is_empty_linked_page_list(lpli_p))
+				lpli_p->curr_tuple_index = get_tuple_count_on_persistent_page(get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def)) - 1;
+			return 0;
+		}
+
+		// for a writable iterator, this may merge the next page into the curr_page (rebuilding its tuples_filter), so the curr_page is tested again
+		next_page_linked_page_list_iterator(lpli_p, transaction_id, abort_error);
+		if(*abort_error)
+			return 0;
+	}
+
+	return 1;
+}
+
 int prev_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const void* transaction_id, int* abort_error)
 {
 	// if the linked_page_list is empty, then fail
@@ -1104,6 +1187,11 @@ int remove_all_in_curr_page_from_linked_page_list_iterator(linked_page_list_iter
 	if(*abort_error)
 		goto ABORT_ERROR;
 
+	// the page may stay on as the empty head page, so clear its filter
+	rebuild_tuples_filter_of_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p, lpli_p->pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
 	// since currently there is no tuple to point to, we will just reset the curr_tuple_index
 	lpli_p->curr_tuple_index = 0;
 	// below function only discards the page, if there are other pages in the linked_page_list
@@ -1138,7 +1226,12 @@ int update_at_linked_page_list_iterator(linked_page_list_iterator* lpli_p, const
 	if(*abort_error)
 		goto ABORT_ERROR;
 	if(updated)
+	{
+		add_tuple_to_tuples_filter_of_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), tuple, lpli_p->lpltd_p, lpli_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
 		return 1;
+	}
 
 	// discard tuple at curr_tuple_index
 	int discarded = discard_tuple_on_persistent_page(lpli_p->pmm_p, transaction_id, get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, &(lpli_p->lpltd_p->record_def->size_def), lpli_p->curr_tuple_index, abort_error);
@@ -1175,6 +1268,14 @@ int update_element_in_place_at_linked_page_list_iterator(linked_page_list_iterat
 	if(*abort_error)
 		goto ABORT_ERROR;
 
+	// the updated element may be a part of the fingerprint of the tuple
+	if(updated)
+	{
+		add_tuple_to_tuples_filter_of_linked_page_list_page(get_from_ref(&(lpli_p->curr_page)), get_tuple_linked_page_list_iterator(lpli_p), lpli_p->lpltd_p, lpli_p->pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto ABORT_ERROR;
+	}
+
 	return updated;
 
 	ABORT_ERROR:;
@@ -1192,7 +1293,7 @@ int sort_all_tuples_on_curr_page_in_linked_page_list_iterator(linked_page_list_i
 
 	sort_and_convert_to_sorted_packed_page(
 									get_from_ref(&(lpli_p->curr_page)), lpli_p->lpltd_p->pas_p->page_size, 
-									lpli_p->lpltd_p->record_def, key_element_ids, key_compare_direction, key_element_count,
+									lpli_p->lpltd_p->record_def, key_element_ids, key_compare_direction, key_element_count, get_tuple_keys_comparator(lpli_p->lpltd_p->record_def, key_element_ids, key_element_count),
 									lpli_p->pmm_p,
 									transaction_id,
 									abort_error
@@ -15,6 +15,7 @@ int init_linked_page_list_page(persistent_page* ppage, int is_self_referencing,
 	hdr.parent.type = LINKED_PAGE_LIST_PAGE;
 	hdr.next_page_id = (is_self_referencing ? ppage->page_id : lpltd_p->pas_p->NULL_PAGE_ID);
 	hdr.prev_page_id = (is_self_referencing ? ppage->page_id : lpltd_p->pas_p->NULL_PAGE_ID);
+	hdr.tuples_filter = 0;
 	set_linked_page_list_page_header(ppage, &hdr, lpltd_p, pmm_p, transaction_id, abort_error);
 	if((*abort_error))
 		return 0;
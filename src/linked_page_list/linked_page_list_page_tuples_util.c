@@ -244,6 +244,14 @@ persistent_page split_insert_linked_page_list_page(persistent_page* page1, const
 			goto ABORT_ERROR;
 	}
 
+	// the tuples of page1 are now spread over page1 and new_page, so both of their filters are rebuilt
+	rebuild_tuples_filter_of_linked_page_list_page(page1, lpltd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+	rebuild_tuples_filter_of_linked_page_list_page(&new_page, lpltd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto ABORT_ERROR;
+
 	// if not an abort_error, return new_page (persistent_page by value)
 	return new_page;
 
@@ -307,5 +315,64 @@ int merge_linked_page_list_pages(persistent_page* page1, persistent_page* page2,
 		}
 	}
 
+	// rebuild the filter of the page merged into, this is where the stale fingerprints (of the removed tuples) of both the pages get dropped
+	rebuild_tuples_filter_of_linked_page_list_page(((merge_into == MERGE_INTO_PAGE1) ? page1 : page2), lpltd_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
 	return 1;
+}
+
+// bits of the tuples_filter set for a fingerprint, 2 of the 64 bits picked by the lowest 12 bits of the fingerprint
+static uint64_t get_tuples_filter_bits_for_fingerprint(uint64_t fingerprint)
+{
+	return (UINT64_C(1) << (fingerprint & 63)) | (UINT64_C(1) << ((fingerprint >> 6) & 63));
+}
+
+// sets the tuples_filter in the page header, only if it changes
+static void set_tuples_filter_of_linked_page_list_page(persistent_page* ppage, uint64_t tuples_filter, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	linked_page_list_page_header hdr = get_linked_page_list_page_header(ppage, lpltd_p);
+	if(hdr.tuples_filter == tuples_filter)
+		return;
+
+	hdr.tuples_filter = tuples_filter;
+	set_linked_page_list_page_header(ppage, &hdr, lpltd_p, pmm_p, transaction_id, abort_error);
+}
+
+int may_contain_fingerprint_linked_page_list_page(const persistent_page* ppage, uint64_t fingerprint, const linked_page_list_tuple_defs* lpltd_p)
+{
+	if(lpltd_p->get_tuple_fingerprint == NULL)
+		return 1;
+
+	uint64_t fingerprint_bits = get_tuples_filter_bits_for_fingerprint(fingerprint);
+	return (get_linked_page_list_page_header(ppage, lpltd_p).tuples_filter & fingerprint_bits) == fingerprint_bits;
+}
+
+void add_tuple_to_tuples_filter_of_linked_page_list_page(persistent_page* ppage, const void* tuple, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(lpltd_p->get_tuple_fingerprint == NULL || tuple == NULL)
+		return;
+
+	uint64_t tuples_filter = get_linked_page_list_page_header(ppage, lpltd_p).tuples_filter;
+	tuples_filter |= get_tuples_filter_bits_for_fingerprint(lpltd_p->get_tuple_fingerprint(lpltd_p->fingerprint_context, tuple));
+
+	set_tuples_filter_of_linked_page_list_page(ppage, tuples_filter, lpltd_p, pmm_p, transaction_id, abort_error);
+}
+
+void rebuild_tuples_filter_of_linked_page_list_page(persistent_page* ppage, const linked_page_list_tuple_defs* lpltd_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(lpltd_p->get_tuple_fingerprint == NULL)
+		return;
+
+	uint64_t tuples_filter = 0;
+	uint32_t tuple_count = get_tuple_count_on_persistent_page(ppage, lpltd_p->pas_p->page_size, &(lpltd_p->record_def->size_def));
+	for(uint32_t i = 0; i < tuple_count; i++)
+	{
+		const void* tuple = get_nth_tuple_on_persistent_page(ppage, lpltd_p->pas_p->page_size, &(lpltd_p->record_def->size_def), i);
+		if(tuple != NULL)
+			tuples_filter |= get_tuples_filter_bits_for_fingerprint(lpltd_p->get_tuple_fingerprint(lpltd_p->fingerprint_context, tuple));
+	}
+
+	set_tuples_filter_of_linked_page_list_page(ppage, tuples_filter, lpltd_p, pmm_p, transaction_id, abort_error);
 }
\ No newline at end of file
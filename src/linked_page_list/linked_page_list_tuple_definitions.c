@@ -6,6 +6,27 @@
 
 #include<stdlib.h>
 
+// computes the max_record_size for the lpltd_p (with its pas_p and get_tuple_fingerprint already set), it returns 0, if the record_def's records do not fit on the page
+static int compute_max_record_size(linked_page_list_tuple_defs* lpltd_p, const tuple_def* record_def)
+{
+	// there must be room for atleast some bytes after the linked_page_list_page_header
+	if(!can_page_header_fit_on_persistent_page(sizeof_LINKED_PAGE_LIST_PAGE_HEADER(lpltd_p), lpltd_p->pas_p->page_size))
+		return 0;
+
+	// check if the record_def's record's min_size fits on half of the page
+	uint32_t space_allotted_for_records = get_space_to_be_allotted_to_all_tuples_on_persistent_page(sizeof_LINKED_PAGE_LIST_PAGE_HEADER(lpltd_p), lpltd_p->pas_p->page_size, &(record_def->size_def));
+	uint32_t space_additional_for_record = get_additional_space_overhead_per_tuple_on_persistent_page(lpltd_p->pas_p->page_size, &(record_def->size_def));
+	if((space_allotted_for_records / 2) < get_minimum_tuple_size(record_def) + space_additional_for_record)
+		return 0;
+
+	// calculate maximum record size that can can fit on this linked_page_list
+	lpltd_p->max_record_size = (space_allotted_for_records / 2) - space_additional_for_record;
+	if(is_fixed_sized_tuple_def(record_def))
+		lpltd_p->max_record_size = record_def->size_def.size;
+
+	return 1;
+}
+
 int init_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lpltd_p, const page_access_specs* pas_p, const tuple_def* record_def)
 {
 	// zero initialize lpltd_p
@@ -19,24 +40,29 @@ int init_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lpltd_p
 	lpltd_p->pas_p = pas_p;
 
 	// this can only be done after setting the pas_p attribute of lpltd
-	// there must be room for atleast some bytes after the page_table_page_header
-	if(!can_page_header_fit_on_persistent_page(sizeof_LINKED_PAGE_LIST_PAGE_HEADER(lpltd_p), lpltd_p->pas_p->page_size))
+	if(!compute_max_record_size(lpltd_p, record_def))
 		return 0;
 
-	// check if the record_def's record's min_size fits on half of the page
-	uint32_t space_allotted_for_records = get_space_to_be_allotted_to_all_tuples_on_persistent_page(sizeof_LINKED_PAGE_LIST_PAGE_HEADER(lpltd_p), pas_p->page_size, &(record_def->size_def));
-	uint32_t space_additional_for_record = get_additional_space_overhead_per_tuple_on_persistent_page(pas_p->page_size, &(record_def->size_def));
-	if((space_allotted_for_records / 2) < get_minimum_tuple_size(record_def) + space_additional_for_record)
+	// initialize record_def from the record_def provided
+	lpltd_p->record_def = record_def;
+
+	return 1;
+}
+
+int set_tuple_fingerprint_for_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lpltd_p, const void* fingerprint_context, uint64_t (*get_tuple_fingerprint)(const void* fingerprint_context, const void* tuple))
+{
+	if(get_tuple_fingerprint == NULL)
 		return 0;
 
-	// calculate maximum record size that can can fit on this linked_page_list
-	lpltd_p->max_record_size = (space_allotted_for_records / 2) - space_additional_for_record;
-	if(is_fixed_sized_tuple_def(record_def))
-		lpltd_p->max_record_size = record_def->size_def.size;
+	// the header size depends on the get_tuple_fingerprint, so work on a copy, until the max_record_size is known to be valid
+	linked_page_list_tuple_defs lpltd_with_fingerprint = (*lpltd_p);
+	lpltd_with_fingerprint.get_tuple_fingerprint = get_tuple_fingerprint;
+	lpltd_with_fingerprint.fingerprint_context = fingerprint_context;
 
-	// initialize record_def from the record_def provided
-	lpltd_p->record_def = record_def;
+	if(!compute_max_record_size(&lpltd_with_fingerprint, lpltd_p->record_def))
+		return 0;
 
+	(*lpltd_p) = lpltd_with_fingerprint;
 	return 1;
 }
 
@@ -61,6 +87,8 @@ void deinit_linked_page_list_tuple_definitions(linked_page_list_tuple_defs* lplt
 	lpltd_p->pas_p = NULL;
 	lpltd_p->record_def = NULL;
 	lpltd_p->max_record_size = 0;
+	lpltd_p->get_tuple_fingerprint = NULL;
+	lpltd_p->fingerprint_context = NULL;
 }
 
 void print_linked_page_list_tuple_definitions(const linked_page_list_tuple_defs* lpltd_p)
@@ -32,6 +32,16 @@ int is_writable_page_table_range_locker(const page_table_range_locker* ptrl_p)
 	return is_writable_array_table_range_locker(&(ptrl_p->atrl));
 }
 
+int get_root_epoch_for_page_table_range_locker(const page_table_range_locker* ptrl_p, uint64_t* epoch)
+{
+	return get_root_epoch_for_array_table_range_locker(&(ptrl_p->atrl), epoch);
+}
+
+int increment_root_epoch_for_page_table_range_locker(page_table_range_locker* ptrl_p, const void* transaction_id, int* abort_error)
+{
+	return increment_root_epoch_for_array_table_range_locker(&(ptrl_p->atrl), transaction_id, abort_error);
+}
+
 uint64_t get_from_page_table(page_table_range_locker* ptrl_p, uint64_t bucket_id, const void* transaction_id, int* abort_error)
 {
 	char page_id_entry_memory[MAX_TUPLE_SIZE_FOR_ONLY_NON_NULLABLE_FIXED_WIDTH_UNSIGNED_PAGE_ID];
@@ -13,6 +13,11 @@ int init_page_table_tuple_definitions(page_table_tuple_defs* pttd_p, const page_
 	return init_array_table_tuple_definitions(&(pttd_p->attd), pas_p, &(pas_p->page_id_tuple_def));
 }
 
+int set_root_epoch_for_page_table_tuple_definitions(page_table_tuple_defs* pttd_p)
+{
+	return set_root_epoch_for_array_table_tuple_definitions(&(pttd_p->attd));
+}
+
 void deinit_page_table_tuple_definitions(page_table_tuple_defs* pttd_p)
 {
 	deinit_array_table_tuple_definitions(&(pttd_p->attd));
@@ -0,0 +1,148 @@
+#include<partitioned_bplus_tree.h>
+
+#include<partitioned_bplus_tree_iterator.h>
+
+#include<page_table.h>
+
+#include<stdlib.h>
+
+uint64_t get_new_partitioned_bplus_tree(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// create a new page_table for the partitioned_bplus_tree
+	uint64_t root_page_id = get_new_page_table(&(pbpttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return pbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	// take a range lock on the page table, to set the root_page_ids of the partitions
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, (bucket_range){0, pbpttd_p->partitions_count - 1}, &(pbpttd_p->pttd), pam_p, pmm_p, transaction_id, abort_error);
+	if(*abort_error)
+		return pbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	for(uint64_t i = 0; i < pbpttd_p->partitions_count; i++)
+	{
+		uint64_t partition_root_page_id = get_new_bplus_tree(&(pbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+		if(*abort_error)
+			break;
+
+		set_in_page_table(ptrl_p, i, partition_root_page_id, transaction_id, abort_error);
+		if(*abort_error)
+			break;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, since we only performed set calls with non NULL_PAGE_IDs
+	if(*abort_error)
+		return pbpttd_p->pttd.pas_p->NULL_PAGE_ID;
+
+	return root_page_id;
+}
+
+int get_partition_root_page_ids_for_partitioned_bplus_tree(uint64_t root_page_id, uint64_t* partition_root_page_ids, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	// take a range lock on the page table
+	page_table_range_locker* ptrl_p = get_new_page_table_range_locker(root_page_id, (bucket_range){0, pbpttd_p->partitions_count - 1}, &(pbpttd_p->pttd), pam_p, NULL, transaction_id, abort_error);
+	if(*abort_error)
+		return 0;
+
+	for(uint64_t i = 0; i < pbpttd_p->partitions_count; i++)
+	{
+		partition_root_page_ids[i] = get_from_page_table(ptrl_p, i, transaction_id, abort_error);
+		if(*abort_error)
+			break;
+	}
+
+	delete_page_table_range_locker(ptrl_p, NULL, NULL, transaction_id, abort_error); // vaccum will not be required here, we only perforned a read
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+int insert_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* record, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	if(!check_if_record_can_be_inserted_for_bplus_tree_tuple_definitions(&(pbpttd_p->bpttd), record))
+		return 0;
+
+	uint64_t partition_index = get_partition_index_for_record_using_partitioned_bplus_tree_tuple_definitions(pbpttd_p, record);
+	return insert_in_bplus_tree(partition_root_page_ids[partition_index], record, &(pbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int delete_from_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t partition_index = get_partition_index_for_key_using_partitioned_bplus_tree_tuple_definitions(pbpttd_p, key);
+	return delete_from_bplus_tree(partition_root_page_ids[partition_index], key, &(pbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+}
+
+int inspected_update_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, void* new_record, const update_inspector* ui_p, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t partition_index = get_partition_index_for_record_using_partitioned_bplus_tree_tuple_definitions(pbpttd_p, new_record);
+	return inspected_update_in_bplus_tree(partition_root_page_ids[partition_index], new_record, ui_p, &(pbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+}
+
+bplus_tree_iterator* find_in_partition_of_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, int is_stacked, int lock_type, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p, const void* transaction_id, int* abort_error)
+{
+	// the partition can not be identified without the partitioning key elements
+	if(key == NULL || key_element_count_concerned < pbpttd_p->partitioning_key_element_count)
+		return NULL;
+
+	uint64_t partition_index = get_partition_index_for_key_using_partitioned_bplus_tree_tuple_definitions(pbpttd_p, key);
+	return find_in_bplus_tree(partition_root_page_ids[partition_index], key, key_element_count_concerned, find_pos, is_stacked, lock_type, &(pbpttd_p->bpttd), pam_p, pmm_p, transaction_id, abort_error);
+}
+
+partitioned_bplus_tree_iterator* find_in_partitioned_bplus_tree(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	return get_new_partitioned_bplus_tree_iterator(partition_root_page_ids, key, key_element_count_concerned, find_pos, pbpttd_p, pam_p, transaction_id, abort_error);
+}
+
+int destroy_partitioned_bplus_tree(uint64_t root_page_id, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t* partition_root_page_ids = malloc(sizeof(uint64_t) * pbpttd_p->partitions_count);
+	if(partition_root_page_ids == NULL)
+		exit(-1);
+
+	if(!get_partition_root_page_ids_for_partitioned_bplus_tree(root_page_id, partition_root_page_ids, pbpttd_p, pam_p, transaction_id, abort_error))
+		goto EXIT;
+
+	for(uint64_t i = 0; i < pbpttd_p->partitions_count; i++)
+	{
+		destroy_bplus_tree(partition_root_page_ids[i], &(pbpttd_p->bpttd), pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+
+	destroy_page_table(root_page_id, &(pbpttd_p->pttd), pam_p, transaction_id, abort_error);
+
+	EXIT:;
+	free(partition_root_page_ids);
+
+	if(*abort_error)
+		return 0;
+
+	return 1;
+}
+
+void print_partitioned_bplus_tree(uint64_t root_page_id, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	uint64_t* partition_root_page_ids = malloc(sizeof(uint64_t) * pbpttd_p->partitions_count);
+	if(partition_root_page_ids == NULL)
+		exit(-1);
+
+	printf("\n\nPartitioned_bplus_tree @ root_page_id = %"PRIu64"\n\n", root_page_id);
+
+	print_page_table(root_page_id, 0, &(pbpttd_p->pttd), pam_p, transaction_id, abort_error);
+	if(*abort_error)
+		goto EXIT;
+
+	if(!get_partition_root_page_ids_for_partitioned_bplus_tree(root_page_id, partition_root_page_ids, pbpttd_p, pam_p, transaction_id, abort_error))
+		goto EXIT;
+
+	for(uint64_t i = 0; i < pbpttd_p->partitions_count; i++)
+	{
+		printf("\npartition %"PRIu64" :\n", i);
+		print_bplus_tree(partition_root_page_ids[i], 0, &(pbpttd_p->bpttd), pam_p, transaction_id, abort_error);
+		if(*abort_error)
+			goto EXIT;
+	}
+
+	EXIT:;
+	free(partition_root_page_ids);
+}
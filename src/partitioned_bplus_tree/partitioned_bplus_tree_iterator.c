@@ -0,0 +1,139 @@
+#include<partitioned_bplus_tree_iterator.h>
+
+#include<bplus_tree.h>
+
+#include<stdlib.h>
+
+// points curr_partition_index to the partition_iterator with the least (or the greatest, if !is_ascending) key
+// the records of different partitions never have the same key, since the partition of a record is decided by its key
+static void select_curr_partition_for_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p)
+{
+	const bplus_tree_tuple_defs* bpttd_p = &(pbpi_p->pbpttd_p->bpttd);
+
+	pbpi_p->curr_partition_index = pbpi_p->pbpttd_p->partitions_count;
+	const void* curr_tuple = NULL;
+
+	for(uint64_t i = 0; i < pbpi_p->pbpttd_p->partitions_count; i++)
+	{
+		if(pbpi_p->partition_iterators[i] == NULL)
+			continue;
+
+		const void* tuple = get_tuple_bplus_tree_iterator(pbpi_p->partition_iterators[i]);
+		if(tuple == NULL)
+			continue;
+
+		if(curr_tuple != NULL)
+		{
+			int cmp = bpttd_p->key_comparator(tuple, bpttd_p->record_def, bpttd_p->key_element_ids, curr_tuple, bpttd_p->record_def, bpttd_p->key_element_ids, bpttd_p->key_compare_direction, bpttd_p->key_element_count);
+			if((pbpi_p->is_ascending && cmp >= 0) || (!pbpi_p->is_ascending && cmp <= 0))
+				continue;
+		}
+
+		pbpi_p->curr_partition_index = i;
+		curr_tuple = tuple;
+	}
+}
+
+// deletes all the partition_iterators, releasing all their locks
+static void delete_all_partition_iterators(partitioned_bplus_tree_iterator* pbpi_p, const void* transaction_id, int* abort_error)
+{
+	for(uint64_t i = 0; i < pbpi_p->pbpttd_p->partitions_count; i++)
+	{
+		if(pbpi_p->partition_iterators[i] == NULL)
+			continue;
+		delete_bplus_tree_iterator(pbpi_p->partition_iterators[i], transaction_id, abort_error);
+		pbpi_p->partition_iterators[i] = NULL;
+	}
+	pbpi_p->curr_partition_index = pbpi_p->pbpttd_p->partitions_count;
+}
+
+partitioned_bplus_tree_iterator* get_new_partitioned_bplus_tree_iterator(const uint64_t* partition_root_page_ids, const void* key, uint32_t key_element_count_concerned, find_position find_pos, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p, const void* transaction_id, int* abort_error)
+{
+	partitioned_bplus_tree_iterator* pbpi_p = malloc(sizeof(partitioned_bplus_tree_iterator));
+	if(pbpi_p == NULL)
+		exit(-1);
+
+	pbpi_p->is_ascending = (find_pos == MIN || find_pos == GREATER_THAN || find_pos == GREATER_THAN_EQUALS);
+	pbpi_p->pbpttd_p = pbpttd_p;
+	pbpi_p->pam_p = pam_p;
+
+	pbpi_p->partition_iterators = calloc(pbpttd_p->partitions_count, sizeof(bplus_tree_iterator*));
+	if(pbpi_p->partition_iterators == NULL)
+		exit(-1);
+
+	for(uint64_t i = 0; i < pbpttd_p->partitions_count; i++)
+	{
+		pbpi_p->partition_iterators[i] = find_in_bplus_tree(partition_root_page_ids[i], key, key_element_count_concerned, find_pos, 0, READ_LOCK, &(pbpttd_p->bpttd), pam_p, NULL, transaction_id, abort_error);
+		if(*abort_error)
+		{
+			delete_partitioned_bplus_tree_iterator(pbpi_p, transaction_id, abort_error);
+			return NULL;
+		}
+
+		// nothing to scan in this partition, release its locks right away
+		if(get_tuple_bplus_tree_iterator(pbpi_p->partition_iterators[i]) == NULL)
+		{
+			delete_bplus_tree_iterator(pbpi_p->partition_iterators[i], transaction_id, abort_error);
+			pbpi_p->partition_iterators[i] = NULL;
+			if(*abort_error)
+			{
+				delete_partitioned_bplus_tree_iterator(pbpi_p, transaction_id, abort_error);
+				return NULL;
+			}
+		}
+	}
+
+	select_curr_partition_for_partitioned_bplus_tree_iterator(pbpi_p);
+
+	return pbpi_p;
+}
+
+const void* get_tuple_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p)
+{
+	if(pbpi_p->curr_partition_index == pbpi_p->pbpttd_p->partitions_count)
+		return NULL;
+	return get_tuple_bplus_tree_iterator(pbpi_p->partition_iterators[pbpi_p->curr_partition_index]);
+}
+
+int next_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p, const void* transaction_id, int* abort_error)
+{
+	if(pbpi_p->curr_partition_index == pbpi_p->pbpttd_p->partitions_count)
+		return 0;
+
+	bplus_tree_iterator** curr_partition_iterator = &(pbpi_p->partition_iterators[pbpi_p->curr_partition_index]);
+
+	int moved = 0;
+	if(pbpi_p->is_ascending)
+		moved = next_bplus_tree_iterator(*curr_partition_iterator, transaction_id, abort_error);
+	else
+		moved = prev_bplus_tree_iterator(*curr_partition_iterator, transaction_id, abort_error);
+	if(*abort_error)
+	{
+		// the curr_partition_iterator has already released all its locks
+		delete_all_partition_iterators(pbpi_p, transaction_id, abort_error);
+		return 0;
+	}
+
+	// this partition has no more records to scan, release its locks right away
+	if(!moved || get_tuple_bplus_tree_iterator(*curr_partition_iterator) == NULL)
+	{
+		delete_bplus_tree_iterator(*curr_partition_iterator, transaction_id, abort_error);
+		(*curr_partition_iterator) = NULL;
+		if(*abort_error)
+		{
+			delete_all_partition_iterators(pbpi_p, transaction_id, abort_error);
+			return 0;
+		}
+	}
+
+	select_curr_partition_for_partitioned_bplus_tree_iterator(pbpi_p);
+
+	return pbpi_p->curr_partition_index != pbpi_p->pbpttd_p->partitions_count;
+}
+
+void delete_partitioned_bplus_tree_iterator(partitioned_bplus_tree_iterator* pbpi_p, const void* transaction_id, int* abort_error)
+{
+	delete_all_partition_iterators(pbpi_p, transaction_id, abort_error);
+	free(pbpi_p->partition_iterators);
+	free(pbpi_p);
+}
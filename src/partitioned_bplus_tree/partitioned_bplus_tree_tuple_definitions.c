@@ -0,0 +1,66 @@
+#include<partitioned_bplus_tree_tuple_definitions_public.h>
+
+#include<stdlib.h>
+
+int init_partitioned_bplus_tree_tuple_definitions(partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_specs* pas_p, const tuple_def* record_def, const positional_accessor* key_element_ids, const compare_direction* key_compare_direction, uint32_t key_element_count, uint32_t partitioning_key_element_count, uint64_t partitions_count, const tuple_hasher* hasher)
+{
+	// zero initialize pbpttd_p
+	(*pbpttd_p) = (partitioned_bplus_tree_tuple_defs){};
+
+	// basic parameter check
+	if(partitions_count == 0 || partitioning_key_element_count == 0 || partitioning_key_element_count > key_element_count)
+		return 0;
+
+	pbpttd_p->partitions_count = partitions_count;
+
+	pbpttd_p->partitioning_key_element_count = partitioning_key_element_count;
+
+	pbpttd_p->hasher = (*hasher);
+
+	if(!init_bplus_tree_tuple_definitions(&(pbpttd_p->bpttd), pas_p, record_def, key_element_ids, key_compare_direction, key_element_count))
+	{
+		deinit_partitioned_bplus_tree_tuple_definitions(pbpttd_p);
+		return 0;
+	}
+
+	if(!init_page_table_tuple_definitions(&(pbpttd_p->pttd), pas_p))
+	{
+		deinit_partitioned_bplus_tree_tuple_definitions(pbpttd_p);
+		return 0;
+	}
+
+	return 1;
+}
+
+uint64_t get_partition_index_for_key_using_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const void* key)
+{
+	tuple_hasher local_hasher = pbpttd_p->hasher;
+	return hash_tuple(key, pbpttd_p->bpttd.key_def, NULL, &local_hasher, pbpttd_p->partitioning_key_element_count) % pbpttd_p->partitions_count;
+}
+
+uint64_t get_partition_index_for_record_using_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p, const void* record_tuple)
+{
+	tuple_hasher local_hasher = pbpttd_p->hasher;
+	return hash_tuple(record_tuple, pbpttd_p->bpttd.record_def, pbpttd_p->bpttd.key_element_ids, &local_hasher, pbpttd_p->partitioning_key_element_count) % pbpttd_p->partitions_count;
+}
+
+void deinit_partitioned_bplus_tree_tuple_definitions(partitioned_bplus_tree_tuple_defs* pbpttd_p)
+{
+	deinit_bplus_tree_tuple_definitions(&(pbpttd_p->bpttd));
+	deinit_page_table_tuple_definitions(&(pbpttd_p->pttd));
+	pbpttd_p->partitions_count = 0;
+	pbpttd_p->partitioning_key_element_count = 0;
+}
+
+void print_partitioned_bplus_tree_tuple_definitions(const partitioned_bplus_tree_tuple_defs* pbpttd_p)
+{
+	printf("Partitioned_bplus_tree tuple defs:\n");
+
+	printf("partitions_count = %"PRIu64"\n", pbpttd_p->partitions_count);
+
+	printf("partitioning_key_element_count = %"PRIu32"\n", pbpttd_p->partitioning_key_element_count);
+
+	print_bplus_tree_tuple_definitions(&(pbpttd_p->bpttd));
+
+	print_page_table_tuple_definitions(&(pbpttd_p->pttd));
+}
@@ -194,7 +194,7 @@ static int compare_sorted_runs(const void* sh_vp, const void* asr_vp1, const voi
 									sh_p->std_p->key_compare_direction,
 									sh_p->std_p->key_element_count);
 	else
-		return compare_tuples(	get_tuple_linked_page_list_iterator(asr_p1->run_iterator), sh_p->std_p->record_def, sh_p->std_p->key_element_ids,
+		return sh_p->std_p->key_comparator(	get_tuple_linked_page_list_iterator(asr_p1->run_iterator), sh_p->std_p->record_def, sh_p->std_p->key_element_ids,
 								get_tuple_linked_page_list_iterator(asr_p2->run_iterator), sh_p->std_p->record_def, sh_p->std_p->key_element_ids,
 								sh_p->std_p->key_compare_direction,
 								sh_p->std_p->key_element_count);
@@ -27,6 +27,8 @@ int init_sorter_tuple_definitions(sorter_tuple_defs* std_p, const page_access_sp
 
 	std_p->record_def = record_def;
 
+	std_p->key_comparator = get_tuple_keys_comparator(record_def, key_element_ids, key_element_count);
+
 	if(!init_linked_page_list_tuple_definitions(&(std_p->lpltd), pas_p, record_def))
 	{
 		deinit_sorter_tuple_definitions(std_p);
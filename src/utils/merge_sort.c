@@ -0,0 +1,45 @@
+#include<merge_sort.h>
+
+#include<string.h>
+
+#include<cutlery_math.h>
+
+#define element_at(array, index) (((char*)(array)) + ((index) * element_size))
+
+void merge_sort_elements(void* elements, void* temp, uint32_t element_count, size_t element_size, const void* context, element_comparator compare)
+{
+	// every pass merges the runs of width from src into runs of 2 * width in dst, then the 2 arrays swap their roles
+	void* src = elements;
+	void* dst = temp;
+
+	for(uint64_t width = 1; width < element_count; width *= 2)
+	{
+		for(uint64_t low = 0; low < element_count; low += 2 * width)
+		{
+			uint32_t mid = min(low + width, element_count);
+			uint32_t high = min(low + 2 * width, element_count);
+
+			uint32_t i = low, j = mid, k = low;
+			while(i < mid && j < high)
+			{
+				// pick from the right run, only if it is strictly lesser, this keeps the sort stable
+				if(compare(context, element_at(src, j), element_at(src, i)) < 0)
+					memcpy(element_at(dst, k++), element_at(src, j++), element_size);
+				else
+					memcpy(element_at(dst, k++), element_at(src, i++), element_size);
+			}
+			if(i < mid)
+				memcpy(element_at(dst, k), element_at(src, i), (mid - i) * element_size);
+			if(j < high)
+				memcpy(element_at(dst, k), element_at(src, j), (high - j) * element_size);
+		}
+
+		void* t = src;
+		src = dst;
+		dst = t;
+	}
+
+	// the sorted result is in src, after the last pass
+	if(src != elements)
+		memcpy(elements, src, ((size_t)element_count) * element_size);
+}
@@ -40,7 +40,48 @@ persistent_page get_new_persistent_page_with_write_lock(const page_access_method
 	return ppage;
 }
 
-persistent_page acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int* abort_error)
+persistent_page get_new_persistent_page_with_write_lock_after(const page_access_methods* pam_p, const void* transaction_id, uint64_t after_page_id, int* abort_error)
+{
+	// no new locks can be issued, or modified, once a transaction is aborted
+	if(*(abort_error))
+	{
+		printf("BUG :: attempting to acquire new page with a write lock, after knowing of an abort\n");
+		exit(-1);
+	}
+
+	// this is an optional method, not having it is the same as not having any page after the after_page_id
+	if(pam_p->get_new_page_with_write_lock_after == NULL)
+		return get_NULL_persistent_page(pam_p);
+
+	persistent_page ppage = {};
+	ppage.page = pam_p->get_new_page_with_write_lock_after(pam_p->context, transaction_id, after_page_id, &(ppage.page_id), abort_error);
+
+	// failure without an abort_error, implies that there is no page after the after_page_id
+	if(ppage.page == NULL)
+		return get_NULL_persistent_page(pam_p);
+
+	if(*(abort_error)) // success but with abort_error is a bug
+	{
+		printf("BUG :: pam success with an abort_error, buggy pam implementation\n");
+		exit(-1);
+	}
+
+	if(ppage.page_id <= after_page_id) // a page that is not after the after_page_id is a bug too
+	{
+		printf("BUG :: pam returned a new page that is not after the requested page_id, buggy pam implementation\n");
+		exit(-1);
+	}
+
+	// set the write locked flag on ppage
+	ppage.flags = 0;
+	ppage.is_write_locked = 1;
+
+	return ppage;
+}
+
+// common body of acquire_persistent_page_with_lock() and try_acquire_persistent_page_with_lock()
+// if non_blocking is set, then the try_acquire_page_with_*_lock methods of the pam_p are used, and a NULL page without an abort_error is not a bug
+static persistent_page acquire_or_try_acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int non_blocking, int* abort_error)
 {
 	// no new locks can be issued, or modified, once a transaction is aborted
 	if(*(abort_error))
@@ -51,63 +92,60 @@ persistent_page acquire_persistent_page_with_lock(const page_access_methods* pam
 
 	persistent_page ppage = {.page_id = page_id};
 
+	void* (*acquire_page)(void* context, const void* transaction_id, uint64_t page_id, int* abort_error) = NULL;
 	switch(lock_type)
 	{
 		case READ_LOCK :
 		{
-			ppage.page = pam_p->acquire_page_with_reader_lock(pam_p->context, transaction_id, ppage.page_id, abort_error);
-
-			if(ppage.page == NULL)
-			{
-				if((*abort_error) == 0) // failure without abort_error is a bug
-				{
-					printf("BUG :: pam failure without an abort_error, buggy pam implementation\n");
-					exit(-1);
-				}
-				return get_NULL_persistent_page(pam_p);
-			}
-
-			if(*(abort_error)) // success but with abort_error is a bug
-			{
-				printf("BUG :: pam success with an abort_error, buggy pam implementation\n");
-				exit(-1);
-			}
-
-			ppage.flags = 0;
-			ppage.is_write_locked = 0;
-
+			acquire_page = non_blocking ? pam_p->try_acquire_page_with_reader_lock : pam_p->acquire_page_with_reader_lock;
 			break;
 		}
 		case WRITE_LOCK :
 		{
-			ppage.page = pam_p->acquire_page_with_writer_lock(pam_p->context, transaction_id, ppage.page_id, abort_error);
-
-			if(ppage.page == NULL)
-			{
-				if((*abort_error) == 0) // failure without abort_error is a bug
-				{
-					printf("BUG :: pam failure without an abort_error, buggy pam implementation\n");
-					exit(-1);
-				}
-				return get_NULL_persistent_page(pam_p);
-			}
-
-			if(*(abort_error)) // success but with abort_error is a bug
-			{
-				printf("BUG :: pam success with an abort_error, buggy pam implementation\n");
-				exit(-1);
-			}
+			acquire_page = non_blocking ? pam_p->try_acquire_page_with_writer_lock : pam_p->acquire_page_with_writer_lock;
+			break;
+		}
+		default :
+			return ppage;
+	}
 
-			ppage.flags = 0;
-			ppage.is_write_locked = 1;
+	ppage.page = acquire_page(pam_p->context, transaction_id, ppage.page_id, abort_error);
 
-			break;
+	if(ppage.page == NULL)
+	{
+		// failure without an abort_error, implies that the lock could not be acquired without waiting, else it is a bug
+		if((*abort_error) == 0 && !non_blocking)
+		{
+			printf("BUG :: pam failure without an abort_error, buggy pam implementation\n");
+			exit(-1);
 		}
+		return get_NULL_persistent_page(pam_p);
 	}
 
+	if(*(abort_error)) // success but with abort_error is a bug
+	{
+		printf("BUG :: pam success with an abort_error, buggy pam implementation\n");
+		exit(-1);
+	}
+
+	ppage.flags = 0;
+	ppage.is_write_locked = (lock_type == WRITE_LOCK);
+
 	return ppage;
 }
 
+persistent_page acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int* abort_error)
+{
+	return acquire_or_try_acquire_persistent_page_with_lock(pam_p, transaction_id, page_id, lock_type, 0, abort_error);
+}
+
+persistent_page try_acquire_persistent_page_with_lock(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, int lock_type, int* abort_error)
+{
+	// if the pam does not support non-blocking lock acquisition (for this lock_type), then fallback to the blocking one
+	int non_blocking = (lock_type == READ_LOCK && pam_p->try_acquire_page_with_reader_lock != NULL) || (lock_type == WRITE_LOCK && pam_p->try_acquire_page_with_writer_lock != NULL);
+	return acquire_or_try_acquire_persistent_page_with_lock(pam_p, transaction_id, page_id, lock_type, non_blocking, abort_error);
+}
+
 int downgrade_to_reader_lock_on_persistent_page(const page_access_methods* pam_p, const void* transaction_id, persistent_page* ppage, int opts, int* abort_error)
 {
 	// no new locks can be issued, or modified, once a transaction is aborted
@@ -302,5 +340,28 @@ int free_persistent_page(const page_access_methods* pam_p, const void* transacti
 		}
 	}
 
+	return res;
+}
+int compress_persistent_page(const page_access_methods* pam_p, const void* transaction_id, uint64_t page_id, uint64_t cold_after_modifications_count, const page_codec* codec, int* abort_error)
+{
+	// a page can not be compressed, once a transaction is aborted
+	if(*(abort_error))
+	{
+		printf("BUG :: attempting to compress a page, after knowing of an abort\n");
+		exit(-1);
+	}
+
+	// this is an optional method, not having it is the same as the page never being cold enough
+	if(pam_p->compress_page == NULL)
+		return 0;
+
+	int res = pam_p->compress_page(pam_p->context, transaction_id, page_id, cold_after_modifications_count, codec, abort_error);
+
+	if(res && *(abort_error)) // success but with abort_error is a bug
+	{
+		printf("BUG :: pam success with an abort_error, buggy pam implementation\n");
+		exit(-1);
+	}
+
 	return res;
 }
\ No newline at end of file
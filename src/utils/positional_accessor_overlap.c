@@ -0,0 +1,23 @@
+#include<positional_accessor_overlap.h>
+
+#include<cutlery_math.h>
+
+int are_overlapping_positional_accessors(positional_accessor pa1, positional_accessor pa2)
+{
+	for(uint32_t j = 0; j < min(pa1.positions_length, pa2.positions_length); j++)
+	{
+		if(pa1.positions[j] != pa2.positions[j])
+			return 0;
+	}
+	return 1;
+}
+
+int is_overlapping_any_positional_accessor(const positional_accessor* pas, uint32_t pas_count, positional_accessor pa)
+{
+	for(uint32_t i = 0; i < pas_count; i++)
+	{
+		if(are_overlapping_positional_accessors(pas[i], pa))
+			return 1;
+	}
+	return 0;
+}
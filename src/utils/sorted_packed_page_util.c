@@ -31,14 +31,17 @@ struct tuple_on_page_compare_context
 
 	// number of elements in tuple_keys_to_compare and key_elements_to_compare
 	uint32_t keys_count;
+
+	// comparator for the types of the keys, picked once by the caller (when its tuple_defs were initialized)
+	tuple_keys_comparator key_comparator;
 };
 
-#define get_tuple_on_page_compare_context(tpl_def_v, tuple_keys_to_compare_v, key_def_v, key_elements_to_compare_v, key_compare_direction_v, keys_count_v) ((const tuple_on_page_compare_context){.tpl_def = tpl_def_v, .tuple_keys_to_compare = tuple_keys_to_compare_v, .key_def = key_def_v, .key_elements_to_compare = key_elements_to_compare_v, .key_compare_direction = key_compare_direction_v, .keys_count = keys_count_v})
+#define get_tuple_on_page_compare_context(tpl_def_v, tuple_keys_to_compare_v, key_def_v, key_elements_to_compare_v, key_compare_direction_v, keys_count_v, key_comparator_v) ((const tuple_on_page_compare_context){.tpl_def = tpl_def_v, .tuple_keys_to_compare = tuple_keys_to_compare_v, .key_def = key_def_v, .key_elements_to_compare = key_elements_to_compare_v, .key_compare_direction = key_compare_direction_v, .keys_count = keys_count_v, .key_comparator = key_comparator_v})
 
 int compare_tuples_using_comparator_context(const void* context, const void* tuple1, const void* tuple2)
 {
 	const tuple_on_page_compare_context* context_p = context;
-	return compare_tuples(tuple1, context_p->tpl_def, context_p->tuple_keys_to_compare, tuple2, context_p->key_def, context_p->key_elements_to_compare, context_p->key_compare_direction, context_p->keys_count);
+	return context_p->key_comparator(tuple1, context_p->tpl_def, context_p->tuple_keys_to_compare, tuple2, context_p->key_def, context_p->key_elements_to_compare, context_p->key_compare_direction, context_p->keys_count);
 }
 
 // compare context to compare a tuple with (must) an external materialized key tuple
@@ -131,7 +134,7 @@ index_accessed_interface get_index_accessed_interface_for_sorted_packed_page(tup
 
 int insert_to_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t* index,
 									const page_modification_methods* pmm_p,
@@ -140,7 +143,7 @@ int insert_to_sorted_packed_page(
 								)
 {
 	// search for a viable index for the new tuple to insert
-	uint32_t new_index = find_insertion_point_in_sorted_packed_page(ppage, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, tuple);
+	uint32_t new_index = find_insertion_point_in_sorted_packed_page(ppage, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, key_comparator, tuple);
 
 	// this is the final index for the newly inserted element
 	if(index != NULL)
@@ -152,7 +155,7 @@ int insert_to_sorted_packed_page(
 
 int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index
 								)
@@ -169,7 +172,7 @@ int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 	if(tuple_count > 0 && index < tuple_count)
 	{
 		const void* ith_tuple = get_nth_tuple_on_persistent_page(ppage, page_size, &(tpl_def->size_def), index);
-		if( compare_tuples(tuple, tpl_def, tuple_keys_to_compare, ith_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) > 0)
+		if( key_comparator(tuple, tpl_def, tuple_keys_to_compare, ith_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) > 0)
 			return 0;
 	}
 
@@ -177,7 +180,7 @@ int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 	if(tuple_count > 0 && index > 0)
 	{
 		const void* i_1_th_tuple = get_nth_tuple_on_persistent_page(ppage, page_size, &(tpl_def->size_def), index - 1);
-		if( compare_tuples(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) < 0)
+		if( key_comparator(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) < 0)
 			return 0;
 	}
 
@@ -186,7 +189,7 @@ int is_correct_insertion_index_for_insert_at_in_sorted_packed_page(
 
 int insert_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index,
 									const page_modification_methods* pmm_p,
@@ -195,7 +198,7 @@ int insert_at_in_sorted_packed_page(
 								)
 {
 	// fail if this function is not called with a correct insertion index
-	if(!is_correct_insertion_index_for_insert_at_in_sorted_packed_page(ppage, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, tuple, index))
+	if(!is_correct_insertion_index_for_insert_at_in_sorted_packed_page(ppage, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, key_comparator, tuple, index))
 		return 0;
 
 	// insert tuple to the page at the desired index
@@ -204,7 +207,7 @@ int insert_at_in_sorted_packed_page(
 
 int update_at_in_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple, 
 									uint32_t index,
 									const page_modification_methods* pmm_p,
@@ -224,7 +227,7 @@ int update_at_in_sorted_packed_page(
 	if(tuple_count > 0 && index != tuple_count - 1)
 	{
 		const void* i_1_th_tuple = get_nth_tuple_on_persistent_page(ppage, page_size, &(tpl_def->size_def), index + 1);
-		if( compare_tuples(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) > 0)
+		if( key_comparator(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) > 0)
 			return 0;
 	}
 
@@ -232,7 +235,7 @@ int update_at_in_sorted_packed_page(
 	if(tuple_count > 0 && index > 0)
 	{
 		const void* i_1_th_tuple = get_nth_tuple_on_persistent_page(ppage, page_size, &(tpl_def->size_def), index - 1);
-		if( compare_tuples(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) < 0)
+		if( key_comparator(tuple, tpl_def, tuple_keys_to_compare, i_1_th_tuple, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count) < 0)
 			return 0;
 	}
 
@@ -305,7 +308,7 @@ static uint32_t append_tuples_from_page(persistent_page* ppage_dest, uint32_t pa
 
 uint32_t insert_all_from_sorted_packed_page(
 									persistent_page* ppage_dest, const persistent_page* ppage_src, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									uint32_t start_index, uint32_t last_index,
 									const page_modification_methods* pmm_p,
 									const void* transaction_id,
@@ -326,7 +329,7 @@ uint32_t insert_all_from_sorted_packed_page(
 	const void* first_tuple_src = get_nth_tuple_on_persistent_page(ppage_src, page_size, &(tpl_def->size_def), 0);
 
 	// if they are in order then perform a direct copy
-	int compare_last_first = compare_tuples(last_tuple_dest, tpl_def, tuple_keys_to_compare, first_tuple_src, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count);
+	int compare_last_first = key_comparator(last_tuple_dest, tpl_def, tuple_keys_to_compare, first_tuple_src, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count);
 	if(compare_last_first <= 0)
 		return append_tuples_from_page(ppage_dest, page_size, &(tpl_def->size_def), ppage_src, start_index, last_index, pmm_p, transaction_id, abort_error);
 
@@ -339,7 +342,7 @@ uint32_t insert_all_from_sorted_packed_page(
 		if(tup == NULL)
 			continue;
 
-		int res = insert_to_sorted_packed_page(ppage_dest, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, tup, NULL, pmm_p, transaction_id, abort_error);
+		int res = insert_to_sorted_packed_page(ppage_dest, page_size, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, key_comparator, tup, NULL, pmm_p, transaction_id, abort_error);
 		if((*abort_error) || res == 0)
 			break;
 
@@ -351,7 +354,7 @@ uint32_t insert_all_from_sorted_packed_page(
 
 uint32_t find_insertion_point_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* tuple
 									)
 {
@@ -362,7 +365,7 @@ uint32_t find_insertion_point_in_sorted_packed_page(
 		return 0;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	return find_insertion_index_in_sorted_iai(&iai, 0, tuple_count - 1, tuple, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
@@ -370,7 +373,7 @@ uint32_t find_insertion_point_in_sorted_packed_page(
 
 uint32_t find_first_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -381,7 +384,7 @@ uint32_t find_first_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = binary_search_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context), FIRST_OCCURENCE);
@@ -395,7 +398,7 @@ uint32_t find_first_in_sorted_packed_page(
 
 uint32_t find_last_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -406,7 +409,7 @@ uint32_t find_last_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = binary_search_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context), LAST_OCCURENCE);
@@ -420,7 +423,7 @@ uint32_t find_last_in_sorted_packed_page(
 
 uint32_t find_preceding_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -431,7 +434,7 @@ uint32_t find_preceding_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = find_preceding_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
@@ -445,7 +448,7 @@ uint32_t find_preceding_in_sorted_packed_page(
 
 uint32_t find_preceding_equals_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -456,7 +459,7 @@ uint32_t find_preceding_equals_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = find_preceding_or_equals_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
@@ -470,7 +473,7 @@ uint32_t find_preceding_equals_in_sorted_packed_page(
 
 uint32_t find_succeeding_equals_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -481,7 +484,7 @@ uint32_t find_succeeding_equals_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = find_succeeding_or_equals_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
@@ -495,7 +498,7 @@ uint32_t find_succeeding_equals_in_sorted_packed_page(
 
 uint32_t find_succeeding_in_sorted_packed_page(
 									const persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const void* key, const tuple_def* key_def, const positional_accessor* key_elements_to_compare
 								)
 {
@@ -506,7 +509,7 @@ uint32_t find_succeeding_in_sorted_packed_page(
 		return NO_TUPLE_FOUND;
 
 	tuple_accessed_page tap = get_tuple_accessed_page((persistent_page*)ppage, page_size, tpl_def, NULL, NULL, NULL);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, key_def, key_elements_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	const index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	cy_uint result = find_succeeding_in_sorted_iai(&iai, 0, tuple_count - 1, key, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
@@ -692,7 +695,7 @@ void reverse_sort_order_on_sorted_packed_page(
 // on page quick sort algorithm
 void sort_and_convert_to_sorted_packed_page(
 									persistent_page* ppage, uint32_t page_size, 
-									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count,
+									const tuple_def* tpl_def, const positional_accessor* tuple_keys_to_compare, const compare_direction* tuple_keys_compare_direction, uint32_t keys_count, tuple_keys_comparator key_comparator,
 									const page_modification_methods* pmm_p,
 									const void* transaction_id,
 									int* abort_error
@@ -705,7 +708,7 @@ void sort_and_convert_to_sorted_packed_page(
 		return ;
 
 	tuple_accessed_page tap = get_tuple_accessed_page(ppage, page_size, tpl_def, pmm_p, transaction_id, abort_error);
-	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count);
+	const tuple_on_page_compare_context topcc = get_tuple_on_page_compare_context(tpl_def, tuple_keys_to_compare, tpl_def, tuple_keys_to_compare, tuple_keys_compare_direction, keys_count, key_comparator);
 	index_accessed_interface iai = get_index_accessed_interface_for_sorted_packed_page(&tap);
 
 	quick_sort_iai(&iai, 0, tuple_count - 1, &contexted_comparator(&topcc, compare_tuples_using_comparator_context));
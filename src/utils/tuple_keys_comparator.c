@@ -0,0 +1,128 @@
+#include<tuple_keys_comparator.h>
+
+#include<cutlery_stds.h>
+#include<cutlery_math.h>
+
+// position of the ith key element, element_ids = NULL implies the first elements of the tuple
+#define get_key_element_id(element_ids, i) (((element_ids) == NULL) ? STATIC_POSITION(i) : (element_ids)[i])
+
+// direction of the ith key element, cmp_dir = NULL implies ASC
+#define get_key_compare_direction(cmp_dir, i) (((cmp_dir) == NULL) ? ASC : (cmp_dir)[i])
+
+// NULL is the least value of any type, just as in compare_tuples()
+#define compare_NULLs(uval1, uval2) ((!!is_user_value_NULL(&(uval2))) - (!!is_user_value_NULL(&(uval1))))
+
+#define compare_numerals(uval1, uval2, value_field) (((uval1).value_field > (uval2).value_field) - ((uval1).value_field < (uval2).value_field))
+
+// reads the key element into uval, an element that could not be read is read as a NULL
+static inline void read_key_element(user_value* uval, const tuple_def* def, positional_accessor element_id, const void* tup)
+{
+	if(!get_value_from_element_from_tuple(uval, def, element_id, tup))
+		(*uval) = (*NULL_USER_VALUE);
+}
+
+// defines a function, that returns the raw compare result (without compare direction) of the numeral elements of the 2 tuples, read into the value_field of their user_values
+#define define_numeral_elements_comparator(value_field) \
+static inline int compare_ ## value_field ## _elements(const void* tup1, const tuple_def* def1, positional_accessor element_id1, const void* tup2, const tuple_def* def2, positional_accessor element_id2) \
+{ \
+	user_value uval1; \
+	read_key_element(&uval1, def1, element_id1, tup1); \
+	user_value uval2; \
+	read_key_element(&uval2, def2, element_id2, tup2); \
+	if(is_user_value_NULL(&uval1) || is_user_value_NULL(&uval2)) \
+		return compare_NULLs(uval1, uval2); \
+	return compare_numerals(uval1, uval2, value_field); \
+}
+
+define_numeral_elements_comparator(uint_value)
+define_numeral_elements_comparator(int_value)
+
+// defines a kernel for a single numeral key element, that is read into its value_field of the user_value
+#define define_single_numeral_key_comparator(name, value_field) \
+static int name(const void* tup1, const tuple_def* def1, const positional_accessor* element_ids1, const void* tup2, const tuple_def* def2, const positional_accessor* element_ids2, const compare_direction* cmp_dir, uint32_t element_count) \
+{ \
+	if(element_count == 0) \
+		return 0; \
+	return compare_ ## value_field ## _elements(tup1, def1, get_key_element_id(element_ids1, 0), tup2, def2, get_key_element_id(element_ids2, 0)) * get_key_compare_direction(cmp_dir, 0); \
+}
+
+// defines a kernel for two numeral key elements, that are read into value_field0 and value_field1 of their user_values
+#define define_two_numeral_keys_comparator(name, value_field0, value_field1) \
+static int name(const void* tup1, const tuple_def* def1, const positional_accessor* element_ids1, const void* tup2, const tuple_def* def2, const positional_accessor* element_ids2, const compare_direction* cmp_dir, uint32_t element_count) \
+{ \
+	if(element_count == 0) \
+		return 0; \
+	int cmp = compare_ ## value_field0 ## _elements(tup1, def1, get_key_element_id(element_ids1, 0), tup2, def2, get_key_element_id(element_ids2, 0)) * get_key_compare_direction(cmp_dir, 0); \
+	if(cmp != 0 || element_count == 1) \
+		return cmp; \
+	return compare_ ## value_field1 ## _elements(tup1, def1, get_key_element_id(element_ids1, 1), tup2, def2, get_key_element_id(element_ids2, 1)) * get_key_compare_direction(cmp_dir, 1); \
+}
+
+define_single_numeral_key_comparator(compare_tuples_on_uint_key, uint_value)
+define_single_numeral_key_comparator(compare_tuples_on_int_key, int_value)
+
+define_two_numeral_keys_comparator(compare_tuples_on_uint_uint_keys, uint_value, uint_value)
+define_two_numeral_keys_comparator(compare_tuples_on_uint_int_keys, uint_value, int_value)
+define_two_numeral_keys_comparator(compare_tuples_on_int_uint_keys, int_value, uint_value)
+define_two_numeral_keys_comparator(compare_tuples_on_int_int_keys, int_value, int_value)
+
+static int compare_tuples_on_fixed_length_string_key(const void* tup1, const tuple_def* def1, const positional_accessor* element_ids1, const void* tup2, const tuple_def* def2, const positional_accessor* element_ids2, const compare_direction* cmp_dir, uint32_t element_count)
+{
+	if(element_count == 0)
+		return 0;
+
+	user_value uval1;
+	read_key_element(&uval1, def1, get_key_element_id(element_ids1, 0), tup1);
+	user_value uval2;
+	read_key_element(&uval2, def2, get_key_element_id(element_ids2, 0), tup2);
+
+	int cmp;
+	if(is_user_value_NULL(&uval1) || is_user_value_NULL(&uval2))
+		cmp = compare_NULLs(uval1, uval2);
+	else
+	{
+		// lexicographic order, a string is lesser than the longer strings it prefixes
+		cmp = memory_compare(uval1.string_value, uval2.string_value, min(uval1.string_size, uval2.string_size));
+		cmp = (cmp > 0) - (cmp < 0);
+		if(cmp == 0)
+			cmp = (uval1.string_size > uval2.string_size) - (uval1.string_size < uval2.string_size);
+	}
+
+	return cmp * get_key_compare_direction(cmp_dir, 0);
+}
+
+// numeral types that have a kernel, UINT read as uint_value and INT read as int_value
+static int is_kernel_numeral_type_info(const data_type_info* dti)
+{
+	return dti->type == UINT || dti->type == INT;
+}
+
+tuple_keys_comparator get_tuple_keys_comparator(const tuple_def* tpl_def, const positional_accessor* key_element_ids, uint32_t key_element_count)
+{
+	if(key_element_count == 1)
+	{
+		const data_type_info* dti0 = get_type_info_for_element_from_tuple_def(tpl_def, get_key_element_id(key_element_ids, 0));
+
+		if(dti0->type == UINT)
+			return compare_tuples_on_uint_key;
+		if(dti0->type == INT)
+			return compare_tuples_on_int_key;
+		if(dti0->type == STRING && !is_variable_sized_type_info(dti0))
+			return compare_tuples_on_fixed_length_string_key;
+	}
+	else if(key_element_count == 2)
+	{
+		const data_type_info* dti0 = get_type_info_for_element_from_tuple_def(tpl_def, get_key_element_id(key_element_ids, 0));
+		const data_type_info* dti1 = get_type_info_for_element_from_tuple_def(tpl_def, get_key_element_id(key_element_ids, 1));
+
+		if(is_kernel_numeral_type_info(dti0) && is_kernel_numeral_type_info(dti1))
+		{
+			if(dti0->type == UINT)
+				return (dti1->type == UINT) ? compare_tuples_on_uint_uint_keys : compare_tuples_on_uint_int_keys;
+			else
+				return (dti1->type == UINT) ? compare_tuples_on_int_uint_keys : compare_tuples_on_int_int_keys;
+		}
+	}
+
+	return compare_tuples;
+}
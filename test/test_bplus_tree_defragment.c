@@ -0,0 +1,339 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for defragment_bplus_tree(), on a bplus_tree left sparse by deleting 3 of every 4 records
+// it is defragmented in small budgeted steps, resuming from the returned key each time
+// the records must then be unchanged, the leaf level no bigger and no emptier, and the merged away pages returned to the data store
+
+#define RECORDS_COUNT 2000
+
+// the leaf_pages_budget for each call to defragment_bplus_tree
+#define LEAF_PAGES_BUDGET 8
+
+#define TARGET_FILL_PERCENT 100
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// scans the whole bplus_tree forward or backward, checking that it holds exactly the keys in [0, records_count) for which is_key_present() returns 1
+// in order and each with a value of 10 times its key
+void check_scan(uint64_t root_page_id, int is_forward, uint64_t records_count, int (*is_key_present)(uint64_t key), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, (is_forward ? GREATER_THAN : LESSER_THAN), 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the next key that we expect to see, it is records_count once we are out of keys (on either end)
+	uint64_t expected_key = records_count;
+	for(uint64_t i = 0; i < records_count; i++)
+	{
+		uint64_t key = is_forward ? i : (records_count - 1 - i);
+		if(is_key_present(key))
+		{
+			expected_key = key;
+			break;
+		}
+	}
+
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+			uint64_t value = read_value(record);
+
+			if(key != expected_key || value != key * 10)
+			{
+				printf("FAILED : %s scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", (is_forward ? "forward" : "backward"), key, value, expected_key);
+				exit(-1);
+			}
+
+			// find the next present key in the scan direction
+			do
+			{
+				expected_key = is_forward ? (expected_key + 1) : ((expected_key == 0) ? records_count : (expected_key - 1));
+			}
+			while(expected_key < records_count && !is_key_present(expected_key));
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != records_count)
+	{
+		printf("FAILED : %s scan stopped before key %"PRIu64"\n", (is_forward ? "forward" : "backward"), expected_key);
+		exit(-1);
+	}
+}
+
+bplus_tree_level_statistics get_leaf_level_statistics(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_statistics bpts;
+	get_statistics_bplus_tree(root_page_id, 1, 0, &bpts, bpttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	bplus_tree_level_statistics leaf_stats = bpts.levels[0];
+
+	deinitialize_bplus_tree_statistics(&bpts);
+
+	return leaf_stats;
+}
+
+// every page below the root has exactly one entry in its parent (counting the least_keys_page_id), so an interior level must have as many entries and pages as there are pages below it
+// returns the number of pages at level = 1, and 0 if the root is a leaf page
+uint64_t check_interior_levels(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_statistics bpts;
+	get_statistics_bplus_tree(root_page_id, 1, 0, &bpts, bpttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint32_t level = 1; level < bpts.height; level++)
+	{
+		if(bpts.levels[level].tuple_count + bpts.levels[level].page_count != bpts.levels[level - 1].page_count)
+		{
+			printf("FAILED : level %"PRIu32" has %"PRIu64" pages with %"PRIu64" entries, for %"PRIu64" pages below it\n", level, bpts.levels[level].page_count, bpts.levels[level].tuple_count, bpts.levels[level - 1].page_count);
+			exit(-1);
+		}
+	}
+
+	uint64_t level_1_page_count = (bpts.height > 1) ? bpts.levels[1].page_count : 0;
+
+	deinitialize_bplus_tree_statistics(&bpts);
+
+	return level_1_page_count;
+}
+
+// only the keys divisible by 4 are left after the deletes
+int is_key_present(uint64_t key)
+{
+	return (key % 4) == 0;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// delete 3 of every 4 records, leaving the leaf pages sparse
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+			continue;
+
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, key);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+	bplus_tree_level_statistics leaf_stats_before = get_leaf_level_statistics(root_page_id, &bpttd, pam_p);
+	uint64_t level_1_pages_before = check_interior_levels(root_page_id, &bpttd, pam_p);
+	uint64_t used_pages_before_defragment = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	// defragment in budgeted steps, each resuming from where the last one stopped
+	uint64_t defragment_calls = 0;
+	{
+		char* resume_key = malloc(bpttd.max_index_record_size);
+		char* from_key = malloc(bpttd.max_index_record_size);
+		int has_more = defragment_bplus_tree(root_page_id, TARGET_FILL_PERCENT, LEAF_PAGES_BUDGET, NULL, resume_key, &bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		defragment_calls++;
+
+		while(has_more)
+		{
+			memcpy(from_key, resume_key, bpttd.max_index_record_size);
+			has_more = defragment_bplus_tree(root_page_id, TARGET_FILL_PERCENT, LEAF_PAGES_BUDGET, from_key, resume_key, &bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+			defragment_calls++;
+
+			if(defragment_calls > leaf_stats_before.page_count)
+			{
+				printf("FAILED : defragment_bplus_tree did not finish in %"PRIu64" calls, for %"PRIu64" leaf pages\n", defragment_calls, leaf_stats_before.page_count);
+				exit(-1);
+			}
+		}
+
+		free(resume_key);
+		free(from_key);
+	}
+
+	bplus_tree_level_statistics leaf_stats_after = get_leaf_level_statistics(root_page_id, &bpttd, pam_p);
+	uint64_t level_1_pages_after = check_interior_levels(root_page_id, &bpttd, pam_p);
+	uint64_t used_pages_after_defragment = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	printf("defragmented in %"PRIu64" calls : leaf pages %"PRIu64" -> %"PRIu64", fill %"PRIu64"%% -> %"PRIu64"%%, used pages %"PRIu64" -> %"PRIu64"\n", defragment_calls,
+		leaf_stats_before.page_count, leaf_stats_after.page_count,
+		(leaf_stats_before.space_occupied * 100) / leaf_stats_before.space_allotted, (leaf_stats_after.space_occupied * 100) / leaf_stats_after.space_allotted,
+		used_pages_before_defragment, used_pages_after_defragment);
+
+	if(leaf_stats_after.tuple_count != leaf_stats_before.tuple_count)
+	{
+		printf("FAILED : defragment changed the record count from %"PRIu64" to %"PRIu64"\n", leaf_stats_before.tuple_count, leaf_stats_after.tuple_count);
+		exit(-1);
+	}
+
+	// the leaf pages may only be merged, never split, so they can only get fewer and fuller
+	if(leaf_stats_after.page_count > leaf_stats_before.page_count || leaf_stats_after.space_occupied * leaf_stats_before.space_allotted < leaf_stats_before.space_occupied * leaf_stats_after.space_allotted)
+	{
+		printf("FAILED : defragment made the leaf level bigger or emptier\n");
+		exit(-1);
+	}
+
+	// the level = 1 pages only lose their entries to the leaf merges, so they may only be merged, never split
+	if(level_1_pages_after > level_1_pages_before)
+	{
+		printf("FAILED : defragment left %"PRIu64" level 1 pages (from %"PRIu64"), for %"PRIu64" leaf pages (from %"PRIu64")\n", level_1_pages_after, level_1_pages_before, leaf_stats_after.page_count, leaf_stats_before.page_count);
+		exit(-1);
+	}
+
+	// the merged away leaf pages must be freed
+	if(used_pages_before_defragment - used_pages_after_defragment < leaf_stats_before.page_count - leaf_stats_after.page_count)
+	{
+		printf("FAILED : defragment merged away %"PRIu64" leaf pages, but freed only %"PRIu64" pages\n", leaf_stats_before.page_count - leaf_stats_after.page_count, used_pages_before_defragment - used_pages_after_defragment);
+		exit(-1);
+	}
+
+	// the leaf pages must still be correctly linked in both the directions
+	check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+	printf("PASSED : defragment kept all the records, freed the merged away leaf pages, and kept the interior levels consistent\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by destroy, after the defragment\n");
+		exit(-1);
+	}
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
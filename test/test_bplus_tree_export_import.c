@@ -0,0 +1,403 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for export_bplus_tree() and import_bplus_tree(), round tripping through an in-memory buffer
+// the stream is large enough for several blocks, and the corrupt or truncated streams must be refused without leaving behind any pages
+
+#define RECORDS_COUNT 8000
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// scans the whole bplus_tree forward or backward, checking that it holds exactly the keys in [0, records_count) for which is_key_present() returns 1
+// in order and each with a value of 10 times its key
+void check_scan(uint64_t root_page_id, int is_forward, uint64_t records_count, int (*is_key_present)(uint64_t key), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, (is_forward ? GREATER_THAN : LESSER_THAN), 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the next key that we expect to see, it is records_count once we are out of keys (on either end)
+	uint64_t expected_key = records_count;
+	for(uint64_t i = 0; i < records_count; i++)
+	{
+		uint64_t key = is_forward ? i : (records_count - 1 - i);
+		if(is_key_present(key))
+		{
+			expected_key = key;
+			break;
+		}
+	}
+
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+			uint64_t value = read_value(record);
+
+			if(key != expected_key || value != key * 10)
+			{
+				printf("FAILED : %s scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", (is_forward ? "forward" : "backward"), key, value, expected_key);
+				exit(-1);
+			}
+
+			// find the next present key in the scan direction
+			do
+			{
+				expected_key = is_forward ? (expected_key + 1) : ((expected_key == 0) ? records_count : (expected_key - 1));
+			}
+			while(expected_key < records_count && !is_key_present(expected_key));
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != records_count)
+	{
+		printf("FAILED : %s scan stopped before key %"PRIu64"\n", (is_forward ? "forward" : "backward"), expected_key);
+		exit(-1);
+	}
+}
+
+// only the keys divisible by 4 are inserted
+int is_key_present(uint64_t key)
+{
+	return (key % 4) == 0;
+}
+
+// an in-memory stream, the writer appends to it, and the reader reads it from the start, upto the readable_size
+typedef struct buffer_stream buffer_stream;
+struct buffer_stream
+{
+	char* data;
+	uint32_t size;
+	uint32_t capacity;
+
+	// the writer fails, once the size would grow beyond writable_size
+	uint32_t writable_size;
+
+	uint32_t read_offset;
+	uint32_t readable_size;
+};
+
+int write_to_buffer_stream(void* context, const void* data, uint32_t size)
+{
+	buffer_stream* bs_p = context;
+	if(bs_p->size + size > bs_p->writable_size)
+		return 0;
+	if(bs_p->size + size > bs_p->capacity)
+	{
+		bs_p->capacity = 2 * (bs_p->size + size);
+		bs_p->data = realloc(bs_p->data, bs_p->capacity);
+		if(bs_p->data == NULL)
+			exit(-1);
+	}
+	memcpy(bs_p->data + bs_p->size, data, size);
+	bs_p->size += size;
+	return 1;
+}
+
+int read_from_buffer_stream(void* context, void* data, uint32_t size)
+{
+	buffer_stream* bs_p = context;
+	if(bs_p->read_offset + size > bs_p->readable_size)
+		return 0;
+	memcpy(data, bs_p->data + bs_p->read_offset, size);
+	bs_p->read_offset += size;
+	return 1;
+}
+
+// imports from the stream, reading only its first readable_size bytes
+uint64_t import_from_buffer_stream(buffer_stream* bs_p, uint32_t readable_size, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	bs_p->read_offset = 0;
+	bs_p->readable_size = readable_size;
+	uint64_t root_page_id = import_bplus_tree(&((bplus_tree_import_reader){.context = bs_p, .read = read_from_buffer_stream}), bpttd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return root_page_id;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// insert the present keys in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key is visited once)
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t key = (i * 7919) % RECORDS_COUNT;
+		if(!is_key_present(key))
+			continue;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	buffer_stream bs = {.writable_size = UINT32_MAX};
+	bplus_tree_export_writer bptew = {.context = &bs, .write = write_to_buffer_stream};
+
+	if(!export_bplus_tree(root_page_id, &bptew, &bpttd, pam_p, transaction_id, &abort_error))
+	{
+		printf("FAILED : export\n");
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	printf("exported %d records in a stream of %"PRIu32" bytes\n", RECORDS_COUNT / 4, bs.size);
+
+	// round trip
+	{
+		uint64_t used_pages_before_import = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+		uint64_t imported_root_page_id = import_from_buffer_stream(&bs, bs.size, &bpttd, pam_p, pmm_p);
+		if(imported_root_page_id == bpttd.pas_p->NULL_PAGE_ID)
+		{
+			printf("FAILED : import of the exported stream\n");
+			exit(-1);
+		}
+
+		check_scan(imported_root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+		check_scan(imported_root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+		destroy_bplus_tree(imported_root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before_import)
+		{
+			printf("FAILED : pages were left behind by destroying the imported bplus_tree\n");
+			exit(-1);
+		}
+
+		printf("PASSED : round trip\n");
+	}
+
+	// the corrupt and the truncated streams must be refused, freeing the pages built until then
+	{
+		uint64_t used_pages_before_import = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+		// the byte to corrupt, at the end of the stream the last blocks would already have been loaded
+		uint32_t corrupt_offsets[] = {0, 100, bs.size / 2, bs.size - 20};
+		for(int i = 0; i < sizeof(corrupt_offsets) / sizeof(corrupt_offsets[0]); i++)
+		{
+			bs.data[corrupt_offsets[i]] ^= 0x5a;
+			uint64_t imported_root_page_id = import_from_buffer_stream(&bs, bs.size, &bpttd, pam_p, pmm_p);
+			bs.data[corrupt_offsets[i]] ^= 0x5a;
+
+			if(imported_root_page_id != bpttd.pas_p->NULL_PAGE_ID)
+			{
+				printf("FAILED : imported a stream corrupted at byte %"PRIu32"\n", corrupt_offsets[i]);
+				exit(-1);
+			}
+		}
+
+		uint32_t truncated_sizes[] = {0, 10, bs.size / 2, bs.size - 1};
+		for(int i = 0; i < sizeof(truncated_sizes) / sizeof(truncated_sizes[0]); i++)
+		{
+			uint64_t imported_root_page_id = import_from_buffer_stream(&bs, truncated_sizes[i], &bpttd, pam_p, pmm_p);
+
+			if(imported_root_page_id != bpttd.pas_p->NULL_PAGE_ID)
+			{
+				printf("FAILED : imported a stream truncated to %"PRIu32" bytes\n", truncated_sizes[i]);
+				exit(-1);
+			}
+		}
+
+		if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before_import)
+		{
+			printf("FAILED : pages were left behind by the refused imports\n");
+			exit(-1);
+		}
+
+		printf("PASSED : corrupt and truncated streams refused\n");
+	}
+
+	// a failing writer fails the export, and it must not leave behind any locks, so that the bplus_tree can still be destroyed
+	{
+		buffer_stream failing_bs = {.writable_size = bs.size / 2};
+		bplus_tree_export_writer failing_bptew = {.context = &failing_bs, .write = write_to_buffer_stream};
+
+		if(export_bplus_tree(root_page_id, &failing_bptew, &bpttd, pam_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : export succeeded with a failing writer\n");
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		free(failing_bs.data);
+
+		printf("PASSED : export with a failing writer\n");
+	}
+
+	// an empty bplus_tree round trips to an empty bplus_tree
+	{
+		uint64_t used_pages_before_empty = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+		uint64_t empty_root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		buffer_stream empty_bs = {.writable_size = UINT32_MAX};
+		if(!export_bplus_tree(empty_root_page_id, &((bplus_tree_export_writer){.context = &empty_bs, .write = write_to_buffer_stream}), &bpttd, pam_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : export of an empty bplus_tree\n");
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		uint64_t imported_root_page_id = import_from_buffer_stream(&empty_bs, empty_bs.size, &bpttd, pam_p, pmm_p);
+		if(imported_root_page_id == bpttd.pas_p->NULL_PAGE_ID)
+		{
+			printf("FAILED : import of an empty bplus_tree\n");
+			exit(-1);
+		}
+
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(imported_root_page_id, NULL, bpttd.key_element_count, GREATER_THAN, 0, READ_LOCK, &bpttd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+		while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+		{
+			if(get_tuple_bplus_tree_iterator(bpi_p) != NULL)
+			{
+				printf("FAILED : the imported empty bplus_tree has records\n");
+				exit(-1);
+			}
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+		delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		destroy_bplus_tree(imported_root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		destroy_bplus_tree(empty_root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		free(empty_bs.data);
+
+		if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before_empty)
+		{
+			printf("FAILED : pages were left behind by the empty round trip\n");
+			exit(-1);
+		}
+
+		printf("PASSED : empty round trip\n");
+	}
+
+	free(bs.data);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by destroy\n");
+		exit(-1);
+	}
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,238 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for insert_batch_in_bplus_tree(), the keys [0, RECORDS_COUNT) are inserted in scrambled batches of BATCH_SIZE records
+// every batch also carries the duplicates of its own records and of the records of the previous batch, which must not be inserted
+
+#define RECORDS_COUNT 2000
+#define BATCH_SIZE 100
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// scans the whole bplus_tree forward or backward, checking that it holds exactly the keys in [0, records_count) for which is_key_present() returns 1
+// in order and each with a value of 10 times its key
+void check_scan(uint64_t root_page_id, int is_forward, uint64_t records_count, int (*is_key_present)(uint64_t key), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, (is_forward ? GREATER_THAN : LESSER_THAN), 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the next key that we expect to see, it is records_count once we are out of keys (on either end)
+	uint64_t expected_key = records_count;
+	for(uint64_t i = 0; i < records_count; i++)
+	{
+		uint64_t key = is_forward ? i : (records_count - 1 - i);
+		if(is_key_present(key))
+		{
+			expected_key = key;
+			break;
+		}
+	}
+
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+			uint64_t value = read_value(record);
+
+			if(key != expected_key || value != key * 10)
+			{
+				printf("FAILED : %s scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", (is_forward ? "forward" : "backward"), key, value, expected_key);
+				exit(-1);
+			}
+
+			// find the next present key in the scan direction
+			do
+			{
+				expected_key = is_forward ? (expected_key + 1) : ((expected_key == 0) ? records_count : (expected_key - 1));
+			}
+			while(expected_key < records_count && !is_key_present(expected_key));
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != records_count)
+	{
+		printf("FAILED : %s scan stopped before key %"PRIu64"\n", (is_forward ? "forward" : "backward"), expected_key);
+		exit(-1);
+	}
+}
+
+// every key in [0, RECORDS_COUNT) must be present after the inserts
+int is_key_present(uint64_t key)
+{
+	return 1;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// the memory for the records of a batch, with room for the duplicates
+	char (*records_memory)[PAGE_SIZE] = malloc(sizeof(char[PAGE_SIZE]) * 2 * BATCH_SIZE);
+	const void** records = malloc(sizeof(void*) * 2 * BATCH_SIZE);
+
+	uint64_t total_inserted = 0;
+	for(uint64_t batch_start = 0; batch_start < RECORDS_COUNT; batch_start += BATCH_SIZE)
+	{
+		uint32_t records_count = 0;
+
+		// the new keys of this batch, in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key gets inserted once)
+		for(uint64_t i = batch_start; i < batch_start + BATCH_SIZE && i < RECORDS_COUNT; i++)
+		{
+			uint64_t key = (i * 7919) % RECORDS_COUNT;
+			build_record(records_memory[records_count], key, key * 10);
+			records[records_count] = records_memory[records_count];
+			records_count++;
+		}
+
+		// a few duplicates of this batch, and of the last batch (already in the bplus_tree), with different values
+		uint32_t new_records_count = records_count;
+		for(uint64_t i = batch_start; i < batch_start + BATCH_SIZE && i < RECORDS_COUNT; i += 10)
+		{
+			uint64_t key = (i * 7919) % RECORDS_COUNT;
+			build_record(records_memory[records_count], key, key * 10 + 1);
+			records[records_count] = records_memory[records_count];
+			records_count++;
+
+			if(batch_start == 0)
+				continue;
+
+			key = ((i - BATCH_SIZE) * 7919) % RECORDS_COUNT;
+			build_record(records_memory[records_count], key, key * 10 + 1);
+			records[records_count] = records_memory[records_count];
+			records_count++;
+		}
+
+		uint32_t inserted = insert_batch_in_bplus_tree(root_page_id, records, records_count, &bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		// the duplicates from the batch itself follow their originals, and the sort is stable, so only the originals get inserted
+		if(inserted != new_records_count)
+		{
+			printf("FAILED : inserted %"PRIu32" of %"PRIu32" records, expected %"PRIu32"\n", inserted, records_count, new_records_count);
+			exit(-1);
+		}
+		total_inserted += inserted;
+	}
+
+	free(records);
+	free(records_memory);
+
+	if(total_inserted != RECORDS_COUNT)
+	{
+		printf("FAILED : inserted %"PRIu64" records in all, expected %d\n", total_inserted, RECORDS_COUNT);
+		exit(-1);
+	}
+
+	check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+	printf("PASSED : batch inserted %d records, rejecting all the duplicates\n", RECORDS_COUNT);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
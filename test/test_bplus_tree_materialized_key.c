@@ -0,0 +1,331 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for the keys materialized (with materialize_key_from_tuple()) on every walk down of the bplus_tree
+// the bplus_tree is keyed on 2 elements {value DESC, key ASC}, that are not in the order of the record, so the key_dtis must stay paired with the right key user_values
+// the keys are materialized both from the records (on inserts) and from the key tuples (on finds and deletes), and also for only the first key element (on prefix finds)
+// run it with "vald", to also check that the single allocation of the materialized key is neither overrun nor leaked
+
+#define RECORDS_COUNT 2000
+
+// value of the record with the key, the records are grouped by it
+#define GROUPS_COUNT 7
+#define GROUP_OF(key) ((key) % GROUPS_COUNT)
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// only the even keys are left, after the deletes
+int is_key_present(uint64_t key)
+{
+	return (key % 2) == 0;
+}
+
+// builds a key tuple of the 2 key elements {group, key}
+void build_composite_key(const tuple_def* key_def, void* key_tuple, uint64_t group, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = group}), UINT32_MAX);
+	set_element_in_tuple(key_def, STATIC_POSITION(1), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+// the number of keys in [0, RECORDS_COUNT) of the group, that are present
+uint64_t get_present_count_in_group(uint64_t group)
+{
+	uint64_t count = 0;
+	for(uint64_t key = group; key < RECORDS_COUNT; key += GROUPS_COUNT)
+		count += is_key_present(key);
+	return count;
+}
+
+// the next present key in the bplus_tree order {value DESC, key ASC}, after the key in the group, it returns RECORDS_COUNT if there are none
+void get_next_present_key(uint64_t* group, uint64_t* key)
+{
+	while(1)
+	{
+		if((*key) + GROUPS_COUNT < RECORDS_COUNT)
+			(*key) += GROUPS_COUNT;
+		else if((*group) > 0)
+			(*key) = --(*group);
+		else
+		{
+			(*key) = RECORDS_COUNT;
+			return;
+		}
+
+		if(is_key_present(*key))
+			return;
+	}
+}
+
+// the whole bplus_tree must be in the order of {value DESC, key ASC}
+void check_order(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// start right before the first key of the last group
+	uint64_t expected_group = GROUPS_COUNT;
+	uint64_t expected_key = RECORDS_COUNT;
+	get_next_present_key(&expected_group, &expected_key);
+
+	while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			if(read_key(record) != expected_key || read_value(record) != expected_group)
+			{
+				printf("FAILED : scan found {%"PRIu64", %"PRIu64"}, when expecting {%"PRIu64", %"PRIu64"}\n", read_key(record), read_value(record), expected_key, expected_group);
+				exit(-1);
+			}
+			get_next_present_key(&expected_group, &expected_key);
+		}
+
+		next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != RECORDS_COUNT)
+	{
+		printf("FAILED : scan stopped before key %"PRIu64"\n", expected_key);
+		exit(-1);
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(1), STATIC_POSITION(0)}, (compare_direction []){DESC, ASC}, 2))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// the keys are materialized from the records
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, GROUP_OF(key));
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// and a record with the same pair of key elements is a duplicate
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 97)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, GROUP_OF(key));
+
+		if(insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : duplicate insert of key %"PRIu64" succeeded\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// the keys are materialized from the key tuples
+	for(uint64_t key = 1; key < RECORDS_COUNT; key += 2)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_composite_key(bpttd.key_def, key_tuple, GROUP_OF(key), key);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	check_order(root_page_id, &bpttd, pam_p);
+
+	printf("PASSED : inserts, duplicate inserts and deletes on a {value DESC, key ASC} key\n");
+
+	// point finds, on all the keys (present or not)
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_composite_key(bpttd.key_def, key_tuple, GROUP_OF(key), key);
+
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, key_tuple, KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS, 0, READ_LOCK, &bpttd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		// skip the positions in between the records
+		while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p) && get_tuple_bplus_tree_iterator(bpi_p) == NULL)
+		{
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+
+		uint64_t expected_group = GROUP_OF(key);
+		uint64_t expected_key = key;
+		if(!is_key_present(key))
+			get_next_present_key(&expected_group, &expected_key);
+
+		const void* record = is_beyond_max_tuple_bplus_tree_iterator(bpi_p) ? NULL : get_tuple_bplus_tree_iterator(bpi_p);
+		uint64_t found_key = (record == NULL) ? RECORDS_COUNT : read_key(record);
+		if(found_key != expected_key)
+		{
+			printf("FAILED : find(>= {%"PRIu64", %"PRIu64"}) found key %"PRIu64", when expecting %"PRIu64"\n", GROUP_OF(key), key, found_key, expected_key);
+			exit(-1);
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	printf("PASSED : point finds on a {value DESC, key ASC} key\n");
+
+	// prefix finds, only the value is materialized, and every group is found from its smallest present key
+	for(uint64_t group = 0; group < GROUPS_COUNT; group++)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_composite_key(bpttd.key_def, key_tuple, group, 0);
+
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, key_tuple, 1, GREATER_THAN_EQUALS, 0, READ_LOCK, &bpttd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t expected_key = group;
+		while(!is_key_present(expected_key))
+			expected_key += GROUPS_COUNT;
+
+		uint64_t found_count = 0;
+		while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+		{
+			const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+			if(record != NULL)
+			{
+				if(read_value(record) != group)
+					break;
+
+				if(read_key(record) != expected_key)
+				{
+					printf("FAILED : prefix find of group %"PRIu64" found key %"PRIu64", when expecting %"PRIu64"\n", group, read_key(record), expected_key);
+					exit(-1);
+				}
+				found_count++;
+
+				do
+				{
+					expected_key += GROUPS_COUNT;
+				}
+				while(!is_key_present(expected_key));
+			}
+
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(found_count != get_present_count_in_group(group))
+		{
+			printf("FAILED : prefix find of group %"PRIu64" found %"PRIu64" records, when expecting %"PRIu64"\n", group, found_count, get_present_count_in_group(group));
+			exit(-1);
+		}
+	}
+
+	printf("PASSED : prefix finds on the first element of a {value DESC, key ASC} key\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,250 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for get_partition_keys_for_bplus_tree()
+// the partitions it returns are scanned one after the other, just as the separate iterators of a partitioned scan would, they must cover every record exactly once
+
+#define RECORDS_COUNT 3000
+
+#define PARTITIONS_COUNT 8
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+uint64_t read_partition_key(const void* partition_key, const bplus_tree_tuple_defs* bpttd_p)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, bpttd_p->key_def, STATIC_POSITION(0), partition_key);
+	return key.uint_value;
+}
+
+// scans the partition [partition_key_lo, partition_key_hi), a NULL partition_key_lo (or partition_key_hi) is the MIN (or MAX) of the key space
+// it checks that the partition has the consecutive keys starting at expected_first_key, and returns the number of records in it
+uint64_t scan_partition(uint64_t root_page_id, const void* partition_key_lo, const void* partition_key_hi, uint64_t expected_first_key, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = (partition_key_lo == NULL) ?
+		find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error) :
+		find_in_bplus_tree(root_page_id, partition_key_lo, KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t records_in_partition = 0;
+	while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+
+			// the partition ends at the first record whose key >= partition_key_hi
+			if(partition_key_hi != NULL && key >= read_partition_key(partition_key_hi, bpttd_p))
+				break;
+
+			if(key != expected_first_key + records_in_partition || read_value(record) != key * 10)
+			{
+				printf("FAILED : partition scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", key, read_value(record), expected_first_key + records_in_partition);
+				exit(-1);
+			}
+			records_in_partition++;
+		}
+
+		next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	return records_in_partition;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	void* partition_keys[PARTITIONS_COUNT - 1];
+
+	// a bplus_tree with only a leaf root page can not be partitioned
+	{
+		uint32_t partition_keys_count = get_partition_keys_for_bplus_tree(root_page_id, PARTITIONS_COUNT, partition_keys, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(partition_keys_count != 0)
+		{
+			printf("FAILED : found %"PRIu32" partition_keys in an empty bplus_tree\n", partition_keys_count);
+			exit(-1);
+		}
+
+		printf("PASSED : no partition_keys for an empty bplus_tree\n");
+	}
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// the partitions together must cover all the records, in order and without overlaps
+	{
+		uint32_t partition_keys_count = get_partition_keys_for_bplus_tree(root_page_id, PARTITIONS_COUNT, partition_keys, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(partition_keys_count == 0 || partition_keys_count > PARTITIONS_COUNT - 1)
+		{
+			printf("FAILED : found %"PRIu32" partition_keys, when asking for %d partitions\n", partition_keys_count, PARTITIONS_COUNT);
+			exit(-1);
+		}
+
+		for(uint32_t i = 1; i < partition_keys_count; i++)
+		{
+			if(read_partition_key(partition_keys[i - 1], &bpttd) >= read_partition_key(partition_keys[i], &bpttd))
+			{
+				printf("FAILED : partition_keys are not in ascending order at %"PRIu32"\n", i);
+				exit(-1);
+			}
+		}
+
+		uint64_t records_scanned = 0;
+		for(uint32_t i = 0; i <= partition_keys_count; i++)
+		{
+			const void* partition_key_lo = (i == 0) ? NULL : partition_keys[i - 1];
+			const void* partition_key_hi = (i == partition_keys_count) ? NULL : partition_keys[i];
+
+			uint64_t records_in_partition = scan_partition(root_page_id, partition_key_lo, partition_key_hi, records_scanned, &bpttd, pam_p);
+			if(records_in_partition == 0)
+			{
+				printf("FAILED : partition %"PRIu32" is empty\n", i);
+				exit(-1);
+			}
+
+			records_scanned += records_in_partition;
+		}
+
+		if(records_scanned != RECORDS_COUNT)
+		{
+			printf("FAILED : the partitions hold %"PRIu64" records, when expecting %d\n", records_scanned, RECORDS_COUNT);
+			exit(-1);
+		}
+
+		for(uint32_t i = 0; i < partition_keys_count; i++)
+			free(partition_keys[i]);
+
+		printf("PASSED : %"PRIu32" partitions cover all the %d records\n", partition_keys_count + 1, RECORDS_COUNT);
+	}
+
+	// asking for lesser than 2 partitions, gives no partition_keys
+	{
+		uint32_t partition_keys_count = get_partition_keys_for_bplus_tree(root_page_id, 1, partition_keys, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(partition_keys_count != 0)
+		{
+			printf("FAILED : found %"PRIu32" partition_keys, when asking for a single partition\n", partition_keys_count);
+			exit(-1);
+		}
+
+		printf("PASSED : no partition_keys for a single partition\n");
+	}
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
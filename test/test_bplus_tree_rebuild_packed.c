@@ -0,0 +1,306 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for rebuild_packed_bplus_tree(), on a bplus_tree left sparse by deleting 3 of every 4 records
+// the packed bplus_tree must have the same records as before, in fewer and fuller leaf pages, at the same root_page_id
+// and the pages of the old bplus_tree must all be freed
+
+#define RECORDS_COUNT 2000
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// scans the whole bplus_tree forward or backward, checking that it holds exactly the keys in [0, records_count) for which is_key_present() returns 1
+// in order and each with a value of 10 times its key
+void check_scan(uint64_t root_page_id, int is_forward, uint64_t records_count, int (*is_key_present)(uint64_t key), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, (is_forward ? GREATER_THAN : LESSER_THAN), 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the next key that we expect to see, it is records_count once we are out of keys (on either end)
+	uint64_t expected_key = records_count;
+	for(uint64_t i = 0; i < records_count; i++)
+	{
+		uint64_t key = is_forward ? i : (records_count - 1 - i);
+		if(is_key_present(key))
+		{
+			expected_key = key;
+			break;
+		}
+	}
+
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+			uint64_t value = read_value(record);
+
+			if(key != expected_key || value != key * 10)
+			{
+				printf("FAILED : %s scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", (is_forward ? "forward" : "backward"), key, value, expected_key);
+				exit(-1);
+			}
+
+			// find the next present key in the scan direction
+			do
+			{
+				expected_key = is_forward ? (expected_key + 1) : ((expected_key == 0) ? records_count : (expected_key - 1));
+			}
+			while(expected_key < records_count && !is_key_present(expected_key));
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != records_count)
+	{
+		printf("FAILED : %s scan stopped before key %"PRIu64"\n", (is_forward ? "forward" : "backward"), expected_key);
+		exit(-1);
+	}
+}
+
+bplus_tree_level_statistics get_leaf_level_statistics(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_statistics bpts;
+	get_statistics_bplus_tree(root_page_id, 1, 0, &bpts, bpttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	bplus_tree_level_statistics leaf_stats = bpts.levels[0];
+
+	deinitialize_bplus_tree_statistics(&bpts);
+
+	return leaf_stats;
+}
+
+// only the keys divisible by 4 are left after the deletes
+int is_key_present(uint64_t key)
+{
+	return (key % 4) == 0;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// insert the keys in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key gets inserted once)
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t key = (i * 7919) % RECORDS_COUNT;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// delete 3 of every 4 records, leaving the leaf pages sparse
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+			continue;
+
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, key);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	bplus_tree_level_statistics leaf_stats = get_leaf_level_statistics(root_page_id, &bpttd, pam_p);
+
+	uint64_t used_pages_before_rebuild = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	if(!rebuild_packed_bplus_tree(root_page_id, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+	{
+		printf("FAILED : rebuild_packed_bplus_tree\n");
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	bplus_tree_level_statistics packed_leaf_stats = get_leaf_level_statistics(root_page_id, &bpttd, pam_p);
+
+	printf("rebuilt : leaf pages %"PRIu64" -> %"PRIu64", fill %"PRIu64"%% -> %"PRIu64"%%, used pages %"PRIu64" -> %"PRIu64"\n",
+		leaf_stats.page_count, packed_leaf_stats.page_count,
+		(leaf_stats.space_occupied * 100) / leaf_stats.space_allotted, (packed_leaf_stats.space_occupied * 100) / packed_leaf_stats.space_allotted,
+		used_pages_before_rebuild, get_used_pages_count_in_unWALed_in_memory_data_store(pam_p));
+
+	// the packed bplus_tree, still at root_page_id, has the same records in both the directions
+	check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+	if(packed_leaf_stats.tuple_count != leaf_stats.tuple_count)
+	{
+		printf("FAILED : the packed bplus_tree has %"PRIu64" records, it had %"PRIu64"\n", packed_leaf_stats.tuple_count, leaf_stats.tuple_count);
+		exit(-1);
+	}
+
+	// the leaf pages are now fully packed, so they can not be more than the ones of the sparse bplus_tree, nor emptier
+	if(packed_leaf_stats.page_count > leaf_stats.page_count || packed_leaf_stats.space_occupied * leaf_stats.space_allotted < leaf_stats.space_occupied * packed_leaf_stats.space_allotted)
+	{
+		printf("FAILED : the packed bplus_tree is bigger or emptier than before\n");
+		exit(-1);
+	}
+
+	// the pages of the old bplus_tree are freed, so there can not be more pages in use than before
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) > used_pages_before_rebuild)
+	{
+		printf("FAILED : the pages of the old bplus_tree were not freed\n");
+		exit(-1);
+	}
+
+	printf("PASSED : the packed bplus_tree has all the records, packed in fewer or as many leaf pages, at the same root_page_id\n");
+
+	// the packed bplus_tree is still a regular bplus_tree, that can be written to
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+			continue;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64" in the packed bplus_tree\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	if(get_leaf_level_statistics(root_page_id, &bpttd, pam_p).tuple_count != RECORDS_COUNT)
+	{
+		printf("FAILED : inserts in the packed bplus_tree were lost\n");
+		exit(-1);
+	}
+
+	printf("PASSED : the packed bplus_tree accepts inserts\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by rebuilding and destroying the bplus_tree\n");
+		exit(-1);
+	}
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
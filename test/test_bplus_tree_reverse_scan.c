@@ -0,0 +1,193 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for the backward scan of an unstacked bplus_tree_iterator, when the prev leaf page can not be try-latched
+// the page_access_methods are wrapped so that every other try_acquire_page_with_*_lock call fails, as if the prev leaf page was locked by some other thread
+// so the iterator has to fall back to walking down from the root to the predecessor of its fence key, and it must still visit every record exactly once
+
+#define RECORDS_COUNT 1000
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// the page_access_methods being wrapped, and the count of the try_acquire_page_with_*_lock calls, made through the wrapper
+const page_access_methods* wrapped_pam_p = NULL;
+uint64_t try_acquire_calls = 0;
+uint64_t try_acquire_failures = 0;
+
+void* failing_try_acquire_page_with_reader_lock(void* context, const void* transaction_id, uint64_t page_id, int* abort_error)
+{
+	if((try_acquire_calls++) % 2 == 0)
+	{
+		try_acquire_failures++;
+		return NULL;
+	}
+	return wrapped_pam_p->try_acquire_page_with_reader_lock(context, transaction_id, page_id, abort_error);
+}
+
+void* failing_try_acquire_page_with_writer_lock(void* context, const void* transaction_id, uint64_t page_id, int* abort_error)
+{
+	if((try_acquire_calls++) % 2 == 0)
+	{
+		try_acquire_failures++;
+		return NULL;
+	}
+	return wrapped_pam_p->try_acquire_page_with_writer_lock(context, transaction_id, page_id, abort_error);
+}
+
+// scans the bplus_tree backward from its last record, and checks that it visits all the keys in descending order
+void check_reverse_scan(uint64_t root_page_id, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, LESSER_THAN, 0, READ_LOCK, bpttd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t expected_key = RECORDS_COUNT;
+	while(!is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			user_value key;
+			get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+
+			if(expected_key == 0 || key.uint_value != expected_key - 1)
+			{
+				printf("FAILED : %s reverse scan found key %"PRIu64", when expecting %"PRIu64"\n", (pmm_p == NULL) ? "read-only" : "writable", key.uint_value, expected_key - 1);
+				exit(-1);
+			}
+			expected_key--;
+		}
+
+		prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != 0)
+	{
+		printf("FAILED : %s reverse scan stopped before key %"PRIu64"\n", (pmm_p == NULL) ? "read-only" : "writable", expected_key - 1);
+		exit(-1);
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	// same data store, but with every other try-latch failing
+	page_access_methods failing_pam = (*pam_p);
+	wrapped_pam_p = pam_p;
+	failing_pam.try_acquire_page_with_reader_lock = failing_try_acquire_page_with_reader_lock;
+	failing_pam.try_acquire_page_with_writer_lock = failing_try_acquire_page_with_writer_lock;
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// read-only scan, try-latching the prev leaf pages with READ_LOCKs
+	check_reverse_scan(root_page_id, &bpttd, &failing_pam, NULL);
+
+	// writable scan, try-latching the prev leaf pages with WRITE_LOCKs
+	check_reverse_scan(root_page_id, &bpttd, &failing_pam, pmm_p);
+
+	if(try_acquire_failures == 0 || try_acquire_failures == try_acquire_calls)
+	{
+		printf("FAILED : the scans made %"PRIu64" try-latch calls, with %"PRIu64" failures, both the paths were not tested\n", try_acquire_calls, try_acquire_failures);
+		exit(-1);
+	}
+
+	printf("PASSED : reverse scans visited all %d records, with %"PRIu64" of %"PRIu64" try-latches failing\n", RECORDS_COUNT, try_acquire_failures, try_acquire_calls);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
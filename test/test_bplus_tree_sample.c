@@ -0,0 +1,250 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for sample_bplus_tree(), on a bplus_tree whose first half is left sparse by deleting 3 of every 4 records in it
+// so the leaf pages (and their parents) have very different fanouts, and yet every record must be sampled equally often
+// the first half then holds 1/5th of the records, and must get 1/5th of the samples
+
+#define RECORDS_COUNT 2000
+
+#define SAMPLES_COUNT 40000
+
+// the samples of the first half, may be off from their expected count by atmost this percent
+#define TOLERANCE_PERCENT 15
+
+// a bplus_tree of atleast half full pages accepts atleast 1 in 2^height walks
+#define MAX_CONSECUTIVE_REJECTED_WALKS 1024
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// only the keys divisible by 4 are left in the first half, after the deletes
+int is_key_present(uint64_t key)
+{
+	return (key >= RECORDS_COUNT / 2) || ((key % 4) == 0);
+}
+
+typedef struct sample_counts sample_counts;
+struct sample_counts
+{
+	uint64_t total;
+	uint64_t in_first_half;
+
+	// sum of the sampled keys, to compare 2 runs with the same seed
+	uint64_t key_sum;
+};
+
+void record_sampled(void* context, const void* record)
+{
+	sample_counts* sc_p = context;
+
+	uint64_t key = read_key(record);
+	uint64_t value = read_value(record);
+	if(key >= RECORDS_COUNT || !is_key_present(key) || value != key * 10)
+	{
+		printf("FAILED : sampled a record {%"PRIu64", %"PRIu64"}, that is not in the bplus_tree\n", key, value);
+		exit(-1);
+	}
+
+	sc_p->total++;
+	if(key < RECORDS_COUNT / 2)
+		sc_p->in_first_half++;
+	sc_p->key_sum += key;
+}
+
+sample_counts sample(uint64_t root_page_id, uint64_t seed, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	sample_counts sc = {};
+	uint64_t samples_found = sample_bplus_tree(root_page_id, SAMPLES_COUNT, seed, MAX_CONSECUTIVE_REJECTED_WALKS, &sc, record_sampled, bpttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(samples_found != SAMPLES_COUNT || sc.total != SAMPLES_COUNT)
+	{
+		printf("FAILED : found %"PRIu64" samples (%"PRIu64" passed to the callback), when asked for %d\n", samples_found, sc.total, SAMPLES_COUNT);
+		exit(-1);
+	}
+
+	return sc;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// an empty bplus_tree gives no samples, and must return right away, even with an unbounded max_consecutive_rejected_walks
+	{
+		sample_counts sc = {};
+		uint64_t samples_found = sample_bplus_tree(root_page_id, SAMPLES_COUNT, 0, UINT64_MAX, &sc, record_sampled, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(samples_found != 0 || sc.total != 0)
+		{
+			printf("FAILED : found %"PRIu64" samples in an empty bplus_tree\n", samples_found);
+			exit(-1);
+		}
+
+		printf("PASSED : no samples from an empty bplus_tree\n");
+	}
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	uint64_t present_records = 0;
+	uint64_t present_records_in_first_half = 0;
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+		{
+			present_records++;
+			if(key < RECORDS_COUNT / 2)
+				present_records_in_first_half++;
+			continue;
+		}
+
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, key);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// every record is equally likely to be sampled, irrespective of the fanouts on its path
+	sample_counts sc = sample(root_page_id, 42, &bpttd, pam_p);
+
+	uint64_t expected_in_first_half = (SAMPLES_COUNT * present_records_in_first_half) / present_records;
+	uint64_t allowed_error = (expected_in_first_half * TOLERANCE_PERCENT) / 100;
+	if(sc.in_first_half + allowed_error < expected_in_first_half || sc.in_first_half > expected_in_first_half + allowed_error)
+	{
+		printf("FAILED : the sparse first half got %"PRIu64" samples, when expecting %"PRIu64" (+/- %"PRIu64")\n", sc.in_first_half, expected_in_first_half, allowed_error);
+		exit(-1);
+	}
+
+	printf("PASSED : the sparse first half got %"PRIu64" of %d samples, expecting %"PRIu64"\n", sc.in_first_half, SAMPLES_COUNT, expected_in_first_half);
+
+	// the same seed gives the same samples
+	sample_counts sc_again = sample(root_page_id, 42, &bpttd, pam_p);
+	if(sc_again.in_first_half != sc.in_first_half || sc_again.key_sum != sc.key_sum)
+	{
+		printf("FAILED : the same seed gave different samples\n");
+		exit(-1);
+	}
+
+	printf("PASSED : the same seed gave the same samples\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,278 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for seek_bplus_tree_iterator(), on both the unstacked and the stacked iterators
+// the iterator is seeked forward by small and large distances, and backward, with every find_position
+// and it must always land where a freshly opened iterator (with find_in_bplus_tree()) would
+
+#define RECORDS_COUNT 2000
+
+// only the even keys are inserted, so that the seeks for the odd keys land in between the records
+#define KEY_OF(i) (((uint64_t)(i)) * 2)
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// no record is found for the find_position
+#define NO_KEY UINT64_MAX
+
+// the key of the record, that a find_in_bplus_tree(target, find_pos) must position at
+uint64_t get_expected_key(uint64_t target, find_position find_pos)
+{
+	uint64_t max_key = KEY_OF(RECORDS_COUNT - 1);
+	switch(find_pos)
+	{
+		case MIN :
+			return KEY_OF(0);
+		case MAX :
+			return max_key;
+		case GREATER_THAN_EQUALS :
+		{
+			uint64_t key = (target % 2) ? (target + 1) : target;
+			return (key <= max_key) ? key : NO_KEY;
+		}
+		case GREATER_THAN :
+		{
+			uint64_t key = (target % 2) ? (target + 1) : (target + 2);
+			return (key <= max_key) ? key : NO_KEY;
+		}
+		case LESSER_THAN_EQUALS :
+		{
+			uint64_t key = (target % 2) ? (target - 1) : target;
+			return (key <= max_key) ? key : max_key;
+		}
+		case LESSER_THAN :
+		{
+			if(target == 0)
+				return NO_KEY;
+			uint64_t key = (target % 2) ? (target - 1) : (target - 2);
+			return (key <= max_key) ? key : max_key;
+		}
+	}
+	return NO_KEY;
+}
+
+// the key of the record at the iterator, skipping the positions in between the records (in the direction of the find_pos)
+uint64_t get_key_at_iterator(bplus_tree_iterator* bpi_p, find_position find_pos)
+{
+	int is_forward = (find_pos == MIN || find_pos == GREATER_THAN_EQUALS || find_pos == GREATER_THAN);
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			if(read_value(record) != read_key(record) * 10)
+			{
+				printf("FAILED : found a corrupt record {%"PRIu64", %"PRIu64"}\n", read_key(record), read_value(record));
+				exit(-1);
+			}
+			return read_key(record);
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+	return NO_KEY;
+}
+
+const char* find_position_names[] = {"MIN", "LESSER_THAN", "LESSER_THAN_EQUALS", "GREATER_THAN_EQUALS", "GREATER_THAN", "MAX"};
+
+// the targets to seek to in order, small and large steps forward, then backward
+uint64_t seek_targets[] = {0, 1, 2, 5, 6, 40, 41, 300, 301, 302, 2000, 3997, 3998, 3999, 5000, 1000, 999, 3, 0};
+
+void test_seeks(uint64_t root_page_id, int is_stacked, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, is_stacked, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	find_position find_positions[] = {GREATER_THAN_EQUALS, GREATER_THAN, LESSER_THAN_EQUALS, LESSER_THAN};
+
+	uint64_t seeks = 0;
+	for(uint32_t f = 0; f < sizeof(find_positions)/sizeof(find_positions[0]); f++)
+	{
+		for(uint32_t t = 0; t < sizeof(seek_targets)/sizeof(seek_targets[0]); t++)
+		{
+			find_position find_pos = find_positions[f];
+
+			char key_tuple[PAGE_SIZE];
+			build_key(bpttd_p->key_def, key_tuple, seek_targets[t]);
+
+			if(!seek_bplus_tree_iterator(bpi_p, key_tuple, KEY_ELEMENT_COUNT, find_pos, transaction_id, &abort_error))
+			{
+				printf("FAILED : %s seek to %s %"PRIu64" failed\n", (is_stacked ? "stacked" : "unstacked"), find_position_names[find_pos], seek_targets[t]);
+				exit(-1);
+			}
+			CHECK_ABORT();
+
+			uint64_t key = get_key_at_iterator(bpi_p, find_pos);
+			uint64_t expected_key = get_expected_key(seek_targets[t], find_pos);
+			if(key != expected_key)
+			{
+				printf("FAILED : %s seek to %s %"PRIu64" landed at key %"PRIu64", when expecting %"PRIu64"\n", (is_stacked ? "stacked" : "unstacked"), find_position_names[find_pos], seek_targets[t], key, expected_key);
+				exit(-1);
+			}
+			seeks++;
+		}
+	}
+
+	// seeks to MIN and MAX, need no key
+	find_position ends[] = {MAX, MIN};
+	for(uint32_t e = 0; e < sizeof(ends)/sizeof(ends[0]); e++)
+	{
+		if(!seek_bplus_tree_iterator(bpi_p, NULL, KEY_ELEMENT_COUNT, ends[e], transaction_id, &abort_error))
+		{
+			printf("FAILED : %s seek to %s failed\n", (is_stacked ? "stacked" : "unstacked"), find_position_names[ends[e]]);
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		uint64_t key = get_key_at_iterator(bpi_p, ends[e]);
+		if(key != get_expected_key(0, ends[e]))
+		{
+			printf("FAILED : %s seek to %s landed at key %"PRIu64"\n", (is_stacked ? "stacked" : "unstacked"), find_position_names[ends[e]], key);
+			exit(-1);
+		}
+		seeks++;
+	}
+
+	// a NULL key is allowed only for MIN and MAX
+	if(seek_bplus_tree_iterator(bpi_p, NULL, KEY_ELEMENT_COUNT, GREATER_THAN_EQUALS, transaction_id, &abort_error))
+	{
+		printf("FAILED : %s seek to GREATER_THAN_EQUALS a NULL key succeeded\n", (is_stacked ? "stacked" : "unstacked"));
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	printf("PASSED : %"PRIu64" seeks of a %s iterator\n", seeks, (is_stacked ? "stacked" : "unstacked"));
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, KEY_OF(i), KEY_OF(i) * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", KEY_OF(i));
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	test_seeks(root_page_id, 0, &bpttd, pam_p);
+
+	test_seeks(root_page_id, 1, &bpttd, pam_p);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,215 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for get_statistics_bplus_tree() and get_approximate_record_count_in_range_bplus_tree()
+// the bplus_tree has the records {key, value = key * 10}, for every key in [0, RECORDS_COUNT), so the exact count of any range is known
+
+#define RECORDS_COUNT 1000
+#define QUANTILES_COUNT 8
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key_tuple(const bplus_tree_tuple_defs* bpttd_p, const void* key_tuple)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, bpttd_p->key_def, STATIC_POSITION(0), key_tuple);
+	return key.uint_value;
+}
+
+// checks the estimate for the range [key1, key2) (NULL for an open end) against the value expected from the histogram, and prints it against the exact count
+void check_estimate(const bplus_tree_statistics* bpts_p, const void* key1, const void* key2, uint64_t expected_estimate, uint64_t exact_count, const bplus_tree_tuple_defs* bpttd_p)
+{
+	uint64_t estimate = get_approximate_record_count_in_range_bplus_tree(bpts_p, key1, key2, bpttd_p);
+
+	char range[128];
+	sprintf(range, "[%s%"PRIu64", %s%"PRIu64")",
+		(key1 == NULL) ? "MIN" : "", (key1 == NULL) ? 0 : read_key_tuple(bpttd_p, key1),
+		(key2 == NULL) ? "MAX" : "", (key2 == NULL) ? 0 : read_key_tuple(bpttd_p, key2));
+
+	if(estimate != expected_estimate)
+	{
+		printf("FAILED : range %s estimated %"PRIu64", expected %"PRIu64" (exact count %"PRIu64")\n", range, estimate, expected_estimate, exact_count);
+		exit(-1);
+	}
+
+	printf("range %s : estimate = %"PRIu64", exact count = %"PRIu64"\n", range, estimate, exact_count);
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// insert the keys in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key gets inserted once)
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t key = (i * 7919) % RECORDS_COUNT;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	bplus_tree_statistics bpts;
+	get_statistics_bplus_tree(root_page_id, 1, QUANTILES_COUNT, &bpts, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	print_bplus_tree_statistics(&bpts, &bpttd);
+
+	// all the leaves were read, so the record count is exact
+	if(bpts.levels[0].tuple_count != RECORDS_COUNT)
+	{
+		printf("FAILED : tuple_count of the leaf level is %"PRIu64", expected %d\n", bpts.levels[0].tuple_count, RECORDS_COUNT);
+		exit(-1);
+	}
+
+	if(bpts.quantile_keys_count < 2)
+	{
+		printf("FAILED : only %"PRIu32" quantile keys, the bplus_tree must be taller for this test\n", bpts.quantile_keys_count);
+		exit(-1);
+	}
+
+	uint64_t bucket_count = bpts.quantile_keys_count + 1;
+	uint64_t Q = bpts.quantile_keys_count;
+
+	// the whole key space is covered by all the buckets
+	check_estimate(&bpts, NULL, NULL, RECORDS_COUNT, RECORDS_COUNT, &bpttd);
+
+	// an empty range
+	check_estimate(&bpts, bpts.quantile_keys[1], bpts.quantile_keys[0], 0, 0, &bpttd);
+
+	// closed ranges between quantile keys [q[i], q[j]), with (j - i) boundaries in range, cover exactly (j - i) buckets
+	for(uint32_t i = 0; i < Q; i++)
+	{
+		for(uint32_t j = i + 1; j < Q; j++)
+		{
+			uint64_t exact_count = read_key_tuple(&bpttd, bpts.quantile_keys[j]) - read_key_tuple(&bpttd, bpts.quantile_keys[i]);
+			check_estimate(&bpts, bpts.quantile_keys[i], bpts.quantile_keys[j], (RECORDS_COUNT * 2 * (j - i)) / (2 * bucket_count), exact_count, &bpttd);
+		}
+	}
+
+	// a closed range with its ends in the middles of the buckets, with 1 boundary in it, covers 2 halves i.e. 1 bucket
+	{
+		char key1[PAGE_SIZE];
+		char key2[PAGE_SIZE];
+		build_key(bpttd.key_def, key1, read_key_tuple(&bpttd, bpts.quantile_keys[0]) - 1);
+		build_key(bpttd.key_def, key2, read_key_tuple(&bpttd, bpts.quantile_keys[0]) + 1);
+		check_estimate(&bpts, key1, key2, (RECORDS_COUNT * 2) / (2 * bucket_count), 2, &bpttd);
+	}
+
+	// a closed range with no boundary in it, lies inside a single bucket, and covers half of it
+	{
+		char key1[PAGE_SIZE];
+		char key2[PAGE_SIZE];
+		build_key(bpttd.key_def, key1, read_key_tuple(&bpttd, bpts.quantile_keys[0]) + 1);
+		build_key(bpttd.key_def, key2, read_key_tuple(&bpttd, bpts.quantile_keys[0]) + 2);
+		check_estimate(&bpts, key1, key2, RECORDS_COUNT / (2 * bucket_count), 1, &bpttd);
+	}
+
+	// open ranges [MIN, q[i]) and [q[i], MAX), the open end covers its bucket completely
+	for(uint32_t i = 0; i < Q; i++)
+	{
+		uint64_t qi = read_key_tuple(&bpttd, bpts.quantile_keys[i]);
+		check_estimate(&bpts, NULL, bpts.quantile_keys[i], (RECORDS_COUNT * (2 * i + 1)) / (2 * bucket_count), qi, &bpttd);
+		check_estimate(&bpts, bpts.quantile_keys[i], NULL, (RECORDS_COUNT * (2 * (Q - i) + 1)) / (2 * bucket_count), RECORDS_COUNT - qi, &bpttd);
+	}
+
+	printf("PASSED : estimates for open and closed ranges\n");
+
+	deinitialize_bplus_tree_statistics(&bpts);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,291 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<buffered_bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for buffered_bplus_tree, the records are {key, value = key * 10} put in a scrambled order
+// then every 3rd key is put again with value = key * 10 + 1, and every 5th key is removed, while the message buffer keeps getting flushed as it outgrows MAX_BUFFER_HEIGHT
+// the point lookups must see the latest put or removal of every key, before and after the final flush, and the bplus_tree of the records must hold exactly the same after the final flush
+
+#define RECORDS_COUNT 2000
+#define MAX_BUFFER_HEIGHT 2
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// every 5th key gets removed, and the rest of the every 3rd key gets put again with a new value
+int is_key_present(uint64_t key)
+{
+	return (key % 5) != 0;
+}
+
+uint64_t expected_value(uint64_t key)
+{
+	return ((key % 3) == 0) ? (key * 10 + 1) : (key * 10);
+}
+
+// checks the point lookups for all the keys in [0, RECORDS_COUNT)
+void check_lookups(const buffered_bplus_tree_root_page_ids* root_page_ids, const buffered_bplus_tree_tuple_defs* bbpttd_p, const page_access_methods* pam_p)
+{
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(bbpttd_p->bpttd.key_def, key_tuple, key);
+
+		char record[PAGE_SIZE];
+		int found = find_in_buffered_bplus_tree(root_page_ids, key_tuple, record, bbpttd_p, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(found != is_key_present(key))
+		{
+			printf("FAILED : lookup of key %"PRIu64" %s\n", key, (found ? "found a removed record" : "did not find the record"));
+			exit(-1);
+		}
+
+		if(found && (read_key(record) != key || read_value(record) != expected_value(key)))
+		{
+			printf("FAILED : lookup of key %"PRIu64" found {%"PRIu64", %"PRIu64"}\n", key, read_key(record), read_value(record));
+			exit(-1);
+		}
+	}
+}
+
+// scans the bplus_tree at root_page_id, and returns the number of tuples in it
+// if check_records is set, then the tuples must be the present records in the order of their keys, each with its expected value
+uint64_t scan(uint64_t root_page_id, int check_records, const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, GREATER_THAN, 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t tuples_count = 0;
+	uint64_t expected_key = 0;
+	while(expected_key < RECORDS_COUNT && !is_key_present(expected_key))
+		expected_key++;
+
+	while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* tuple = get_tuple_bplus_tree_iterator(bpi_p);
+		if(tuple != NULL)
+		{
+			tuples_count++;
+
+			if(check_records)
+			{
+				if(read_key(tuple) != expected_key || read_value(tuple) != expected_value(expected_key))
+				{
+					printf("FAILED : scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", read_key(tuple), read_value(tuple), expected_key);
+					exit(-1);
+				}
+
+				do
+				{
+					expected_key++;
+				}
+				while(expected_key < RECORDS_COUNT && !is_key_present(expected_key));
+			}
+		}
+
+		next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(check_records && expected_key != RECORDS_COUNT)
+	{
+		printf("FAILED : scan stopped before key %"PRIu64"\n", expected_key);
+		exit(-1);
+	}
+
+	return tuples_count;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	buffered_bplus_tree_tuple_defs bbpttd;
+	if(!init_buffered_bplus_tree_tuple_definitions(&bbpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1, MAX_BUFFER_HEIGHT))
+	{
+		printf("failed to initialize buffered_bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_buffered_bplus_tree(&bbpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	buffered_bplus_tree_root_page_ids root_page_ids;
+	get_root_page_ids_for_buffered_bplus_tree(root_page_id, &root_page_ids, &bbpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// put the keys in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key gets put once)
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t key = (i * 7919) % RECORDS_COUNT;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!put_in_buffered_bplus_tree(&root_page_ids, record, &bbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : put of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// the message buffer must have been flushed, as it outgrew MAX_BUFFER_HEIGHT
+	if(scan(root_page_ids.records_root_page_id, 0, &(bbpttd.bpttd), pam_p) == 0)
+	{
+		printf("FAILED : the message buffer was never flushed\n");
+		exit(-1);
+	}
+
+	// put every 3rd key again, replacing both, the flushed records and the buffered messages
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 3)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10 + 1);
+
+		if(!put_in_buffered_bplus_tree(&root_page_ids, record, &bbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : put again of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// remove every 5th key
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 5)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(bbpttd.bpttd.key_def, key_tuple, key);
+
+		if(!remove_from_buffered_bplus_tree(&root_page_ids, key_tuple, &bbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : remove of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	check_lookups(&root_page_ids, &bbpttd, pam_p);
+
+	printf("PASSED : puts, removes and point lookups through the message buffer\n");
+
+	flush_buffered_bplus_tree(&root_page_ids, &bbpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(scan(root_page_ids.message_buffer_root_page_id, 0, &(bbpttd.message_bpttd), pam_p) != 0)
+	{
+		printf("FAILED : messages were left behind by the flush\n");
+		exit(-1);
+	}
+
+	scan(root_page_ids.records_root_page_id, 1, &(bbpttd.bpttd), pam_p);
+
+	check_lookups(&root_page_ids, &bbpttd, pam_p);
+
+	printf("PASSED : flush applied all the messages to the records\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_buffered_bplus_tree(root_page_id, &bbpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by destroy\n");
+		exit(-1);
+	}
+
+	printf("PASSED : destroy freed all the pages\n");
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_buffered_bplus_tree_tuple_definitions(&bbpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
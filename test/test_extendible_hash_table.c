@@ -0,0 +1,303 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<extendible_hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for extendible_hash_table, the records are {key, value = key * 10} with unique keys
+
+// enough records to split the buckets, and double the directory several times
+#define RECORDS_COUNT 1000
+
+// keys used only for building a probe run, that wraps around the end of the bucket
+#define WRAP_KEYS_START 1000000
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t get_home_slot_for_key(const extendible_hash_table_tuple_defs* ehttd_p, uint64_t key)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(ehttd_p->key_def, key_tuple, key);
+	return (get_hash_value_for_key_using_extendible_hash_table_tuple_definitions(ehttd_p, key_tuple) >> 32) % ehttd_p->attd.leaf_entries_per_page;
+}
+
+int insert_key(uint64_t root_page_id, uint64_t key, uint64_t value, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, value);
+	int result = insert_in_extendible_hash_table(root_page_id, record, ehttd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return result;
+}
+
+int delete_key(uint64_t root_page_id, uint64_t key, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(ehttd_p->key_def, key_tuple, key);
+	int result = delete_from_extendible_hash_table(root_page_id, key_tuple, ehttd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return result;
+}
+
+// fails the test, if the key is not found with the value OR if it is found when it must not be present
+void check_key(uint64_t root_page_id, uint64_t key, int must_be_present, uint64_t value, const extendible_hash_table_tuple_defs* ehttd_p, const page_access_methods* pam_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(ehttd_p->key_def, key_tuple, key);
+
+	char record[PAGE_SIZE];
+	int found = find_in_extendible_hash_table(root_page_id, key_tuple, record, ehttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(found != must_be_present)
+	{
+		printf("FAILED : key %"PRIu64" was %s\n", key, found ? "found, after its delete" : "not found");
+		exit(-1);
+	}
+
+	if(!found)
+		return;
+
+	user_value found_value;
+	get_value_from_element_from_tuple(&found_value, &record_def, STATIC_POSITION(1), record);
+	if(found_value.uint_value != value)
+	{
+		printf("FAILED : key %"PRIu64" was found with value %"PRIu64", instead of %"PRIu64"\n", key, found_value.uint_value, value);
+		exit(-1);
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	extendible_hash_table_tuple_defs ehttd;
+	if(!init_extendible_hash_table_tuple_definitions(&ehttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize extendible_hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t leaf_entries_per_page = ehttd.attd.leaf_entries_per_page;
+	if(leaf_entries_per_page < 5)
+	{
+		printf("FAILED : a bucket must have atleast 5 slots for this test, increase the PAGE_SIZE\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_extendible_hash_table(&ehttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// while there is only 1 bucket, build a probe run wrapping around its end
+	// wrap_keys[0 to 2] have their home slot at the last slot, and wrap_keys[3] at the slot 0
+	// so they get placed at slots (last, 0, 2, 1) respectively
+	{
+		uint64_t wrap_keys[4];
+		uint64_t wrap_keys_count = 0;
+		for(uint64_t key = WRAP_KEYS_START; wrap_keys_count < 3; key++)
+			if(get_home_slot_for_key(&ehttd, key) == leaf_entries_per_page - 1)
+				wrap_keys[wrap_keys_count++] = key;
+		for(uint64_t key = WRAP_KEYS_START; wrap_keys_count < 4; key++)
+			if(get_home_slot_for_key(&ehttd, key) == 0)
+				wrap_keys[wrap_keys_count++] = key;
+
+		uint64_t insert_order[4] = {0, 1, 3, 2};
+		for(int i = 0; i < 4; i++)
+		{
+			if(!insert_key(root_page_id, wrap_keys[insert_order[i]], wrap_keys[insert_order[i]] * 10, &ehttd, pam_p, pmm_p))
+			{
+				printf("FAILED : insert of key %"PRIu64"\n", wrap_keys[insert_order[i]]);
+				exit(-1);
+			}
+		}
+
+		// deleting the record at the last slot, must shift back the records at slots 0, 1 and 2, across the end of the bucket
+		if(!delete_key(root_page_id, wrap_keys[0], &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", wrap_keys[0]);
+			exit(-1);
+		}
+
+		check_key(root_page_id, wrap_keys[0], 0, 0, &ehttd, pam_p);
+		for(int i = 1; i < 4; i++)
+			check_key(root_page_id, wrap_keys[i], 1, wrap_keys[i] * 10, &ehttd, pam_p);
+
+		// now delete from the middle of the run, and check again
+		if(!delete_key(root_page_id, wrap_keys[3], &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", wrap_keys[3]);
+			exit(-1);
+		}
+
+		check_key(root_page_id, wrap_keys[3], 0, 0, &ehttd, pam_p);
+		for(int i = 1; i < 3; i++)
+			check_key(root_page_id, wrap_keys[i], 1, wrap_keys[i] * 10, &ehttd, pam_p);
+
+		// empty the bucket, for the tests below
+		for(int i = 1; i < 3; i++)
+		{
+			if(!delete_key(root_page_id, wrap_keys[i], &ehttd, pam_p, pmm_p))
+			{
+				printf("FAILED : delete of key %"PRIu64"\n", wrap_keys[i]);
+				exit(-1);
+			}
+			check_key(root_page_id, wrap_keys[i], 0, 0, &ehttd, pam_p);
+		}
+
+		if(delete_key(root_page_id, wrap_keys[0], &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : deleted key %"PRIu64" twice\n", wrap_keys[0]);
+			exit(-1);
+		}
+
+		printf("PASSED : delete within a probe run wrapping around the end of the bucket\n");
+	}
+
+	// insert all the records
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(!insert_key(root_page_id, key, key * 10, &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+	}
+
+	// there must be atleast RECORDS_COUNT / leaf_entries_per_page buckets, so the directory must have been doubled as many times as it takes to point to all of them
+	uint64_t used_pages_after_inserts = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) - used_pages_before;
+	if(used_pages_after_inserts <= (RECORDS_COUNT / leaf_entries_per_page) + 1)
+	{
+		printf("FAILED : only %"PRIu64" pages in use, after inserting %d records in buckets of %"PRIu64" slots\n", used_pages_after_inserts, RECORDS_COUNT, leaf_entries_per_page);
+		exit(-1);
+	}
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+		check_key(root_page_id, key, 1, key * 10, &ehttd, pam_p);
+
+	printf("PASSED : inserted and found %d records, using %"PRIu64" pages\n", RECORDS_COUNT, used_pages_after_inserts);
+
+	// the duplicates must be rejected, leaving the old value untouched
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 7)
+	{
+		if(insert_key(root_page_id, key, key * 10 + 1, &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : inserted a duplicate of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		check_key(root_page_id, key, 1, key * 10, &ehttd, pam_p);
+	}
+
+	printf("PASSED : duplicates rejected\n");
+
+	// delete all the even keys, and check that only the odd keys remain
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 2)
+	{
+		if(!delete_key(root_page_id, key, &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+	}
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+		check_key(root_page_id, key, (key % 2), key * 10, &ehttd, pam_p);
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 2)
+	{
+		if(delete_key(root_page_id, key, &ehttd, pam_p, pmm_p))
+		{
+			printf("FAILED : deleted key %"PRIu64" twice\n", key);
+			exit(-1);
+		}
+	}
+
+	printf("PASSED : deleted all the even keys\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_extendible_hash_table(root_page_id, &ehttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t used_pages_after_destroy = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+	if(used_pages_after_destroy != used_pages_before)
+	{
+		printf("FAILED : %"PRIu64" pages were left behind by destroy\n", used_pages_after_destroy - used_pages_before);
+		exit(-1);
+	}
+
+	printf("PASSED : destroy freed all the pages\n");
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_extendible_hash_table_tuple_definitions(&ehttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
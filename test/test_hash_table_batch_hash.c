@@ -0,0 +1,228 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+
+// tests for the batch hashing and bucketing functions of the hash_table_tuple_defs
+// get_hash_values_for_keys/records_using_hash_table_tuple_definitions() and get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions()
+// every batch result must be the same as the one of the function for a single key (or record or hash_value)
+
+#define RECORDS_COUNT 500
+
+// all the bucket_counts in [1, SMALL_BUCKET_COUNTS] are tried, along with the ones in large_bucket_counts
+#define SMALL_BUCKET_COUNTS 70
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+// non powers of 2 (including ones just off a power of 2) and powers of 2, upto the largest bucket_count
+uint64_t large_bucket_counts[] = {127, 128, 129, 1000, 1024, 65535, 65537, 1000003, (UINT64_C(3) << 20), (UINT64_C(1) << 40), (UINT64_C(1) << 40) + 1, UINT64_MAX};
+#define LARGE_BUCKET_COUNTS (sizeof(large_bucket_counts)/sizeof(large_bucket_counts[0]))
+
+// it must outlive the httd that it is set on
+positional_accessor hash_element_id = STATIC_POSITION(1);
+
+char records_memory[RECORDS_COUNT][PAGE_SIZE];
+const void* records[RECORDS_COUNT];
+
+char keys_memory[RECORDS_COUNT][PAGE_SIZE];
+const void* keys[RECORDS_COUNT];
+
+uint64_t hash_values[RECORDS_COUNT];
+uint64_t bucket_indices[RECORDS_COUNT];
+
+void check_hash_values(const uint64_t* batch_hash_values, const hash_table_tuple_defs* httd_p, int from_records, const char* test_name)
+{
+	for(uint32_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t hash_value = from_records ? get_hash_value_for_record_using_hash_table_tuple_definitions(httd_p, records[i]) : get_hash_value_for_key_using_hash_table_tuple_definitions(httd_p, keys[i]);
+		if(batch_hash_values[i] != hash_value)
+		{
+			printf("FAILED : %s, batch hash_value %"PRIu64" of %"PRIu32"th %s, when expecting %"PRIu64"\n", test_name, batch_hash_values[i], i, (from_records ? "record" : "key"), hash_value);
+			exit(-1);
+		}
+	}
+}
+
+void check_bucket_indices(uint64_t bucket_count, const hash_table_tuple_defs* httd_p)
+{
+	get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions(hash_values, RECORDS_COUNT, bucket_count, bucket_indices);
+
+	for(uint32_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t bucket_index = get_bucket_index_for_key_using_hash_table_tuple_definitions(httd_p, keys[i], bucket_count);
+		if(bucket_indices[i] != bucket_index || bucket_indices[i] != get_bucket_index_for_hash_value_using_hash_table_tuple_definitions(hash_values[i], bucket_count) || bucket_indices[i] >= bucket_count)
+		{
+			printf("FAILED : batch bucket_index %"PRIu64" of %"PRIu32"th key, when expecting %"PRIu64" of %"PRIu64" buckets\n", bucket_indices[i], i, bucket_index, bucket_count);
+			exit(-1);
+		}
+	}
+
+	// and in place, over a copy of the hash_values
+	uint64_t in_place[RECORDS_COUNT];
+	memcpy(in_place, hash_values, sizeof(in_place));
+	get_bucket_indices_for_hash_values_using_hash_table_tuple_definitions(in_place, RECORDS_COUNT, bucket_count, in_place);
+
+	if(memcmp(in_place, bucket_indices, sizeof(in_place)) != 0)
+	{
+		printf("FAILED : in place batch bucket_indices differ, for %"PRIu64" buckets\n", bucket_count);
+		exit(-1);
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	// same as httd, but with the value element storing the hash_value of the key
+	hash_table_tuple_defs httd_with_hash_element;
+	if(!init_hash_table_tuple_definitions(&httd_with_hash_element, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER)
+	|| !set_hash_element_for_hash_table_tuple_definitions(&httd_with_hash_element, hash_element_id))
+	{
+		printf("failed to initialize hash_table tuple definitions with a hash element\n");
+		exit(-1);
+	}
+
+	for(uint32_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		// spread out keys, including 0 and UINT64_MAX
+		uint64_t key = (i == RECORDS_COUNT - 1) ? UINT64_MAX : (((uint64_t)i) * UINT64_C(0x9E3779B97F4A7C15));
+
+		build_record(records_memory[i], key, key * 10);
+		records[i] = records_memory[i];
+
+		build_key(httd.key_def, keys_memory[i], key);
+		keys[i] = keys_memory[i];
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	get_hash_values_for_records_using_hash_table_tuple_definitions(&httd, records, RECORDS_COUNT, hash_values);
+	check_hash_values(hash_values, &httd, 1, "records");
+
+	get_hash_values_for_keys_using_hash_table_tuple_definitions(&httd, keys, RECORDS_COUNT, hash_values);
+	check_hash_values(hash_values, &httd, 0, "keys");
+
+	// the key of the record hashes the same as the record
+	for(uint32_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		if(hash_values[i] != get_hash_value_for_record_using_hash_table_tuple_definitions(&httd, records[i]))
+		{
+			printf("FAILED : %"PRIu32"th key and record hash differently\n", i);
+			exit(-1);
+		}
+	}
+
+	printf("PASSED : batch hash_values of keys and records\n");
+
+	// with a hash element, the stored hash_values are returned for the records
+	{
+		for(uint32_t i = 0; i < RECORDS_COUNT; i++)
+		{
+			if(!set_hash_value_in_record_using_hash_table_tuple_definitions(&httd_with_hash_element, records_memory[i]))
+			{
+				printf("FAILED : could not store the hash_value in the %"PRIu32"th record\n", i);
+				exit(-1);
+			}
+		}
+
+		// a stored hash_value that is not the hash of the key, must still be the one returned
+		set_element_in_tuple(&record_def, hash_element_id, records_memory[0], &((user_value){.uint_value = 12345}), UINT32_MAX);
+
+		uint64_t stored_hash_values[RECORDS_COUNT];
+		get_hash_values_for_records_using_hash_table_tuple_definitions(&httd_with_hash_element, records, RECORDS_COUNT, stored_hash_values);
+		check_hash_values(stored_hash_values, &httd_with_hash_element, 1, "records with hash element");
+
+		if(stored_hash_values[0] != 12345 || memcmp(stored_hash_values + 1, hash_values + 1, sizeof(uint64_t) * (RECORDS_COUNT - 1)) != 0)
+		{
+			printf("FAILED : batch hash_values of records with hash element are not the ones stored in them\n");
+			exit(-1);
+		}
+
+		printf("PASSED : batch hash_values of records with a hash element\n");
+	}
+
+	for(uint64_t bucket_count = 1; bucket_count <= SMALL_BUCKET_COUNTS; bucket_count++)
+		check_bucket_indices(bucket_count, &httd);
+
+	for(uint32_t i = 0; i < LARGE_BUCKET_COUNTS; i++)
+		check_bucket_indices(large_bucket_counts[i], &httd);
+
+	printf("PASSED : batch bucket_indices, also in place, for %d small and %d large bucket_counts\n", SMALL_BUCKET_COUNTS, (int)LARGE_BUCKET_COUNTS);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	deinit_hash_table_tuple_definitions(&httd_with_hash_element);
+
+	return 0;
+}
@@ -0,0 +1,327 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for the keyed hash_table_iterators and multi_probe_hash_table(), over long buckets of many pages, whose pages get skipped using the filters in their page headers
+// every present key must be found exactly once, and the absent ones (never inserted OR removed) must never be found, even after the splits and the merges of the pages
+
+// only a couple of buckets, so that each of them is a linked_page_list of many pages
+#define BUCKET_COUNT 2
+#define RECORDS_COUNT 600
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// the even keys are inserted, and the keys that are multiples of 6 are removed later
+int is_key_inserted(uint64_t key)
+{
+	return (key < RECORDS_COUNT) && ((key % 2) == 0);
+}
+
+int is_key_removed(uint64_t key)
+{
+	return (key % 6) == 0;
+}
+
+// inserts the record {key, key * 10} into the hash_table
+void insert_key_in_hash_table(uint64_t root_page_id, uint64_t key, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, key * 10);
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+	{
+		printf("FAILED : insert of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+// returns the number of records found for the key, using a keyed hash_table_iterator
+// if remove is set, the first record found is removed, with the (writable) iterator
+uint32_t find_key_in_hash_table(uint64_t root_page_id, uint64_t key, int remove, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, (remove ? pmm_p : NULL), transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint32_t found_count = 0;
+	while(1)
+	{
+		const void* record = get_tuple_hash_table_iterator(hti_p);
+		if(record != NULL)
+		{
+			if(read_key(record) != key || read_value(record) != key * 10)
+			{
+				printf("FAILED : record {%"PRIu64", %"PRIu64"} found for key %"PRIu64"\n", read_key(record), read_value(record), key);
+				exit(-1);
+			}
+			found_count++;
+
+			if(remove)
+			{
+				remove_from_hash_table_iterator(hti_p, transaction_id, &abort_error);
+				CHECK_ABORT();
+				break;
+			}
+		}
+
+		if(!next_hash_table_iterator(hti_p, 0, transaction_id, &abort_error))
+			break;
+		CHECK_ABORT();
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	return found_count;
+}
+
+void find_all_keys(uint64_t root_page_id, int after_removes, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	uint32_t keys_found = 0;
+
+	// also probe beyond the RECORDS_COUNT, for keys that were never inserted
+	for(uint64_t key = 0; key < 2 * RECORDS_COUNT; key++)
+	{
+		uint32_t expected_found_count = (is_key_inserted(key) && !(after_removes && is_key_removed(key))) ? 1 : 0;
+		uint32_t found_count = find_key_in_hash_table(root_page_id, key, 0, httd_p, pam_p, NULL);
+		if(found_count != expected_found_count)
+		{
+			printf("FAILED : key %"PRIu64" was found %"PRIu32" times, when expecting %"PRIu32"\n", key, found_count, expected_found_count);
+			exit(-1);
+		}
+		keys_found += found_count;
+	}
+
+	printf("PASSED : keyed iterators found %"PRIu32" keys\n", keys_found);
+}
+
+void record_found(void* context, uint32_t key_index, const void* record)
+{
+	uint32_t* found_counts = context;
+
+	if(read_key(record) != key_index || read_value(record) != ((uint64_t)key_index) * 10)
+	{
+		printf("FAILED : record {%"PRIu64", %"PRIu64"} reported for key_index %"PRIu32"\n", read_key(record), read_value(record), key_index);
+		exit(-1);
+	}
+
+	found_counts[key_index]++;
+}
+
+typedef struct single_key_probe single_key_probe;
+struct single_key_probe
+{
+	uint64_t key;
+	uint32_t found_count;
+};
+
+void record_found_for_single_key(void* context, uint32_t key_index, const void* record)
+{
+	single_key_probe* skp_p = context;
+
+	if(key_index != 0 || read_key(record) != skp_p->key || read_value(record) != skp_p->key * 10)
+	{
+		printf("FAILED : record {%"PRIu64", %"PRIu64"} reported for key %"PRIu64"\n", read_key(record), read_value(record), skp_p->key);
+		exit(-1);
+	}
+
+	skp_p->found_count++;
+}
+
+// probes each key on its own, so that all the probes are of a single key bucket group, and then all of them at once
+void multi_probe_all_keys(uint64_t root_page_id, int after_removes, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	static char key_tuples[2 * RECORDS_COUNT][PAGE_SIZE];
+	const void* keys[2 * RECORDS_COUNT];
+	for(uint64_t key = 0; key < 2 * RECORDS_COUNT; key++)
+	{
+		build_key(httd_p->key_def, key_tuples[key], key);
+		keys[key] = key_tuples[key];
+	}
+
+	for(int all_at_once = 0; all_at_once <= 1; all_at_once++)
+	{
+		static uint32_t found_counts[2 * RECORDS_COUNT];
+		memset(found_counts, 0, sizeof(found_counts));
+
+		if(all_at_once)
+		{
+			multi_probe_hash_table(root_page_id, keys, 2 * RECORDS_COUNT, found_counts, record_found, httd_p, pam_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+		else
+		{
+			for(uint64_t key = 0; key < 2 * RECORDS_COUNT; key++)
+			{
+				single_key_probe skp = {.key = key};
+				multi_probe_hash_table(root_page_id, &(keys[key]), 1, &skp, record_found_for_single_key, httd_p, pam_p, transaction_id, &abort_error);
+				CHECK_ABORT();
+				found_counts[key] = skp.found_count;
+			}
+		}
+
+		for(uint64_t key = 0; key < 2 * RECORDS_COUNT; key++)
+		{
+			uint32_t expected_found_count = (is_key_inserted(key) && !(after_removes && is_key_removed(key))) ? 1 : 0;
+			if(found_counts[key] != expected_found_count)
+			{
+				printf("FAILED : multi_probe (all_at_once = %d) reported key %"PRIu64" %"PRIu32" times, when expecting %"PRIu32"\n", all_at_once, key, found_counts[key], expected_found_count);
+				exit(-1);
+			}
+		}
+	}
+
+	printf("PASSED : multi_probe_hash_table found all the keys\n");
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_hash_table(BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_inserted(key))
+			insert_key_in_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// the pages of the buckets have only been split so far
+	find_all_keys(root_page_id, 0, &httd, pam_p);
+	multi_probe_all_keys(root_page_id, 0, &httd, pam_p);
+
+	// remove a third of the keys, the writable iterators merge the pages of the buckets as they get emptier, rebuilding their filters
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_inserted(key) && is_key_removed(key) && 1 != find_key_in_hash_table(root_page_id, key, 1, &httd, pam_p, pmm_p))
+		{
+			printf("FAILED : remove of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+	}
+	find_all_keys(root_page_id, 1, &httd, pam_p);
+	multi_probe_all_keys(root_page_id, 1, &httd, pam_p);
+
+	// the records are moved into the new buckets, by inserting them there
+	for(int i = 0; i < 3; i++)
+	{
+		expand_hash_table(root_page_id, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+	find_all_keys(root_page_id, 1, &httd, pam_p);
+	multi_probe_all_keys(root_page_id, 1, &httd, pam_p);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
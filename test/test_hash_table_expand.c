@@ -0,0 +1,309 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for expand_hash_table() and expand_hash_table_by()
+// a split moves every tuple to one of the 2 new buckets, the one that gets none must not be left behind as an empty linked_page_list
+
+#define EXPAND_COUNT 63
+
+#define RECORDS_COUNT 1000
+
+// more than 16 times the initial bucket_count, so that expand_hash_table_by has to expand in multiple rounds
+#define EXPAND_BY_INITIAL_BUCKET_COUNT 3
+#define EXPAND_BY_COUNT 200
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// inserts the record {key, key * 10} into the hash_table
+void insert_key_in_hash_table(uint64_t root_page_id, uint64_t key, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, key * 10);
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+	{
+		printf("FAILED : insert of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+// checks that the hash_table holds exactly the keys in [0, records_count) for which is_key_present() returns 1, each once and with a value of 10 times its key
+void check_hash_table(uint64_t root_page_id, uint64_t records_count, int (*is_key_present)(uint64_t key), const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	uint64_t present_count = 0;
+	for(uint64_t key = 0; key < records_count; key++)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(httd_p->key_def, key_tuple, key);
+
+		hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t found = 0;
+		while(1)
+		{
+			const void* record = get_tuple_hash_table_iterator(hti_p);
+			if(record != NULL)
+			{
+				if(read_value(record) != key * 10)
+				{
+					printf("FAILED : key %"PRIu64" found with value %"PRIu64"\n", key, read_value(record));
+					exit(-1);
+				}
+				found++;
+			}
+
+			int next_res = next_hash_table_iterator(hti_p, 0, transaction_id, &abort_error);
+			CHECK_ABORT();
+			if(next_res == 0)
+				break;
+		}
+
+		hash_table_vaccum_params htvp;
+		delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(found != (is_key_present(key) ? 1 : 0))
+		{
+			printf("FAILED : key %"PRIu64" found %"PRIu64" times\n", key, found);
+			exit(-1);
+		}
+		present_count += found;
+	}
+
+	// and there are no other records
+	hash_table_statistics htts;
+	get_statistics_hash_table(root_page_id, 1, &htts, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	if(htts.tuple_count != present_count)
+	{
+		printf("FAILED : the hash_table has %"PRIu64" records, when expecting %"PRIu64"\n", htts.tuple_count, present_count);
+		exit(-1);
+	}
+}
+
+int is_only_key_0_present(uint64_t key)
+{
+	return key == 0;
+}
+
+int is_key_present(uint64_t key)
+{
+	return 1;
+}
+
+hash_table_statistics get_statistics(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	hash_table_statistics htts;
+	get_statistics_hash_table(root_page_id, 1, &htts, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return htts;
+}
+
+void expand(uint64_t root_page_id, uint64_t expand_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	for(uint64_t i = 0; i < expand_count; i++)
+	{
+		if(!expand_hash_table(root_page_id, httd_p, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : expand_hash_table failed\n");
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// a single record, so every split of its bucket leaves one of the new buckets without any tuple
+	{
+		uint64_t root_page_id = get_new_hash_table(1, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		insert_key_in_hash_table(root_page_id, 0, &httd, pam_p, pmm_p);
+
+		expand(root_page_id, EXPAND_COUNT, &httd, pam_p, pmm_p);
+
+		hash_table_statistics htts = get_statistics(root_page_id, &httd, pam_p);
+		if(htts.bucket_count != 1 + EXPAND_COUNT || htts.empty_bucket_count != 0 || htts.null_bucket_count != EXPAND_COUNT || htts.page_count != 1)
+		{
+			printf("FAILED : after %d expands of a single record hash_table, found %"PRIu64" buckets, %"PRIu64" empty buckets, %"PRIu64" NULL buckets and %"PRIu64" pages\n", EXPAND_COUNT, htts.bucket_count, htts.empty_bucket_count, htts.null_bucket_count, htts.page_count);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, 1, is_only_key_0_present, &httd, pam_p);
+
+		destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		printf("PASSED : expand_hash_table leaves no empty buckets behind\n");
+	}
+
+	// many records, expanded one bucket at a time
+	{
+		uint64_t root_page_id = get_new_hash_table(1, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+			insert_key_in_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+
+		expand(root_page_id, EXPAND_COUNT, &httd, pam_p, pmm_p);
+
+		hash_table_statistics htts = get_statistics(root_page_id, &httd, pam_p);
+		if(htts.bucket_count != 1 + EXPAND_COUNT || htts.empty_bucket_count != 0)
+		{
+			printf("FAILED : after %d expands, found %"PRIu64" buckets, with %"PRIu64" of them empty\n", EXPAND_COUNT, htts.bucket_count, htts.empty_bucket_count);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present, &httd, pam_p);
+
+		destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		printf("PASSED : expand_hash_table of %d records to %"PRIu64" buckets\n", RECORDS_COUNT, htts.bucket_count);
+	}
+
+	// many records, expanded all at once, it must end up with the same records as expanding one bucket at a time
+	{
+		uint64_t root_page_id = get_new_hash_table(EXPAND_BY_INITIAL_BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+			insert_key_in_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+
+		uint64_t buckets_added = expand_hash_table_by(root_page_id, EXPAND_BY_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		hash_table_statistics htts = get_statistics(root_page_id, &httd, pam_p);
+		if(buckets_added != EXPAND_BY_COUNT || htts.bucket_count != EXPAND_BY_INITIAL_BUCKET_COUNT + EXPAND_BY_COUNT || htts.empty_bucket_count != 0)
+		{
+			printf("FAILED : expand_hash_table_by added %"PRIu64" buckets, to %"PRIu64" buckets, with %"PRIu64" of them empty\n", buckets_added, htts.bucket_count, htts.empty_bucket_count);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present, &httd, pam_p);
+
+		// and it can go on expanding from a bucket_count that is not a power of 2, one bucket at a time
+		expand(root_page_id, EXPAND_COUNT, &httd, pam_p, pmm_p);
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present, &httd, pam_p);
+
+		// expanding by 0 buckets does nothing
+		buckets_added = expand_hash_table_by(root_page_id, 0, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		if(buckets_added != 0 || get_statistics(root_page_id, &httd, pam_p).bucket_count != EXPAND_BY_INITIAL_BUCKET_COUNT + EXPAND_BY_COUNT + EXPAND_COUNT)
+		{
+			printf("FAILED : expand_hash_table_by 0 buckets, added %"PRIu64" buckets\n", buckets_added);
+			exit(-1);
+		}
+
+		destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		printf("PASSED : expand_hash_table_by of %d records from %d to %d buckets\n", RECORDS_COUNT, EXPAND_BY_INITIAL_BUCKET_COUNT, EXPAND_BY_INITIAL_BUCKET_COUNT + EXPAND_BY_COUNT);
+	}
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,314 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for the hash_table_handle, its cached bucket_count and bucket heads must never be used once the hash_table has been expanded or shrunk, OR a bucket head has been freed
+// every phase below probes all the keys through the same (long lived) handle, and checks them against the ones found without the handle
+
+#define BUCKET_COUNT 8
+#define RECORDS_COUNT 400
+
+// fewer heads can be cached than there are buckets, so the entries of the cache get replaced
+#define CACHED_HEADS_COUNT 5
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// present[key] is set, if the record {key, key * 10} is expected to be in the hash_table
+int present[2 * RECORDS_COUNT];
+
+// inserts the record {key, key * 10} into the hash_table, using the handle
+void insert_key_using_handle(hash_table_handle* hth_p, uint64_t key, const hash_table_tuple_defs* httd_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, key * 10);
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator_using_hash_table_handle(hth_p, key_tuple, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+	{
+		printf("FAILED : insert of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	present[key] = 1;
+}
+
+// returns the number of records found for the key, using a keyed hash_table_iterator, opened with (if hth_p != NULL) OR without the handle
+// if remove is set, the first record found is removed, with the (writable) iterator, the vaccum that it asks for is performed
+uint32_t find_key(uint64_t root_page_id, hash_table_handle* hth_p, uint64_t key, int remove, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = NULL;
+	if(hth_p != NULL)
+		hti_p = get_new_hash_table_iterator_using_hash_table_handle(hth_p, key_tuple, (remove ? pmm_p : NULL), transaction_id, &abort_error);
+	else
+		hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, (remove ? pmm_p : NULL), transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint32_t found_count = 0;
+	while(1)
+	{
+		const void* record = get_tuple_hash_table_iterator(hti_p);
+		if(record != NULL)
+		{
+			if(read_key(record) != key || read_value(record) != key * 10)
+			{
+				printf("FAILED : record {%"PRIu64", %"PRIu64"} found for key %"PRIu64"\n", read_key(record), read_value(record), key);
+				exit(-1);
+			}
+			found_count++;
+
+			if(remove)
+			{
+				remove_from_hash_table_iterator(hti_p, transaction_id, &abort_error);
+				CHECK_ABORT();
+				break;
+			}
+		}
+
+		if(!next_hash_table_iterator(hti_p, 0, transaction_id, &abort_error))
+			break;
+		CHECK_ABORT();
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(remove)
+	{
+		perform_vaccum_hash_table(root_page_id, &htvp, 1, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		present[key] = 0;
+	}
+
+	return found_count;
+}
+
+// probes all the keys through the handle (twice, the second time mostly from the cache), and checks the bucket_count of the handle
+void check_all_keys_using_handle(const char* phase, uint64_t root_page_id, hash_table_handle* hth_p, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	uint64_t bucket_count = get_bucket_count_hash_table(root_page_id, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t handle_bucket_count = get_bucket_count_using_hash_table_handle(hth_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(bucket_count != handle_bucket_count)
+	{
+		printf("FAILED : %s : bucket_count of the handle is %"PRIu64", when it is %"PRIu64"\n", phase, handle_bucket_count, bucket_count);
+		exit(-1);
+	}
+
+	uint32_t keys_found = 0;
+	for(int pass = 0; pass < 2; pass++)
+	{
+		for(uint64_t key = 0; key < 2 * RECORDS_COUNT; key++)
+		{
+			uint32_t found_count = find_key(root_page_id, hth_p, key, 0, httd_p, pam_p, NULL);
+			uint32_t found_count_without_handle = find_key(root_page_id, NULL, key, 0, httd_p, pam_p, NULL);
+			if(found_count != present[key] || found_count_without_handle != present[key])
+			{
+				printf("FAILED : %s : key %"PRIu64" was found %"PRIu32" times (%"PRIu32" times without the handle), when expecting %d\n", phase, key, found_count, found_count_without_handle, present[key]);
+				exit(-1);
+			}
+			keys_found += found_count;
+		}
+	}
+
+	printf("PASSED : %s : bucket_count = %"PRIu64", %"PRIu32" keys found in 2 passes\n", phase, handle_bucket_count, keys_found);
+}
+
+// removes all the records of the bucket with a writable iterator, opened without a key, so that its head is freed
+void empty_bucket(uint64_t root_page_id, uint64_t bucket_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){bucket_id, bucket_id}, NULL, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	while(1)
+	{
+		const void* record = get_tuple_hash_table_iterator(hti_p);
+		if(record == NULL)
+			break;
+
+		present[read_key(record)] = 0;
+
+		remove_from_hash_table_iterator(hti_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	perform_vaccum_hash_table(root_page_id, &htvp, 1, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_hash_table(BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	hash_table_handle* hth_p = get_new_hash_table_handle(root_page_id, CACHED_HEADS_COUNT, &httd, pam_p);
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// the even keys are inserted through the handle, the first insert into every bucket is done without the cache
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 2)
+		insert_key_using_handle(hth_p, key, &httd, pmm_p);
+	check_all_keys_using_handle("after inserts", root_page_id, hth_p, &httd, pam_p);
+
+	// the cached bucket_count and heads must be dropped after every expand
+	for(int i = 0; i < 5; i++)
+	{
+		expand_hash_table(root_page_id, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+	check_all_keys_using_handle("after expands", root_page_id, hth_p, &httd, pam_p);
+
+	expand_hash_table_by(root_page_id, 20, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	check_all_keys_using_handle("after expand_by", root_page_id, hth_p, &httd, pam_p);
+
+	// and after every shrink
+	for(int i = 0; i < 7; i++)
+	{
+		shrink_hash_table(root_page_id, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+	check_all_keys_using_handle("after shrinks", root_page_id, hth_p, &httd, pam_p);
+
+	// free the heads of a few buckets, by emptying them through the unkeyed iterators
+	for(uint64_t bucket_id = 0; bucket_id < 3; bucket_id++)
+		empty_bucket(root_page_id, bucket_id, &httd, pam_p, pmm_p);
+	check_all_keys_using_handle("after emptying buckets", root_page_id, hth_p, &httd, pam_p);
+
+	// free the heads of buckets, by removing all of their keys through the handle, and then vaccumming them
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(present[key] && (key % 4) == 0 && 1 != find_key(root_page_id, hth_p, key, 1, &httd, pam_p, pmm_p))
+		{
+			printf("FAILED : remove of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+	}
+	check_all_keys_using_handle("after removes", root_page_id, hth_p, &httd, pam_p);
+
+	// insert the odd keys back into all the buckets (including the ones freed above) through the handle
+	for(uint64_t key = 1; key < RECORDS_COUNT; key += 2)
+		insert_key_using_handle(hth_p, key, &httd, pmm_p);
+	check_all_keys_using_handle("after reinserts", root_page_id, hth_p, &httd, pam_p);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	delete_hash_table_handle(hth_p);
+
+	destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
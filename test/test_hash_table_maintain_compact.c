@@ -0,0 +1,368 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for maintain_hash_table() and compact_hash_table()
+// the hash_table is grown by maintain_hash_table() to the target load, then 9 of every 10 records are removed (without any vaccum)
+// compact_hash_table() must then leave no empty bucket, and maintain_hash_table() must shrink the hash_table back
+
+#define INITIAL_BUCKET_COUNT 4
+#define RECORDS_COUNT 1000
+
+#define TARGET_TUPLES_PER_BUCKET 20
+
+// a small pages_budget, so that compact_hash_table() has to be resumed many times
+#define COMPACT_PAGES_BUDGET 4
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// inserts the record {key, key * 10} into the hash_table
+void insert_key_in_hash_table(uint64_t root_page_id, uint64_t key, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, key * 10);
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+	{
+		printf("FAILED : insert of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+// removes the only record with the key from the hash_table, the vaccum that it may ask for is not performed, so its bucket may be left empty
+void remove_key_from_hash_table(uint64_t root_page_id, uint64_t key, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	int removed = 0;
+	while(1)
+	{
+		if(get_tuple_hash_table_iterator(hti_p) != NULL)
+		{
+			removed = remove_from_hash_table_iterator(hti_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+			break;
+		}
+
+		int next_res = next_hash_table_iterator(hti_p, 0, transaction_id, &abort_error);
+		CHECK_ABORT();
+		if(next_res == 0)
+			break;
+	}
+
+	if(!removed)
+	{
+		printf("FAILED : remove of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+// checks that the hash_table holds exactly the keys in [0, records_count) for which is_key_present() returns 1, each once and with a value of 10 times its key
+void check_hash_table(uint64_t root_page_id, uint64_t records_count, int (*is_key_present)(uint64_t key), const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	uint64_t present_count = 0;
+	for(uint64_t key = 0; key < records_count; key++)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(httd_p->key_def, key_tuple, key);
+
+		hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t found = 0;
+		while(1)
+		{
+			const void* record = get_tuple_hash_table_iterator(hti_p);
+			if(record != NULL)
+			{
+				if(read_value(record) != key * 10)
+				{
+					printf("FAILED : key %"PRIu64" found with value %"PRIu64"\n", key, read_value(record));
+					exit(-1);
+				}
+				found++;
+			}
+
+			int next_res = next_hash_table_iterator(hti_p, 0, transaction_id, &abort_error);
+			CHECK_ABORT();
+			if(next_res == 0)
+				break;
+		}
+
+		hash_table_vaccum_params htvp;
+		delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(found != (is_key_present(key) ? 1 : 0))
+		{
+			printf("FAILED : key %"PRIu64" found %"PRIu64" times\n", key, found);
+			exit(-1);
+		}
+		present_count += found;
+	}
+
+	// and there are no other records
+	hash_table_statistics htts;
+	get_statistics_hash_table(root_page_id, 1, &htts, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	if(htts.tuple_count != present_count)
+	{
+		printf("FAILED : the hash_table has %"PRIu64" records, when expecting %"PRIu64"\n", htts.tuple_count, present_count);
+		exit(-1);
+	}
+}
+
+int is_key_present_before_removes(uint64_t key)
+{
+	return 1;
+}
+
+int is_key_present(uint64_t key)
+{
+	return (key % 10) == 0;
+}
+
+hash_table_statistics get_statistics(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	hash_table_statistics htts;
+	get_statistics_hash_table(root_page_id, 1, &htts, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return htts;
+}
+
+uint64_t get_bucket_count(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	uint64_t bucket_count = get_bucket_count_hash_table(root_page_id, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return bucket_count;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_hash_table(INITIAL_BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+		insert_key_in_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// all the buckets are sampled, so the load is known exactly, and the hash_table must grow to the smallest bucket_count that brings it to the target
+	{
+		uint64_t buckets_changed = maintain_hash_table(root_page_id, TARGET_TUPLES_PER_BUCKET, UINT64_MAX, UINT64_MAX, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t expected_bucket_count = RECORDS_COUNT / TARGET_TUPLES_PER_BUCKET;
+		uint64_t bucket_count = get_bucket_count(root_page_id, &httd, pam_p);
+		if(bucket_count != expected_bucket_count || buckets_changed != expected_bucket_count - INITIAL_BUCKET_COUNT)
+		{
+			printf("FAILED : maintain_hash_table grew the hash_table to %"PRIu64" buckets (reporting %"PRIu64" changed), when expecting %"PRIu64"\n", bucket_count, buckets_changed, expected_bucket_count);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present_before_removes, &httd, pam_p);
+
+		// it is at the target load now, so there is nothing more to do
+		buckets_changed = maintain_hash_table(root_page_id, TARGET_TUPLES_PER_BUCKET, UINT64_MAX, UINT64_MAX, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		if(buckets_changed != 0 || get_bucket_count(root_page_id, &httd, pam_p) != expected_bucket_count)
+		{
+			printf("FAILED : maintain_hash_table changed %"PRIu64" buckets of a hash_table at its target load\n", buckets_changed);
+			exit(-1);
+		}
+
+		printf("PASSED : maintain_hash_table grew the hash_table from %d to %"PRIu64" buckets\n", INITIAL_BUCKET_COUNT, bucket_count);
+	}
+
+	// remove 9 of every 10 records, leaving sparse and empty buckets behind
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(!is_key_present(key))
+			remove_key_from_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+	}
+
+	// compact the hash_table, resuming it until it is done
+	{
+		hash_table_statistics before = get_statistics(root_page_id, &httd, pam_p);
+		if(before.empty_bucket_count == 0)
+		{
+			printf("FAILED : no empty buckets to compact, change the RECORDS_COUNT or TARGET_TUPLES_PER_BUCKET\n");
+			exit(-1);
+		}
+
+		uint64_t calls = 0;
+		uint64_t bucket_id = 0;
+		while(1)
+		{
+			uint64_t resume_bucket_id = UINT64_MAX;
+			int has_more = compact_hash_table(root_page_id, bucket_id, COMPACT_PAGES_BUDGET, &resume_bucket_id, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+			calls++;
+
+			if(!has_more)
+				break;
+
+			if(resume_bucket_id <= bucket_id)
+			{
+				printf("FAILED : compact_hash_table asked to resume from bucket %"PRIu64", after starting at bucket %"PRIu64"\n", resume_bucket_id, bucket_id);
+				exit(-1);
+			}
+			bucket_id = resume_bucket_id;
+		}
+
+		hash_table_statistics after = get_statistics(root_page_id, &httd, pam_p);
+
+		if(after.empty_bucket_count != 0 || after.null_bucket_count != before.null_bucket_count + before.empty_bucket_count)
+		{
+			printf("FAILED : %"PRIu64" empty buckets left after compact_hash_table, with %"PRIu64" NULL buckets (from %"PRIu64" empty and %"PRIu64" NULL buckets)\n", after.empty_bucket_count, after.null_bucket_count, before.empty_bucket_count, before.null_bucket_count);
+			exit(-1);
+		}
+
+		if(after.page_count > before.page_count)
+		{
+			printf("FAILED : compact_hash_table grew the buckets from %"PRIu64" to %"PRIu64" pages\n", before.page_count, after.page_count);
+			exit(-1);
+		}
+
+		if(calls < 2)
+		{
+			printf("FAILED : compact_hash_table was done in %"PRIu64" call, the COMPACT_PAGES_BUDGET is not being honoured\n", calls);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present, &httd, pam_p);
+
+		printf("PASSED : compact_hash_table in %"PRIu64" calls, pages %"PRIu64" -> %"PRIu64", empty buckets %"PRIu64" -> 0\n", calls, before.page_count, after.page_count, before.empty_bucket_count);
+	}
+
+	// the load is now a tenth of the target, so maintain_hash_table shrinks the hash_table, to the bucket_count that makes the load half of the target
+	{
+		uint64_t bucket_count_before = get_bucket_count(root_page_id, &httd, pam_p);
+
+		uint64_t buckets_changed = maintain_hash_table(root_page_id, TARGET_TUPLES_PER_BUCKET, UINT64_MAX, UINT64_MAX, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t expected_bucket_count = ((RECORDS_COUNT / 10) * 2) / TARGET_TUPLES_PER_BUCKET;
+		uint64_t bucket_count = get_bucket_count(root_page_id, &httd, pam_p);
+		if(bucket_count != expected_bucket_count || buckets_changed != bucket_count_before - expected_bucket_count)
+		{
+			printf("FAILED : maintain_hash_table shrunk the hash_table to %"PRIu64" buckets (reporting %"PRIu64" changed), when expecting %"PRIu64"\n", bucket_count, buckets_changed, expected_bucket_count);
+			exit(-1);
+		}
+
+		check_hash_table(root_page_id, RECORDS_COUNT, is_key_present, &httd, pam_p);
+
+		printf("PASSED : maintain_hash_table shrunk the hash_table from %"PRIu64" to %"PRIu64" buckets\n", bucket_count_before, bucket_count);
+	}
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
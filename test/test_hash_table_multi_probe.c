@@ -0,0 +1,232 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for multi_probe_hash_table(), with the probe keys in no particular order, some of them repeated and some of them absent from the hash_table
+// every present probe key must be reported exactly once (per its key_index), with the right record, and the absent ones must never be reported
+
+#define BUCKET_COUNT 16
+#define RECORDS_COUNT 1000
+
+// the probe keys repeat after every 150 of them, and span beyond the RECORDS_COUNT, and every third of them is odd, so some of them are never inserted
+#define PROBES_COUNT 300
+#define PROBE_KEY(i) ((((((uint64_t)(i)) * 7) % 150) * 8) + ((((uint64_t)(i)) % 3) == 0))
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// inserts the record {key, key * 10} into the hash_table
+void insert_key_in_hash_table(uint64_t root_page_id, uint64_t key, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p, const page_modification_methods* pmm_p)
+{
+	char record[PAGE_SIZE];
+	build_record(record, key, key * 10);
+	char key_tuple[PAGE_SIZE];
+	build_key(httd_p->key_def, key_tuple, key);
+
+	hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, key_tuple, httd_p, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+	{
+		printf("FAILED : insert of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+	CHECK_ABORT();
+
+	hash_table_vaccum_params htvp;
+	delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+// only the even keys are inserted
+int is_key_present(uint64_t key)
+{
+	return (key < RECORDS_COUNT) && ((key % 2) == 0);
+}
+
+char probe_key_tuples[PROBES_COUNT][PAGE_SIZE];
+
+typedef struct probe_results probe_results;
+struct probe_results
+{
+	uint32_t found_count[PROBES_COUNT];
+};
+
+void record_found(void* context, uint32_t key_index, const void* record)
+{
+	probe_results* pr_p = context;
+
+	uint64_t key = read_key(record);
+	uint64_t value = read_value(record);
+	if(key_index >= PROBES_COUNT || key != PROBE_KEY(key_index) || value != key * 10)
+	{
+		printf("FAILED : record {%"PRIu64", %"PRIu64"} reported for key_index %"PRIu32"\n", key, value, key_index);
+		exit(-1);
+	}
+
+	pr_p->found_count[key_index]++;
+}
+
+void multi_probe(uint64_t root_page_id, uint32_t keys_count, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	const void* keys[PROBES_COUNT];
+	for(uint32_t i = 0; i < keys_count; i++)
+		keys[i] = probe_key_tuples[i];
+
+	probe_results pr = {};
+	uint64_t records_found = multi_probe_hash_table(root_page_id, keys, keys_count, &pr, record_found, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t expected_records_found = 0;
+	for(uint32_t i = 0; i < keys_count; i++)
+	{
+		uint32_t expected_found_count = is_key_present(PROBE_KEY(i)) ? 1 : 0;
+		if(pr.found_count[i] != expected_found_count)
+		{
+			printf("FAILED : key %"PRIu64" at key_index %"PRIu32" was reported %"PRIu32" times, when expecting %"PRIu32"\n", PROBE_KEY(i), i, pr.found_count[i], expected_found_count);
+			exit(-1);
+		}
+		expected_records_found += expected_found_count;
+	}
+
+	if(records_found != expected_records_found)
+	{
+		printf("FAILED : multi_probe_hash_table of %"PRIu32" keys returned %"PRIu64", when expecting %"PRIu64"\n", keys_count, records_found, expected_records_found);
+		exit(-1);
+	}
+
+	printf("PASSED : multi_probe_hash_table of %"PRIu32" keys found %"PRIu64" records\n", keys_count, records_found);
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_hash_table(BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+			insert_key_in_hash_table(root_page_id, key, &httd, pam_p, pmm_p);
+	}
+
+	for(uint32_t i = 0; i < PROBES_COUNT; i++)
+		build_key(httd.key_def, probe_key_tuples[i], PROBE_KEY(i));
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// no keys, no records
+	multi_probe(root_page_id, 0, &httd, pam_p);
+
+	// a single key
+	multi_probe(root_page_id, 1, &httd, pam_p);
+
+	// all the keys, the keys at key_index i and i + 150 are the same, and each of them must be reported for both the key_indices
+	multi_probe(root_page_id, PROBES_COUNT, &httd, pam_p);
+
+	// the bucket_count is not a power of 2 anymore, so the keys go to the split and the unsplit buckets
+	for(int i = 0; i < 5; i++)
+	{
+		expand_hash_table(root_page_id, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+	multi_probe(root_page_id, PROBES_COUNT, &httd, pam_p);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
@@ -0,0 +1,195 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<hash_table.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// regression test for perform_vaccum_hash_table(), called with a batch of hash_table_vaccum_params, where only the later params need a vaccum
+
+#define BUCKET_COUNT 64
+#define RECORDS_COUNT 16
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t get_empty_bucket_count(uint64_t root_page_id, const hash_table_tuple_defs* httd_p, const page_access_methods* pam_p)
+{
+	hash_table_statistics htts;
+	get_statistics_hash_table(root_page_id, 1, &htts, httd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	return htts.empty_bucket_count;
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	hash_table_tuple_defs httd;
+	if(!init_hash_table_tuple_definitions(&httd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, 1, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize hash_table tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_hash_table(BUCKET_COUNT, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// insert all the records, keeping a count of the records in every bucket
+	uint64_t records_in_bucket[BUCKET_COUNT] = {};
+	char keys[RECORDS_COUNT][PAGE_SIZE];
+	for(uint64_t k = 0; k < RECORDS_COUNT; k++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, k, k * 10);
+		build_key(httd.key_def, keys[k], k);
+
+		hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, keys[k], &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(!insert_in_hash_table_iterator(hti_p, record, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", k);
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		hash_table_vaccum_params htvp;
+		delete_hash_table_iterator(hti_p, &htvp, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		records_in_bucket[get_bucket_index_for_key_using_hash_table_tuple_definitions(&httd, keys[k], BUCKET_COUNT)]++;
+	}
+
+	// the first param needs no vaccum, the later ones come from removing the only record of their buckets
+	#define PARAMS_COUNT 4
+	hash_table_vaccum_params htvps[PARAMS_COUNT] = {};
+	uint32_t params_count = 1;
+	for(uint64_t k = 0; k < RECORDS_COUNT && params_count < PARAMS_COUNT; k++)
+	{
+		if(records_in_bucket[get_bucket_index_for_key_using_hash_table_tuple_definitions(&httd, keys[k], BUCKET_COUNT)] != 1)
+			continue;
+
+		hash_table_iterator* hti_p = get_new_hash_table_iterator(root_page_id, (bucket_range){}, keys[k], &httd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(!remove_from_hash_table_iterator(hti_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : remove of key %"PRIu64"\n", k);
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		delete_hash_table_iterator(hti_p, &(htvps[params_count]), transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(!htvps[params_count].hash_table_vaccum_needed)
+		{
+			printf("FAILED : no vaccum asked for, after emptying the bucket of key %"PRIu64"\n", k);
+			exit(-1);
+		}
+
+		params_count++;
+	}
+
+	if(params_count < 3)
+	{
+		printf("FAILED : too few buckets with a single record, change the BUCKET_COUNT or RECORDS_COUNT\n");
+		exit(-1);
+	}
+
+	uint64_t empty_buckets_before = get_empty_bucket_count(root_page_id, &httd, pam_p);
+	if(empty_buckets_before != params_count - 1)
+	{
+		printf("FAILED : expected %"PRIu32" empty buckets before the vaccum, found %"PRIu64"\n", params_count - 1, empty_buckets_before);
+		exit(-1);
+	}
+
+	perform_vaccum_hash_table(root_page_id, htvps, params_count, &httd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// every param must have been looked at, and not just the first one
+	uint64_t empty_buckets_after = get_empty_bucket_count(root_page_id, &httd, pam_p);
+	if(empty_buckets_after != 0)
+	{
+		printf("FAILED : %"PRIu64" empty buckets left after the vaccum\n", empty_buckets_after);
+		exit(-1);
+	}
+
+	printf("PASSED : vaccummed %"PRIu32" buckets, with the first of %"PRIu32" params needing no vaccum\n", params_count - 1, params_count);
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_hash_table(root_page_id, &httd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_hash_table_tuple_definitions(&httd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
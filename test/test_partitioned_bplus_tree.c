@@ -0,0 +1,333 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<partitioned_bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for partitioned_bplus_tree, the records are {key, value = key * 10} with unique keys, hash partitioned on the key
+// the ordered scans merging all the partitions, must see the records just as a single bplus_tree holding all of them would
+
+#define RECORDS_COUNT 1000
+#define PARTITIONS_COUNT 4
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// the even keys are deleted midway through the test
+int deleted_evens = 0;
+
+int is_key_present(uint64_t key)
+{
+	return key < RECORDS_COUNT && (!deleted_evens || (key % 2) == 1);
+}
+
+// scans all the partitions merged, starting at find_pos of the key (NULL for MIN and MAX), and checks that it sees every present key in that direction, in order
+void check_merged_scan(const uint64_t* partition_root_page_ids, uint64_t key, find_position find_pos, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p)
+{
+	int is_ascending = (find_pos == MIN || find_pos == GREATER_THAN || find_pos == GREATER_THAN_EQUALS);
+
+	char key_tuple[PAGE_SIZE];
+	build_key(pbpttd_p->bpttd.key_def, key_tuple, key);
+
+	partitioned_bplus_tree_iterator* pbpi_p = find_in_partitioned_bplus_tree(partition_root_page_ids, ((find_pos == MIN || find_pos == MAX) ? NULL : key_tuple), pbpttd_p->bpttd.key_element_count, find_pos, pbpttd_p, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the first key expected, it is set to RECORDS_COUNT, when there is none
+	uint64_t expected_key;
+	switch(find_pos)
+	{
+		case MIN : expected_key = 0; break;
+		case MAX : expected_key = RECORDS_COUNT - 1; break;
+		case GREATER_THAN : expected_key = key + 1; break;
+		case GREATER_THAN_EQUALS : expected_key = key; break;
+		case LESSER_THAN : expected_key = (key == 0) ? RECORDS_COUNT : (key - 1); break;
+		case LESSER_THAN_EQUALS : expected_key = key; break;
+		default : expected_key = RECORDS_COUNT; break;
+	}
+	while(expected_key < RECORDS_COUNT && !is_key_present(expected_key))
+		expected_key = is_ascending ? (expected_key + 1) : ((expected_key == 0) ? RECORDS_COUNT : (expected_key - 1));
+
+	uint64_t records_seen = 0;
+	const void* record = get_tuple_partitioned_bplus_tree_iterator(pbpi_p);
+	while(record != NULL)
+	{
+		if(read_key(record) != expected_key || read_value(record) != read_key(record) * 10)
+		{
+			printf("FAILED : merged scan from %"PRIu64" found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", key, read_key(record), read_value(record), expected_key);
+			exit(-1);
+		}
+		records_seen++;
+
+		do
+		{
+			expected_key = is_ascending ? (expected_key + 1) : ((expected_key == 0) ? RECORDS_COUNT : (expected_key - 1));
+		}
+		while(expected_key < RECORDS_COUNT && !is_key_present(expected_key));
+
+		next_partitioned_bplus_tree_iterator(pbpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		record = get_tuple_partitioned_bplus_tree_iterator(pbpi_p);
+	}
+
+	delete_partitioned_bplus_tree_iterator(pbpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != RECORDS_COUNT)
+	{
+		printf("FAILED : merged scan from %"PRIu64" stopped before key %"PRIu64", after %"PRIu64" records\n", key, expected_key, records_seen);
+		exit(-1);
+	}
+}
+
+// checks that every record of each partition belongs to it, and that the partitions together hold all the present keys
+void check_partitions(const uint64_t* partition_root_page_ids, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p)
+{
+	uint64_t total_records = 0;
+	for(uint64_t p = 0; p < PARTITIONS_COUNT; p++)
+	{
+		uint64_t partition_records = 0;
+
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(partition_root_page_ids[p], NULL, pbpttd_p->bpttd.key_element_count, GREATER_THAN, 0, READ_LOCK, &(pbpttd_p->bpttd), pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+		{
+			const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+			if(record != NULL)
+			{
+				if(get_partition_index_for_record_using_partitioned_bplus_tree_tuple_definitions(pbpttd_p, record) != p || !is_key_present(read_key(record)))
+				{
+					printf("FAILED : key %"PRIu64" found in partition %"PRIu64"\n", read_key(record), p);
+					exit(-1);
+				}
+				partition_records++;
+			}
+
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		printf("partition %"PRIu64" : %"PRIu64" records\n", p, partition_records);
+		total_records += partition_records;
+	}
+
+	uint64_t expected_records = deleted_evens ? (RECORDS_COUNT / 2) : RECORDS_COUNT;
+	if(total_records != expected_records)
+	{
+		printf("FAILED : the partitions hold %"PRIu64" records, expected %"PRIu64"\n", total_records, expected_records);
+		exit(-1);
+	}
+}
+
+// point lookup of the key, only in the partition that it belongs to
+void check_point_lookup(const uint64_t* partition_root_page_ids, uint64_t key, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p)
+{
+	char key_tuple[PAGE_SIZE];
+	build_key(pbpttd_p->bpttd.key_def, key_tuple, key);
+
+	bplus_tree_iterator* bpi_p = find_in_partition_of_partitioned_bplus_tree(partition_root_page_ids, key_tuple, pbpttd_p->bpttd.key_element_count, GREATER_THAN_EQUALS, 0, READ_LOCK, pbpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+	int found = (record != NULL && read_key(record) == key);
+	if(found != is_key_present(key) || (found && read_value(record) != key * 10))
+	{
+		printf("FAILED : point lookup of key %"PRIu64"\n", key);
+		exit(-1);
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+}
+
+void check_all(const uint64_t* partition_root_page_ids, const partitioned_bplus_tree_tuple_defs* pbpttd_p, const page_access_methods* pam_p)
+{
+	check_partitions(partition_root_page_ids, pbpttd_p, pam_p);
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+		check_point_lookup(partition_root_page_ids, key, pbpttd_p, pam_p);
+
+	check_merged_scan(partition_root_page_ids, 0, MIN, pbpttd_p, pam_p);
+	check_merged_scan(partition_root_page_ids, 0, MAX, pbpttd_p, pam_p);
+	find_position find_poss[] = {GREATER_THAN, GREATER_THAN_EQUALS, LESSER_THAN, LESSER_THAN_EQUALS};
+	uint64_t keys[] = {0, 1, RECORDS_COUNT / 2, (RECORDS_COUNT / 2) + 1, RECORDS_COUNT - 1};
+	for(int f = 0; f < sizeof(find_poss) / sizeof(find_poss[0]); f++)
+		for(int k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+			check_merged_scan(partition_root_page_ids, keys[k], find_poss[f], pbpttd_p, pam_p);
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	partitioned_bplus_tree_tuple_defs pbpttd;
+	if(!init_partitioned_bplus_tree_tuple_definitions(&pbpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1, 1, PARTITIONS_COUNT, FNV_64_TUPLE_HASHER))
+	{
+		printf("failed to initialize partitioned_bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_partitioned_bplus_tree(&pbpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t partition_root_page_ids[PARTITIONS_COUNT];
+	get_partition_root_page_ids_for_partitioned_bplus_tree(root_page_id, partition_root_page_ids, &pbpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// insert the keys in a scrambled order (7919 is coprime with RECORDS_COUNT, so every key gets inserted once)
+	for(uint64_t i = 0; i < RECORDS_COUNT; i++)
+	{
+		uint64_t key = (i * 7919) % RECORDS_COUNT;
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_partitioned_bplus_tree(partition_root_page_ids, record, &pbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// the duplicates must be rejected
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 7)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10 + 1);
+
+		if(insert_in_partitioned_bplus_tree(partition_root_page_ids, record, &pbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : inserted a duplicate of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	check_all(partition_root_page_ids, &pbpttd, pam_p);
+
+	printf("PASSED : inserts, point lookups and merged scans\n");
+
+	// delete all the even keys
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 2)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(pbpttd.bpttd.key_def, key_tuple, key);
+
+		if(!delete_from_partitioned_bplus_tree(partition_root_page_ids, key_tuple, &pbpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+	deleted_evens = 1;
+
+	check_all(partition_root_page_ids, &pbpttd, pam_p);
+
+	printf("PASSED : deletes, point lookups and merged scans\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_partitioned_bplus_tree(root_page_id, &pbpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by destroy\n");
+		exit(-1);
+	}
+
+	printf("PASSED : destroy freed all the pages\n");
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_partitioned_bplus_tree_tuple_definitions(&pbpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
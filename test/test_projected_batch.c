@@ -0,0 +1,281 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+#include<linked_page_list.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for get_projected_batch_bplus_tree_iterator() and get_projected_batch_linked_page_list_iterator()
+// the records are read back in batches of BATCH_SIZE, projecting the value before the key (so the columns are not in the order of the elements)
+// and every record must be read exactly once, in order, with the next_* call after a batch moving on to the first record after it
+
+#define RECORDS_COUNT 1000
+
+// smaller than the records on a page, so that a page is read in multiple batches, and not a multiple of them either
+#define BATCH_SIZE 3
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+positional_accessor projection[] = {STATIC_POSITION(1), STATIC_POSITION(0)};
+#define PROJECTION_COUNT (sizeof(projection)/sizeof(projection[0]))
+
+// checks a batch of records, read into the columns, they must have the consecutive keys from expected_first_key
+void check_batch(user_value** columns, uint32_t tuples_read, uint64_t expected_first_key, const char* data_structure)
+{
+	if(tuples_read > BATCH_SIZE)
+	{
+		printf("FAILED : %s batch read %"PRIu32" records, when asked for atmost %d\n", data_structure, tuples_read, BATCH_SIZE);
+		exit(-1);
+	}
+
+	for(uint32_t i = 0; i < tuples_read; i++)
+	{
+		uint64_t key = columns[1][i].uint_value;
+		uint64_t value = columns[0][i].uint_value;
+		if(key != expected_first_key + i || value != key * 10)
+		{
+			printf("FAILED : %s batch read {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", data_structure, key, value, expected_first_key + i);
+			exit(-1);
+		}
+	}
+}
+
+user_value value_column[BATCH_SIZE];
+user_value key_column[BATCH_SIZE];
+user_value* columns[] = {value_column, key_column};
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	linked_page_list_tuple_defs lpltd;
+	if(!init_linked_page_list_tuple_definitions(&lpltd, &(pam_p->pas), &record_def))
+	{
+		printf("failed to initialize linked_page_list tuple definitions\n");
+		exit(-1);
+	}
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	uint64_t head_page_id = get_new_linked_page_list(&lpltd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64" in bplus_tree\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// append all the records to the linked_page_list in the key order, the iterator stays at the last record appended
+	{
+		linked_page_list_iterator* lpli_p = get_new_linked_page_list_iterator(head_page_id, &lpltd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+		{
+			char record[PAGE_SIZE];
+			build_record(record, key, key * 10);
+
+			if(!insert_at_linked_page_list_iterator(lpli_p, record, INSERT_AFTER_LINKED_PAGE_LIST_ITERATOR, transaction_id, &abort_error))
+			{
+				printf("FAILED : insert of key %"PRIu64" in linked_page_list\n", key);
+				exit(-1);
+			}
+			CHECK_ABORT();
+
+			if(key > 0)
+			{
+				next_linked_page_list_iterator(lpli_p, transaction_id, &abort_error);
+				CHECK_ABORT();
+			}
+		}
+
+		delete_linked_page_list_iterator(lpli_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// an empty linked_page_list has no current tuple to start a batch from
+	{
+		uint64_t empty_head_page_id = get_new_linked_page_list(&lpltd, pam_p, pmm_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		linked_page_list_iterator* lpli_p = get_new_linked_page_list_iterator(empty_head_page_id, &lpltd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint32_t tuples_read = get_projected_batch_linked_page_list_iterator(lpli_p, projection, PROJECTION_COUNT, columns, BATCH_SIZE);
+
+		delete_linked_page_list_iterator(lpli_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		destroy_linked_page_list(empty_head_page_id, &lpltd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(tuples_read != 0)
+		{
+			printf("FAILED : batch read %"PRIu32" records from an empty linked_page_list\n", tuples_read);
+			exit(-1);
+		}
+
+		printf("PASSED : no records read from an empty linked_page_list\n");
+	}
+
+	{
+		bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, KEY_ELEMENT_COUNT, GREATER_THAN, 0, READ_LOCK, &bpttd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t records_read = 0;
+		uint64_t batches = 0;
+		while(!is_beyond_max_tuple_bplus_tree_iterator(bpi_p))
+		{
+			uint32_t tuples_read = get_projected_batch_bplus_tree_iterator(bpi_p, projection, PROJECTION_COUNT, columns, BATCH_SIZE);
+			if(tuples_read > 0)
+			{
+				check_batch(columns, tuples_read, records_read, "bplus_tree");
+				records_read += tuples_read;
+				batches++;
+			}
+
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+
+		delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(records_read != RECORDS_COUNT)
+		{
+			printf("FAILED : bplus_tree batches read %"PRIu64" records, when expecting %d\n", records_read, RECORDS_COUNT);
+			exit(-1);
+		}
+
+		printf("PASSED : bplus_tree read in %"PRIu64" batches\n", batches);
+	}
+
+	{
+		linked_page_list_iterator* lpli_p = get_new_linked_page_list_iterator(head_page_id, &lpltd, pam_p, NULL, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t records_read = 0;
+		uint64_t batches = 0;
+		while(!is_empty_linked_page_list(lpli_p))
+		{
+			uint32_t tuples_read = get_projected_batch_linked_page_list_iterator(lpli_p, projection, PROJECTION_COUNT, columns, BATCH_SIZE);
+			if(tuples_read == 0)
+			{
+				printf("FAILED : linked_page_list batch read no records, after %"PRIu64" records\n", records_read);
+				exit(-1);
+			}
+
+			check_batch(columns, tuples_read, records_read, "linked_page_list");
+			records_read += tuples_read;
+			batches++;
+
+			if(is_at_tail_tuple_linked_page_list_iterator(lpli_p))
+				break;
+
+			next_linked_page_list_iterator(lpli_p, transaction_id, &abort_error);
+			CHECK_ABORT();
+		}
+
+		delete_linked_page_list_iterator(lpli_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+
+		if(records_read != RECORDS_COUNT)
+		{
+			printf("FAILED : linked_page_list batches read %"PRIu64" records, when expecting %d\n", records_read, RECORDS_COUNT);
+			exit(-1);
+		}
+
+		printf("PASSED : linked_page_list read in %"PRIu64" batches\n", batches);
+	}
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	destroy_linked_page_list(head_page_id, &lpltd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	deinit_linked_page_list_tuple_definitions(&lpltd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}
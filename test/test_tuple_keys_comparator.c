@@ -0,0 +1,168 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<tuple_keys_comparator.h>
+
+// tests for get_tuple_keys_comparator(), the kernels it picks for the common key shapes must order random tuples exactly as compare_tuples() does
+// the values are drawn from small ranges (with NULLs and strings that prefix each other), so that the ties on the first key are common
+
+#define PAGE_SIZE 256
+
+#define PAIRS_COUNT 20000
+
+tuple_def tuple_definition;
+char tuple_type_info_memory[sizeof_tuple_data_type_info(6)];
+data_type_info* tuple_type_info = (data_type_info*)tuple_type_info_memory;
+data_type_info c2_type_info;
+data_type_info c5_type_info;
+
+void init_tuple_definition()
+{
+	initialize_tuple_data_type_info(tuple_type_info, "keys", 1, PAGE_SIZE, 6);
+
+	strcpy(tuple_type_info->containees[0].field_name, "u8");
+	tuple_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(tuple_type_info->containees[1].field_name, "i4");
+	tuple_type_info->containees[1].al.type_info = INT_NULLABLE[4];
+
+	c2_type_info = get_fixed_length_string_type("", 6, 1);
+	strcpy(tuple_type_info->containees[2].field_name, "fixed_string");
+	tuple_type_info->containees[2].al.type_info = &c2_type_info;
+
+	strcpy(tuple_type_info->containees[3].field_name, "u2");
+	tuple_type_info->containees[3].al.type_info = UINT_NULLABLE[2];
+
+	strcpy(tuple_type_info->containees[4].field_name, "i8");
+	tuple_type_info->containees[4].al.type_info = INT_NULLABLE[8];
+
+	c5_type_info = get_variable_length_string_type("", 32);
+	strcpy(tuple_type_info->containees[5].field_name, "variable_string");
+	tuple_type_info->containees[5].al.type_info = &c5_type_info;
+
+	if(!initialize_tuple_def(&tuple_definition, tuple_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+// sets the element to NULL 1 in 8 times, else calls set_value
+#define set_random_element(pos, set_value) \
+	if(rand() % 8 == 0) \
+		set_element_in_tuple(&tuple_definition, STATIC_POSITION(pos), tuple, NULL_USER_VALUE, UINT32_MAX); \
+	else \
+		set_value;
+
+void build_random_tuple(void* tuple)
+{
+	init_tuple(&tuple_definition, tuple);
+
+	// strings of 0 to 6 characters from a 2 character alphabet, so that they often prefix each other
+	char string[6];
+	uint32_t string_size = rand() % 7;
+	for(uint32_t i = 0; i < string_size; i++)
+		string[i] = 'a' + (rand() % 2);
+
+	set_random_element(0, set_element_in_tuple(&tuple_definition, STATIC_POSITION(0), tuple, &((user_value){.uint_value = (rand() % 4) * (UINT64_MAX / 3)}), UINT32_MAX))
+	set_random_element(1, set_element_in_tuple(&tuple_definition, STATIC_POSITION(1), tuple, &((user_value){.int_value = (rand() % 5) - 2}), UINT32_MAX))
+	set_random_element(2, set_element_in_tuple(&tuple_definition, STATIC_POSITION(2), tuple, &((user_value){.string_value = string, .string_size = string_size}), UINT32_MAX))
+	set_random_element(3, set_element_in_tuple(&tuple_definition, STATIC_POSITION(3), tuple, &((user_value){.uint_value = rand() % 4}), UINT32_MAX))
+	set_random_element(4, set_element_in_tuple(&tuple_definition, STATIC_POSITION(4), tuple, &((user_value){.int_value = ((rand() % 3) - 1) * (INT64_MAX / 2)}), UINT32_MAX))
+	set_random_element(5, set_element_in_tuple(&tuple_definition, STATIC_POSITION(5), tuple, &((user_value){.string_value = string, .string_size = string_size}), UINT32_MAX))
+}
+
+int sign(int cmp)
+{
+	return (cmp > 0) - (cmp < 0);
+}
+
+// checks the comparator picked for the key_element_ids against compare_tuples(), for all the prefixes of the keys, in all the compare directions
+// is_kernel_expected is 0, if compare_tuples() itself must be picked
+void test_key_shape(const char* shape_name, const positional_accessor* key_element_ids, uint32_t key_element_count, int is_kernel_expected)
+{
+	tuple_keys_comparator comparator = get_tuple_keys_comparator(&tuple_definition, key_element_ids, key_element_count);
+	if(is_kernel_expected != (comparator != compare_tuples))
+	{
+		printf("FAILED : %s got %s\n", shape_name, ((comparator == compare_tuples) ? "compare_tuples, when expecting a kernel" : "a kernel, when expecting compare_tuples"));
+		exit(-1);
+	}
+
+	char tuple1[PAGE_SIZE];
+	char tuple2[PAGE_SIZE];
+
+	for(uint32_t directions = 0; directions < (1U << key_element_count); directions++)
+	{
+		compare_direction cmp_dir[8];
+		for(uint32_t i = 0; i < key_element_count; i++)
+			cmp_dir[i] = ((directions >> i) & 1) ? DESC : ASC;
+
+		for(uint32_t p = 0; p < PAIRS_COUNT; p++)
+		{
+			build_random_tuple(tuple1);
+			if(rand() % 4 == 0)
+				memcpy(tuple2, tuple1, PAGE_SIZE);
+			else
+				build_random_tuple(tuple2);
+
+			for(uint32_t element_count = 0; element_count <= key_element_count; element_count++)
+			{
+				int expected = sign(compare_tuples(tuple1, &tuple_definition, key_element_ids, tuple2, &tuple_definition, key_element_ids, cmp_dir, element_count));
+				int found = sign(comparator(tuple1, &tuple_definition, key_element_ids, tuple2, &tuple_definition, key_element_ids, cmp_dir, element_count));
+				if(expected != found)
+				{
+					printf("FAILED : %s compared %d, when compare_tuples compared %d, for %u keys\n", shape_name, found, expected, element_count);
+					print_tuple(tuple1, &tuple_definition);
+					print_tuple(tuple2, &tuple_definition);
+					exit(-1);
+				}
+
+				// cmp_dir = NULL is all ASC
+				expected = sign(compare_tuples(tuple1, &tuple_definition, key_element_ids, tuple2, &tuple_definition, key_element_ids, NULL, element_count));
+				found = sign(comparator(tuple1, &tuple_definition, key_element_ids, tuple2, &tuple_definition, key_element_ids, NULL, element_count));
+				if(expected != found)
+				{
+					printf("FAILED : %s compared %d, when compare_tuples compared %d, for %u keys with NULL compare directions\n", shape_name, found, expected, element_count);
+					exit(-1);
+				}
+			}
+		}
+	}
+
+	printf("PASSED : %s\n", shape_name);
+}
+
+int main()
+{
+	srand(42);
+
+	init_tuple_definition();
+
+	/* TESTS STARTED */
+
+	test_key_shape("single UINT key", (positional_accessor []){STATIC_POSITION(0)}, 1, 1);
+	test_key_shape("single small UINT key", (positional_accessor []){STATIC_POSITION(3)}, 1, 1);
+	test_key_shape("single INT key", (positional_accessor []){STATIC_POSITION(1)}, 1, 1);
+	test_key_shape("single fixed length STRING key", (positional_accessor []){STATIC_POSITION(2)}, 1, 1);
+
+	test_key_shape("UINT, UINT keys", (positional_accessor []){STATIC_POSITION(0), STATIC_POSITION(3)}, 2, 1);
+	test_key_shape("UINT, INT keys", (positional_accessor []){STATIC_POSITION(0), STATIC_POSITION(1)}, 2, 1);
+	test_key_shape("INT, UINT keys", (positional_accessor []){STATIC_POSITION(4), STATIC_POSITION(3)}, 2, 1);
+	test_key_shape("INT, INT keys", (positional_accessor []){STATIC_POSITION(1), STATIC_POSITION(4)}, 2, 1);
+
+	// element_ids = NULL, is the first elements of the tuple, i.e. the UINT, INT keys
+	test_key_shape("UINT, INT keys with NULL element_ids", NULL, 2, 1);
+
+	// the other shapes fall back to compare_tuples
+	test_key_shape("single variable length STRING key", (positional_accessor []){STATIC_POSITION(5)}, 1, 0);
+	test_key_shape("UINT, fixed length STRING keys", (positional_accessor []){STATIC_POSITION(0), STATIC_POSITION(2)}, 2, 0);
+	test_key_shape("3 numeral keys", (positional_accessor []){STATIC_POSITION(0), STATIC_POSITION(1), STATIC_POSITION(3)}, 3, 0);
+
+	/* TESTS ENDED */
+
+	return 0;
+}
@@ -0,0 +1,438 @@
+#include<stdio.h>
+#include<stdlib.h>
+#include<stdint.h>
+#include<inttypes.h>
+#include<string.h>
+
+#include<tuple.h>
+#include<tuple_def.h>
+
+#include<bplus_tree.h>
+
+#include<unWALed_in_memory_data_store.h>
+#include<unWALed_page_modification_methods.h>
+
+// tests for compress_cold_pages_in_unWALed_in_memory_data_store() and compress_cold_leaf_pages_of_bplus_tree()
+// first on raw pages, whose contents are known, so that only the cold pages that compress well get compressed, and they read back unchanged when locked again
+// then on a bplus_tree left sparse by deleting 3 of every 4 records, that must scan the same after all of its pages are compressed, and compressed again
+// and at last on a bplus_tree with all of its records, whose leaf pages are compressed with the page_codec of the bplus_tree, that takes out their integer keys as a frame of reference, xors the neighbouring records and strips even the short runs of zero bytes
+
+#define RECORDS_COUNT 2000
+
+// attributes of the page_access_specs suggestions for creating page_access_methods
+#define PAGE_ID_WIDTH        3
+#define PAGE_SIZE          256
+
+// initialize transaction_id and abort_error
+const void* transaction_id = NULL;
+int abort_error = 0;
+
+#define CHECK_ABORT() if(abort_error){printf("ABORTED\n"); exit(-1);}
+
+// records of 2 UINT elements, a key at position 0 and a value at position 1
+tuple_def record_def;
+char record_type_info_memory[sizeof_tuple_data_type_info(2)];
+data_type_info* record_type_info = (data_type_info*)record_type_info_memory;
+
+void init_record_def()
+{
+	initialize_tuple_data_type_info(record_type_info, "record", 1, PAGE_SIZE, 2);
+
+	strcpy(record_type_info->containees[0].field_name, "key");
+	record_type_info->containees[0].al.type_info = UINT_NULLABLE[8];
+
+	strcpy(record_type_info->containees[1].field_name, "value");
+	record_type_info->containees[1].al.type_info = UINT_NULLABLE[8];
+
+	if(!initialize_tuple_def(&record_def, record_type_info))
+	{
+		printf("failed finalizing tuple definition\n");
+		exit(-1);
+	}
+}
+
+void build_record(void* record, uint64_t key, uint64_t value)
+{
+	init_tuple(&record_def, record);
+	set_element_in_tuple(&record_def, STATIC_POSITION(0), record, &((user_value){.uint_value = key}), UINT32_MAX);
+	set_element_in_tuple(&record_def, STATIC_POSITION(1), record, &((user_value){.uint_value = value}), UINT32_MAX);
+}
+
+// builds a key tuple, for the key_def of any of the data structures, that are keyed on the first element of the record
+void build_key(const tuple_def* key_def, void* key_tuple, uint64_t key)
+{
+	init_tuple(key_def, key_tuple);
+	set_element_in_tuple(key_def, STATIC_POSITION(0), key_tuple, &((user_value){.uint_value = key}), UINT32_MAX);
+}
+
+uint64_t read_key(const void* record)
+{
+	user_value key;
+	get_value_from_element_from_tuple(&key, &record_def, STATIC_POSITION(0), record);
+	return key.uint_value;
+}
+
+uint64_t read_value(const void* record)
+{
+	user_value value;
+	get_value_from_element_from_tuple(&value, &record_def, STATIC_POSITION(1), record);
+	return value.uint_value;
+}
+
+// scans the whole bplus_tree forward or backward, checking that it holds exactly the keys in [0, records_count) for which is_key_present() returns 1
+// in order and each with a value of 10 times its key
+void check_scan(uint64_t root_page_id, int is_forward, uint64_t records_count, int (*is_key_present)(uint64_t key), const bplus_tree_tuple_defs* bpttd_p, const page_access_methods* pam_p)
+{
+	bplus_tree_iterator* bpi_p = find_in_bplus_tree(root_page_id, NULL, bpttd_p->key_element_count, (is_forward ? GREATER_THAN : LESSER_THAN), 0, READ_LOCK, bpttd_p, pam_p, NULL, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	// the next key that we expect to see, it is records_count once we are out of keys (on either end)
+	uint64_t expected_key = records_count;
+	for(uint64_t i = 0; i < records_count; i++)
+	{
+		uint64_t key = is_forward ? i : (records_count - 1 - i);
+		if(is_key_present(key))
+		{
+			expected_key = key;
+			break;
+		}
+	}
+
+	while(is_forward ? !is_beyond_max_tuple_bplus_tree_iterator(bpi_p) : !is_beyond_min_tuple_bplus_tree_iterator(bpi_p))
+	{
+		const void* record = get_tuple_bplus_tree_iterator(bpi_p);
+		if(record != NULL)
+		{
+			uint64_t key = read_key(record);
+			uint64_t value = read_value(record);
+
+			if(key != expected_key || value != key * 10)
+			{
+				printf("FAILED : %s scan found {%"PRIu64", %"PRIu64"}, when expecting key %"PRIu64"\n", (is_forward ? "forward" : "backward"), key, value, expected_key);
+				exit(-1);
+			}
+
+			// find the next present key in the scan direction
+			do
+			{
+				expected_key = is_forward ? (expected_key + 1) : ((expected_key == 0) ? records_count : (expected_key - 1));
+			}
+			while(expected_key < records_count && !is_key_present(expected_key));
+		}
+
+		if(is_forward)
+			next_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		else
+			prev_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+	}
+
+	delete_bplus_tree_iterator(bpi_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(expected_key != records_count)
+	{
+		printf("FAILED : %s scan stopped before key %"PRIu64"\n", (is_forward ? "forward" : "backward"), expected_key);
+		exit(-1);
+	}
+}
+
+// only the keys divisible by 4 are left after the deletes
+int is_key_present(uint64_t key)
+{
+	return (key % 4) == 0;
+}
+
+int is_every_key_present(uint64_t key)
+{
+	return 1;
+}
+
+// fills the page with a pattern that has no zero bytes, so that it can not be compressed
+void fill_incompressible(char* page)
+{
+	for(uint32_t i = 0; i < PAGE_SIZE; i++)
+		page[i] = ((i * 31 + 7) % 251) + 1;
+}
+
+// zeroes the page, except its first 16 bytes, so that it compresses well
+void fill_compressible(char* page)
+{
+	memset(page, 0, PAGE_SIZE);
+	for(uint32_t i = 0; i < 16; i++)
+		page[i] = i + 1;
+}
+
+// read locks the page and compares it against the expected contents
+void check_page(const page_access_methods* pam_p, uint64_t page_id, const char* expected, const char* name)
+{
+	const char* page = pam_p->acquire_page_with_reader_lock(pam_p->context, transaction_id, page_id, &abort_error);
+	CHECK_ABORT();
+	if(page == NULL)
+	{
+		printf("FAILED : could not lock the %s page\n", name);
+		exit(-1);
+	}
+
+	if(memcmp(page, expected, PAGE_SIZE))
+	{
+		printf("FAILED : contents of the %s page changed\n", name);
+		exit(-1);
+	}
+
+	pam_p->release_reader_lock_on_page(pam_p->context, transaction_id, (void*)page, NONE_OPTION, &abort_error);
+	CHECK_ABORT();
+}
+
+void check_compressed_count(uint64_t compressed, uint64_t expected, const char* when)
+{
+	if(compressed != expected)
+	{
+		printf("FAILED : %s, compressed %"PRIu64" pages, expected %"PRIu64"\n", when, compressed, expected);
+		exit(-1);
+	}
+}
+
+int main()
+{
+	/* SETUP STARTED */
+
+	page_access_methods* pam_p = get_new_unWALed_in_memory_data_store(&((page_access_specs){.page_id_width = PAGE_ID_WIDTH, .page_size = PAGE_SIZE}));
+
+	page_modification_methods* pmm_p = get_new_unWALed_page_modification_methods();
+
+	init_record_def();
+
+	bplus_tree_tuple_defs bpttd;
+	if(!init_bplus_tree_tuple_definitions(&bpttd, &(pam_p->pas), &record_def, (positional_accessor []){STATIC_POSITION(0)}, (compare_direction []){ASC}, 1))
+	{
+		printf("failed to initialize bplus_tree tuple definitions\n");
+		exit(-1);
+	}
+
+	/* SETUP COMPLETED */
+
+	/* TESTS STARTED */
+
+	// raw pages, modified in the order : cold_page, hot_page
+	{
+		char cold_contents[PAGE_SIZE];
+		char hot_contents[PAGE_SIZE];
+		fill_compressible(cold_contents);
+		fill_incompressible(hot_contents);
+
+		uint64_t cold_page_id;
+		void* cold_page = pam_p->get_new_page_with_write_lock(pam_p->context, transaction_id, &cold_page_id, &abort_error);
+		CHECK_ABORT();
+		memcpy(cold_page, cold_contents, PAGE_SIZE);
+		pam_p->release_writer_lock_on_page(pam_p->context, transaction_id, cold_page, WAS_MODIFIED, &abort_error);
+		CHECK_ABORT();
+
+		uint64_t hot_page_id;
+		void* hot_page = pam_p->get_new_page_with_write_lock(pam_p->context, transaction_id, &hot_page_id, &abort_error);
+		CHECK_ABORT();
+		memcpy(hot_page, hot_contents, PAGE_SIZE);
+		pam_p->release_writer_lock_on_page(pam_p->context, transaction_id, hot_page, WAS_MODIFIED, &abort_error);
+		CHECK_ABORT();
+
+		// no page is that cold
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, UINT64_MAX), 0, "with no cold pages");
+
+		// only the cold_page was not modified in the last 1 modification
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 1), 1, "with 1 cold page");
+
+		// the cold_page is already compressed, and the hot_page is still hot
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 1), 0, "again with 1 cold page");
+
+		// the hot_page is now cold, but it does not compress
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0), 0, "with an incompressible page");
+
+		// locking decompresses the cold_page, and a read lock does not modify it, so it gets compressed again
+		check_page(pam_p, cold_page_id, cold_contents, "cold");
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 1), 1, "after reading the cold page");
+		check_page(pam_p, cold_page_id, cold_contents, "cold");
+		check_page(pam_p, hot_page_id, hot_contents, "hot");
+
+		// make the hot_page compressible, it is now the most recently modified page
+		hot_page = pam_p->acquire_page_with_writer_lock(pam_p->context, transaction_id, hot_page_id, &abort_error);
+		CHECK_ABORT();
+		fill_compressible(hot_contents);
+		memcpy(hot_page, hot_contents, PAGE_SIZE);
+		pam_p->release_writer_lock_on_page(pam_p->context, transaction_id, hot_page, WAS_MODIFIED, &abort_error);
+		CHECK_ABORT();
+
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 1), 1, "after modifying the hot page");
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0), 1, "with all pages cold");
+		check_page(pam_p, cold_page_id, cold_contents, "cold");
+		check_page(pam_p, hot_page_id, hot_contents, "hot");
+
+		// compressed pages can be freed, without being locked again
+		check_compressed_count(compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0), 2, "before freeing the pages");
+		pam_p->free_page(pam_p->context, transaction_id, cold_page_id, &abort_error);
+		CHECK_ABORT();
+		pam_p->free_page(pam_p->context, transaction_id, hot_page_id, &abort_error);
+		CHECK_ABORT();
+
+		printf("PASSED : compress and decompress raw pages\n");
+	}
+
+	uint64_t used_pages_before = get_used_pages_count_in_unWALed_in_memory_data_store(pam_p);
+
+	uint64_t root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// delete 3 of every 4 records, leaving the leaf pages sparse
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		if(is_key_present(key))
+			continue;
+
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, key);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : delete of key %"PRIu64"\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// every page of the bplus_tree is cold, scans decompress them, and being only read they get compressed again
+	for(int round = 0; round < 2; round++)
+	{
+		uint64_t compressed = compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0);
+		printf("round %d : compressed %"PRIu64" of %"PRIu64" pages of the bplus_tree\n", round, compressed, get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) - used_pages_before);
+
+		check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+		check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	}
+
+	// writes go to the decompressed pages
+	for(uint64_t key = 0; key < RECORDS_COUNT; key += 4)
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, key);
+
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0);
+
+		if(!delete_from_bplus_tree(root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error)
+		|| !insert_in_bplus_tree(root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : reinsert of key %"PRIu64", into a compressed bplus_tree\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0);
+	check_scan(root_page_id, 1, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+	check_scan(root_page_id, 0, RECORDS_COUNT, is_key_present, &bpttd, pam_p);
+
+	printf("PASSED : bplus_tree scans and writes over compressed pages\n");
+
+	uint64_t dense_root_page_id = get_new_bplus_tree(&bpttd, pam_p, pmm_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	for(uint64_t key = 0; key < RECORDS_COUNT; key++)
+	{
+		char record[PAGE_SIZE];
+		build_record(record, key, key * 10);
+
+		if(!insert_in_bplus_tree(dense_root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : insert of key %"PRIu64", into the dense bplus_tree\n", key);
+			exit(-1);
+		}
+		CHECK_ABORT();
+	}
+
+	// the leaf pages are decoded (and xor-ed back) by the codec of the bplus_tree, when the scans lock them
+	for(int round = 0; round < 2; round++)
+	{
+		uint64_t compressed = compress_cold_leaf_pages_of_bplus_tree(dense_root_page_id, 0, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		printf("round %d : compressed %"PRIu64" leaf pages of the dense bplus_tree\n", round, compressed);
+
+		if(compressed == 0)
+		{
+			printf("FAILED : no leaf page of the dense bplus_tree compressed with its page_codec\n");
+			exit(-1);
+		}
+
+		check_scan(dense_root_page_id, 1, RECORDS_COUNT, is_every_key_present, &bpttd, pam_p);
+		check_scan(dense_root_page_id, 0, RECORDS_COUNT, is_every_key_present, &bpttd, pam_p);
+	}
+
+	// the hot leaf pages are left as is, the rest of the leaf pages are compressed again after being decompressed by the scans of the last round
+	{
+		char key_tuple[PAGE_SIZE];
+		build_key(bpttd.key_def, key_tuple, 0);
+
+		char record[PAGE_SIZE];
+		build_record(record, 0, 0);
+
+		if(!delete_from_bplus_tree(dense_root_page_id, key_tuple, &bpttd, pam_p, pmm_p, transaction_id, &abort_error)
+		|| !insert_in_bplus_tree(dense_root_page_id, record, &bpttd, pam_p, pmm_p, transaction_id, &abort_error))
+		{
+			printf("FAILED : reinsert of key 0, into the dense bplus_tree\n");
+			exit(-1);
+		}
+		CHECK_ABORT();
+
+		uint64_t compressed = compress_cold_leaf_pages_of_bplus_tree(dense_root_page_id, 1, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		printf("compressed %"PRIu64" leaf pages of the dense bplus_tree, with only its first leaf page hot\n", compressed);
+
+		// the first leaf page was the last one modified, and the rest were compressed by the call above
+		compressed = compress_cold_leaf_pages_of_bplus_tree(dense_root_page_id, 1, &bpttd, pam_p, transaction_id, &abort_error);
+		CHECK_ABORT();
+		check_compressed_count(compressed, 0, "with only the first leaf page hot");
+	}
+
+	printf("PASSED : bplus_tree leaf pages compressed with the page_codec of the bplus_tree\n");
+
+	/* TESTS ENDED */
+
+	/* CLEANUP */
+
+	// destroying frees the compressed pages as well
+	compress_cold_pages_in_unWALed_in_memory_data_store(pam_p, 0);
+	destroy_bplus_tree(root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	compress_cold_leaf_pages_of_bplus_tree(dense_root_page_id, 0, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+	destroy_bplus_tree(dense_root_page_id, &bpttd, pam_p, transaction_id, &abort_error);
+	CHECK_ABORT();
+
+	if(get_used_pages_count_in_unWALed_in_memory_data_store(pam_p) != used_pages_before)
+	{
+		printf("FAILED : pages were left behind by destroy\n");
+		exit(-1);
+	}
+
+	close_and_destroy_unWALed_in_memory_data_store(pam_p);
+
+	deinit_bplus_tree_tuple_definitions(&bpttd);
+
+	delete_unWALed_page_modification_methods(pmm_p);
+
+	return 0;
+}